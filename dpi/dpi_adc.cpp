@@ -0,0 +1,468 @@
+/**
+ * dpi_adc.cpp - DPI-C ADC Quantization Engine (INL/DNL, Offset/Gain, Skew, Noise)
+ *
+ * Back end for the RX ADC (spec/serdes_architecture.md §3.1.1, adc_model.sv).
+ * The ideal transfer function is the spec's
+ *     code = clamp(round(x × 2^(BITS-1) / FULL_SCALE), -2^(BITS-1), 2^(BITS-1)-1)
+ * which for BITS = 8, FULL_SCALE = 1.0 V is clamp(round(x × 128), -128, 127).
+ *
+ * Features:
+ * - 2..16 bits, configurable full scale (half range, volts)
+ * - Time-interleaved lanes: per-lane offset, gain error and sampling skew
+ *   (sample i is taken by lane i % num_lanes); skew adds one sample of
+ *   latency so its slope is always a central difference
+ * - Thermal (input-referred) Gaussian noise
+ * - Table-driven INL/DNL: per-code transition levels, loaded from a table
+ *   or generated from a profile (bow, S-curve, random DNL)
+ * - Block conversion: AVX2 round-half-away + clamp + convert, 4 samples
+ *   per instruction (scalar fallback gives identical codes)
+ *
+ * Author: Generated for SerDes RX front-end modeling
+ * Date: 2025
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "dpi_alloc.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+//==============================================================================
+// CONFIGURATION
+//==============================================================================
+#define ADC_MIN_BITS     2
+#define ADC_MAX_BITS     16
+#define ADC_MAX_LANES    64
+#define ADC_CHUNK        256         // Samples per internal conversion chunk
+
+// INL profile shapes for dpi_adc_set_inl_profile()
+#define ADC_INL_NONE     0
+#define ADC_INL_BOW      1           // Quadratic (even-order distortion)
+#define ADC_INL_SCURVE   2           // Cubic (odd-order distortion)
+
+//==============================================================================
+// ENGINE STATE
+//==============================================================================
+struct AdcLane {
+    double offset_v;
+    double gain;                     // 1 + gain error
+    double skew_ui;                  // Skew in sample periods
+};
+
+struct AdcEngine {
+    int bits;
+    int code_min;
+    int code_max;
+    double full_scale_v;
+    double sample_rate_hz;
+    double scale;                    // LSB per volt
+
+    int num_lanes;
+    AdcLane lanes[ADC_MAX_LANES];
+    int any_skew;
+    uint64_t sample_index;
+    int have_x;                      // Skew history seeded (from the first input)
+    double prev_x;                   // Input before held_x
+    double held_x;                   // Latest input, converted next with skew
+
+    double noise_rms_v;
+    uint64_t rng[2];                 // xorshift128+
+    int have_spare;
+    double spare;
+
+    // Transition levels in LSB, signed domain: code c starts at thr[c - code_min]
+    // (thr[0] = -inf, ideal thr = c - 0.5). Empty = ideal quantizer.
+    dpi_vector<double> thr{DpiAllocator<double>("adc.thr")};
+
+    uint64_t clipped;
+    double work[ADC_CHUNK];          // Analog pre-pass (scaled to LSB)
+};
+
+//==============================================================================
+// RANDOM NUMBERS (xorshift128+, Box-Muller)
+//==============================================================================
+static inline uint64_t adc_next_u64(AdcEngine *a) {
+    uint64_t s1 = a->rng[0];
+    const uint64_t s0 = a->rng[1];
+    a->rng[0] = s0;
+    s1 ^= s1 << 23;
+    a->rng[1] = s1 ^ s0 ^ (s1 >> 17) ^ (s0 >> 26);
+    return a->rng[1] + s0;
+}
+
+static inline double adc_uniform(AdcEngine *a) {
+    return ((double)(adc_next_u64(a) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+static double adc_gauss(AdcEngine *a) {
+    if (a->have_spare) {
+        a->have_spare = 0;
+        return a->spare;
+    }
+    const double r = sqrt(-2.0 * log(adc_uniform(a)));
+    const double th = 2.0 * M_PI * adc_uniform(a);
+    a->spare = r * sin(th);
+    a->have_spare = 1;
+    return r * cos(th);
+}
+
+static void adc_seed(AdcEngine *a, int seed) {
+    uint64_t z = (uint64_t)seed * 0x9E3779B97F4A7C15ULL + 0x2545F4914F6CDD1DULL;
+    for (int i = 0; i < 2; i++) {                // splitmix64
+        z += 0x9E3779B97F4A7C15ULL;
+        uint64_t x = z;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        a->rng[i] = x ^ (x >> 31);
+    }
+    a->have_spare = 0;
+}
+
+//==============================================================================
+// QUANTIZER
+//==============================================================================
+static inline double adc_round_half_away(double v) {
+    return trunc(v + copysign(0.5, v));
+}
+
+/** Ideal code → INL-corrected code using the transition table. */
+static inline int adc_apply_thresholds(const AdcEngine *a, double v, int c) {
+    const double *thr = a->thr.data();
+    const int base = a->code_min;
+    while (c > a->code_min && v < thr[c - base]) c--;
+    while (c < a->code_max && v >= thr[c + 1 - base]) c++;
+    return c;
+}
+
+/**
+ * Quantize n pre-scaled values (LSB units) in a->work to codes.
+ */
+static void adc_quantize(AdcEngine *a, int n, int *codes) {
+    const double lo = (double)a->code_min;
+    const double hi = (double)a->code_max;
+    int i = 0;
+#if defined(__AVX2__)
+    const __m256d vlo = _mm256_set1_pd(lo);
+    const __m256d vhi = _mm256_set1_pd(hi);
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(&a->work[i]);
+        v = _mm256_add_pd(v, _mm256_or_pd(_mm256_and_pd(v, sign), half));
+        v = _mm256_round_pd(v, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+        v = _mm256_min_pd(_mm256_max_pd(v, vlo), vhi);
+        _mm_storeu_si128((__m128i *)&codes[i], _mm256_cvtpd_epi32(v));
+    }
+#endif
+    for (; i < n; i++) {
+        double v = adc_round_half_away(a->work[i]);
+        v = v < lo ? lo : (v > hi ? hi : v);
+        codes[i] = (int)v;
+    }
+
+    for (int j = 0; j < n; j++) {
+        if (a->work[j] < lo - 0.5 || a->work[j] >= hi + 0.5) a->clipped++;
+    }
+    if (!a->thr.empty()) {
+        for (int j = 0; j < n; j++) codes[j] = adc_apply_thresholds(a, a->work[j], codes[j]);
+    }
+}
+
+/**
+ * Analog pre-pass: skew (first-order, x + τ·dx/dt), lane gain/offset and
+ * thermal noise, scaled to LSB. With skew the output runs one sample late:
+ * a sample is converted when its successor arrives, so every slope is a
+ * central difference however the input is split into calls. The first
+ * output repeats the first input, which also seeds the history.
+ */
+static void adc_front_end(AdcEngine *a, const double *x, int n) {
+    if (!a->have_x) {
+        a->prev_x = a->held_x = x[0];
+        a->have_x = 1;
+    }
+    for (int i = 0; i < n; i++) {
+        uint64_t k = a->sample_index + (uint64_t)i;     // Input sample converted now
+        double v = x[i];
+        if (a->any_skew) {
+            k -= (k > 0);
+            v = a->held_x;
+        }
+        const AdcLane *l = &a->lanes[k % (uint64_t)a->num_lanes];
+        if (a->any_skew) v += l->skew_ui * 0.5 * (x[i] - a->prev_x);
+        a->prev_x = a->held_x;
+        a->held_x = x[i];
+        v = v * l->gain + l->offset_v;
+        if (a->noise_rms_v > 0.0) v += a->noise_rms_v * adc_gauss(a);
+        a->work[i] = v * a->scale;
+    }
+    a->sample_index += (uint64_t)n;
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// DPI-C EXPORTED FUNCTIONS
+//==============================================================================
+/**
+ * DPI-C Function: dpi_adc_create
+ *
+ * Args:
+ *   bits           : Resolution (2..16)
+ *   full_scale_v   : Half range; [-FS, +FS) maps to [-2^(bits-1), 2^(bits-1)-1]
+ *   sample_rate_hz : Aggregate sample rate (skew is given in seconds)
+ *   num_lanes      : Interleaved sub-ADCs (1..64)
+ *   seed           : Noise / random-DNL seed
+ *
+ * Returns:
+ *   chandle: ADC handle (ideal, noiseless), or NULL on invalid arguments
+ */
+void *dpi_adc_create(int bits, double full_scale_v, double sample_rate_hz,
+                     int num_lanes, int seed) {
+    if (bits < ADC_MIN_BITS || bits > ADC_MAX_BITS || full_scale_v <= 0.0 ||
+        sample_rate_hz <= 0.0 || num_lanes < 1 || num_lanes > ADC_MAX_LANES) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_adc_create: invalid arguments "
+                "(bits=%d fs=%g rate=%g lanes=%d)\n", bits, full_scale_v,
+                sample_rate_hz, num_lanes);
+        return NULL;
+    }
+    // Declared needs: engine + a full transition table
+    AdcEngine *a = dpi_arena_new<AdcEngine>(
+        dpi_arena_need<AdcEngine>() + dpi_arena_need<double>((size_t)1 << bits), "adc");
+    a->bits = bits;
+    a->code_min = -(1 << (bits - 1));
+    a->code_max = (1 << (bits - 1)) - 1;
+    a->full_scale_v = full_scale_v;
+    a->sample_rate_hz = sample_rate_hz;
+    a->scale = (double)(1 << (bits - 1)) / full_scale_v;
+    a->num_lanes = num_lanes;
+    for (int l = 0; l < ADC_MAX_LANES; l++) a->lanes[l] = {0.0, 1.0, 0.0};
+    a->any_skew = 0;
+    a->sample_index = 0;
+    a->have_x = 0;
+    a->prev_x = 0.0;
+    a->held_x = 0.0;
+    a->noise_rms_v = 0.0;
+    a->clipped = 0;
+    adc_seed(a, seed);
+    return a;
+}
+
+/**
+ * DPI-C Function: dpi_adc_set_lane
+ *
+ * Args:
+ *   lane       : Sub-ADC index (0..num_lanes-1)
+ *   offset_v   : Input-referred offset (V)
+ *   gain_error : Fractional gain error (0.01 = +1%)
+ *   skew_s     : Sampling-time skew (s, positive = samples late); any
+ *                nonzero skew delays the output by one sample
+ */
+void dpi_adc_set_lane(void *handle, int lane, double offset_v, double gain_error,
+                      double skew_s) {
+    AdcEngine *a = (AdcEngine *)handle;
+    if (lane < 0 || lane >= a->num_lanes) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_adc_set_lane: lane %d out of range\n", lane);
+        return;
+    }
+    a->lanes[lane].offset_v = offset_v;
+    a->lanes[lane].gain = 1.0 + gain_error;
+    a->lanes[lane].skew_ui = skew_s * a->sample_rate_hz;
+    a->any_skew = 0;
+    for (int l = 0; l < a->num_lanes; l++) a->any_skew |= (a->lanes[l].skew_ui != 0.0);
+}
+
+/** DPI-C Function: dpi_adc_set_noise - input-referred thermal noise RMS (V). */
+void dpi_adc_set_noise(void *handle, double rms_v) {
+    ((AdcEngine *)handle)->noise_rms_v = rms_v > 0.0 ? rms_v : 0.0;
+}
+
+/**
+ * DPI-C Function: dpi_adc_set_inl_table
+ *
+ * Loads per-code INL in LSB: inl[c - code_min] shifts the transition into
+ * code c (index 0 is unused). n must be 2^bits; n = 0 restores ideal.
+ *
+ * Returns:
+ *   int: 0 on success, -1 on size mismatch or non-monotonic transitions
+ */
+int dpi_adc_set_inl_table(void *handle, const double *inl, int n) {
+    AdcEngine *a = (AdcEngine *)handle;
+    const int ncodes = a->code_max - a->code_min + 1;
+    if (n == 0) {
+        a->thr.clear();
+        return 0;
+    }
+    if (n != ncodes) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_adc_set_inl_table: expected %d entries, got %d\n",
+                ncodes, n);
+        return -1;
+    }
+    std::vector<double> thr(ncodes);
+    thr[0] = -INFINITY;
+    for (int i = 1; i < ncodes; i++) {
+        thr[i] = (double)(a->code_min + i) - 0.5 + inl[i];
+        if (i > 1 && thr[i] <= thr[i - 1]) {
+            fprintf(stderr, "[DPI-C ERROR] dpi_adc_set_inl_table: missing code %d "
+                    "(DNL <= -1 LSB)\n", a->code_min + i - 1);
+            return -1;
+        }
+    }
+    a->thr.assign(thr.begin(), thr.end());   // Reuses the arena block after the first table
+    return 0;
+}
+
+/**
+ * DPI-C Function: dpi_adc_set_inl_profile
+ *
+ * Generates the transition table from a profile.
+ *
+ * Args:
+ *   shape         : 0 = none, 1 = bow (quadratic), 2 = S-curve (cubic)
+ *   amplitude_lsb : Peak INL of the shape (LSB), zero at the end points
+ *   sigma_lsb     : Random per-transition shift (LSB RMS, seeded);
+ *                   the resulting DNL RMS is ~1.41 x sigma_lsb
+ *
+ * Returns:
+ *   int: 0 on success, -1 on invalid shape or missing codes
+ */
+int dpi_adc_set_inl_profile(void *handle, int shape, double amplitude_lsb,
+                            double sigma_lsb) {
+    AdcEngine *a = (AdcEngine *)handle;
+    if (shape < ADC_INL_NONE || shape > ADC_INL_SCURVE) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_adc_set_inl_profile: unknown shape %d\n", shape);
+        return -1;
+    }
+    const int ncodes = a->code_max - a->code_min + 1;
+    std::vector<double> inl(ncodes, 0.0);
+    for (int i = 1; i < ncodes; i++) {
+        const double u = 2.0 * (double)i / (double)ncodes - 1.0;     // -1..1
+        double v = 0.0;
+        if (shape == ADC_INL_BOW) v = amplitude_lsb * (1.0 - u * u);
+        if (shape == ADC_INL_SCURVE) v = amplitude_lsb * 2.598076 * u * (1.0 - u * u);
+        if (sigma_lsb > 0.0) v += sigma_lsb * adc_gauss(a);
+        inl[i] = v;
+    }
+    if (shape == ADC_INL_NONE && sigma_lsb <= 0.0) return dpi_adc_set_inl_table(a, NULL, 0);
+    return dpi_adc_set_inl_table(a, inl.data(), ncodes);
+}
+
+/**
+ * DPI-C Function: dpi_adc_convert
+ *
+ * Converts one sample (streaming use, e.g. adc_model.sv per clock).
+ */
+int dpi_adc_convert(void *handle, double x) {
+    AdcEngine *a = (AdcEngine *)handle;
+    int code;
+    adc_front_end(a, &x, 1);
+    adc_quantize(a, 1, &code);
+    return code;
+}
+
+/**
+ * DPI-C Function: dpi_adc_convert_block
+ *
+ * Converts n samples x[] → codes[] at block rate.
+ *
+ * Returns:
+ *   int: Number of samples converted
+ */
+int dpi_adc_convert_block(void *handle, const double *x, int *codes, int n) {
+    AdcEngine *a = (AdcEngine *)handle;
+    for (int off = 0; off < n; off += ADC_CHUNK) {
+        const int m = (n - off < ADC_CHUNK) ? n - off : ADC_CHUNK;
+        adc_front_end(a, &x[off], m);
+        adc_quantize(a, m, &codes[off]);
+    }
+    return n;
+}
+
+/**
+ * DPI-C Function: dpi_adc_inl
+ *
+ * INL of the transition into code (LSB); 0 for an ideal ADC.
+ */
+double dpi_adc_inl(void *handle, int code) {
+    const AdcEngine *a = (const AdcEngine *)handle;
+    if (a->thr.empty() || code <= a->code_min || code > a->code_max) return 0.0;
+    return a->thr[code - a->code_min] - ((double)code - 0.5);
+}
+
+/**
+ * DPI-C Function: dpi_adc_dnl
+ *
+ * DNL of code (LSB): width - 1. End codes (open-ended) return 0.
+ */
+double dpi_adc_dnl(void *handle, int code) {
+    const AdcEngine *a = (const AdcEngine *)handle;
+    if (a->thr.empty() || code <= a->code_min || code >= a->code_max) return 0.0;
+    const int i = code - a->code_min;
+    return a->thr[i + 1] - a->thr[i] - 1.0;
+}
+
+/** DPI-C Function: dpi_adc_clip_count - samples outside the input range. */
+long long dpi_adc_clip_count(void *handle) {
+    return (long long)((AdcEngine *)handle)->clipped;
+}
+
+/** DPI-C Function: dpi_adc_destroy */
+void dpi_adc_destroy(void *handle) {
+    dpi_arena_delete((AdcEngine *)handle);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * =============================================================================
+ * IMPLEMENTATION NOTES
+ * =============================================================================
+ *
+ * 1. Signal Chain per Sample (lane = sample_index % num_lanes):
+ *    x → skew: x + τ·dx/dt → gain·x + offset → + noise → ×(2^(bits-1)/FS)
+ *      → round half away from zero (SV round()) → clamp → INL correction
+ *
+ * 2. Sampling Skew:
+ *    - First-order model: x(t + τ) ≈ x(t) + τ·x'(t), x' by central
+ *      difference 0.5·(x[k+1] - x[k-1])
+ *    - Once any lane has skew the output is one sample late, so x[k+1] is
+ *      always known: codes do not depend on how the input is split into
+ *      dpi_adc_convert / dpi_adc_convert_block calls. The first output
+ *      repeats x[0], and x[-1] = x[0]
+ *    - Accurate while τ·f_signal << 1; this is the regime in which TI-ADC
+ *      skew spurs (at f_s/M ± f_in) are usually analyzed
+ *    - The central difference under-estimates the slope by sinc(f/f_s)
+ *      (-6.5% at f_s/10), so the modeled skew error is slightly low
+ *    - Configure the lanes before converting: enabling skew mid-stream
+ *      adds the one-sample latency there (one sample is output twice)
+ *
+ * 3. INL/DNL Table:
+ *    - thr[c] = c - 0.5 + INL[c] (LSB) is where code c begins
+ *    - SIMD rounding gives the ideal code; the table correction moves it by
+ *      the (usually 0 or 1) codes the transition shift requires
+ *    - DNL[c] = thr[c+1] - thr[c] - 1; a table with DNL <= -1 (missing code)
+ *      is rejected
+ *    - The profile INL is relative to the ideal end-point line
+ *
+ * 4. Clipping:
+ *    - Inputs beyond the outer code edges clamp to code_min/code_max and
+ *      are counted (dpi_adc_clip_count) to flag AGC / full-scale problems
+ *
+ * 5. Verilator Compilation:
+ *    - Add to test_config.yaml:
+ *      verilator_extra_flags:
+ *        - ../dpi/dpi_adc.cpp
+ *        - -CFLAGS
+ *        - -march=native
+ *
+ * =============================================================================
+ */
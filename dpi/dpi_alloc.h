@@ -0,0 +1,597 @@
+/**
+ * dpi_alloc.h - Huge-Page / NUMA-Local Allocation for Large DPI Buffers
+ *
+ * Shared by the C++ engines in dpi/ for their large buffers (eye
+ * histograms, FWHT / FFT work arrays, captured blocks). Header-only: a
+ * test adds no source file, and engines built into one model share one
+ * registry.
+ *
+ * Features:
+ * - Buffers of 2 MB and more are mmap'ed on a 2 MB boundary and backed by
+ *   transparent huge pages (madvise), or by explicit hugetlbfs pages when
+ *   reserved; smaller buffers use the normal heap
+ * - NUMA: the pages are preferred on the node of the thread that creates
+ *   the buffer (the simulation thread), so parallel instances on a
+ *   multi-socket host each stay on local memory
+ * - Placement report: requested vs actual node and huge-page backed bytes
+ *   per buffer, printed when the buffer is freed and for buffers still
+ *   live at exit
+ * - dpi_vector<T>: std::vector with this allocator; an engine switches a
+ *   member by changing its type and naming the buffer
+ * - Engine arenas: each engine instance lives in one region sized from its
+ *   declared needs; its dpi_vector members are carved from it, freed blocks
+ *   are reused, destroy is one free, and the state can be checkpointed as
+ *   one blob (dpi_<engine>_save / dpi_<engine>_restore)
+ *
+ * Environment:
+ *   DPI_HUGEPAGES    thp (default) | explicit | off
+ *   DPI_NUMA         local (default) | off
+ *   DPI_ALLOC_REPORT 1 = print the placement of every large buffer
+ *
+ * Usage:
+ *   struct Engine { dpi_vector<uint32_t> hist{DpiAllocator<uint32_t>("eye.hist")}; };
+ *   Engine *e = dpi_arena_new<Engine>(dpi_arena_need<Engine>() +
+ *                                     dpi_arena_need<uint32_t>(n), "eye");
+ *   e->hist.assign(n, 0);             // From the arena, no malloc
+ *   dpi_arena_delete(e);
+ *
+ * Author: Generated for SerDes simulation performance
+ * Date: 2025
+ */
+
+#ifndef DPI_ALLOC_H
+#define DPI_ALLOC_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+//==============================================================================
+// CONFIGURATION
+//==============================================================================
+#define DPI_ALLOC_HUGE_PAGE     ((size_t)2 << 20)   // x86-64 / aarch64 PMD page
+#define DPI_ALLOC_HUGE_MIN      DPI_ALLOC_HUGE_PAGE // Smaller buffers use the heap
+
+// <numaif.h> values (not included: it belongs to libnuma-dev)
+#define DPI_MPOL_PREFERRED      1
+#define DPI_MPOL_F_NODE         (1 << 0)
+#define DPI_MPOL_F_ADDR         (1 << 1)
+
+enum DpiPages {
+    DPI_PAGES_SMALL = 0,                // 4 KB pages
+    DPI_PAGES_THP = 1,                  // madvise(MADV_HUGEPAGE)
+    DPI_PAGES_HUGETLB = 2               // MAP_HUGETLB (reserved pool)
+};
+
+//==============================================================================
+// REGISTRY
+//==============================================================================
+struct DpiBlock {
+    const char *tag;
+    size_t bytes;                       // Requested
+    size_t mapped;                      // Mapped (multiple of the huge page)
+    int pages;                          // DpiPages
+    int node;                           // Preferred NUMA node, -1 = not bound
+};
+
+struct DpiAllocState {
+    std::mutex lock;
+    std::map<void *, DpiBlock> blocks;
+    int hugepages;                      // DpiPages to request
+    bool numa;
+    bool report;
+    size_t live;
+    size_t peak;
+
+    DpiAllocState() : live(0), peak(0) {
+        const char *hp = getenv("DPI_HUGEPAGES");
+        const char *numa_env = getenv("DPI_NUMA");
+        const char *rep = getenv("DPI_ALLOC_REPORT");
+        hugepages = (hp && !strcmp(hp, "off")) ? DPI_PAGES_SMALL
+                  : (hp && !strcmp(hp, "explicit")) ? DPI_PAGES_HUGETLB : DPI_PAGES_THP;
+        numa = !(numa_env && !strcmp(numa_env, "off"));
+        report = rep && strcmp(rep, "0") != 0;
+    }
+
+    ~DpiAllocState();
+};
+
+/** One registry per process, shared by every engine that includes this file. */
+inline DpiAllocState &dpi_alloc_state() {
+    static DpiAllocState state;
+    return state;
+}
+
+//==============================================================================
+// PLACEMENT QUERIES
+//==============================================================================
+#ifdef __linux__
+/** NUMA node of the calling thread's CPU (-1 if unknown). */
+inline int dpi_alloc_thread_node() {
+    unsigned cpu = 0, node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) != 0) return -1;
+    return (int)node;
+}
+
+/** NUMA node holding the page at p (-1 if unknown). */
+inline int dpi_alloc_page_node(void *p) {
+    int node = -1;
+    if (syscall(SYS_get_mempolicy, &node, NULL, 0UL, p, DPI_MPOL_F_NODE | DPI_MPOL_F_ADDR) != 0)
+        return -1;
+    return node;
+}
+
+/** AnonHugePages of the mapping containing p, from /proc/self/smaps. */
+inline size_t dpi_alloc_thp_bytes(void *p) {
+    FILE *f = fopen("/proc/self/smaps", "r");
+    if (!f) return 0;
+    char line[512];
+    bool inside = false;
+    size_t kb = 0;
+    const uintptr_t a = (uintptr_t)p;
+    while (fgets(line, sizeof(line), f)) {
+        unsigned long lo, hi;
+        if (sscanf(line, "%lx-%lx ", &lo, &hi) == 2) {
+            if (inside) break;
+            inside = (a >= lo && a < hi);
+        } else if (inside && sscanf(line, "AnonHugePages: %zu kB", &kb) == 1) {
+            break;
+        }
+    }
+    fclose(f);
+    return kb * 1024;
+}
+#endif
+
+/** Print where a large buffer ended up (call once its pages are touched). */
+inline void dpi_alloc_describe(void *p, const DpiBlock &b) {
+    static const char *const kinds[] = {"4 KB pages", "THP", "hugetlb"};
+#ifdef __linux__
+    const double mb = 1.0 / (1 << 20);
+    const size_t huge = (b.pages == DPI_PAGES_HUGETLB) ? b.mapped
+                                                       : std::min(dpi_alloc_thp_bytes(p), b.mapped);
+    const int node = dpi_alloc_page_node(p);
+    fprintf(stderr, "[DPI-C ALLOC] %s: %.1f MB, %s (%.1f MB in 2 MB pages), node %d%s\n",
+            b.tag, b.bytes * mb, kinds[b.pages], huge * mb, node,
+            b.node < 0 ? " (not bound)" : (node == b.node ? " (local)" : " (REMOTE)"));
+#else
+    fprintf(stderr, "[DPI-C ALLOC] %s: %.1f MB, %s\n", b.tag, b.bytes / 1048576.0, kinds[b.pages]);
+    (void)p;
+#endif
+}
+
+/** Placement of every live large buffer and the peak total. */
+inline void dpi_alloc_report() {
+    DpiAllocState &s = dpi_alloc_state();
+    std::lock_guard<std::mutex> guard(s.lock);
+    for (const auto &kv : s.blocks) dpi_alloc_describe(kv.first, kv.second);
+    fprintf(stderr, "[DPI-C ALLOC] peak %.1f MB in large buffers\n", s.peak / 1048576.0);
+}
+
+// Buffers still live at exit (engines never destroyed) are reported here
+inline DpiAllocState::~DpiAllocState() {
+    if (!report || peak == 0) return;
+    for (const auto &kv : blocks) dpi_alloc_describe(kv.first, kv.second);
+    fprintf(stderr, "[DPI-C ALLOC] peak %.1f MB in large buffers\n", peak / 1048576.0);
+}
+
+//==============================================================================
+// ALLOCATION
+//==============================================================================
+/**
+ * Allocate a buffer; 2 MB and larger ones get huge pages and NUMA binding.
+ *
+ * Args:
+ *   bytes: Size
+ *   tag:   Name shown in the placement report (static string)
+ *
+ * Returns:
+ *   Pointer (64-byte aligned, 2 MB for huge-page buffers); throws std::bad_alloc
+ */
+inline void *dpi_alloc_large(size_t bytes, const char *tag) {
+    if (bytes < DPI_ALLOC_HUGE_MIN) return ::operator new(bytes, std::align_val_t(64));
+#ifdef __linux__
+    DpiAllocState &s = dpi_alloc_state();
+    const size_t mapped = (bytes + DPI_ALLOC_HUGE_PAGE - 1) & ~(DPI_ALLOC_HUGE_PAGE - 1);
+    const int prot = PROT_READ | PROT_WRITE;
+    void *p = MAP_FAILED;
+    int pages = s.hugepages;
+
+    if (pages == DPI_PAGES_HUGETLB) {
+        p = mmap(NULL, mapped, prot, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p == MAP_FAILED) pages = DPI_PAGES_THP;     // No reserved pool: fall back
+    }
+    if (p == MAP_FAILED) {
+        // THP only backs 2 MB-aligned ranges: over-map by one huge page, trim
+        char *raw = (char *)mmap(NULL, mapped + DPI_ALLOC_HUGE_PAGE, prot,
+                                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED) throw std::bad_alloc();
+        char *aligned = (char *)(((uintptr_t)raw + DPI_ALLOC_HUGE_PAGE - 1) &
+                                 ~(uintptr_t)(DPI_ALLOC_HUGE_PAGE - 1));
+        if (aligned > raw) munmap(raw, (size_t)(aligned - raw));
+        const size_t tail = (size_t)(raw + mapped + DPI_ALLOC_HUGE_PAGE - (aligned + mapped));
+        if (tail) munmap(aligned + mapped, tail);
+        p = aligned;
+        if (pages == DPI_PAGES_THP && madvise(p, mapped, MADV_HUGEPAGE) != 0)
+            pages = DPI_PAGES_SMALL;                    // THP disabled in this kernel
+    }
+
+    // Prefer the simulation thread's node (not strict: a full node spills
+    // to the others instead of failing); ENOSYS / EPERM leave it unbound
+    int node = -1;
+    if (s.numa) {
+        const int n = dpi_alloc_thread_node();
+        unsigned long mask = (n >= 0 && n < 63) ? 1UL << n : 0;
+        if (mask && syscall(SYS_mbind, p, mapped, DPI_MPOL_PREFERRED, &mask,
+                            8 * sizeof(mask), 0) == 0)
+            node = n;
+    }
+
+    std::lock_guard<std::mutex> guard(s.lock);
+    s.blocks[p] = {tag, bytes, mapped, pages, node};
+    s.live += mapped;
+    if (s.live > s.peak) s.peak = s.live;
+    return p;
+#else
+    (void)tag;
+    return ::operator new(bytes, std::align_val_t(64));
+#endif
+}
+
+/** Free a dpi_alloc_large() buffer; `bytes` must be the allocated size. */
+inline void dpi_free_large(void *p, size_t bytes) {
+    if (bytes < DPI_ALLOC_HUGE_MIN) {
+        ::operator delete(p, std::align_val_t(64));
+        return;
+    }
+#ifdef __linux__
+    DpiAllocState &s = dpi_alloc_state();
+    DpiBlock b;
+    {
+        std::lock_guard<std::mutex> guard(s.lock);
+        auto it = s.blocks.find(p);
+        if (it == s.blocks.end()) {
+            fprintf(stderr, "[DPI-C ERROR] dpi_free_large: unknown buffer %p\n", p);
+            return;
+        }
+        b = it->second;
+        s.blocks.erase(it);
+        s.live -= b.mapped;
+    }
+    if (s.report) dpi_alloc_describe(p, b);
+    munmap(p, b.mapped);
+#else
+    ::operator delete(p, std::align_val_t(64));
+#endif
+}
+
+//==============================================================================
+// ENGINE ARENA
+//==============================================================================
+// One contiguous region per engine instance: the engine struct is the first
+// block, its buffers follow, bump-allocated. The create function sizes it
+// from the declared needs (sum of dpi_arena_need<T>(n) terms), so an engine
+// costs one allocation to create and one to destroy, and its whole state is
+// one blob (dpi_arena_save / dpi_arena_restore). Blocks freed below the top
+// (a growing vector's old storage) become holes that later blocks reuse
+#define DPI_ARENA_ALIGN         64      // Cache line: buffers never share one
+
+// Free block inside the arena; the list lives in the holes themselves
+struct DpiArenaHole {
+    size_t bytes;
+    DpiArenaHole *next;                 // Next hole at a higher address
+};
+
+struct DpiArena {
+    char *base;                         // First block (the engine)
+    size_t capacity;
+    size_t used;
+    size_t peak;                        // High-water mark of used
+    size_t region;                      // Whole mapping, this header included
+    size_t spilled;                     // Bytes that did not fit (allocated outside)
+    DpiArenaHole *holes;                // Freed blocks below used, address order
+    const char *tag;
+};
+
+#define DPI_ARENA_HEADER \
+    ((sizeof(DpiArena) + DPI_ARENA_ALIGN - 1) & ~(size_t)(DPI_ARENA_ALIGN - 1))
+
+inline size_t dpi_arena_round(size_t bytes) {
+    return (bytes + DPI_ARENA_ALIGN - 1) & ~(size_t)(DPI_ARENA_ALIGN - 1);
+}
+
+/** Arena bytes for n objects of T (one declared need). */
+template <class T>
+inline size_t dpi_arena_need(size_t n = 1) {
+    return dpi_arena_round(n * sizeof(T));
+}
+
+/** Arena that dpi_vector members constructed on this thread draw from. */
+inline DpiArena *&dpi_arena_current() {
+    static thread_local DpiArena *current = NULL;
+    return current;
+}
+
+struct DpiArenaScope {
+    DpiArena *saved;
+    explicit DpiArenaScope(DpiArena *a) : saved(dpi_arena_current()) { dpi_arena_current() = a; }
+    ~DpiArenaScope() { dpi_arena_current() = saved; }
+};
+
+inline DpiArena *dpi_arena_create(size_t bytes, const char *tag) {
+    const size_t region = DPI_ARENA_HEADER + dpi_arena_round(bytes);
+    char *p = (char *)dpi_alloc_large(region, tag);
+    DpiArena *a = (DpiArena *)p;
+    a->base = p + DPI_ARENA_HEADER;
+    a->capacity = region - DPI_ARENA_HEADER;
+    a->used = 0;
+    a->peak = 0;
+    a->region = region;
+    a->spilled = 0;
+    a->holes = NULL;
+    a->tag = tag;
+    return a;
+}
+
+inline void dpi_arena_destroy(DpiArena *a) {
+    if (a == NULL) return;
+    if (dpi_alloc_state().report) {
+        fprintf(stderr, "[DPI-C ALLOC] arena %s: %zu bytes declared, %zu peak, %zu spilled\n",
+                a->tag, a->capacity, a->peak, a->spilled);
+    }
+    dpi_free_large(a, a->region);
+}
+
+/** First-fit from the holes, else bump; a block that does not fit goes to dpi_alloc_large(). */
+inline void *dpi_arena_alloc(DpiArena *a, size_t bytes) {
+    const size_t n = dpi_arena_round(bytes);
+    for (DpiArenaHole **h = &a->holes; n && *h; h = &(*h)->next) {
+        DpiArenaHole *b = *h;
+        if (b->bytes < n) continue;
+        if (b->bytes > n) {
+            DpiArenaHole *rest = (DpiArenaHole *)((char *)b + n);
+            rest->bytes = b->bytes - n;
+            rest->next = b->next;
+            *h = rest;
+        } else {
+            *h = b->next;
+        }
+        return b;
+    }
+    if (n <= a->capacity - a->used) {
+        void *p = a->base + a->used;
+        a->used += n;
+        a->peak = std::max(a->peak, a->used);
+        return p;
+    }
+    if (a->spilled == 0) {
+        fprintf(stderr, "[DPI-C ERROR] %s: arena of %zu bytes exhausted, allocating outside it "
+                "(declared needs too small)\n", a->tag, a->capacity);
+    }
+    a->spilled += bytes;
+    return dpi_alloc_large(bytes, a->tag);
+}
+
+/** Lower the top past a hole that ends at it (the last hole, if any). */
+inline void dpi_arena_trim(DpiArena *a) {
+    DpiArenaHole **h = &a->holes;
+    if (*h == NULL) return;
+    while ((*h)->next) h = &(*h)->next;
+    if ((char *)*h + (*h)->bytes == a->base + a->used) {
+        a->used = (size_t)((char *)*h - a->base);
+        *h = NULL;
+    }
+}
+
+/** The top block lowers the top; others become holes, merged with their neighbours. */
+inline void dpi_arena_free(DpiArena *a, void *p, size_t bytes) {
+    char *c = (char *)p;
+    if (c < a->base || c >= a->base + a->capacity) {
+        dpi_free_large(p, bytes);
+        return;
+    }
+    const size_t n = dpi_arena_round(bytes);
+    if (n == 0) return;
+    if (c + n == a->base + a->used) {
+        a->used = (size_t)(c - a->base);
+        dpi_arena_trim(a);
+        return;
+    }
+    DpiArenaHole **h = &a->holes;
+    DpiArenaHole *prev = NULL;
+    while (*h && (char *)*h < c) {
+        prev = *h;
+        h = &(*h)->next;
+    }
+    DpiArenaHole *b = (DpiArenaHole *)c;
+    b->bytes = n;
+    b->next = *h;
+    if (b->next && c + n == (char *)b->next) {
+        b->bytes += b->next->bytes;
+        b->next = b->next->next;
+    }
+    if (prev && (char *)prev + prev->bytes == c) {
+        prev->bytes += b->bytes;
+        prev->next = b->next;
+    } else {
+        *h = b;
+    }
+}
+
+/**
+ * Release everything above a mark in O(1) (plus the holes above it).
+ *
+ * Typical use is a reset path: take the mark after the fixed buffers at
+ * create; on reset, release the containers allocated since (they must not
+ * keep blocks above the mark), rewind, and allocate them again.
+ */
+inline size_t dpi_arena_mark(const DpiArena *a) {
+    return a->used;
+}
+
+inline void dpi_arena_rewind(DpiArena *a, size_t mark) {
+    if (mark > a->used) return;
+    a->used = mark;
+    char *top = a->base + mark;
+    for (DpiArenaHole **h = &a->holes; *h; h = &(*h)->next) {
+        if ((char *)*h >= top) {
+            *h = NULL;
+            break;
+        }
+        if ((char *)*h + (*h)->bytes > top) (*h)->bytes = (size_t)(top - (char *)*h);
+    }
+    dpi_arena_trim(a);
+}
+
+/** Arena holding an engine created by dpi_arena_new(). */
+inline DpiArena *dpi_arena_of(const void *engine) {
+    return (DpiArena *)((char *)engine - DPI_ARENA_HEADER);
+}
+
+/**
+ * Create an engine as the first block of a new arena.
+ *
+ * Its dpi_vector members draw from the arena: size it with the engine's
+ * declared needs, dpi_arena_need<T>() + dpi_arena_need<Elem>(n) + ...
+ */
+template <class T>
+inline T *dpi_arena_new(size_t bytes, const char *tag) {
+    DpiArena *a = dpi_arena_create(bytes, tag);
+    DpiArenaScope scope(a);
+    return new (dpi_arena_alloc(a, sizeof(T))) T();
+}
+
+template <class T>
+inline void dpi_arena_delete(T *engine) {
+    if (engine == NULL) return;
+    DpiArena *a = dpi_arena_of(engine);
+    engine->~T();
+    dpi_arena_destroy(a);
+}
+
+/**
+ * Checkpoint: write the used part of an engine's arena as one blob.
+ *
+ * The blob holds pointers into the arena itself, so it can only be
+ * restored into the same engine (rewind within a run, or in a fork()ed
+ * child). Buffers outside the arena (spilled or deliberately external,
+ * such as growing captures) are not part of it.
+ *
+ * Returns:
+ *   0 on success, -1 if the arena spilled or the write failed
+ */
+inline int dpi_arena_save(const void *engine, FILE *f) {
+    const DpiArena *a = dpi_arena_of(engine);
+    if (a->spilled) return -1;
+    const uint64_t header[3] = {(uint64_t)a->capacity, (uint64_t)a->used,
+                                a->holes ? (uint64_t)((char *)a->holes - a->base) : UINT64_MAX};
+    if (fwrite(header, sizeof(header), 1, f) != 1) return -1;
+    return (fwrite(a->base, 1, a->used, f) == a->used) ? 0 : -1;
+}
+
+/**
+ * Restore a dpi_arena_save() blob into the same engine.
+ *
+ * The arena returns to its state at the save: blocks allocated since are
+ * dropped with the engine state that referred to them.
+ */
+inline int dpi_arena_restore(void *engine, FILE *f) {
+    DpiArena *a = dpi_arena_of(engine);
+    uint64_t header[3];
+    if (a->spilled || fread(header, sizeof(header), 1, f) != 1 ||
+        header[0] != a->capacity || header[1] > a->capacity ||
+        (header[2] != UINT64_MAX && header[2] >= header[1])) {
+        return -1;
+    }
+    if (fread(a->base, 1, (size_t)header[1], f) != header[1]) return -1;
+    a->used = (size_t)header[1];
+    a->peak = std::max(a->peak, a->used);
+    a->holes = (header[2] == UINT64_MAX) ? NULL : (DpiArenaHole *)(a->base + header[2]);
+    return 0;
+}
+
+/** dpi_<engine>_save: checkpoint an engine to a file (fn names it in errors). */
+inline int dpi_arena_save_file(const void *engine, const char *path, const char *fn) {
+    FILE *f = fopen(path, "wb");
+    if (f == NULL) {
+        fprintf(stderr, "[DPI-C ERROR] %s: cannot open %s\n", fn, path);
+        return -1;
+    }
+    int rc = dpi_arena_save(engine, f);
+    if (fclose(f) != 0) rc = -1;
+    if (rc != 0) {
+        fprintf(stderr, "[DPI-C ERROR] %s: checkpoint not written to %s%s\n", fn, path,
+                dpi_arena_of(engine)->spilled ? " (buffers outside the arena)" : "");
+    }
+    return rc;
+}
+
+/** dpi_<engine>_restore: restore a checkpoint written by the same engine instance. */
+inline int dpi_arena_restore_file(void *engine, const char *path, const char *fn) {
+    FILE *f = fopen(path, "rb");
+    if (f == NULL) {
+        fprintf(stderr, "[DPI-C ERROR] %s: cannot open %s\n", fn, path);
+        return -1;
+    }
+    const int rc = dpi_arena_restore(engine, f);
+    fclose(f);
+    if (rc != 0) {
+        fprintf(stderr, "[DPI-C ERROR] %s: %s is not a checkpoint of this engine\n", fn, path);
+    }
+    return rc;
+}
+
+//==============================================================================
+// STL ALLOCATOR
+//==============================================================================
+template <class T>
+struct DpiAllocator {
+    typedef T value_type;
+    const char *tag;
+    DpiArena *arena;                    // NULL: dpi_alloc_large()
+
+    // Constructed inside dpi_arena_new(): the engine's arena
+    DpiAllocator(const char *name = "dpi") noexcept : tag(name), arena(dpi_arena_current()) {}
+    DpiAllocator(const char *name, DpiArena *a) noexcept : tag(name), arena(a) {}
+    template <class U>
+    DpiAllocator(const DpiAllocator<U> &other) noexcept : tag(other.tag), arena(other.arena) {}
+
+    T *allocate(size_t n) {
+        return static_cast<T *>(arena ? dpi_arena_alloc(arena, n * sizeof(T))
+                                      : dpi_alloc_large(n * sizeof(T), tag));
+    }
+    void deallocate(T *p, size_t n) noexcept {
+        if (arena) dpi_arena_free(arena, p, n * sizeof(T));
+        else dpi_free_large(p, n * sizeof(T));
+    }
+};
+
+// Instances drawing from the same place can free each other's blocks
+template <class T, class U>
+inline bool operator==(const DpiAllocator<T> &a, const DpiAllocator<U> &b) { return a.arena == b.arena; }
+template <class T, class U>
+inline bool operator!=(const DpiAllocator<T> &a, const DpiAllocator<U> &b) { return a.arena != b.arena; }
+
+template <class T>
+using dpi_vector = std::vector<T, DpiAllocator<T>>;
+
+/** Give a vector's block back to its arena (clear() keeps it), e.g. before a rewind. */
+template <class T>
+inline void dpi_vector_release(dpi_vector<T> &v) {
+    dpi_vector<T>(v.get_allocator()).swap(v);
+}
+
+#endif // DPI_ALLOC_H
@@ -0,0 +1,685 @@
+/**
+ * dpi_ctle_adapt.cpp - DPI-C CTLE Peaking Auto-Selection Engine
+ *
+ * One-pass CTLE calibration for simulated link bring-up (spec/
+ * serdes_architecture.md §8.3, spec/ctle_specification.md §6.3). Instead of
+ * one full simulation per peaking setting, a short block of the CTLE input
+ * waveform is captured once and every candidate peaking code is evaluated
+ * on it in C++, in parallel threads; the best code is then programmed into
+ * the RTL.
+ *
+ * Flow:
+ * 1. Register candidate codes (fz, fp1, fp2, DC gain). Each is converted
+ *    to ONE biquad (bilinear transform of the full H(s) of spec §3.1,
+ *    prewarped at the peaking frequency)
+ * 2. dpi_ctle_adapt_load() appends waveform samples (CTLE input, a whole
+ *    number of samples per UI); dpi_ctle_adapt_load_bits() optionally
+ *    appends the transmitted bits of the same UIs
+ * 3. dpi_ctle_adapt_run() filters the capture with every code and scores
+ *    it at its best sampling point:
+ *    - METRIC_EYE: vertical eye opening / eye amplitude (dimensionless,
+ *      independent of DC gain; 1 = no ISI, < 0 = closed eye)
+ *    - METRIC_ISI: -(ISI energy / cursor energy) of the pulse response
+ *      estimated by correlating the output with the data
+ * 4. Query the best code, per-code score / phase / peaking, biquad
+ *    coefficients, or write a CSV report
+ *
+ * Features:
+ * - Codes scored concurrently (std::thread, one filter buffer per worker)
+ * - Deterministic: results do not depend on the thread count
+ * - Data-aided (known bits, latency found by search) or decision-directed
+ * - Sample precision: float64, or float32 capture and filtering (half the
+ *   capture memory and filter-buffer traffic); float32 runs are guarded by
+ *   re-scoring the leading codes in float64
+ *
+ * Author: Generated for SerDes CTLE adaptation
+ * Date: 2025
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include "dpi_alloc.h"
+
+//==============================================================================
+// CONFIGURATION
+//==============================================================================
+#define CTLE_MAX_CODES      256
+#define CTLE_MAX_THREADS    64
+#define CTLE_WARMUP_UI      32          // UIs skipped for the filter transient
+#define CTLE_ISI_PRE        2           // Precursor taps in the ISI estimate
+#define CTLE_ISI_POST       16          // Postcursor taps in the ISI estimate
+#define CTLE_PEAK_POINTS    400         // Log-spaced points for peaking search
+#define CTLE_MAX_LAG_UI     8           // Latency search with known bits (UIs)
+
+#define METRIC_EYE          0
+#define METRIC_ISI          1
+
+#define CTLE_PREC_F64       0
+#define CTLE_PREC_F32       1
+#define CTLE_GUARD_CODES    2           // Leading codes re-scored in float64
+#define CTLE_GUARD_TOL      1.0e-3      // Max float32 vs float64 score difference
+
+//==============================================================================
+// ENGINE STATE
+//==============================================================================
+struct CtleCode {
+    double fz, fp1, fp2, gain;
+    double b[3];                // Biquad numerator
+    double a[2];                // Biquad denominator (1 + a1·z⁻¹ + a2·z⁻²)
+    double peaking_db;
+    double score;
+    int phase;                  // Best sampling point (samples after UI start)
+};
+
+struct CtleAdapt {
+    double fs;
+    double ui;
+    int spu;                    // Samples per UI
+    int threads;
+    dpi_vector<CtleCode> codes{DpiAllocator<CtleCode>("ctle_adapt.codes")};
+    // The capture and the known bits grow with every load: outside the
+    // engine arena. One of the two captures is used, per the sample precision
+    int precision;
+    dpi_vector<double> capture{DpiAllocator<double>("ctle_adapt.capture", NULL)};
+    dpi_vector<float> capture_f32{DpiAllocator<float>("ctle_adapt.capture_f32", NULL)};
+    double guard_error;         // Max |float32 - float64| score of the last run
+    dpi_vector<signed char> bits{DpiAllocator<signed char>("ctle_adapt.bits", NULL)}; // ±1 per UI
+    int best;
+    int metric;
+
+    // dpi_ctle_adapt_apply() state
+    int apply_code;
+    double s1, s2;
+};
+
+//==============================================================================
+// BIQUAD DESIGN
+//==============================================================================
+/**
+ * H(s) = G·(1 + s/ωz) / ((1 + s/ωp1)(1 + s/ωp2)), bilinear transform with
+ * s = K·(z - 1)/(z + 1), K = ω0 / tan(ω0 / 2fs) (prewarped at ω0).
+ */
+static void ctle_design(CtleCode *c, double fs) {
+    const double wz = 2.0 * M_PI * c->fz;
+    const double wp1 = 2.0 * M_PI * c->fp1;
+    const double wp2 = 2.0 * M_PI * c->fp2;
+    double w0 = 2.0 * M_PI * std::sqrt(c->fz * c->fp1);
+    if (w0 >= 0.9 * M_PI * fs) w0 = 0.9 * M_PI * fs;
+    const double K = w0 / std::tan(w0 / (2.0 * fs));
+
+    // N(s) = n0 + n1·s, D(s) = d0 + d1·s + d2·s²
+    const double n0 = c->gain, n1 = c->gain / wz;
+    const double d0 = 1.0, d1 = 1.0 / wp1 + 1.0 / wp2, d2 = 1.0 / (wp1 * wp2);
+
+    // Multiply through by (z + 1)²: coefficients of z², z¹, z⁰
+    const double N2 = n0 + n1 * K, N1 = 2.0 * n0, N0 = n0 - n1 * K;
+    const double D2 = d0 + d1 * K + d2 * K * K;
+    const double D1 = 2.0 * d0 - 2.0 * d2 * K * K;
+    const double D0 = d0 - d1 * K + d2 * K * K;
+    c->b[0] = N2 / D2;
+    c->b[1] = N1 / D2;
+    c->b[2] = N0 / D2;
+    c->a[0] = D1 / D2;
+    c->a[1] = D0 / D2;
+}
+
+/** Analog peaking: max |H(jω)| / G over 1 MHz .. fs/2, in dB. */
+static double ctle_peaking(const CtleCode *c, double fs) {
+    double peak = 1.0;
+    const double f_lo = 1.0e6, f_hi = fs / 2.0;
+    for (int i = 0; i < CTLE_PEAK_POINTS; i++) {
+        const double f = f_lo * std::pow(f_hi / f_lo, (double)i / (CTLE_PEAK_POINTS - 1));
+        const double m = std::sqrt(1.0 + (f / c->fz) * (f / c->fz)) /
+                         (std::sqrt(1.0 + (f / c->fp1) * (f / c->fp1)) *
+                          std::sqrt(1.0 + (f / c->fp2) * (f / c->fp2)));
+        if (m > peak) peak = m;
+    }
+    return 20.0 * std::log10(peak);
+}
+
+/** Direct form II transposed, fresh state, arithmetic in the sample type. */
+template <class T>
+static void ctle_filter(const CtleCode *c, const T *x, T *y, size_t n) {
+    const T b0 = (T)c->b[0], b1 = (T)c->b[1], b2 = (T)c->b[2];
+    const T a1 = (T)c->a[0], a2 = (T)c->a[1];
+    T s1 = 0, s2 = 0;
+    for (size_t i = 0; i < n; i++) {
+        const T v = b0 * x[i] + s1;
+        s1 = b1 * x[i] - a1 * v + s2;
+        s2 = b2 * x[i] - a2 * v;
+        y[i] = v;
+    }
+}
+
+static size_t ctle_capture_size(const CtleAdapt *e) {
+    return (e->precision == CTLE_PREC_F32) ? e->capture_f32.size() : e->capture.size();
+}
+
+//==============================================================================
+// EYE METRICS
+//==============================================================================
+/**
+ * Symbols of the capture as seen at sample offset lag: y[k·spu + lag] is
+ * compared against d[k] (known bits, or the sign of the sample itself).
+ */
+template <class T>
+struct EyeView {
+    const T *y;
+    const signed char *bits;    // ±1 per UI, NULL = decision-directed
+    int spu;
+    int n_ui;
+};
+
+template <class T>
+static inline double view_sample(const EyeView<T> &v, int k, int lag) {
+    return v.y[(size_t)k * v.spu + lag];
+}
+
+template <class T>
+static inline double view_decision(const EyeView<T> &v, int k, int lag) {
+    if (v.bits) return v.bits[k];
+    return (view_sample(v, k, lag) >= 0.0) ? 1.0 : -1.0;
+}
+
+/** Last UI whose sample at lag is inside the capture. */
+template <class T>
+static inline int view_end(const EyeView<T> &v, int lag) {
+    return (int)(((size_t)v.n_ui * v.spu - lag - 1) / v.spu) + 1;
+}
+
+/** (min of '1' samples - max of '0' samples) / (mean '1' - mean '0'). */
+template <class T>
+static double metric_eye(const EyeView<T> &v, int lag) {
+    double min1 = HUGE_VAL, max0 = -HUGE_VAL, sum1 = 0.0, sum0 = 0.0;
+    int n1 = 0, n0 = 0;
+    const int k1 = view_end(v, lag);
+    for (int k = CTLE_WARMUP_UI; k < k1; k++) {
+        const double s = view_sample(v, k, lag);
+        if (view_decision(v, k, lag) > 0.0) {
+            if (s < min1) min1 = s;
+            sum1 += s;
+            n1++;
+        } else {
+            if (s > max0) max0 = s;
+            sum0 += s;
+            n0++;
+        }
+    }
+    if (n1 == 0 || n0 == 0) return -HUGE_VAL;
+    const double amp = sum1 / n1 - sum0 / n0;
+    return (amp > 0.0) ? (min1 - max0) / amp : -HUGE_VAL;
+}
+
+/** -(Σ h_j², j ≠ 0) / h_0², h_j = <y[k] · d[k - j]>. */
+template <class T>
+static double metric_isi(const EyeView<T> &v, int lag) {
+    const int taps = CTLE_ISI_PRE + 1 + CTLE_ISI_POST;
+    double h[CTLE_ISI_PRE + 1 + CTLE_ISI_POST] = {0.0};
+    const int k0 = CTLE_WARMUP_UI + CTLE_ISI_POST;
+    const int k1 = view_end(v, lag) - CTLE_ISI_PRE;
+    if (k1 <= k0) return -HUGE_VAL;
+    for (int k = k0; k < k1; k++) {
+        const double s = view_sample(v, k, lag);
+        for (int j = -CTLE_ISI_PRE; j <= CTLE_ISI_POST; j++)
+            h[j + CTLE_ISI_PRE] += s * view_decision(v, k - j, lag);
+    }
+    const double cursor = h[CTLE_ISI_PRE];
+    if (cursor <= 0.0) return -HUGE_VAL;
+    double isi = 0.0;
+    for (int j = 0; j < taps; j++) {
+        if (j != CTLE_ISI_PRE) isi += h[j] * h[j];
+    }
+    return -isi / (cursor * cursor);
+}
+
+/**
+ * Filter the capture with one code and keep its best sampling point. With
+ * known bits the search covers CTLE_MAX_LAG_UI UIs of latency (channel +
+ * CTLE delay); decision-directed it covers one UI of phase.
+ */
+template <class T>
+static void ctle_score(const CtleAdapt *e, CtleCode *c, const T *x, size_t n,
+                       dpi_vector<T> &y) {
+    const int n_ui = (int)(n / e->spu);
+    const bool aided = (int)e->bits.size() >= n_ui;
+    y.resize(n);
+    ctle_filter(c, x, y.data(), n);
+    const EyeView<T> v = {y.data(), aided ? e->bits.data() : NULL, e->spu, n_ui};
+    const int lags = aided ? CTLE_MAX_LAG_UI * e->spu : e->spu;
+    c->score = -HUGE_VAL;
+    c->phase = 0;
+    for (int lag = 0; lag < lags; lag++) {
+        const double s = (e->metric == METRIC_EYE) ? metric_eye(v, lag) : metric_isi(v, lag);
+        if (s > c->score) {
+            c->score = s;
+            c->phase = lag;
+        }
+    }
+}
+
+/** Score every code, workers pulling code indices (one writer per code). */
+template <class T>
+static void ctle_score_all(CtleAdapt *e, const T *x, size_t n, const char *tag) {
+    const int n_codes = (int)e->codes.size();
+    std::atomic<int> next(0);
+    auto worker = [e, x, n, tag, n_codes, &next]() {
+        // Allocated by the worker: huge pages on the worker's NUMA node
+        dpi_vector<T> y{DpiAllocator<T>(tag)};
+        for (int c = next++; c < n_codes; c = next++) ctle_score(e, &e->codes[c], x, n, y);
+    };
+    const int n_threads = (e->threads < n_codes) ? e->threads : n_codes;
+    std::vector<std::thread> pool;
+    for (int t = 1; t < n_threads; t++) pool.emplace_back(worker);
+    worker();
+    for (std::thread &t : pool) t.join();
+}
+
+/**
+ * Accuracy guard of a float32 run: re-score the CTLE_GUARD_CODES leading
+ * codes in float64 (same stored samples) and keep the float64 results.
+ * Reports when the scores moved by more than CTLE_GUARD_TOL or the leader
+ * changed.
+ */
+static void ctle_guard_f32(CtleAdapt *e) {
+    const int n_codes = (int)e->codes.size();
+    std::vector<int> order(n_codes);
+    for (int c = 0; c < n_codes; c++) order[c] = c;
+    const int n_guard = (n_codes < CTLE_GUARD_CODES) ? n_codes : CTLE_GUARD_CODES;
+    std::partial_sort(order.begin(), order.begin() + n_guard, order.end(), [e](int a, int b) {
+        const double sa = e->codes[a].score, sb = e->codes[b].score;
+        return (sa != sb) ? sa > sb : a < b;
+    });
+
+    const dpi_vector<double> x(e->capture_f32.begin(), e->capture_f32.end(),
+                               DpiAllocator<double>("ctle_adapt.guard"));
+    dpi_vector<double> y{DpiAllocator<double>("ctle_adapt.guard")};
+    e->guard_error = 0.0;
+    for (int i = 0; i < n_guard; i++) {
+        CtleCode &c = e->codes[order[i]];
+        const double f32 = c.score;
+        ctle_score(e, &c, x.data(), x.size(), y);
+        const double d = (c.score == f32) ? 0.0 : std::fabs(c.score - f32);
+        if (d > e->guard_error) e->guard_error = d;
+    }
+    const bool leader_kept = n_guard < 2 ||
+                             e->codes[order[0]].score >= e->codes[order[1]].score;
+    if (e->guard_error > CTLE_GUARD_TOL || !leader_kept) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_ctle_adapt_run: float32 scores differ from float64 "
+                "by %.3g (tolerance %.3g)%s; use float64 precision\n", e->guard_error,
+                CTLE_GUARD_TOL, leader_kept ? "" : ", leading code changed");
+    }
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// DPI-C EXPORTED FUNCTIONS
+//==============================================================================
+
+/**
+ * DPI-C Function: dpi_ctle_adapt_create
+ *
+ * Args:
+ *   fs_hz:   Sample rate of the captured waveform (Hz)
+ *   ui_s:    Unit interval (s); fs_hz × ui_s must be an integer >= 1
+ *   threads: Worker threads for dpi_ctle_adapt_run() (0 = all cores)
+ *
+ * Returns:
+ *   Engine handle, or NULL on invalid arguments
+ */
+void *dpi_ctle_adapt_create(double fs_hz, double ui_s, int threads) {
+    const double spu = fs_hz * ui_s;
+    if (fs_hz <= 0.0 || ui_s <= 0.0 || spu < 0.999 || std::fabs(spu - std::round(spu)) > 1e-6) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_ctle_adapt_create: fs × UI must be a positive integer "
+                "(got %g)\n", spu);
+        return NULL;
+    }
+    // Declared needs: engine + a full code table
+    CtleAdapt *e = dpi_arena_new<CtleAdapt>(
+        dpi_arena_need<CtleAdapt>() + dpi_arena_need<CtleCode>(CTLE_MAX_CODES), "ctle_adapt");
+    e->codes.reserve(CTLE_MAX_CODES);
+    e->fs = fs_hz;
+    e->ui = ui_s;
+    e->spu = (int)std::round(spu);
+    if (threads <= 0) threads = (int)std::thread::hardware_concurrency();
+    e->threads = (threads < 1) ? 1 : (threads > CTLE_MAX_THREADS ? CTLE_MAX_THREADS : threads);
+    e->best = -1;
+    e->metric = METRIC_EYE;
+    e->apply_code = -1;
+    e->precision = CTLE_PREC_F64;
+    e->guard_error = 0.0;
+    return e;
+}
+
+/**
+ * DPI-C Function: dpi_ctle_adapt_add_code
+ *
+ * Register a candidate peaking code (spec §3.1 parameters).
+ *
+ * Returns:
+ *   Code index (0, 1, ...), or -1 on invalid parameters / table full
+ */
+int dpi_ctle_adapt_add_code(void *handle, double fz_hz, double fp1_hz, double fp2_hz,
+                            double dc_gain) {
+    CtleAdapt *e = (CtleAdapt *)handle;
+    if ((int)e->codes.size() >= CTLE_MAX_CODES) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_ctle_adapt_add_code: more than %d codes\n",
+                CTLE_MAX_CODES);
+        return -1;
+    }
+    if (fz_hz <= 0.0 || fp1_hz <= 0.0 || fp2_hz <= 0.0 || dc_gain <= 0.0 ||
+        fp1_hz >= e->fs / 2.0 || fp2_hz >= e->fs / 2.0) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_ctle_adapt_add_code: frequencies must be in "
+                "(0, fs/2), gain > 0\n");
+        return -1;
+    }
+    CtleCode c = {};
+    c.fz = fz_hz;
+    c.fp1 = fp1_hz;
+    c.fp2 = fp2_hz;
+    c.gain = dc_gain;
+    ctle_design(&c, e->fs);
+    c.peaking_db = ctle_peaking(&c, e->fs);
+    c.score = -HUGE_VAL;
+    e->codes.push_back(c);
+    return (int)e->codes.size() - 1;
+}
+
+/** DPI-C Function: dpi_ctle_adapt_num_codes */
+int dpi_ctle_adapt_num_codes(void *handle) {
+    return (int)((CtleAdapt *)handle)->codes.size();
+}
+
+/** DPI-C Function: dpi_ctle_adapt_peaking - analog peaking of a code (dB). */
+double dpi_ctle_adapt_peaking(void *handle, int code) {
+    CtleAdapt *e = (CtleAdapt *)handle;
+    if (code < 0 || code >= (int)e->codes.size()) return 0.0;
+    return e->codes[code].peaking_db;
+}
+
+/**
+ * DPI-C Function: dpi_ctle_adapt_biquad
+ *
+ * Args:
+ *   coef: Output {b0, b1, b2, a1, a2} for
+ *         y[n] = b0·x[n] + b1·x[n-1] + b2·x[n-2] - a1·y[n-1] - a2·y[n-2]
+ *
+ * Returns:
+ *   0 on success, -1 on invalid code
+ */
+int dpi_ctle_adapt_biquad(void *handle, int code, double *coef) {
+    CtleAdapt *e = (CtleAdapt *)handle;
+    if (code < 0 || code >= (int)e->codes.size()) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_ctle_adapt_biquad: invalid code %d\n", code);
+        return -1;
+    }
+    const CtleCode &c = e->codes[code];
+    coef[0] = c.b[0];
+    coef[1] = c.b[1];
+    coef[2] = c.b[2];
+    coef[3] = c.a[0];
+    coef[4] = c.a[1];
+    return 0;
+}
+
+/**
+ * DPI-C Function: dpi_ctle_adapt_set_precision
+ *
+ * Select the sample precision of the capture and of the filtering in
+ * dpi_ctle_adapt_run(). SV always passes real (float64): samples are
+ * converted once, when loaded. A capture already loaded is converted.
+ *
+ * Args:
+ *   precision: 0 = float64 (default), 1 = float32
+ *
+ * Returns:
+ *   0 on success, -1 on an unknown precision
+ */
+int dpi_ctle_adapt_set_precision(void *handle, int precision) {
+    CtleAdapt *e = (CtleAdapt *)handle;
+    if (precision != CTLE_PREC_F64 && precision != CTLE_PREC_F32) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_ctle_adapt_set_precision: unknown precision %d\n",
+                precision);
+        return -1;
+    }
+    if (precision == e->precision) return 0;
+    if (precision == CTLE_PREC_F32) {
+        e->capture_f32.assign(e->capture.begin(), e->capture.end());
+        e->capture.clear();
+        e->capture.shrink_to_fit();
+    } else {
+        e->capture.assign(e->capture_f32.begin(), e->capture_f32.end());
+        e->capture_f32.clear();
+        e->capture_f32.shrink_to_fit();
+    }
+    e->precision = precision;
+    return 0;
+}
+
+/** DPI-C Function: dpi_ctle_adapt_load - append n samples to the capture. */
+void dpi_ctle_adapt_load(void *handle, const double *x, int n) {
+    CtleAdapt *e = (CtleAdapt *)handle;
+    if (e->precision == CTLE_PREC_F32) e->capture_f32.insert(e->capture_f32.end(), x, x + n);
+    else e->capture.insert(e->capture.end(), x, x + n);
+}
+
+/**
+ * DPI-C Function: dpi_ctle_adapt_load_bits
+ *
+ * Append the transmitted bits (0/1) of n UIs. When the bits cover every
+ * captured UI, scoring is data-aided; otherwise decisions are by sign.
+ */
+void dpi_ctle_adapt_load_bits(void *handle, const int *bits, int n) {
+    CtleAdapt *e = (CtleAdapt *)handle;
+    for (int i = 0; i < n; i++) e->bits.push_back(bits[i] ? 1 : -1);
+}
+
+/** DPI-C Function: dpi_ctle_adapt_clear - drop the capture, bits and scores. */
+void dpi_ctle_adapt_clear(void *handle) {
+    CtleAdapt *e = (CtleAdapt *)handle;
+    e->capture.clear();
+    e->capture_f32.clear();
+    e->bits.clear();
+    for (CtleCode &c : e->codes) c.score = -HUGE_VAL;
+    e->best = -1;
+}
+
+/**
+ * DPI-C Function: dpi_ctle_adapt_run
+ *
+ * Score every code on the capture and select the best.
+ *
+ * Args:
+ *   metric: 0 = vertical eye opening, 1 = ISI energy
+ *
+ * Returns:
+ *   Best code index, or -1 if there are no codes or the capture is too short
+ */
+int dpi_ctle_adapt_run(void *handle, int metric) {
+    CtleAdapt *e = (CtleAdapt *)handle;
+    const int n_codes = (int)e->codes.size();
+    const int n_ui = (int)(ctle_capture_size(e) / e->spu);
+    if (n_codes == 0 || n_ui < 2 * CTLE_WARMUP_UI + CTLE_ISI_POST) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_ctle_adapt_run: need codes and >= %d UIs of capture "
+                "(have %d codes, %d UIs)\n", 2 * CTLE_WARMUP_UI + CTLE_ISI_POST, n_codes, n_ui);
+        return -1;
+    }
+    e->metric = (metric == METRIC_ISI) ? METRIC_ISI : METRIC_EYE;
+
+    e->guard_error = 0.0;
+    if (e->precision == CTLE_PREC_F32) {
+        ctle_score_all(e, e->capture_f32.data(), e->capture_f32.size(), "ctle_adapt.filtered_f32");
+        ctle_guard_f32(e);
+    } else {
+        ctle_score_all(e, e->capture.data(), e->capture.size(), "ctle_adapt.filtered");
+    }
+
+    // Ties resolve to the lowest code (least peaking for an ordered table)
+    e->best = 0;
+    for (int c = 1; c < n_codes; c++) {
+        if (e->codes[c].score > e->codes[e->best].score) e->best = c;
+    }
+    return e->best;
+}
+
+/**
+ * DPI-C Function: dpi_ctle_adapt_guard_error - largest |float32 - float64|
+ * score difference of the last float32 run (0 for float64 runs).
+ */
+double dpi_ctle_adapt_guard_error(void *handle) {
+    return ((CtleAdapt *)handle)->guard_error;
+}
+
+/** DPI-C Function: dpi_ctle_adapt_best - code chosen by the last run (-1 if none). */
+int dpi_ctle_adapt_best(void *handle) {
+    return ((CtleAdapt *)handle)->best;
+}
+
+/** DPI-C Function: dpi_ctle_adapt_score - score of a code from the last run. */
+double dpi_ctle_adapt_score(void *handle, int code) {
+    CtleAdapt *e = (CtleAdapt *)handle;
+    if (code < 0 || code >= (int)e->codes.size()) return -HUGE_VAL;
+    return e->codes[code].score;
+}
+
+/**
+ * DPI-C Function: dpi_ctle_adapt_phase - best sampling point of a code, in
+ * samples after the UI start (data-aided: includes the latency in UIs × spu).
+ */
+int dpi_ctle_adapt_phase(void *handle, int code) {
+    CtleAdapt *e = (CtleAdapt *)handle;
+    if (code < 0 || code >= (int)e->codes.size()) return -1;
+    return e->codes[code].phase;
+}
+
+/**
+ * DPI-C Function: dpi_ctle_adapt_apply
+ *
+ * Filter a block with one code (streaming: state carries across calls with
+ * the same code and resets when the code changes).
+ *
+ * Returns:
+ *   0 on success, -1 on invalid code
+ */
+int dpi_ctle_adapt_apply(void *handle, int code, const double *x, int n, double *y) {
+    CtleAdapt *e = (CtleAdapt *)handle;
+    if (code < 0 || code >= (int)e->codes.size()) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_ctle_adapt_apply: invalid code %d\n", code);
+        return -1;
+    }
+    if (code != e->apply_code) {
+        e->apply_code = code;
+        e->s1 = e->s2 = 0.0;
+    }
+    const CtleCode &c = e->codes[code];
+    for (int i = 0; i < n; i++) {
+        const double v = c.b[0] * x[i] + e->s1;
+        e->s1 = c.b[1] * x[i] - c.a[0] * v + e->s2;
+        e->s2 = c.b[2] * x[i] - c.a[1] * v;
+        y[i] = v;
+    }
+    return 0;
+}
+
+/** DPI-C Function: dpi_ctle_adapt_write_report - per-code CSV of the last run. */
+int dpi_ctle_adapt_write_report(void *handle, const char *path) {
+    CtleAdapt *e = (CtleAdapt *)handle;
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_ctle_adapt_write_report: cannot open %s\n", path);
+        return -1;
+    }
+    fprintf(f, "code,fz_hz,fp1_hz,fp2_hz,dc_gain,peaking_db,%s,phase,best\n",
+            (e->metric == METRIC_ISI) ? "isi_score" : "eye_score");
+    for (size_t c = 0; c < e->codes.size(); c++) {
+        const CtleCode &k = e->codes[c];
+        fprintf(f, "%zu,%.6e,%.6e,%.6e,%.6f,%.4f,%.6f,%d,%d\n", c, k.fz, k.fp1, k.fp2, k.gain,
+                k.peaking_db, k.score, k.phase, (int)c == e->best);
+    }
+    fclose(f);
+    return 0;
+}
+
+/** DPI-C Function: dpi_ctle_adapt_destroy */
+void dpi_ctle_adapt_destroy(void *handle) {
+    dpi_arena_delete((CtleAdapt *)handle);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * =============================================================================
+ * IMPLEMENTATION NOTES
+ * =============================================================================
+ *
+ * 1. One Biquad per Code:
+ *    - H(s) = G·(1 + s/ωz) / (1 + s/ωp1)(1 + s/ωp2) has one zero and two
+ *      poles, so the whole CTLE is a single second-order section instead of
+ *      the two cascaded first-order sections of spec §4
+ *    - Bilinear transform prewarped at √(fz·fp1): the peaking frequency
+ *      maps exactly, DC gain is exact (Σb / (1 + a1 + a2) = G)
+ *    - DF-II transposed: 5 multiplies per sample, 2 state variables
+ *
+ * 2. Eye Metric (METRIC_EYE):
+ *    - Per sampling point: (min of '1' samples - max of '0' samples) /
+ *      (mean '1' - mean '0'); best point per code
+ *    - Normalizing by the eye amplitude removes the DC gain and peaking
+ *      gain from the comparison: only ISI closes the eye
+ *
+ * 3. ISI Metric (METRIC_ISI):
+ *    - h_j = mean(y[k]·d[k-j]) is the pulse response for random data;
+ *      score = -Σ_{j≠0} h_j² / h_0² over
+ *      CTLE_ISI_PRE precursors and CTLE_ISI_POST postcursors
+ *    - Smoother than the eye metric (uses all samples, not the extremes),
+ *      so it needs fewer UIs for a stable choice
+ *    - Residual ISI left for FFE/DFE: pick the ISI metric when a DFE follows
+ *
+ * 4. Threads:
+ *    - Codes are independent: workers pull indices from an atomic counter
+ *      and each owns its output buffer; the capture is read-only during a
+ *      run. Cost: codes × samples × (5 + spu·metric) / threads
+ *    - Results are identical for any thread count
+ *
+ * 5. Data-Aided vs Decision-Directed:
+ *    - With known bits the sampling point is searched over
+ *      CTLE_MAX_LAG_UI UIs, which absorbs channel and CTLE latency; a
+ *      closed eye scores < 0
+ *    - By sign, '1'/'0' are classified from the samples themselves, so
+ *      the eye metric can never go below 0 and both metrics are optimistic
+ *      for closed eyes: use it only to fine-tune an already open eye
+ *
+ * 6. Capture Length:
+ *    - >= 2·CTLE_WARMUP_UI + CTLE_ISI_POST UIs; 1000-4000 UIs of random
+ *      data give a stable choice. The capture should not contain long runs
+ *      (decisions by sign assume a DC-balanced, zero-mean signal)
+ *
+ * 7. Sample Precision:
+ *    - float32 halves the capture and the per-worker filter buffers, which
+ *      the metrics sweep once per sampling point: it pays off for captures
+ *      that do not fit in cache. The biquad is a recursion and runs scalar
+ *      either way. Sums and extremes in the metrics stay double
+ *    - Input rounding is ~6e-8 relative; the error that matters is the
+ *      float recursion of high-peaking (poles near z = 1) codes. The guard
+ *      re-scores the CTLE_GUARD_CODES leaders in float64 and keeps those
+ *      scores, so the choice is the float64 choice among the leaders
+ *    - dpi_ctle_adapt_guard_error() exposes the largest difference; above
+ *      CTLE_GUARD_TOL the run reports [DPI-C ERROR]
+ *
+ * 8. Verilator Compilation:
+ *    - Add to test_config.yaml:
+ *      verilator_extra_flags:
+ *        - ../dpi/dpi_ctle_adapt.cpp
+ *        - -LDFLAGS
+ *        - -pthread
+ *
+ * =============================================================================
+ */
@@ -0,0 +1,399 @@
+/**
+ * dpi_dac.cpp - DPI-C TX DAC Engine (INL/DNL, PAM4 RLM, Output Pole, DCD)
+ *
+ * Back end for the TX DAC (spec/serdes_architecture.md §2.1.4, dac_model.sv).
+ * Maps TX FFE output codes or NRZ/PAM4 symbols to an oversampled output
+ * waveform for downstream channel models. The ideal symbol mapping is the
+ * spec's (× FULL_SCALE):
+ *     NRZ:  0 → -1.0, 1 → +1.0
+ *     PAM4: 0 → -0.75, 1 → -0.25, 2 → +0.25, 3 → +0.75
+ *
+ * Features:
+ * - Code path: signed codes, v = (code + INL[code]) / 2^(BITS-1) × FS,
+ *   per-code INL table (or DNL table, integrated with endpoint correction)
+ * - Static compression of the output driver, set from a PAM4 level-mismatch
+ *   ratio (RLM, IEEE 802.3 definition)
+ * - Finite output bandwidth: single-pole IIR, discretized exactly for a
+ *   piecewise-constant input (also across a fractional-sample edge)
+ * - Duty-cycle distortion: boundaries into odd UIs are late by DCD × UI,
+ *   so even UIs last 1 + DCD and odd UIs 1 - DCD
+ * - Block processing: n symbols in, n × samples_per_ui samples out
+ *
+ * Author: Generated for SerDes TX front-end modeling
+ * Date: 2025
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "dpi_alloc.h"
+
+//==============================================================================
+// CONFIGURATION
+//==============================================================================
+#define DAC_MIN_BITS     2
+#define DAC_MAX_BITS     16
+#define DAC_MAX_SPU      256         // Samples per UI
+
+//==============================================================================
+// ENGINE STATE
+//==============================================================================
+struct DacEngine {
+    int bits;
+    int code_min;
+    int code_max;
+    double full_scale_v;
+    double ui_s;
+    int spu;                         // Output samples per UI
+
+    dpi_vector<double> inl{DpiAllocator<double>("dac.inl")}; // LSB, index code - code_min (empty = ideal)
+    double comp;                     // Compression: y = x·(1 - comp·x²), x normalized
+    double dcd_ui;
+    double f3db_hz;                  // 0 = infinite bandwidth
+
+    // Per-sample pole factors: full sample, and both parts of a split sample
+    double a_full;
+    double a_pre, a_post;            // Odd boundary: before / after the edge
+    double dcd_samples;              // Odd-boundary delay in samples
+
+    // Streaming state
+    double y;                        // Filter output (V)
+    double x_prev;                   // Level of the previous UI (V)
+    uint64_t ui_index;
+    uint64_t clipped;
+};
+
+//==============================================================================
+// TRANSFER HELPERS
+//==============================================================================
+static inline double dac_compress(const DacEngine *d, double x) {
+    return x * (1.0 - d->comp * x * x);
+}
+
+/** Static output level (V) of a signed code, INL and compression included. */
+static inline double dac_code_level(DacEngine *d, int code) {
+    if (code < d->code_min) { code = d->code_min; d->clipped++; }
+    if (code > d->code_max) { code = d->code_max; d->clipped++; }
+    double c = (double)code;
+    if (!d->inl.empty()) c += d->inl[code - d->code_min];
+    return dac_compress(d, c / (double)(1 << (d->bits - 1))) * d->full_scale_v;
+}
+
+/** Static output level (V) of an NRZ (pam = 2) or PAM4 (pam = 4) symbol. */
+static inline double dac_symbol_level(const DacEngine *d, int sym, int pam) {
+    double x;
+    if (pam == 4) x = -0.75 + 0.5 * (double)(sym & 3);
+    else          x = (sym & 1) ? 1.0 : -1.0;
+    return dac_compress(d, x) * d->full_scale_v;
+}
+
+/** Recomputes the pole factors after a bandwidth / DCD / rate change. */
+static void dac_update_pole(DacEngine *d) {
+    const double dt = d->ui_s / d->spu;
+    d->dcd_samples = d->dcd_ui * d->spu;
+    if (d->f3db_hz <= 0.0) {
+        d->a_full = d->a_pre = d->a_post = 0.0;
+        return;
+    }
+    const double tau = 1.0 / (2.0 * M_PI * d->f3db_hz);
+    const double frac = d->dcd_samples - floor(d->dcd_samples);
+    d->a_full = exp(-dt / tau);
+    d->a_pre = exp(-frac * dt / tau);
+    d->a_post = exp(-(1.0 - frac) * dt / tau);
+}
+
+//==============================================================================
+// WAVEFORM GENERATION
+//==============================================================================
+/**
+ * Emits one UI at level x. Output sample i is the filter output at the end
+ * of sample period i, t = (ui + (i + 1) / spu)·UI, integrated exactly:
+ * y ← x + (y - x)·a for a constant input, split in two at an odd-UI edge.
+ */
+static inline void dac_emit_ui(DacEngine *d, double x, double *out) {
+    // The edge sits dcd_samples into odd UIs: periods before it see the
+    // previous level, the one containing it is split
+    const double edge = (d->ui_index & 1) ? d->dcd_samples : 0.0;
+    const int n_old = (int)floor(edge);
+    const int split = edge > (double)n_old;
+    const double xp = d->x_prev;
+    double y = d->y;
+    for (int i = 0; i < d->spu; i++) {
+        if (i < n_old) {
+            y = xp + (y - xp) * d->a_full;
+        } else if (i == n_old && split) {
+            y = xp + (y - xp) * d->a_pre;
+            y = x + (y - x) * d->a_post;
+        } else {
+            y = x + (y - x) * d->a_full;
+        }
+        out[i] = y;
+    }
+    d->y = y;
+    d->x_prev = x;
+    d->ui_index++;
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// DPI-C EXPORTED FUNCTIONS
+//==============================================================================
+/**
+ * DPI-C Function: dpi_dac_create
+ *
+ * Args:
+ *   bits           : Code resolution (2..16), signed codes
+ *   full_scale_v   : Output for normalized level 1.0 (V)
+ *   ui_s           : Unit interval (s)
+ *   samples_per_ui : Output oversampling (1..256)
+ *
+ * Returns:
+ *   chandle: Engine handle, or NULL on invalid arguments
+ */
+void *dpi_dac_create(int bits, double full_scale_v, double ui_s, int samples_per_ui) {
+    if (bits < DAC_MIN_BITS || bits > DAC_MAX_BITS || full_scale_v <= 0.0 || ui_s <= 0.0 ||
+        samples_per_ui < 1 || samples_per_ui > DAC_MAX_SPU) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_dac_create: invalid arguments\n");
+        return NULL;
+    }
+    // Declared needs: engine + a full INL table
+    DacEngine *d = dpi_arena_new<DacEngine>(
+        dpi_arena_need<DacEngine>() + dpi_arena_need<double>((size_t)1 << bits), "dac");
+    d->bits = bits;
+    d->code_min = -(1 << (bits - 1));
+    d->code_max = (1 << (bits - 1)) - 1;
+    d->full_scale_v = full_scale_v;
+    d->ui_s = ui_s;
+    d->spu = samples_per_ui;
+    d->comp = 0.0;
+    d->dcd_ui = 0.0;
+    d->f3db_hz = 0.0;
+    d->y = 0.0;
+    d->x_prev = 0.0;
+    d->ui_index = 0;
+    d->clipped = 0;
+    dac_update_pole(d);
+    return d;
+}
+
+/**
+ * DPI-C Function: dpi_dac_set_inl_table
+ *
+ * INL per code in LSB, n = 2^bits entries, index 0 = most negative code.
+ *
+ * Returns:
+ *   int: 0 on success, -1 on size mismatch
+ */
+int dpi_dac_set_inl_table(void *handle, const double *inl_lsb, int n) {
+    DacEngine *d = (DacEngine *)handle;
+    if (n != d->code_max - d->code_min + 1) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_dac_set_inl_table: expected %d entries, got %d\n",
+                d->code_max - d->code_min + 1, n);
+        return -1;
+    }
+    d->inl.assign(inl_lsb, inl_lsb + n);
+    return 0;
+}
+
+/**
+ * DPI-C Function: dpi_dac_set_dnl_table
+ *
+ * DNL per code step in LSB (entry i = step from code i - 1 to code i;
+ * entry 0 is ignored). INL is the running sum with the end-point line
+ * removed, so INL is 0 at both end codes.
+ *
+ * Returns:
+ *   int: 0 on success, -1 on size mismatch
+ */
+int dpi_dac_set_dnl_table(void *handle, const double *dnl_lsb, int n) {
+    DacEngine *d = (DacEngine *)handle;
+    if (n != d->code_max - d->code_min + 1) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_dac_set_dnl_table: expected %d entries, got %d\n",
+                d->code_max - d->code_min + 1, n);
+        return -1;
+    }
+    std::vector<double> inl(n, 0.0);
+    for (int i = 1; i < n; i++) inl[i] = inl[i - 1] + dnl_lsb[i];
+    const double slope = inl[n - 1] / (n - 1);
+    for (int i = 0; i < n; i++) inl[i] -= slope * i;
+    d->inl.assign(inl.begin(), inl.end());
+    return 0;
+}
+
+/** DPI-C Function: dpi_dac_inl - INL of a code (LSB). */
+double dpi_dac_inl(void *handle, int code) {
+    const DacEngine *d = (const DacEngine *)handle;
+    if (d->inl.empty() || code < d->code_min || code > d->code_max) return 0.0;
+    return d->inl[code - d->code_min];
+}
+
+/** DPI-C Function: dpi_dac_dnl - step from code - 1 to code minus 1 LSB. */
+double dpi_dac_dnl(void *handle, int code) {
+    return dpi_dac_inl(handle, code) - dpi_dac_inl(handle, code - 1);
+}
+
+/**
+ * DPI-C Function: dpi_dac_set_rlm
+ *
+ * Sets the driver compression y = x·(1 - k·x²) so that the ideal PAM4
+ * levels end up with the given level-mismatch ratio (0.5 < rlm <= 1).
+ *
+ * Returns:
+ *   int: 0 on success, -1 if out of range
+ */
+int dpi_dac_set_rlm(void *handle, double rlm) {
+    DacEngine *d = (DacEngine *)handle;
+    if (rlm <= 0.5 || rlm > 1.0) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_dac_set_rlm: rlm %.3f out of range (0.5, 1]\n", rlm);
+        return -1;
+    }
+    // Compression widens the middle eye: 3·ES = 2 - RLM, with
+    // ES = V(0.25) / V(0.75) = (1 - k/16) / (3·(1 - 9k/16))
+    const double r = 2.0 - rlm;
+    d->comp = (r - 1.0) / (0.5625 * r - 0.0625);
+    return 0;
+}
+
+/**
+ * DPI-C Function: dpi_dac_rlm
+ *
+ * PAM4 level-mismatch ratio of the static symbol levels:
+ *   Vmid = (V0 + V3) / 2, ES1 = (V1 - Vmid) / (V0 - Vmid),
+ *   ES2 = (V2 - Vmid) / (V3 - Vmid), RLM = min(3·ES1, 3·ES2, 2 - 3·ES1, 2 - 3·ES2)
+ */
+double dpi_dac_rlm(void *handle) {
+    const DacEngine *d = (const DacEngine *)handle;
+    double v[4];
+    for (int s = 0; s < 4; s++) v[s] = dac_symbol_level(d, s, 4);
+    const double mid = 0.5 * (v[0] + v[3]);
+    const double es1 = (v[1] - mid) / (v[0] - mid);
+    const double es2 = (v[2] - mid) / (v[3] - mid);
+    return fmin(fmin(3.0 * es1, 3.0 * es2), fmin(2.0 - 3.0 * es1, 2.0 - 3.0 * es2));
+}
+
+/** DPI-C Function: dpi_dac_set_bandwidth - output pole -3 dB frequency (Hz, 0 = none). */
+void dpi_dac_set_bandwidth(void *handle, double f3db_hz) {
+    DacEngine *d = (DacEngine *)handle;
+    d->f3db_hz = f3db_hz > 0.0 ? f3db_hz : 0.0;
+    dac_update_pole(d);
+}
+
+/**
+ * DPI-C Function: dpi_dac_set_dcd
+ *
+ * Duty-cycle distortion: the edge into every odd UI is late by dcd_ui.
+ *
+ * Returns:
+ *   int: 0 on success, -1 if dcd_ui is outside [0, 0.5)
+ */
+int dpi_dac_set_dcd(void *handle, double dcd_ui) {
+    DacEngine *d = (DacEngine *)handle;
+    if (dcd_ui < 0.0 || dcd_ui >= 0.5) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_dac_set_dcd: dcd %.3f UI out of range [0, 0.5)\n",
+                dcd_ui);
+        return -1;
+    }
+    d->dcd_ui = dcd_ui;
+    dac_update_pole(d);
+    return 0;
+}
+
+/** DPI-C Function: dpi_dac_level - static level (V) of a symbol (pam = 2 or 4). */
+double dpi_dac_level(void *handle, int symbol, int pam) {
+    return dac_symbol_level((const DacEngine *)handle, symbol, pam);
+}
+
+/** DPI-C Function: dpi_dac_code_level - static level (V) of a code, INL included. */
+double dpi_dac_code_level(void *handle, int code) {
+    return dac_code_level((DacEngine *)handle, code);
+}
+
+/**
+ * DPI-C Function: dpi_dac_codes_block
+ *
+ * Converts n codes (one per UI) to n × samples_per_ui output samples.
+ *
+ * Returns:
+ *   int: Number of samples written
+ */
+int dpi_dac_codes_block(void *handle, const int *codes, int n, double *out) {
+    DacEngine *d = (DacEngine *)handle;
+    for (int k = 0; k < n; k++) dac_emit_ui(d, dac_code_level(d, codes[k]), out + (size_t)k * d->spu);
+    return n * d->spu;
+}
+
+/**
+ * DPI-C Function: dpi_dac_symbols_block
+ *
+ * Converts n NRZ (pam = 2) or PAM4 (pam = 4) symbols to n × samples_per_ui
+ * output samples.
+ *
+ * Returns:
+ *   int: Number of samples written, -1 for an invalid pam
+ */
+int dpi_dac_symbols_block(void *handle, const int *symbols, int n, int pam, double *out) {
+    DacEngine *d = (DacEngine *)handle;
+    if (pam != 2 && pam != 4) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_dac_symbols_block: pam must be 2 or 4\n");
+        return -1;
+    }
+    for (int k = 0; k < n; k++) {
+        dac_emit_ui(d, dac_symbol_level(d, symbols[k], pam), out + (size_t)k * d->spu);
+    }
+    return n * d->spu;
+}
+
+/** DPI-C Function: dpi_dac_clip_count - codes clamped to the code range. */
+long long dpi_dac_clip_count(void *handle) {
+    return (long long)((DacEngine *)handle)->clipped;
+}
+
+/** DPI-C Function: dpi_dac_destroy */
+void dpi_dac_destroy(void *handle) {
+    dpi_arena_delete((DacEngine *)handle);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * =============================================================================
+ * IMPLEMENTATION NOTES
+ * =============================================================================
+ *
+ * 1. Static Transfer:
+ *    - Code path:   x = (code + INL[code]) / 2^(BITS-1)
+ *    - Symbol path: x = spec level (NRZ ±1, PAM4 ±0.75 / ±0.25)
+ *    - Both:        V = FS · x · (1 - k·x²)
+ *    - k from RLM: with compression the inner PAM4 levels sit relatively
+ *      further out, 3·ES = 2 - RLM; RLM 0.95 → k ≈ 0.095
+ *
+ * 2. Output Pole (exact discretization):
+ *    - τ = 1 / (2π·f3dB); over a sample period dt with constant input x:
+ *      y ← x + (y - x)·e^(-dt/τ)  (first-order IIR, one multiply-add)
+ *    - An edge at fraction f of a sample period splits the step into
+ *      e^(-f·dt/τ) at the old level and e^(-(1-f)·dt/τ) at the new one,
+ *      so DCD below one sample period is still resolved exactly
+ *    - Sample i of UI k is the output at t = (k + (i + 1) / spu)·UI, the
+ *      end of its sample period; samples_per_ui = 1 gives the end-of-UI
+ *      response for RTL-rate models
+ *
+ * 3. DCD:
+ *    - Edges into odd UIs are delayed by DCD·UI (even UIs 1 + DCD long,
+ *      odd UIs 1 - DCD). Measured with dpi_tie.cpp this shows up as a
+ *      difference between the two boundary classes, not as a mean shift
+ *    - The delay stays inside the odd UI, so no look-ahead across blocks
+ *
+ * 4. Verilator Compilation:
+ *    - Add to test_config.yaml:
+ *      verilator_extra_flags:
+ *        - ../dpi/dpi_dac.cpp
+ *
+ * =============================================================================
+ */
@@ -0,0 +1,465 @@
+/**
+ * dpi_diff.cpp - DPI-C Differential-Pair (P/N) Signal Engine
+ *
+ * Adds a pair concept to the single-`real` RNM style: a differential signal
+ * is split into P and N legs, each leg gets its own impairments, and the
+ * result is decomposed back into differential and common-mode components
+ * (spec/ctle_specification.md §3.1, §6.7 balance, §6.8 CM rejection).
+ *
+ * Signal path per sample:
+ *   vdiff ─► split: P = Vcm + gP·vdiff/2,  N = Vcm - gN·vdiff/2
+ *         ─► + common-mode injection (tone + Gaussian, equal on both legs)
+ *         ─► intra-pair skew (fractional delay of one leg)
+ *         ─► per-leg single pole (bandwidth mismatch → mode conversion)
+ *         ─► diff = P - N,  cm = (P + N)/2
+ *
+ * Features:
+ * - P and N are the two lanes of one SSE2 register (interleaved pair
+ *   storage), so every stage, including the recursive pole, processes both
+ *   legs in one instruction: differential costs about the same as
+ *   single-ended
+ * - Drive from a differential signal, or from external P/N legs
+ * - Running statistics of the differential and common-mode outputs
+ *
+ * Author: Generated for SerDes differential signal modeling
+ * Date: 2025
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+#include "dpi_alloc.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+//==============================================================================
+// CONFIGURATION
+//==============================================================================
+#define DIFF_RING           128         // Skew delay line (pairs, power of 2)
+#define DIFF_MAX_SKEW       (DIFF_RING - 2)   // Samples
+
+//==============================================================================
+// PAIR LANES (P in lane 0, N in lane 1)
+//==============================================================================
+#if defined(__SSE2__)
+typedef __m128d Pair;
+static inline Pair pair_set(double p, double n) { return _mm_set_pd(n, p); }
+static inline Pair pair_dup(double v) { return _mm_set1_pd(v); }
+static inline Pair pair_add(Pair a, Pair b) { return _mm_add_pd(a, b); }
+static inline Pair pair_sub(Pair a, Pair b) { return _mm_sub_pd(a, b); }
+static inline Pair pair_mul(Pair a, Pair b) { return _mm_mul_pd(a, b); }
+static inline Pair pair_load(const double *pn) { return _mm_loadu_pd(pn); }
+static inline void pair_store(double *pn, Pair a) { _mm_storeu_pd(pn, a); }
+/** P from a, N from b. */
+static inline Pair pair_blend(Pair a, Pair b) { return _mm_move_sd(b, a); }
+#else
+struct Pair {
+    double v[2];
+};
+static inline Pair pair_set(double p, double n) { Pair r = {{p, n}}; return r; }
+static inline Pair pair_dup(double v) { return pair_set(v, v); }
+static inline Pair pair_add(Pair a, Pair b) { return pair_set(a.v[0] + b.v[0], a.v[1] + b.v[1]); }
+static inline Pair pair_sub(Pair a, Pair b) { return pair_set(a.v[0] - b.v[0], a.v[1] - b.v[1]); }
+static inline Pair pair_mul(Pair a, Pair b) { return pair_set(a.v[0] * b.v[0], a.v[1] * b.v[1]); }
+static inline Pair pair_load(const double *pn) { return pair_set(pn[0], pn[1]); }
+static inline void pair_store(double *pn, Pair a) { pn[0] = a.v[0]; pn[1] = a.v[1]; }
+static inline Pair pair_blend(Pair a, Pair b) { return pair_set(a.v[0], b.v[1]); }
+#endif
+
+//==============================================================================
+// ENGINE STATE
+//==============================================================================
+struct DiffEngine {
+    double fs;
+    double vcm;
+
+    // Split gains (P: +gP/2, N: -gN/2)
+    double gain_p, gain_n;
+
+    // Common-mode injection
+    double cm_amp, cm_freq, cm_rms;
+    uint64_t rng;
+    uint64_t t_index;
+
+    // Skew: leg delays in samples (one of them is 0)
+    double delay_p, delay_n;
+    int ip, in;                 // Integer parts
+    double fp, fn;              // Fractional parts
+    double ring[2 * DIFF_RING]; // Interleaved P/N
+    unsigned w;
+
+    // Per-leg pole, ramp-invariant: y = c·y[-1] + b0·x + b1·x[-1]
+    double pole_c[2], pole_b0[2], pole_b1[2];
+    double y[2];
+    double x_prev[2];
+    int primed;
+
+    // Output statistics
+    long long count;
+    double sum_diff, sum_diff2, sum_cm, sum_cm2;
+};
+
+//==============================================================================
+// HELPERS
+//==============================================================================
+static inline double diff_gauss(DiffEngine *d) {
+    // xorshift64* + Box-Muller (one value per call)
+    double u[2];
+    for (int k = 0; k < 2; k++) {
+        d->rng ^= d->rng >> 12;
+        d->rng ^= d->rng << 25;
+        d->rng ^= d->rng >> 27;
+        u[k] = ((double)((d->rng * 0x2545F4914F6CDD1DULL) >> 11) + 0.5) / 9007199254740992.0;
+    }
+    return std::sqrt(-2.0 * std::log(u[0])) * std::cos(2.0 * M_PI * u[1]);
+}
+
+static inline double diff_cm_sample(DiffEngine *d) {
+    double v = 0.0;
+    if (d->cm_amp != 0.0)
+        v += d->cm_amp * std::sin(2.0 * M_PI * d->cm_freq * (double)d->t_index / d->fs);
+    if (d->cm_rms > 0.0) v += d->cm_rms * diff_gauss(d);
+    d->t_index++;
+    return v;
+}
+
+/** Single pole, exact for a linearly interpolated input (f3db = 0: bypass). */
+static void pole_design(double f3db, double fs, double *c, double *b0, double *b1) {
+    if (f3db <= 0.0) {
+        *c = 0.0;
+        *b0 = 1.0;
+        *b1 = 0.0;
+        return;
+    }
+    const double a = 2.0 * M_PI * f3db / fs;
+    const double e = std::exp(-a);
+    const double g = (1.0 - e) / a;
+    *c = e;
+    *b0 = 1.0 - g;
+    *b1 = g - e;
+}
+
+/**
+ * Skew, poles and decomposition for one block of leg pairs (already split
+ * and CM-injected, interleaved P/N in pn[2n]). Writes diff/cm (either may
+ * be NULL) and, if legs_out is set, the processed P/N pairs back into pn.
+ */
+static void diff_run(DiffEngine *d, double *pn, int n, double *diff, double *cm, int legs_out) {
+    const unsigned mask = DIFF_RING - 1;
+    const Pair frac = pair_set(d->fp, d->fn);
+    const Pair c = pair_load(d->pole_c);
+    const Pair b0 = pair_load(d->pole_b0);
+    const Pair b1 = pair_load(d->pole_b1);
+    Pair y = pair_load(d->y);
+    Pair xp = pair_load(d->x_prev);
+    if (!d->primed && n > 0) {
+        // Start settled at the first input: no turn-on transient
+        y = xp = pair_load(pn);
+        for (unsigned k = 0; k < DIFF_RING; k++) pair_store(&d->ring[2 * k], y);
+        d->primed = 1;
+    }
+    for (int i = 0; i < n; i++) {
+        pair_store(&d->ring[2 * d->w], pair_load(&pn[2 * i]));
+        // Delayed leg: x[w - I] + f·(x[w - I - 1] - x[w - I]), per lane
+        const Pair a = pair_blend(pair_load(&d->ring[2 * ((d->w - d->ip) & mask)]),
+                                  pair_load(&d->ring[2 * ((d->w - d->in) & mask)]));
+        const Pair b = pair_blend(pair_load(&d->ring[2 * ((d->w - d->ip - 1) & mask)]),
+                                  pair_load(&d->ring[2 * ((d->w - d->in - 1) & mask)]));
+        const Pair x = pair_add(a, pair_mul(frac, pair_sub(b, a)));
+        d->w = (d->w + 1) & mask;
+        y = pair_add(pair_mul(c, y), pair_add(pair_mul(b0, x), pair_mul(b1, xp)));
+        xp = x;
+
+        double leg[2];
+        pair_store(leg, y);
+        const double vd = leg[0] - leg[1];
+        const double vc = (leg[0] + leg[1]) * 0.5;
+        if (diff) diff[i] = vd;
+        if (cm) cm[i] = vc;
+        if (legs_out) pair_store(&pn[2 * i], y);
+        d->sum_diff += vd;
+        d->sum_diff2 += vd * vd;
+        d->sum_cm += vc;
+        d->sum_cm2 += vc * vc;
+    }
+    pair_store(d->y, y);
+    pair_store(d->x_prev, xp);
+    d->count += n;
+}
+
+/** Split a differential block into CM-injected leg pairs. */
+static void diff_split(DiffEngine *d, const double *vdiff, int n, double *pn) {
+    const Pair g = pair_set(0.5 * d->gain_p, -0.5 * d->gain_n);
+    for (int i = 0; i < n; i++) {
+        const double c = d->vcm + diff_cm_sample(d);
+        pair_store(&pn[2 * i], pair_add(pair_dup(c), pair_mul(g, pair_dup(vdiff[i]))));
+    }
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// DPI-C EXPORTED FUNCTIONS
+//==============================================================================
+
+/**
+ * DPI-C Function: dpi_diff_create
+ *
+ * Args:
+ *   fs_hz: Sample rate (Hz)
+ *   vcm:   Common-mode voltage of the legs (V), e.g. 0.5
+ *
+ * Returns:
+ *   Engine handle (ideal pair: no skew, mismatch, poles or CM noise), or
+ *   NULL on invalid arguments
+ */
+void *dpi_diff_create(double fs_hz, double vcm) {
+    if (fs_hz <= 0.0) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_diff_create: fs_hz must be > 0\n");
+        return NULL;
+    }
+    DiffEngine *d = dpi_arena_new<DiffEngine>(dpi_arena_need<DiffEngine>(), "diff");
+    d->fs = fs_hz;
+    d->vcm = vcm;
+    d->gain_p = d->gain_n = 1.0;
+    pole_design(0.0, fs_hz, &d->pole_c[0], &d->pole_b0[0], &d->pole_b1[0]);
+    pole_design(0.0, fs_hz, &d->pole_c[1], &d->pole_b0[1], &d->pole_b1[1]);
+    d->rng = 0x9E3779B97F4A7C15ULL;
+    return d;
+}
+
+/**
+ * DPI-C Function: dpi_diff_set_skew
+ *
+ * Args:
+ *   skew_s: Intra-pair skew (s); > 0 delays N relative to P, < 0 delays P
+ *
+ * Returns:
+ *   0 on success, -1 if |skew| exceeds DIFF_MAX_SKEW samples
+ */
+int dpi_diff_set_skew(void *handle, double skew_s) {
+    DiffEngine *d = (DiffEngine *)handle;
+    const double s = skew_s * d->fs;
+    if (std::fabs(s) > DIFF_MAX_SKEW) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_diff_set_skew: %.3g samples exceeds %d\n", s,
+                DIFF_MAX_SKEW);
+        return -1;
+    }
+    d->delay_p = (s < 0.0) ? -s : 0.0;
+    d->delay_n = (s > 0.0) ? s : 0.0;
+    d->ip = (int)d->delay_p;
+    d->in = (int)d->delay_n;
+    d->fp = d->delay_p - d->ip;
+    d->fn = d->delay_n - d->in;
+    return 0;
+}
+
+/**
+ * DPI-C Function: dpi_diff_set_mismatch
+ *
+ * Args:
+ *   gain_mismatch: Leg amplitude imbalance; P gets 1 + m/2, N gets 1 - m/2
+ *   bw_p_hz, bw_n_hz: Per-leg single-pole bandwidth (0 = ideal)
+ *
+ * Returns:
+ *   0 on success, -1 on invalid arguments
+ */
+int dpi_diff_set_mismatch(void *handle, double gain_mismatch, double bw_p_hz, double bw_n_hz) {
+    DiffEngine *d = (DiffEngine *)handle;
+    if (bw_p_hz < 0.0 || bw_n_hz < 0.0 || std::fabs(gain_mismatch) >= 2.0) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_diff_set_mismatch: invalid mismatch\n");
+        return -1;
+    }
+    d->gain_p = 1.0 + 0.5 * gain_mismatch;
+    d->gain_n = 1.0 - 0.5 * gain_mismatch;
+    pole_design(bw_p_hz, d->fs, &d->pole_c[0], &d->pole_b0[0], &d->pole_b1[0]);
+    pole_design(bw_n_hz, d->fs, &d->pole_c[1], &d->pole_b0[1], &d->pole_b1[1]);
+    return 0;
+}
+
+/**
+ * DPI-C Function: dpi_diff_set_cm_noise
+ *
+ * Common-mode injection, identical on both legs.
+ *
+ * Args:
+ *   tone_amp_v, tone_freq_hz: Sinusoidal CM interferer (amplitude 0 = off)
+ *   rms_v: Gaussian CM noise (0 = off)
+ *   seed:  RNG seed
+ */
+void dpi_diff_set_cm_noise(void *handle, double tone_amp_v, double tone_freq_hz, double rms_v,
+                           int seed) {
+    DiffEngine *d = (DiffEngine *)handle;
+    d->cm_amp = tone_amp_v;
+    d->cm_freq = tone_freq_hz;
+    d->cm_rms = rms_v;
+    d->rng = 0x9E3779B97F4A7C15ULL ^ ((uint64_t)(uint32_t)seed * 0xD1B54A32D192ED03ULL);
+    if (d->rng == 0) d->rng = 1;
+}
+
+/**
+ * DPI-C Function: dpi_diff_process
+ *
+ * Differential input block → differential and common-mode outputs.
+ *
+ * Returns:
+ *   n
+ */
+int dpi_diff_process(void *handle, const double *vdiff, int n, double *diff_out,
+                     double *cm_out) {
+    DiffEngine *d = (DiffEngine *)handle;
+    double pn[2 * 256];
+    for (int i = 0; i < n; i += 256) {
+        const int m = (n - i < 256) ? n - i : 256;
+        diff_split(d, vdiff + i, m, pn);
+        diff_run(d, pn, m, diff_out + i, cm_out + i, 0);
+    }
+    return n;
+}
+
+/**
+ * DPI-C Function: dpi_diff_legs
+ *
+ * Differential input block → impaired P and N legs (e.g. to drive the
+ * signal_in_p / signal_in_n ports of an RNM block).
+ *
+ * Returns:
+ *   n
+ */
+int dpi_diff_legs(void *handle, const double *vdiff, int n, double *p_out, double *n_out) {
+    DiffEngine *d = (DiffEngine *)handle;
+    double pn[2 * 256];
+    for (int i = 0; i < n; i += 256) {
+        const int m = (n - i < 256) ? n - i : 256;
+        diff_split(d, vdiff + i, m, pn);
+        diff_run(d, pn, m, NULL, NULL, 1);
+        for (int j = 0; j < m; j++) {
+            p_out[i + j] = pn[2 * j];
+            n_out[i + j] = pn[2 * j + 1];
+        }
+    }
+    return n;
+}
+
+/**
+ * DPI-C Function: dpi_diff_process_legs
+ *
+ * External P/N legs (e.g. RNM outputs) → differential and common-mode.
+ * Gain mismatch scales each leg about Vcm; CM injection, skew and poles
+ * apply as for dpi_diff_process().
+ *
+ * Returns:
+ *   n
+ */
+int dpi_diff_process_legs(void *handle, const double *p_in, const double *n_in, int n,
+                          double *diff_out, double *cm_out) {
+    DiffEngine *d = (DiffEngine *)handle;
+    double pn[2 * 256];
+    const Pair g = pair_set(d->gain_p, d->gain_n);
+    for (int i = 0; i < n; i += 256) {
+        const int m = (n - i < 256) ? n - i : 256;
+        for (int j = 0; j < m; j++) {
+            const Pair vcm = pair_dup(d->vcm);
+            const Pair leg = pair_add(vcm, pair_mul(g, pair_sub(pair_set(p_in[i + j], n_in[i + j]),
+                                                                vcm)));
+            pair_store(&pn[2 * j], pair_add(leg, pair_dup(diff_cm_sample(d))));
+        }
+        diff_run(d, pn, m, diff_out + i, cm_out + i, 0);
+    }
+    return n;
+}
+
+/** DPI-C Function: dpi_diff_reset_stats - clear the output statistics. */
+void dpi_diff_reset_stats(void *handle) {
+    DiffEngine *d = (DiffEngine *)handle;
+    d->count = 0;
+    d->sum_diff = d->sum_diff2 = d->sum_cm = d->sum_cm2 = 0.0;
+}
+
+/** DPI-C Function: dpi_diff_mean_diff - mean differential output (V). */
+double dpi_diff_mean_diff(void *handle) {
+    DiffEngine *d = (DiffEngine *)handle;
+    return d->count ? d->sum_diff / d->count : 0.0;
+}
+
+/** DPI-C Function: dpi_diff_mean_cm - mean common-mode output (V). */
+double dpi_diff_mean_cm(void *handle) {
+    DiffEngine *d = (DiffEngine *)handle;
+    return d->count ? d->sum_cm / d->count : 0.0;
+}
+
+/** DPI-C Function: dpi_diff_ac_diff - RMS of the differential output about its mean (V). */
+double dpi_diff_ac_diff(void *handle) {
+    DiffEngine *d = (DiffEngine *)handle;
+    if (d->count == 0) return 0.0;
+    const double m = d->sum_diff / d->count;
+    const double v = d->sum_diff2 / d->count - m * m;
+    return v > 0.0 ? std::sqrt(v) : 0.0;
+}
+
+/** DPI-C Function: dpi_diff_ac_cm - RMS of the common-mode output about its mean (V). */
+double dpi_diff_ac_cm(void *handle) {
+    DiffEngine *d = (DiffEngine *)handle;
+    if (d->count == 0) return 0.0;
+    const double m = d->sum_cm / d->count;
+    const double v = d->sum_cm2 / d->count - m * m;
+    return v > 0.0 ? std::sqrt(v) : 0.0;
+}
+
+/** DPI-C Function: dpi_diff_destroy */
+void dpi_diff_destroy(void *handle) {
+    dpi_arena_delete((DiffEngine *)handle);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * =============================================================================
+ * IMPLEMENTATION NOTES
+ * =============================================================================
+ *
+ * 1. Interleaved Pair Lanes:
+ *    - Legs are stored as {P0, N0, P1, N1, ...}; one SSE2 register holds
+ *      the P and N sample of the same instant. The recursive pole cannot be
+ *      vectorized across time, but it can across the two legs, so the pair
+ *      costs one recursion per sample like a single-ended signal
+ *    - Without SSE2 the Pair type falls back to a two-element struct with
+ *      identical results
+ *
+ * 2. Skew:
+ *    - The lagging leg is read from a delay line with linear interpolation
+ *      between x[w - I] and x[w - I - 1] (I, f = integer / fractional delay);
+ *      exact for integer-sample skew, a mild low-pass otherwise
+ *    - A sine of amplitude A with skew τ: diff = A·cos(ωτ/2),
+ *      cm = (A/2)·sin(ωτ/2) → differential-to-CM conversion grows with
+ *      frequency
+ *
+ * 3. Mismatch:
+ *    - Gain imbalance m: CM = (m/4)·vdiff
+ *    - Bandwidth mismatch: a CM input v produces diff = (H_P - H_N)·v
+ *      (CM-to-differential conversion); with matched legs CMRR is infinite
+ *      and diff is exactly 0 for any CM input
+ *    - Poles are ramp-invariant (exact for a linearly interpolated input,
+ *      matching the skew interpolation): with a = 2π·f3dB/fs, e = e^-a,
+ *      g = (1 - e)/a: y = e·y[-1] + (1 - g)·x + (g - e)·x[-1]. A
+ *      step-invariant pole (y += (x - y)(1 - e)) would misstate the
+ *      mode conversion of poles within a decade of fs by > 10%
+ *
+ * 4. State:
+ *    - The delay line and poles start settled at the first input sample
+ *      (no turn-on transient); state carries across calls
+ *
+ * 5. Verilator Compilation:
+ *    - Add to test_config.yaml:
+ *      verilator_extra_flags:
+ *        - ../dpi/dpi_diff.cpp
+ *
+ * =============================================================================
+ */
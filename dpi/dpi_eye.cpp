@@ -0,0 +1,1068 @@
+/**
+ * dpi_eye.cpp - DPI-C Eye Histogram, Bathtub Curves and Dual-Dirac Extrapolation
+ *
+ * spec/test_strategy.md sets a BER < 1e-12 target that no simulation can
+ * count directly. This engine accumulates the histograms an eye analysis
+ * needs while the simulation runs, then fits dual-Dirac / Q-scale tails and
+ * extrapolates eye width and height to any target BER (1e-12, 1e-15).
+ *
+ * Features:
+ * - 2D eye histogram (phase within UI × voltage), fixed memory
+ * - Fine crossing-phase histogram from interpolated waveform crossings or
+ *   from edge timestamps supplied directly
+ * - Horizontal bathtub (sampling phase) and vertical bathtub (decision
+ *   threshold at the eye center), measured and fitted
+ * - Q-scale tail fits with optimized normalization ρ per tail (dual-Dirac):
+ *   RJ (σ), DJ(δδ), TJ / eye width and eye height at any BER
+ * - Block waveform input: one call per simulation block
+ * - Polygon eye-mask compliance: masks are rasterized once onto the 2D
+ *   histogram grid and hits are counted as samples arrive (one table
+ *   lookup per sample); automatic horizontal alignment to the measured
+ *   eye center and mask-margin search (largest scaled mask with no hits)
+ * - Checkpoint: dpi_eye_save / dpi_eye_restore write and reload the whole
+ *   engine state as one blob
+ *
+ * Author: Generated for SerDes eye / BER analysis
+ * Date: 2025
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "dpi_alloc.h"
+
+//==============================================================================
+// CONFIGURATION
+//==============================================================================
+#define EYE_XING_BINS      4096     // Crossing phase histogram bins per UI
+#define EYE_MAX_TIME_BINS  1024
+#define EYE_MAX_V_BINS     4096
+#define EYE_FIT_MIN_COUNT  8        // Tail points need this many hits
+#define EYE_FIT_MIN_Q      1.0      // Fit only beyond ~16% of the tail (Q >= 1)
+#define EYE_RHO_STEPS      40       // Normalization grid for the Q-scale fit
+#define EYE_MASK_MAX_POLYS  255      // Mask raster stores polygon index + 1 in a byte
+#define EYE_MASK_MAX_POINTS 32       // Vertices per mask polygon (arena budget)
+#define EYE_MASK_ALIGN_XINGS 1000    // Crossings before the mask auto-aligns
+#define EYE_MASK_MAX_SCALE  4.0      // Margin search range: scale 0 .. 4
+
+//==============================================================================
+// ENGINE STATE
+//==============================================================================
+struct TailFit {
+    double mu;                      // Dirac position
+    double sigma;                   // Gaussian RMS
+    double rho;                     // Tail normalization
+    int valid;
+};
+
+struct MaskPoint {
+    double x;                       // UI from the eye center
+    double v;                       // V
+};
+
+typedef dpi_vector<MaskPoint> MaskPoly;
+
+struct EyeEngine {
+    double ui_s;
+    double vref;
+    double v_min, v_max;
+    int time_bins;
+    int v_bins;
+
+    dpi_vector<uint32_t> eye{DpiAllocator<uint32_t>("eye.hist")}; // [time_bin * v_bins + v_bin]
+    dpi_vector<uint64_t> xing;      // [EYE_XING_BINS] crossing phase
+    uint64_t samples;
+    uint64_t crossings;
+    double t_first, t_last;
+    double prev_v, prev_t;
+    int have_prev;
+
+    // Analysis results
+    int analyzed;
+    double center_phase;            // Mean crossing phase (UI)
+    int center_col;                 // Eye-center column of the 2D histogram
+    TailFit h_left_edge;            // Right tail of the left crossing (early side of eye)
+    TailFit h_right_edge;           // Left tail of the right crossing
+    TailFit v_upper;                // Lower tail of the "1" level
+    TailFit v_lower;                // Upper tail of the "0" level
+    double transition_density;
+    uint64_t col_total;
+
+    // Eye mask
+    dpi_vector<MaskPoly> mask_polys;    // Outlines, carved from the arena above mask_mark
+    size_t mask_mark;                   // dpi_eye_mask_clear() rewinds the arena to here
+    dpi_vector<uint8_t> mask_map{DpiAllocator<uint8_t>("eye.mask")}; // [time_bin * v_bins + v_bin] = polygon + 1
+    dpi_vector<uint64_t> mask_poly_hits;
+    uint64_t mask_hits;
+    int mask_state;                 // 0 = no mask, 1 = waiting for alignment, 2 = active
+    double mask_origin;             // Phase (UI) of mask x = 0
+    double mask_offset;             // Alignment shift from the measured eye center (UI)
+};
+
+//==============================================================================
+// NORMAL DISTRIBUTION HELPERS
+//==============================================================================
+static inline double eye_phi_c(double q) {
+    return 0.5 * erfc(q / M_SQRT2);
+}
+
+/**
+ * Q(p): the Q-scale value with upper-tail probability p (Φc(Q) = p), p < 1.
+ * Acklam's rational approximation refined by one Halley step.
+ */
+static double eye_q_of_p(double p) {
+    static const double a[6] = {-3.969683028665376e+01, 2.209460984245205e+02,
+                                -2.759285104469687e+02, 1.383577518672690e+02,
+                                -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[5] = {-5.447609879822406e+01, 1.615858368580409e+02,
+                                -1.556989798598866e+02, 6.680131188771972e+01,
+                                -1.328068155288572e+01};
+    static const double c[6] = {-7.784894002430293e-03, -3.223964580411365e-01,
+                                -2.400758277161838e+00, -2.549732539343734e+00,
+                                4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[4] = {7.784695709041462e-03, 3.224671290700398e-01,
+                                2.445134137142996e+00, 3.754408661907416e+00};
+    if (p <= 0.0) return 40.0;
+    if (p >= 1.0) return -40.0;
+    // Lower-tail quantile x of probability p, then Q = -x
+    double x;
+    if (p < 0.02425) {
+        const double q = sqrt(-2.0 * log(p));
+        x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    } else if (p <= 1.0 - 0.02425) {
+        const double q = p - 0.5;
+        const double r = q * q;
+        x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+            (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+    } else {
+        const double q = sqrt(-2.0 * log(1.0 - p));
+        x = -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+    const double e = 0.5 * erfc(-x / M_SQRT2) - p;
+    const double u = e * sqrt(2.0 * M_PI) * exp(x * x / 2.0);
+    x = x - u / (1.0 + x * u / 2.0);
+    return -x;
+}
+
+//==============================================================================
+// Q-SCALE TAIL FIT
+//==============================================================================
+/**
+ * Fits x = mu + dir·sigma·Q(p/ρ) to tail points (x_k, p_k), where p_k is
+ * the tail probability (normalized to the population) and dir = +1 for an
+ * upper tail, -1 for a lower tail. ρ is chosen on a log grid to minimize
+ * the residual variance in units of sigma² (optimized Q-scale normalization).
+ */
+static TailFit eye_fit_tail(const std::vector<double> &x, const std::vector<double> &p,
+                            const std::vector<uint64_t> &count, int dir) {
+    TailFit best = {0.0, 0.0, 0.0, 0};
+    double best_score = INFINITY;
+    std::vector<double> q(x.size());
+    for (int r = 0; r <= EYE_RHO_STEPS; r++) {
+        const double rho = pow(10.0, -2.0 + 2.0 * (double)r / EYE_RHO_STEPS);  // 0.01..1
+        double sq = 0, sx = 0, sqq = 0, sqx = 0;
+        int n = 0;
+        for (size_t k = 0; k < x.size(); k++) {
+            q[k] = -1.0;
+            if (count[k] < EYE_FIT_MIN_COUNT || p[k] >= rho) continue;
+            const double qk = eye_q_of_p(p[k] / rho);
+            if (qk < EYE_FIT_MIN_Q) continue;
+            q[k] = qk;
+            sq += qk;
+            sx += x[k];
+            sqq += qk * qk;
+            sqx += qk * x[k];
+            n++;
+        }
+        if (n < 5) continue;
+        const double den = n * sqq - sq * sq;
+        if (den <= 0.0) continue;
+        const double slope = (n * sqx - sq * sx) / den;
+        const double icpt = (sx - slope * sq) / n;
+        if (slope * dir <= 0.0) continue;
+        double res = 0.0;
+        for (size_t k = 0; k < x.size(); k++) {
+            if (q[k] < 0.0) continue;
+            const double e = x[k] - (icpt + slope * q[k]);
+            res += e * e;
+        }
+        const double score = res / ((n - 2) * slope * slope);
+        if (score < best_score) {
+            best_score = score;
+            best.mu = icpt;
+            best.sigma = fabs(slope);
+            best.rho = rho;
+            best.valid = 1;
+        }
+    }
+    return best;
+}
+
+/** Position where a fitted tail reaches probability ber (per population). */
+static double eye_tail_position(const TailFit &f, int dir, double ber) {
+    return f.mu + dir * f.sigma * eye_q_of_p(ber / f.rho);
+}
+
+//==============================================================================
+// ACCUMULATION
+//==============================================================================
+static inline void eye_track_time(EyeEngine *e, double t) {
+    if (e->samples == 0 && e->crossings == 0) e->t_first = t;
+    if (t < e->t_first) e->t_first = t;
+    if (t > e->t_last) e->t_last = t;
+}
+
+static inline double eye_phase(const EyeEngine *e, double t) {
+    double ph = fmod(t / e->ui_s, 1.0);
+    return ph < 0.0 ? ph + 1.0 : ph;
+}
+
+static inline void eye_add_sample(EyeEngine *e, double t, double v) {
+    eye_track_time(e, t);
+    int tb = (int)(eye_phase(e, t) * e->time_bins);
+    if (tb >= e->time_bins) tb = e->time_bins - 1;
+    int vb = (int)((v - e->v_min) / (e->v_max - e->v_min) * e->v_bins);
+    vb = vb < 0 ? 0 : (vb >= e->v_bins ? e->v_bins - 1 : vb);
+    const size_t idx = (size_t)tb * e->v_bins + vb;
+    e->eye[idx]++;
+    e->samples++;
+    if (e->mask_state == 2 && e->mask_map[idx]) {
+        e->mask_hits++;
+        e->mask_poly_hits[e->mask_map[idx] - 1]++;
+    }
+}
+
+/** Circular mean of the crossing phase (UI, 0..1). */
+static double eye_mean_phase(const EyeEngine *e) {
+    double cs = 0.0, sn = 0.0;
+    for (int b = 0; b < EYE_XING_BINS; b++) {
+        const double ph = 2.0 * M_PI * (b + 0.5) / EYE_XING_BINS;
+        cs += e->xing[b] * cos(ph);
+        sn += e->xing[b] * sin(ph);
+    }
+    const double c = atan2(sn, cs) / (2.0 * M_PI);
+    return c < 0.0 ? c + 1.0 : c;
+}
+
+/** Measured eye center (UI phase, 0..1): mean crossing phase + 0.5 UI. */
+static double eye_center(const EyeEngine *e) {
+    const double c = eye_mean_phase(e) + 0.5;
+    return c >= 1.0 ? c - 1.0 : c;
+}
+
+static void eye_mask_place(EyeEngine *e, double origin);
+
+/** Places a waiting mask on the eye center once EYE_MASK_ALIGN_XINGS crossings are in. */
+static inline void eye_mask_ensure(EyeEngine *e) {
+    if (e->mask_state == 1 && e->crossings >= EYE_MASK_ALIGN_XINGS)
+        eye_mask_place(e, eye_center(e));
+}
+
+static inline void eye_add_edge(EyeEngine *e, double t) {
+    eye_track_time(e, t);
+    int b = (int)(eye_phase(e, t) * EYE_XING_BINS);
+    if (b >= EYE_XING_BINS) b = EYE_XING_BINS - 1;
+    e->xing[b]++;
+    e->crossings++;
+    e->analyzed = 0;
+    eye_mask_ensure(e);
+}
+
+//==============================================================================
+// ANALYSIS
+//==============================================================================
+static int eye_analyze(EyeEngine *e) {
+    if (e->crossings < 100) {
+        fprintf(stderr, "[DPI-C ERROR] eye: only %llu crossings, cannot analyze\n",
+                (unsigned long long)e->crossings);
+        return -1;
+    }
+
+    e->center_phase = eye_mean_phase(e);
+    const int kc = (int)(e->center_phase * EYE_XING_BINS);
+
+    const double span_ui = (e->t_last - e->t_first) / e->ui_s;
+    e->transition_density = span_ui > 0.0 ? (double)e->crossings / span_ui : 0.5;
+    if (e->transition_density > 1.0) e->transition_density = 1.0;
+
+    // Crossing distribution re-centred to [-0.5, 0.5) UI around the mean
+    const int B = EYE_XING_BINS;
+    std::vector<uint64_t> h(B);
+    for (int d = -B / 2; d < B / 2; d++) h[d + B / 2] = e->xing[((kc + d) % B + B) % B];
+    const double N = (double)e->crossings;
+
+    // Upper tail (late crossings) → closes the eye from the left
+    std::vector<double> x, p;
+    std::vector<uint64_t> cnt;
+    uint64_t acc = 0;
+    for (int i = B - 1; i >= B / 2; i--) {
+        acc += h[i];
+        x.push_back((double)(i - B / 2) / B);        // Left edge of bin
+        p.push_back((double)acc / N);
+        cnt.push_back(acc);
+    }
+    e->h_left_edge = eye_fit_tail(x, p, cnt, +1);
+
+    // Lower tail (early crossings) → closes the eye from the right
+    x.clear(); p.clear(); cnt.clear();
+    acc = 0;
+    for (int i = 0; i < B / 2; i++) {
+        acc += h[i];
+        x.push_back((double)(i + 1 - B / 2) / B);    // Right edge of bin
+        p.push_back((double)acc / N);
+        cnt.push_back(acc);
+    }
+    e->h_right_edge = eye_fit_tail(x, p, cnt, -1);
+
+    // Vertical: 2D column at the eye center (crossing + 0.5 UI)
+    double mid = e->center_phase + 0.5;
+    if (mid >= 1.0) mid -= 1.0;
+    e->center_col = (int)(mid * e->time_bins);
+    if (e->center_col >= e->time_bins) e->center_col = e->time_bins - 1;
+    const uint32_t *col = &e->eye[(size_t)e->center_col * e->v_bins];
+    const double dv = (e->v_max - e->v_min) / e->v_bins;
+    int kref = (int)((e->vref - e->v_min) / dv);
+    kref = kref < 0 ? 0 : (kref > e->v_bins ? e->v_bins : kref);
+    e->col_total = 0;
+    for (int k = 0; k < e->v_bins; k++) e->col_total += col[k];
+
+    e->v_upper.valid = 0;
+    e->v_lower.valid = 0;
+    if (e->col_total > 0) {
+        const double M = (double)e->col_total;
+        // "1" level: lower tail, cumulative from the threshold upward
+        x.clear(); p.clear(); cnt.clear();
+        acc = 0;
+        for (int k = kref; k < e->v_bins; k++) {
+            acc += col[k];
+            x.push_back(e->v_min + (k + 1) * dv);
+            p.push_back((double)acc / M);
+            cnt.push_back(acc);
+        }
+        e->v_upper = eye_fit_tail(x, p, cnt, -1);
+        // "0" level: upper tail, cumulative from the threshold downward
+        x.clear(); p.clear(); cnt.clear();
+        acc = 0;
+        for (int k = kref - 1; k >= 0; k--) {
+            acc += col[k];
+            x.push_back(e->v_min + k * dv);
+            p.push_back((double)acc / M);
+            cnt.push_back(acc);
+        }
+        e->v_lower = eye_fit_tail(x, p, cnt, +1);
+    }
+
+    e->analyzed = 1;
+    return (e->h_left_edge.valid && e->h_right_edge.valid) ? 0 : -1;
+}
+
+static inline void eye_ensure(EyeEngine *e) {
+    if (!e->analyzed) eye_analyze(e);
+}
+
+/** Fitted horizontal bathtub BER at sampling phase t (UI after crossing). */
+static double eye_h_ber_fit(const EyeEngine *e, double t) {
+    const TailFit &l = e->h_left_edge;
+    const TailFit &r = e->h_right_edge;
+    double ber = 0.0;
+    if (l.valid) ber += l.rho * eye_phi_c((t - l.mu) / l.sigma);
+    if (r.valid) ber += r.rho * eye_phi_c(((r.mu + 1.0) - t) / r.sigma);
+    return e->transition_density * ber;
+}
+
+/** Fitted vertical bathtub BER at decision threshold v. */
+static double eye_v_ber_fit(const EyeEngine *e, double v) {
+    const TailFit &u = e->v_upper;
+    const TailFit &l = e->v_lower;
+    double ber = 0.0;
+    if (u.valid) ber += u.rho * eye_phi_c((u.mu - v) / u.sigma);
+    if (l.valid) ber += l.rho * eye_phi_c((v - l.mu) / l.sigma);
+    return ber;
+}
+
+//==============================================================================
+// EYE MASK
+//==============================================================================
+/** Point-in-polygon (even-odd rule). */
+static bool eye_mask_inside(const MaskPoly &poly, double x, double v) {
+    bool in = false;
+    for (size_t i = 0, j = poly.size() - 1; i < poly.size(); j = i++) {
+        const MaskPoint &a = poly[i];
+        const MaskPoint &b = poly[j];
+        if ((a.v > v) != (b.v > v) && x < a.x + (v - a.v) * (b.x - a.x) / (b.v - a.v)) in = !in;
+    }
+    return in;
+}
+
+/**
+ * Mask polygons at margin scale s. Polygons around the eye center (they
+ * contain (0, vref)) scale about it; the others (amplitude limits) move
+ * toward vref by (s - 1) × the inner mask half-height.
+ */
+static dpi_vector<MaskPoly> eye_mask_scaled(const EyeEngine *e, double s) {
+    dpi_vector<MaskPoly> out{DpiAllocator<MaskPoly>("eye.mask_scaled", NULL)};
+    for (const MaskPoly &poly : e->mask_polys) {
+        out.emplace_back(poly.begin(), poly.end(),
+                         DpiAllocator<MaskPoint>("eye.mask_scaled", NULL));
+    }
+    double h_inner = 0.0;
+    std::vector<bool> inner(out.size());
+    for (size_t p = 0; p < out.size(); p++) {
+        inner[p] = eye_mask_inside(out[p], 0.0, e->vref);
+        if (!inner[p]) continue;
+        for (const MaskPoint &pt : out[p]) h_inner = std::max(h_inner, fabs(pt.v - e->vref));
+    }
+    for (size_t p = 0; p < out.size(); p++) {
+        double vc = 0.0;
+        for (const MaskPoint &pt : out[p]) vc += pt.v;
+        const double dir = (vc / out[p].size() > e->vref) ? -1.0 : 1.0;
+        for (MaskPoint &pt : out[p]) {
+            if (inner[p]) {
+                pt.x *= s;
+                pt.v = e->vref + (pt.v - e->vref) * s;
+            } else {
+                pt.v += dir * (s - 1.0) * h_inner;
+            }
+        }
+    }
+    return out;
+}
+
+/**
+ * Voltage bins [k0, k1) of one histogram column covered by a polygon,
+ * by scanline: crossings of the vertical line x with the polygon edges,
+ * filled pairwise (bin centers inside).
+ */
+static void eye_mask_column(const EyeEngine *e, const MaskPoly &poly, double x,
+                            std::vector<std::pair<int, int>> &spans) {
+    std::vector<double> ys;
+    for (size_t i = 0, j = poly.size() - 1; i < poly.size(); j = i++) {
+        const MaskPoint &a = poly[j];
+        const MaskPoint &b = poly[i];
+        if ((a.x <= x && x < b.x) || (b.x <= x && x < a.x)) {
+            ys.push_back(a.v + (x - a.x) * (b.v - a.v) / (b.x - a.x));
+        }
+    }
+    std::sort(ys.begin(), ys.end());
+    const double dv = (e->v_max - e->v_min) / e->v_bins;
+    for (size_t i = 0; i + 1 < ys.size(); i += 2) {
+        int k0 = (int)ceil((ys[i] - e->v_min) / dv - 0.5);
+        int k1 = (int)ceil((ys[i + 1] - e->v_min) / dv - 0.5);
+        k0 = std::max(0, std::min(k0, e->v_bins));
+        k1 = std::max(0, std::min(k1, e->v_bins));
+        if (k1 > k0) spans.push_back(std::make_pair(k0, k1));
+    }
+}
+
+/** Mask x (UI from the eye center) of histogram column tb for a mask origin. */
+static inline double eye_mask_x(const EyeEngine *e, int tb, double origin) {
+    double x = (tb + 0.5) / e->time_bins - origin;
+    x -= floor(x + 0.5);                            // Wrap to [-0.5, 0.5)
+    return x;
+}
+
+/** Rasterizes the mask at origin and recounts the hits from the histogram. */
+static void eye_mask_place(EyeEngine *e, double origin) {
+    e->mask_origin = origin;
+    e->mask_map.assign((size_t)e->time_bins * e->v_bins, 0);
+    std::vector<std::pair<int, int>> spans;
+    for (int tb = 0; tb < e->time_bins; tb++) {
+        const double x = eye_mask_x(e, tb, origin);
+        for (size_t p = 0; p < e->mask_polys.size(); p++) {
+            spans.clear();
+            eye_mask_column(e, e->mask_polys[p], x, spans);
+            for (const auto &sp : spans) {
+                for (int k = sp.first; k < sp.second; k++) {
+                    uint8_t &m = e->mask_map[(size_t)tb * e->v_bins + k];
+                    if (!m) m = (uint8_t)(p + 1);
+                }
+            }
+        }
+    }
+    e->mask_hits = 0;
+    e->mask_poly_hits.assign(e->mask_polys.size(), 0);
+    for (size_t i = 0; i < e->mask_map.size(); i++) {
+        if (e->mask_map[i] && e->eye[i]) {
+            e->mask_hits += e->eye[i];
+            e->mask_poly_hits[e->mask_map[i] - 1] += e->eye[i];
+        }
+    }
+    e->mask_state = 2;
+}
+
+/** Per-column prefix sums of the 2D histogram: [tb * (v_bins + 1) + k]. */
+static std::vector<uint64_t> eye_column_prefix(const EyeEngine *e) {
+    std::vector<uint64_t> pre((size_t)e->time_bins * (e->v_bins + 1), 0);
+    for (int tb = 0; tb < e->time_bins; tb++) {
+        uint64_t *c = &pre[(size_t)tb * (e->v_bins + 1)];
+        const uint32_t *h = &e->eye[(size_t)tb * e->v_bins];
+        for (int k = 0; k < e->v_bins; k++) c[k + 1] = c[k] + h[k];
+    }
+    return pre;
+}
+
+/** Hits of the given polygons at origin, from column prefix sums. */
+static uint64_t eye_mask_count(const EyeEngine *e, const dpi_vector<MaskPoly> &polys,
+                               double origin, const std::vector<uint64_t> &pre) {
+    uint64_t hits = 0;
+    std::vector<std::pair<int, int>> spans;
+    for (int tb = 0; tb < e->time_bins; tb++) {
+        const double x = eye_mask_x(e, tb, origin);
+        const uint64_t *c = &pre[(size_t)tb * (e->v_bins + 1)];
+        for (const auto &poly : polys) {
+            spans.clear();
+            eye_mask_column(e, poly, x, spans);
+            for (const auto &sp : spans) hits += c[sp.second] - c[sp.first];
+        }
+    }
+    return hits;
+}
+
+/** True if poly may become mask polygon number index (prints the error otherwise). */
+static bool eye_mask_valid(const MaskPoly &poly, size_t index) {
+    if (poly.size() < 3 || poly.size() > EYE_MASK_MAX_POINTS || index >= EYE_MASK_MAX_POLYS) {
+        fprintf(stderr, "[DPI-C ERROR] eye: invalid mask polygon (%zu vertices)\n", poly.size());
+        return false;
+    }
+    return true;
+}
+
+static int eye_mask_add(EyeEngine *e, const MaskPoly &poly) {
+    if (!eye_mask_valid(poly, e->mask_polys.size())) return -1;
+    e->mask_polys.emplace_back(poly.begin(), poly.end(),
+                               DpiAllocator<MaskPoint>("eye.mask_poly", dpi_arena_of(e)));
+    e->mask_offset = 0.0;
+    e->mask_state = 1;
+    eye_mask_ensure(e);
+    return (int)e->mask_polys.size() - 1;
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// DPI-C EXPORTED FUNCTIONS
+//==============================================================================
+/**
+ * DPI-C Function: dpi_eye_create
+ *
+ * Args:
+ *   ui_s         : Unit interval (s); phase = fmod(t / ui_s, 1)
+ *   time_bins    : 2D histogram phase bins per UI (8..1024)
+ *   v_min, v_max : 2D histogram voltage range (V)
+ *   v_bins       : 2D histogram voltage bins (16..4096)
+ *   vref         : Decision threshold / crossing level (V)
+ *
+ * Returns:
+ *   chandle: Engine handle, or NULL on invalid arguments
+ */
+void *dpi_eye_create(double ui_s, int time_bins, double v_min, double v_max,
+                     int v_bins, double vref) {
+    if (ui_s <= 0.0 || time_bins < 8 || time_bins > EYE_MAX_TIME_BINS ||
+        v_bins < 16 || v_bins > EYE_MAX_V_BINS || v_max <= v_min) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_eye_create: invalid arguments\n");
+        return NULL;
+    }
+    // Declared needs: engine, histogram, mask raster (used once a mask is
+    // loaded), crossing histogram, per-polygon hit counters and the
+    // polygon outlines (EYE_MASK_MAX_POINTS vertices each)
+    const size_t cells = (size_t)time_bins * v_bins;
+    EyeEngine *e = dpi_arena_new<EyeEngine>(
+        dpi_arena_need<EyeEngine>() + dpi_arena_need<uint32_t>(cells) +
+        dpi_arena_need<uint8_t>(cells) + dpi_arena_need<uint64_t>(EYE_XING_BINS) +
+        dpi_arena_need<uint64_t>(EYE_MASK_MAX_POLYS) +
+        dpi_arena_need<MaskPoly>(EYE_MASK_MAX_POLYS) +
+        EYE_MASK_MAX_POLYS * dpi_arena_need<MaskPoint>(EYE_MASK_MAX_POINTS), "eye");
+    e->ui_s = ui_s;
+    e->time_bins = time_bins;
+    e->v_min = v_min;
+    e->v_max = v_max;
+    e->v_bins = v_bins;
+    e->vref = vref;
+    e->eye.assign(cells, 0);
+    e->xing.assign(EYE_XING_BINS, 0);
+    e->mask_map.reserve(cells);
+    e->mask_poly_hits.reserve(EYE_MASK_MAX_POLYS);
+    e->mask_polys.reserve(EYE_MASK_MAX_POLYS);
+    e->mask_mark = dpi_arena_mark(dpi_arena_of(e));
+    e->samples = 0;
+    e->crossings = 0;
+    e->t_first = 0.0;
+    e->t_last = 0.0;
+    e->have_prev = 0;
+    e->analyzed = 0;
+    e->mask_hits = 0;
+    e->mask_state = 0;
+    e->mask_origin = 0.5;
+    e->mask_offset = 0.0;
+    return e;
+}
+
+/**
+ * DPI-C Function: dpi_eye_add_waveform
+ *
+ * Adds a uniformly sampled block v[0..n-1] at times t0 + i·dt to the 2D
+ * histogram and records vref crossings with linear interpolation (also
+ * across block boundaries).
+ */
+void dpi_eye_add_waveform(void *handle, const double *v, int n, double t0, double dt) {
+    EyeEngine *e = (EyeEngine *)handle;
+    for (int i = 0; i < n; i++) {
+        const double t = t0 + i * dt;
+        eye_add_sample(e, t, v[i]);
+        if (e->have_prev) {
+            const double a = e->prev_v - e->vref;
+            const double b = v[i] - e->vref;
+            if ((a < 0.0 && b >= 0.0) || (a >= 0.0 && b < 0.0)) {
+                eye_add_edge(e, e->prev_t + (t - e->prev_t) * a / (a - b));
+            }
+        }
+        e->prev_v = v[i];
+        e->prev_t = t;
+        e->have_prev = 1;
+    }
+    e->analyzed = 0;
+}
+
+/** DPI-C Function: dpi_eye_add_sample - one (time, voltage) point. */
+void dpi_eye_add_sample(void *handle, double t, double v) {
+    EyeEngine *e = (EyeEngine *)handle;
+    eye_add_sample(e, t, v);
+    e->analyzed = 0;
+}
+
+/** DPI-C Function: dpi_eye_add_edge - one crossing time (e.g. from a TIE monitor). */
+void dpi_eye_add_edge(void *handle, double t) {
+    eye_add_edge((EyeEngine *)handle, t);
+}
+
+/**
+ * DPI-C Function: dpi_eye_analyze
+ *
+ * Fits all four tails. Queries call this implicitly when data changed.
+ *
+ * Returns:
+ *   int: 0 if both horizontal tails fitted, -1 otherwise
+ */
+int dpi_eye_analyze(void *handle) {
+    return eye_analyze((EyeEngine *)handle);
+}
+
+/** DPI-C Function: dpi_eye_center_phase - mean crossing phase (UI, 0..1). */
+double dpi_eye_center_phase(void *handle) {
+    EyeEngine *e = (EyeEngine *)handle;
+    eye_ensure(e);
+    return e->center_phase;
+}
+
+/** DPI-C Function: dpi_eye_rj - random jitter, mean of both tail σ (UI RMS). */
+double dpi_eye_rj(void *handle) {
+    EyeEngine *e = (EyeEngine *)handle;
+    eye_ensure(e);
+    return 0.5 * (e->h_left_edge.sigma + e->h_right_edge.sigma);
+}
+
+/** DPI-C Function: dpi_eye_dj - dual-Dirac deterministic jitter DJ(δδ) (UI). */
+double dpi_eye_dj(void *handle) {
+    EyeEngine *e = (EyeEngine *)handle;
+    eye_ensure(e);
+    const double dj = e->h_left_edge.mu - e->h_right_edge.mu;
+    return dj > 0.0 ? dj : 0.0;
+}
+
+/**
+ * DPI-C Function: dpi_eye_width
+ *
+ * Extrapolated horizontal eye opening (UI) at the target BER.
+ */
+double dpi_eye_width(void *handle, double ber) {
+    EyeEngine *e = (EyeEngine *)handle;
+    eye_ensure(e);
+    if (!e->h_left_edge.valid || !e->h_right_edge.valid) return 0.0;
+    const double b = ber / e->transition_density;
+    const double left = eye_tail_position(e->h_left_edge, +1, b);
+    const double right = 1.0 + eye_tail_position(e->h_right_edge, -1, b);
+    return right > left ? right - left : 0.0;
+}
+
+/** DPI-C Function: dpi_eye_tj - total jitter at the target BER (UI) = 1 - width. */
+double dpi_eye_tj(void *handle, double ber) {
+    return 1.0 - dpi_eye_width(handle, ber);
+}
+
+/**
+ * DPI-C Function: dpi_eye_height
+ *
+ * Extrapolated vertical eye opening (V) at the eye center and target BER.
+ */
+double dpi_eye_height(void *handle, double ber) {
+    EyeEngine *e = (EyeEngine *)handle;
+    eye_ensure(e);
+    if (!e->v_upper.valid || !e->v_lower.valid) return 0.0;
+    const double top = eye_tail_position(e->v_upper, -1, ber);
+    const double bot = eye_tail_position(e->v_lower, +1, ber);
+    return top > bot ? top - bot : 0.0;
+}
+
+/** DPI-C Function: dpi_eye_vnoise - mean σ of the two vertical tails (V RMS). */
+double dpi_eye_vnoise(void *handle) {
+    EyeEngine *e = (EyeEngine *)handle;
+    eye_ensure(e);
+    return 0.5 * (e->v_upper.sigma + e->v_lower.sigma);
+}
+
+/** DPI-C Function: dpi_eye_crossings */
+long long dpi_eye_crossings(void *handle) {
+    return (long long)((EyeEngine *)handle)->crossings;
+}
+
+/**
+ * DPI-C Function: dpi_eye_write_bathtub
+ *
+ * CSV: axis,position,ber_measured,ber_fit
+ *   axis "h": position = sampling phase after the crossing (UI)
+ *   axis "v": position = decision threshold at the eye center (V)
+ */
+int dpi_eye_write_bathtub(void *handle, const char *path) {
+    EyeEngine *e = (EyeEngine *)handle;
+    eye_ensure(e);
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        fprintf(stderr, "[DPI-C ERROR] eye: cannot open %s\n", path);
+        return -1;
+    }
+    fprintf(f, "axis,position,ber_measured,ber_fit\n");
+
+    const int B = EYE_XING_BINS;
+    const int kc = (int)(e->center_phase * B);
+    const double N = (double)(e->crossings ? e->crossings : 1);
+    // Survival of the left crossing and CDF of the right crossing at phase t
+    std::vector<double> late(B + 1, 0.0), early(B + 1, 0.0);
+    for (int i = B - 1; i >= 0; i--) late[i] = late[i + 1] + e->xing[(kc + i) % B];
+    for (int i = 1; i <= B; i++) early[i] = early[i - 1] + e->xing[(kc + i - 1) % B];
+    const int step = B / 256;
+    for (int i = 0; i <= B; i += step) {
+        const double t = (double)i / B;
+        // Crossings from the left edge later than t (offsets i..B/2) and from
+        // the right edge earlier than t (offsets -B/2..i-B)
+        const double l = (i < B / 2) ? (late[i] - late[B / 2]) : 0.0;
+        const double r = (i > B / 2) ? (early[i] - early[B / 2]) : 0.0;
+        const double meas = e->transition_density * (l + r) / N;
+        fprintf(f, "h,%.6f,%.6e,%.6e\n", t, meas, eye_h_ber_fit(e, t));
+    }
+
+    const uint32_t *col = &e->eye[(size_t)e->center_col * e->v_bins];
+    const double dv = (e->v_max - e->v_min) / e->v_bins;
+    const double M = (double)(e->col_total ? e->col_total : 1);
+    for (int k = 0; k <= e->v_bins; k++) {
+        const double v = e->v_min + k * dv;
+        uint64_t err = 0;
+        for (int j = 0; j < e->v_bins; j++) {
+            const double vc = e->v_min + (j + 0.5) * dv;
+            const bool one = vc >= e->vref;
+            if ((one && j < k) || (!one && j >= k)) err += col[j];
+        }
+        fprintf(f, "v,%.6f,%.6e,%.6e\n", v, (double)err / M, eye_v_ber_fit(e, v));
+    }
+    fclose(f);
+    return 0;
+}
+
+/**
+ * DPI-C Function: dpi_eye_write_histogram
+ *
+ * CSV of the 2D eye: phase_ui,voltage,count (non-zero bins only).
+ */
+int dpi_eye_write_histogram(void *handle, const char *path) {
+    const EyeEngine *e = (const EyeEngine *)handle;
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        fprintf(stderr, "[DPI-C ERROR] eye: cannot open %s\n", path);
+        return -1;
+    }
+    fprintf(f, "phase_ui,voltage,count\n");
+    const double dv = (e->v_max - e->v_min) / e->v_bins;
+    for (int t = 0; t < e->time_bins; t++) {
+        for (int k = 0; k < e->v_bins; k++) {
+            const uint32_t c = e->eye[(size_t)t * e->v_bins + k];
+            if (c) fprintf(f, "%.5f,%.6f,%u\n", (t + 0.5) / e->time_bins,
+                           e->v_min + (k + 0.5) * dv, c);
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+/**
+ * DPI-C Function: dpi_eye_mask_add_polygon
+ *
+ * Adds one mask polygon with vertices (x_ui[i], v[i]): x in UI from the eye
+ * center, v in volts; 3..EYE_MASK_MAX_POINTS vertices. The mask goes live
+ * once EYE_MASK_ALIGN_XINGS crossings have fixed the eye center (or at once
+ * if they already have); samples collected before are counted from the
+ * histogram.
+ *
+ * Returns:
+ *   int: Polygon index, or -1 on error
+ */
+int dpi_eye_mask_add_polygon(void *handle, const double *x_ui, const double *v, int n) {
+    MaskPoly poly{DpiAllocator<MaskPoint>("eye.mask_poly", NULL)};
+    for (int i = 0; i < n; i++) poly.push_back(MaskPoint{x_ui[i], v[i]});
+    return eye_mask_add((EyeEngine *)handle, poly);
+}
+
+/**
+ * DPI-C Function: dpi_eye_mask_load
+ *
+ * Loads polygons from a text file: "polygon" starts a polygon, each
+ * following line holds "x_ui v"; '#' starts a comment. The whole file is
+ * validated before any polygon is added, so on error the mask is unchanged.
+ *
+ * Returns:
+ *   int: Number of polygons loaded, or -1 on error
+ */
+int dpi_eye_mask_load(void *handle, const char *path) {
+    EyeEngine *e = (EyeEngine *)handle;
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        fprintf(stderr, "[DPI-C ERROR] eye: cannot open mask %s\n", path);
+        return -1;
+    }
+    std::vector<MaskPoly> polys;
+    char line[256];
+    int lineno = 0;
+    while (fgets(line, sizeof(line), f)) {
+        lineno++;
+        char *hash = strchr(line, '#');
+        if (hash) *hash = '\0';
+        char word[16];
+        double x, v;
+        if (sscanf(line, "%15s", word) != 1) continue;
+        if (strcmp(word, "polygon") == 0) {
+            polys.emplace_back(DpiAllocator<MaskPoint>("eye.mask_poly", NULL));
+        } else if (sscanf(line, "%lf %lf", &x, &v) == 2 && !polys.empty()) {
+            polys.back().push_back(MaskPoint{x, v});
+        } else {
+            fprintf(stderr, "[DPI-C ERROR] eye: %s:%d: expected \"polygon\" or \"x_ui v\"\n",
+                    path, lineno);
+            fclose(f);
+            return -1;
+        }
+    }
+    fclose(f);
+    for (size_t k = 0; k < polys.size(); k++) {
+        if (!eye_mask_valid(polys[k], e->mask_polys.size() + k)) {
+            fprintf(stderr, "[DPI-C ERROR] eye: %s: polygon %zu rejected, mask unchanged\n",
+                    path, k + 1);
+            return -1;
+        }
+    }
+    for (const auto &poly : polys) eye_mask_add(e, poly);
+    return (int)polys.size();
+}
+
+/** DPI-C Function: dpi_eye_mask_clear - removes all mask polygons. */
+void dpi_eye_mask_clear(void *handle) {
+    EyeEngine *e = (EyeEngine *)handle;
+    e->mask_polys.clear();
+    dpi_arena_rewind(dpi_arena_of(e), e->mask_mark);
+    e->mask_map.clear();
+    e->mask_poly_hits.clear();
+    e->mask_hits = 0;
+    e->mask_state = 0;
+}
+
+/**
+ * DPI-C Function: dpi_eye_mask_align
+ *
+ * Re-centers the mask on the measured eye center (crossing mean + 0.5 UI).
+ * With search_ui > 0 it then tries every histogram column shift within
+ * ±search_ui and keeps the one with the fewest hits (nearest to the
+ * center on ties), as compliance specs that allow mask alignment do.
+ *
+ * Returns:
+ *   longint: Mask hits at the chosen position, or -1 without mask/crossings
+ */
+long long dpi_eye_mask_align(void *handle, double search_ui) {
+    EyeEngine *e = (EyeEngine *)handle;
+    if (e->mask_state == 0 || e->crossings < 100) return -1;
+    const double center = eye_center(e);
+    double best = 0.0;
+    if (search_ui > 0.0) {
+        const std::vector<uint64_t> pre = eye_column_prefix(e);
+        const int steps = (int)(search_ui * e->time_bins);
+        uint64_t best_hits = UINT64_MAX;
+        for (int d = 0; d <= steps; d++) {
+            for (int sgn = 1; sgn >= -1; sgn -= 2) {
+                const double off = sgn * (double)d / e->time_bins;
+                const uint64_t h = eye_mask_count(e, e->mask_polys, center + off, pre);
+                if (h < best_hits) {
+                    best_hits = h;
+                    best = off;
+                }
+                if (d == 0) break;
+            }
+        }
+    }
+    double origin = center + best;
+    origin -= floor(origin);
+    eye_mask_place(e, origin);
+    e->mask_offset = best;
+    return (long long)e->mask_hits;
+}
+
+/**
+ * DPI-C Function: dpi_eye_mask_recount
+ *
+ * Recounts the hits from the histogram at the current mask position
+ * (cross-check of the per-sample count).
+ */
+long long dpi_eye_mask_recount(void *handle) {
+    EyeEngine *e = (EyeEngine *)handle;
+    eye_mask_ensure(e);
+    if (e->mask_state != 2) return -1;
+    eye_mask_place(e, e->mask_origin);
+    return (long long)e->mask_hits;
+}
+
+/** DPI-C Function: dpi_eye_mask_hits - samples inside the mask so far. */
+long long dpi_eye_mask_hits(void *handle) {
+    EyeEngine *e = (EyeEngine *)handle;
+    eye_mask_ensure(e);
+    return (long long)e->mask_hits;
+}
+
+/** DPI-C Function: dpi_eye_mask_polygon_hits - hits of polygon i. */
+long long dpi_eye_mask_polygon_hits(void *handle, int i) {
+    EyeEngine *e = (EyeEngine *)handle;
+    eye_mask_ensure(e);
+    if (i < 0 || i >= (int)e->mask_poly_hits.size()) return 0;
+    return (long long)e->mask_poly_hits[i];
+}
+
+/** DPI-C Function: dpi_eye_mask_hit_ratio - mask hits / samples. */
+double dpi_eye_mask_hit_ratio(void *handle) {
+    EyeEngine *e = (EyeEngine *)handle;
+    eye_mask_ensure(e);
+    return e->samples ? (double)e->mask_hits / (double)e->samples : 0.0;
+}
+
+/** DPI-C Function: dpi_eye_mask_offset - alignment shift from the eye center (UI). */
+double dpi_eye_mask_offset(void *handle) {
+    return ((EyeEngine *)handle)->mask_offset;
+}
+
+/**
+ * DPI-C Function: dpi_eye_mask_margin
+ *
+ * Mask margin (%): bisection for the largest scale s with hits <=
+ * max_hit_ratio × samples at the current alignment; returns (s - 1) × 100.
+ * Positive = the mask could grow by that much and still pass.
+ */
+double dpi_eye_mask_margin(void *handle, double max_hit_ratio) {
+    EyeEngine *e = (EyeEngine *)handle;
+    eye_mask_ensure(e);
+    if (e->mask_state != 2) return 0.0;
+    const std::vector<uint64_t> pre = eye_column_prefix(e);
+    const uint64_t allowed = (uint64_t)(max_hit_ratio * (double)e->samples);
+    double lo = 0.0, hi = EYE_MASK_MAX_SCALE;
+    if (eye_mask_count(e, eye_mask_scaled(e, hi), e->mask_origin, pre) <= allowed) lo = hi;
+    for (int i = 0; i < 40 && hi - lo > 1e-4; i++) {
+        const double mid = 0.5 * (lo + hi);
+        if (eye_mask_count(e, eye_mask_scaled(e, mid), e->mask_origin, pre) <= allowed) lo = mid;
+        else hi = mid;
+    }
+    return (lo - 1.0) * 100.0;
+}
+
+/**
+ * DPI-C Function: dpi_eye_save / dpi_eye_restore
+ *
+ * Checkpoint the whole engine (histograms, fits, mask) to a file and
+ * restore it into the same engine instance later in the run.
+ *
+ * Returns:
+ *   int: 0 on success, -1 on error
+ */
+int dpi_eye_save(void *handle, const char *path) {
+    return dpi_arena_save_file(handle, path, "dpi_eye_save");
+}
+
+int dpi_eye_restore(void *handle, const char *path) {
+    return dpi_arena_restore_file(handle, path, "dpi_eye_restore");
+}
+
+/** DPI-C Function: dpi_eye_destroy */
+void dpi_eye_destroy(void *handle) {
+    dpi_arena_delete((EyeEngine *)handle);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * =============================================================================
+ * IMPLEMENTATION NOTES
+ * =============================================================================
+ *
+ * 1. Dual-Dirac Model:
+ *    - Each tail = ρ · Gaussian(σ) centred on a Dirac at μ
+ *    - Horizontal: the late tail of the left crossing (μ_L, σ_L) and the
+ *      early tail of the right crossing (1 UI + μ_R, σ_R) close the eye;
+ *      DJ(δδ) = μ_L - μ_R, RJ = (σ_L + σ_R) / 2
+ *    - BER(t) = D_T · [ρ_L Φc((t-μ_L)/σ_L) + ρ_R Φc((1+μ_R-t)/σ_R)]
+ *      with D_T = crossings per UI (transition density)
+ *    - Width(BER) = (1 + μ_R - σ_R·Q(BER/(D_T ρ_R))) - (μ_L + σ_L·Q(BER/(D_T ρ_L)))
+ *
+ * 2. Q-Scale Fit:
+ *    - Tail points with >= 8 hits and Q(p/ρ) >= 1 are fitted by least
+ *      squares x = μ ± σ·Q(p/ρ); ρ is optimized on a log grid 0.01..1
+ *    - ρ and σ are only separable with enough tail depth: plan on >= 1e5
+ *      crossings (a 1e7-bit run has ~5e6) for a stable RJ
+ *    - A run of 1e7 bits resolves tails to ~1e-6; the Gaussian tail model
+ *      carries that to 1e-12 / 1e-15 (Q = 7.03 / 7.94)
+ *    - Bounded non-Gaussian jitter (sinusoidal PJ, DCD) is absorbed into μ
+ *      as long as the fitted region lies beyond it
+ *
+ * 3. Vertical Analysis:
+ *    - Uses the 2D column at crossing + 0.5 UI. Samples above vref are "1"
+ *      and below are "0" (valid while the measured eye is open)
+ *    - For PAM4 create one engine per eye with vref at each threshold and
+ *      v_min/v_max spanning the two adjacent levels
+ *
+ * 4. Eye Mask:
+ *    - Polygons are in (UI from the eye center, V). The raster holds the
+ *      polygon index per 2D bin (bin center inside), so a sample costs one
+ *      byte lookup; hits are exact at the histogram resolution
+ *    - Alignment moves the whole mask horizontally; re-placing it recounts
+ *      the hits from the histogram, so no sample is lost or counted twice
+ *    - Margin: polygons containing (0, vref) scale about it; the others
+ *      (amplitude limits) move toward vref by the same absolute amount.
+ *      Bisection assumes hits grow with the scale (true for convex inner
+ *      masks); each step is one scanline pass over column prefix sums
+ *    - Overlapping polygons: the raster credits the first polygon, the
+ *      margin search counts each
+ *
+ * 5. Memory:
+ *    - 2D: time_bins × v_bins × 4 bytes (64 × 1024 = 256 KB)
+ *    - Crossing histogram: 4096 × 8 bytes
+ *    - Mask raster: time_bins × v_bins bytes
+ *    - Mask outlines: up to 255 polygons × EYE_MASK_MAX_POINTS vertices,
+ *      in the arena above a mark; dpi_eye_mask_clear rewinds to it, so
+ *      loading and clearing masks never grows the arena
+ *
+ * 6. Verilator Compilation:
+ *    - Add to test_config.yaml:
+ *      verilator_extra_flags:
+ *        - ../dpi/dpi_eye.cpp
+ *
+ * =============================================================================
+ */
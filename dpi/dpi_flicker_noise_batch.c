@@ -5,11 +5,13 @@
  * - Loads pre-generated noise samples from binary file at initialization
  * - Returns samples sequentially on each call
  * - Achieves exact sample-by-sample matching with Python reference
+ * - Samples stay in the file's precision (float64, float32 or int16) and
+ *   are converted to double only when returned to SystemVerilog
  *
  * Key Differences from Streaming Version (dpi_flicker_noise.c):
  * - Algorithm: Pre-loaded from file (vs computed on-the-fly)
  * - State: 4096-element array + index (vs 10 noise sources + counter)
- * - Memory: ~32 KB (vs ~80 bytes)
+ * - Memory: 8-32 KB by precision (vs ~80 bytes)
  * - Computation: O(1) per call (vs O(10) per call)
  * - Match: Exact sample-by-sample (vs statistical only)
  *
@@ -17,6 +19,7 @@
  * Date: 2025
  */
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -31,14 +34,47 @@ extern "C" {
 #define MAX_SAMPLES 4096
 #define NOISE_DATA_FILE "dpi/flicker_noise_batch.bin"
 
+// Sample file header (scripts/sample_format.py); files without it are the
+// original headerless float64 array
+#define SAMPLE_MAGIC "DPISAMP1"
+#define SAMPLE_F64 0
+#define SAMPLE_F32 1
+#define SAMPLE_I16 2
+#define SAMPLE_DEFAULT_TOL 1e-3       // Precision error RMS / signal RMS (DPI_SAMPLE_TOL)
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t dtype;                   // SAMPLE_F64 / SAMPLE_F32 / SAMPLE_I16
+    uint64_t count;
+    double scale;                     // value = stored × scale
+    double rms;                       // RMS of the float64 source
+    double err_rms;                   // RMS of (stored - source)
+    double err_max;                   // max |stored - source|
+} SampleHeader;
+
 //==============================================================================
 // STATIC STATE (persists between DPI-C calls)
 //==============================================================================
-static double preloaded_noise[MAX_SAMPLES];  // Pre-loaded noise array
+static void *preloaded_noise = NULL;          // Pre-loaded noise, stored precision
+static int sample_type = SAMPLE_F64;          // Stored precision
+static double sample_scale = 1.0;             // int16 LSB value
 static int current_index = 0;                 // Current read index
 static int initialized = 0;                   // Initialization flag
 static int num_samples_loaded = 0;            // Actual samples loaded from file
 
+static const char *const sample_type_name[] = {"float64", "float32", "int16"};
+static const size_t sample_type_size[] = {sizeof(double), sizeof(float), sizeof(int16_t)};
+
+/** Stored sample i as double (the only conversion, at the SV boundary). */
+static inline double sample_at(int i) {
+    switch (sample_type) {
+    case SAMPLE_F32: return (double)((const float *)preloaded_noise)[i];
+    case SAMPLE_I16: return ((const int16_t *)preloaded_noise)[i] * sample_scale;
+    default:         return ((const double *)preloaded_noise)[i];
+    }
+}
+
 //==============================================================================
 // INITIALIZATION FUNCTION
 //==============================================================================
@@ -46,16 +82,25 @@ static int num_samples_loaded = 0;            // Actual samples loaded from file
  * Load noise samples from binary file.
  * Called automatically on first invocation of dpi_flicker_noise_batch().
  *
- * Binary Format:
- * - Data type: IEEE 754 double precision (8 bytes per sample)
+ * Binary Format (scripts/sample_format.py):
+ * - SampleHeader (56 bytes), then count samples of dtype: float64,
+ *   float32, or int16 scaled by header.scale
+ * - Legacy: no header, raw double array (MAX_SAMPLES × 8 = 32,768 bytes)
  * - Byte order: Native (little-endian on x86/ARM)
- * - Size: MAX_SAMPLES × 8 = 32,768 bytes
- * - No header, just raw double array
+ * - The table is allocated for the stored type and count, so a float32 /
+ *   int16 file halves / quarters the memory as well as the file
  *
  * Error Handling:
  * - File not found: Prints error, fills with zeros (fallback)
  * - Partial read: Prints warning, uses available samples
- * - Both cases set initialized=1 to prevent repeated attempts
+ * - Unknown sample type: Prints error, falls back to zeros
+ * - Allocation failure: Prints error, returns zeros (no samples loaded)
+ * - All cases set initialized=1 to prevent repeated attempts
+ *
+ * Accuracy Guard:
+ * - The header records the precision error of the stored samples against
+ *   the float64 source; above DPI_SAMPLE_TOL (relative to the source RMS,
+ *   default SAMPLE_DEFAULT_TOL) a warning is printed
  */
 static void init_flicker_noise_batch() {
     FILE *f = fopen(NOISE_DATA_FILE, "rb");
@@ -72,14 +117,44 @@ static void init_flicker_noise_batch() {
         fprintf(stderr, "========================================\n");
 
         // Fill with zeros as fallback
-        memset(preloaded_noise, 0, sizeof(preloaded_noise));
-        num_samples_loaded = MAX_SAMPLES;
+        preloaded_noise = calloc(MAX_SAMPLES, sizeof(double));
+        sample_type = SAMPLE_F64;
+        num_samples_loaded = preloaded_noise ? MAX_SAMPLES : 0;
         initialized = 1;
         return;
     }
 
-    // Read binary data (IEEE 754 double precision)
-    num_samples_loaded = fread(preloaded_noise, sizeof(double), MAX_SAMPLES, f);
+    // Header (sample type, scale, precision error) or legacy raw doubles
+    SampleHeader hdr;
+    size_t expected = MAX_SAMPLES;
+    int has_header = fread(&hdr, sizeof(hdr), 1, f) == 1 &&
+                     memcmp(hdr.magic, SAMPLE_MAGIC, sizeof(hdr.magic)) == 0;
+    if (has_header) {
+        if (hdr.dtype > SAMPLE_I16) {
+            fprintf(stderr, "[DPI-C ERROR] %s: unknown sample type %u, using zeros\n",
+                    NOISE_DATA_FILE, (unsigned)hdr.dtype);
+            fclose(f);
+            preloaded_noise = calloc(MAX_SAMPLES, sizeof(double));
+            sample_type = SAMPLE_F64;
+            num_samples_loaded = preloaded_noise ? MAX_SAMPLES : 0;
+            initialized = 1;
+            return;
+        }
+        sample_type = (int)hdr.dtype;
+        sample_scale = hdr.scale;
+        if (hdr.count < expected) expected = (size_t)hdr.count;
+    } else {
+        rewind(f);
+        sample_type = SAMPLE_F64;
+        sample_scale = 1.0;
+    }
+    preloaded_noise = malloc(expected * sample_type_size[sample_type]);
+    if (preloaded_noise == NULL && expected > 0) {
+        fprintf(stderr, "[DPI-C ERROR] %s: cannot allocate %zu samples, using zeros\n",
+                NOISE_DATA_FILE, expected);
+    }
+    num_samples_loaded = preloaded_noise ?
+        (int)fread(preloaded_noise, sample_type_size[sample_type], expected, f) : 0;
     fclose(f);
 
     // Check if we got all expected samples
@@ -97,12 +172,34 @@ static void init_flicker_noise_batch() {
         // Success message
         fprintf(stderr, "[DPI-C INFO] Loaded %d noise samples from %s (%.1f KB)\n",
                 num_samples_loaded, NOISE_DATA_FILE,
-                (num_samples_loaded * sizeof(double)) / 1024.0);
+                (num_samples_loaded * sample_type_size[sample_type]) / 1024.0);
+        fprintf(stderr, "[DPI-C INFO] Sample precision: %s%s\n", sample_type_name[sample_type],
+                has_header ? "" : " (legacy file, no header)");
+
+        // Accuracy guard: precision error recorded by the generator
+        if (has_header && hdr.rms > 0.0) {
+            const char *env = getenv("DPI_SAMPLE_TOL");
+            const double tol = env ? strtod(env, NULL) : SAMPLE_DEFAULT_TOL;
+            const double rel = hdr.err_rms / hdr.rms;
+            fprintf(stderr, "[DPI-C INFO] Precision error: RMS %.3e (%.2e of signal RMS), "
+                    "max %.3e\n", hdr.err_rms, rel, hdr.err_max);
+            if (rel > tol) {
+                fprintf(stderr, "\n");
+                fprintf(stderr, "========================================\n");
+                fprintf(stderr, "WARNING: Sample precision exceeds tolerance\n");
+                fprintf(stderr, "========================================\n");
+                fprintf(stderr, "%s error is %.2e of the signal RMS (tolerance %.0e)\n",
+                        sample_type_name[sample_type], rel, tol);
+                fprintf(stderr, "Results may differ from the float64 reference.\n");
+                fprintf(stderr, "Re-run with: --precision float32 (or float64)\n");
+                fprintf(stderr, "========================================\n");
+            }
+        }
 
         // Debug: Print first 10 samples for verification
         fprintf(stderr, "[DPI-C DEBUG] First 10 samples from binary:\n");
         for (int i = 0; i < 10 && i < num_samples_loaded; i++) {
-            fprintf(stderr, "  [%3d] %11.6f\n", i, preloaded_noise[i]);
+            fprintf(stderr, "  [%3d] %11.6f\n", i, sample_at(i));
         }
     }
 
@@ -145,13 +242,18 @@ double dpi_flicker_noise_batch(void) {
         init_flicker_noise_batch();
     }
 
+    // Nothing loaded (allocation failed or empty file)
+    if (num_samples_loaded == 0) {
+        return 0.0;
+    }
+
     // Wrap index if exceeded (loop back to beginning)
     if (current_index >= num_samples_loaded) {
         current_index = 0;
     }
 
-    // Return current sample and advance index
-    return preloaded_noise[current_index++];
+    // Return current sample (converted to double) and advance index
+    return sample_at(current_index++);
 }
 
 /**
@@ -195,17 +297,18 @@ double dpi_flicker_noise(void) {
  *    |--------------------|------------------------|------------------------|
  *    | Algorithm          | Voss-McCartney compute | Pre-loaded from file   |
  *    | State              | 10 sources + counter   | 4096 array + index     |
- *    | Memory             | ~80 bytes              | ~32 KB                 |
+ *    | Memory             | ~80 bytes              | 8-32 KB (by precision) |
  *    | Per-call compute   | O(10) - sum sources    | O(1) - array lookup    |
  *    | RNG                | C rand()               | Python reference       |
  *    | Match with Python  | Statistical only       | Exact sample-by-sample |
  *
  * 2. Binary File Format:
- *    - Generated by: scripts/generate_flicker_noise_batch.py
- *    - Format: IEEE 754 double precision (8 bytes per sample)
+ *    - Generated by: scripts/generate_flicker_noise_batch.py [--precision P]
+ *    - Written / read by scripts/sample_format.py: 56-byte SampleHeader,
+ *      then float64 (8 B), float32 (4 B) or int16 (2 B, × scale) samples
  *    - Byte order: Native (little-endian on x86/ARM)
- *    - Total size: 4096 × 8 = 32,768 bytes
- *    - No header, just contiguous double array
+ *    - Total size: 56 + 4096 × {8, 4, 2} = 32,824 / 16,440 / 8,248 bytes
+ *    - Headerless files (4096 × 8 = 32,768 bytes of doubles) still load
  *
  * 3. File Path:
  *    - Relative path: dpi/flicker_noise_batch.bin
@@ -215,7 +318,8 @@ double dpi_flicker_noise(void) {
  * 4. Error Handling:
  *    - File not found: Fallback to zeros, print clear error message
  *    - Partial read: Use available samples, print warning
- *    - Both cases allow simulation to continue (graceful degradation)
+ *    - No samples at all (empty file, allocation failure): returns 0.0
+ *    - All cases allow simulation to continue (graceful degradation)
  *
  * 5. Index Wrapping:
  *    - When current_index >= num_samples_loaded, wrap to 0
@@ -249,11 +353,23 @@ double dpi_flicker_noise(void) {
  *
  * 10. Debugging:
  *     - If "Cannot open file" error:
- *       Check: ls -lh dpi/flicker_noise_batch.bin (should be 32,768 bytes)
+ *       Check: ls -lh dpi/flicker_noise_batch.bin (sizes in note 2)
  *     - If verification fails:
  *       Check: Binary file was generated with same SEED and SAMPLES
  *     - If partial read warning:
  *       Re-generate binary file (may be corrupted)
  *
+ *
+ * 11. Sample Precision:
+ *     - float32 (~-150 dB) and int16 full-scale (~-90 dB re RMS for this
+ *       noise) are far below what the amplifier model resolves, and halve
+ *       or quarter the table. The table is malloc'ed for the file's sample
+ *       type and count (32 / 16 / 8 KB for 4096 samples), so the memory
+ *       shrinks with the file; the zero fallback is a float64 table
+ *     - The conversion to double happens in sample_at(), i.e. at the DPI
+ *       return: SV always sees real
+ *     - verify_noise_match_batch.py compares exactly against the stored
+ *       (quantized) samples and checks the float64 reference separately
+ *
  * =============================================================================
  */
@@ -0,0 +1,546 @@
+/**
+ * dpi_gearbox.cpp - DPI-C Serializer/Deserializer Gearbox (M:N Bit Packing)
+ *
+ * Word-level replacement for the serializer (§2.1.3) and deserializer
+ * (§3.1.5). Shifting one bit per serial clock is the most expensive thing a
+ * SerDes RTL simulation does; here the serial stream lives in a bit FIFO of
+ * 64-bit words and every push/pop moves a whole parallel word with two
+ * shifts, so the RTL only ever sees parallel words.
+ *
+ * Features:
+ * - Any M:N width ratio (1..64 bits each side), e.g. 32:40, 64:10, 66:64
+ * - LSB-first (PCIe) or MSB-first serial bit order per gearbox
+ * - PAM4 symbol packing: words <-> level indices (0..3), optional Gray
+ *   coding; MSB/LSB bit planes split/merged with BMI2 PEXT/PDEP
+ * - Serial-domain stage that exists only inside the model: symbol errors
+ *   at a given SER (adjacent-level for PAM4) and RX bit slip
+ * - Streaming (one word per call) and block APIs
+ *
+ * Author: Generated for SerDes parallel/serial conversion
+ * Date: 2025
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "dpi_alloc.h"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+//==============================================================================
+// CONFIGURATION
+//==============================================================================
+#define GB_FIFO_WORDS   1024            // Bit FIFO capacity (64-bit words, power of 2)
+#define GB_FIFO_BITS    ((uint64_t)GB_FIFO_WORDS * 64)
+#define GB_MAX_WIDTH    64
+#define GB_EVEN_BITS    0x5555555555555555ULL  // PAM4 symbol MSBs (first bit sent)
+#define GB_NO_ERROR     UINT64_MAX
+
+//==============================================================================
+// ENGINE STATE
+//==============================================================================
+struct Gearbox {
+    int in_width;
+    int out_width;
+    int msb_first;
+
+    // Serial stream: bit p (absolute) at buf[(p >> 6) & mask], bit p & 63
+    dpi_vector<uint64_t> buf{DpiAllocator<uint64_t>("gearbox.fifo")};
+    uint64_t head;              // Next bit to pop
+    uint64_t tail;              // Next bit to push
+
+    // Serial-domain stage
+    int pam;                    // 2 or 4
+    int bps;                    // Bits per symbol
+    int gray;
+    double ser;
+    uint64_t rng;
+    uint64_t next_error;        // Absolute symbol index of the next error
+
+    long long words_in;
+    long long words_out;
+    long long symbol_errors;
+    long long bit_errors;
+    long long slipped;
+};
+
+//==============================================================================
+// BIT MANIPULATION
+//==============================================================================
+static inline uint64_t low_mask(int k) {
+    return (k >= 64) ? ~0ULL : ((1ULL << k) - 1);
+}
+
+/** Reverse the low k bits of v. */
+static inline uint64_t reverse_bits(uint64_t v, int k) {
+    v = __builtin_bswap64(v);
+    v = ((v >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((v & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    v = ((v >> 2) & 0x3333333333333333ULL) | ((v & 0x3333333333333333ULL) << 2);
+    v = ((v >> 1) & 0x5555555555555555ULL) | ((v & 0x5555555555555555ULL) << 1);
+    return v >> (64 - k);
+}
+
+/** Gather the even bits of w into 32 contiguous bits (PEXT with 0x55..). */
+static inline uint32_t pack_even(uint64_t w) {
+#if defined(__BMI2__)
+    return (uint32_t)_pext_u64(w, GB_EVEN_BITS);
+#else
+    w &= GB_EVEN_BITS;
+    w = (w | (w >> 1)) & 0x3333333333333333ULL;
+    w = (w | (w >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+    w = (w | (w >> 4)) & 0x00FF00FF00FF00FFULL;
+    w = (w | (w >> 8)) & 0x0000FFFF0000FFFFULL;
+    w = (w | (w >> 16)) & 0x00000000FFFFFFFFULL;
+    return (uint32_t)w;
+#endif
+}
+
+/** Scatter 32 bits onto the even bit positions (PDEP with 0x55..). */
+static inline uint64_t spread_even(uint32_t p) {
+#if defined(__BMI2__)
+    return _pdep_u64(p, GB_EVEN_BITS);
+#else
+    uint64_t w = p;
+    w = (w | (w << 16)) & 0x0000FFFF0000FFFFULL;
+    w = (w | (w << 8)) & 0x00FF00FF00FF00FFULL;
+    w = (w | (w << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    w = (w | (w << 2)) & 0x3333333333333333ULL;
+    w = (w | (w << 1)) & GB_EVEN_BITS;
+    return w;
+#endif
+}
+
+/** Split 32 PAM4 symbols (bit 2i = MSB, 2i+1 = LSB) into bit planes. */
+static inline void pam4_split(uint64_t w, uint32_t *msb, uint32_t *lsb) {
+    *msb = pack_even(w);
+    *lsb = pack_even(w >> 1);
+}
+
+static inline uint64_t pam4_merge(uint32_t msb, uint32_t lsb) {
+    return spread_even(msb) | (spread_even(lsb) << 1);
+}
+
+//==============================================================================
+// BIT FIFO
+//==============================================================================
+static inline void fifo_write(Gearbox *g, uint64_t v, int k) {
+    const uint64_t mask = GB_FIFO_WORDS - 1;
+    const uint64_t w = (g->tail >> 6) & mask;
+    const int off = (int)(g->tail & 63);
+    v &= low_mask(k);
+    // Keep the bits around the written field: within 64 bits of full, the
+    // rest of the tail word and the spill word still hold unread head bits
+    g->buf[w] = (g->buf[w] & ~(low_mask(k) << off)) | (v << off);
+    if (off + k > 64) {
+        uint64_t &spill = g->buf[(w + 1) & mask];
+        spill = (spill & ~low_mask(off + k - 64)) | (v >> (64 - off));
+    }
+    g->tail += (uint64_t)k;
+}
+
+static inline uint64_t fifo_read(const Gearbox *g, uint64_t pos, int k) {
+    const uint64_t mask = GB_FIFO_WORDS - 1;
+    const uint64_t w = (pos >> 6) & mask;
+    const int off = (int)(pos & 63);
+    uint64_t r = g->buf[w] >> off;
+    if (off + k > 64) r |= g->buf[(w + 1) & mask] << (64 - off);
+    return r & low_mask(k);
+}
+
+/** Overwrite k bits at an absolute position already in the FIFO. */
+static inline void fifo_patch(Gearbox *g, uint64_t pos, uint64_t v, int k) {
+    const uint64_t mask = GB_FIFO_WORDS - 1;
+    for (int i = 0; i < k; i++, pos++) {
+        const uint64_t bit = 1ULL << (pos & 63);
+        uint64_t &word = g->buf[(pos >> 6) & mask];
+        word = ((v >> i) & 1) ? (word | bit) : (word & ~bit);
+    }
+}
+
+/** Bits that may be popped: whole symbols only, so errors land before reads. */
+static inline uint64_t fifo_available(const Gearbox *g) {
+    const uint64_t end = g->tail - g->tail % (uint64_t)g->bps;
+    return (end > g->head) ? end - g->head : 0;
+}
+
+//==============================================================================
+// SERIAL-DOMAIN STAGE
+//==============================================================================
+static inline double gb_uniform(Gearbox *g) {
+    // xorshift64*, 53-bit mantissa in (0, 1)
+    g->rng ^= g->rng >> 12;
+    g->rng ^= g->rng << 25;
+    g->rng ^= g->rng >> 27;
+    return ((double)((g->rng * 0x2545F4914F6CDD1DULL) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+/** Geometric gap to the next symbol error (>= 1). */
+static inline uint64_t gb_error_gap(Gearbox *g) {
+    if (g->ser <= 0.0) return GB_NO_ERROR;
+    if (g->ser >= 1.0) return 1;
+    return (uint64_t)(std::log(gb_uniform(g)) / std::log1p(-g->ser)) + 1;
+}
+
+/** Bits of one symbol (first bit sent in bit 0 = PAM4 MSB) -> level index. */
+static inline int bits_to_level(const Gearbox *g, int bits) {
+    if (g->bps == 1) return bits;
+    const int msb = bits & 1;
+    const int lsb = (bits >> 1) & 1;
+    return (msb << 1) | (g->gray ? (msb ^ lsb) : lsb);
+}
+
+static inline int level_to_bits(const Gearbox *g, int level) {
+    if (g->bps == 1) return level;
+    const int msb = level >> 1;
+    const int lsb = g->gray ? ((level & 1) ^ msb) : (level & 1);
+    return msb | (lsb << 1);
+}
+
+/** Apply every pending symbol error whose bits are now in the FIFO. */
+static void gb_serial_stage(Gearbox *g) {
+    const uint64_t complete = g->tail / (uint64_t)g->bps;
+    while (g->next_error != GB_NO_ERROR && g->next_error < complete) {
+        const uint64_t pos = g->next_error * (uint64_t)g->bps;
+        if (pos >= g->head) {
+            const int old_bits = (int)fifo_read(g, pos, g->bps);
+            int level = bits_to_level(g, old_bits);
+            // Adjacent-level decision error; outer levels can only move inward
+            if (level == 0) level = 1;
+            else if (level == g->pam - 1) level = g->pam - 2;
+            else level += (gb_uniform(g) < 0.5) ? -1 : 1;
+            const int new_bits = level_to_bits(g, level);
+            fifo_patch(g, pos, (uint64_t)new_bits, g->bps);
+            g->symbol_errors++;
+            g->bit_errors += __builtin_popcount(old_bits ^ new_bits);
+        }
+        const uint64_t gap = gb_error_gap(g);
+        g->next_error = (gap == GB_NO_ERROR) ? GB_NO_ERROR : g->next_error + gap;
+    }
+}
+
+static int gb_push(Gearbox *g, uint64_t word) {
+    if (g->tail - g->head + (uint64_t)g->in_width > GB_FIFO_BITS) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_gearbox_push: FIFO overflow (%llu bits queued)\n",
+                (unsigned long long)(g->tail - g->head));
+        return -1;
+    }
+    if (g->msb_first) word = reverse_bits(word, g->in_width);
+    fifo_write(g, word, g->in_width);
+    gb_serial_stage(g);
+    g->words_in++;
+    return 0;
+}
+
+static int gb_pop(Gearbox *g, uint64_t *word) {
+    if (fifo_available(g) < (uint64_t)g->out_width) return 0;
+    uint64_t w = fifo_read(g, g->head, g->out_width);
+    g->head += (uint64_t)g->out_width;
+    *word = g->msb_first ? reverse_bits(w, g->out_width) : w;
+    g->words_out++;
+    return 1;
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// DPI-C EXPORTED FUNCTIONS
+//==============================================================================
+
+/**
+ * DPI-C Function: dpi_gearbox_create
+ *
+ * Args:
+ *   in_width:  Parallel width on the push side (bits, 1..64)
+ *   out_width: Parallel width on the pop side (bits, 1..64)
+ *   msb_first: 0 = bit 0 of each word is sent first (PCIe), 1 = MSB first
+ *
+ * Returns:
+ *   Gearbox handle, or NULL on invalid widths
+ */
+void *dpi_gearbox_create(int in_width, int out_width, int msb_first) {
+    if (in_width < 1 || in_width > GB_MAX_WIDTH || out_width < 1 || out_width > GB_MAX_WIDTH) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_gearbox_create: widths must be 1..%d (got %d:%d)\n",
+                GB_MAX_WIDTH, in_width, out_width);
+        return NULL;
+    }
+    // Declared needs: engine + the bit FIFO
+    Gearbox *g = dpi_arena_new<Gearbox>(
+        dpi_arena_need<Gearbox>() + dpi_arena_need<uint64_t>(GB_FIFO_WORDS), "gearbox");
+    g->in_width = in_width;
+    g->out_width = out_width;
+    g->msb_first = msb_first ? 1 : 0;
+    g->buf.assign(GB_FIFO_WORDS, 0);
+    g->pam = 2;
+    g->bps = 1;
+    g->rng = 0x9E3779B97F4A7C15ULL;
+    g->next_error = GB_NO_ERROR;
+    return g;
+}
+
+/**
+ * DPI-C Function: dpi_gearbox_set_serial
+ *
+ * Configure the serial-domain stage between push and pop.
+ *
+ * Args:
+ *   pam:  2 (NRZ) or 4 (PAM4, 2 bits per symbol, first bit = symbol MSB)
+ *   gray: 1 = Gray-coded PAM4 levels (00, 01, 11, 10)
+ *   ser:  Symbol error rate (0 = error-free); PAM4 errors move one level
+ *   seed: RNG seed for error placement
+ *
+ * Returns:
+ *   0 on success, -1 on invalid arguments
+ */
+int dpi_gearbox_set_serial(void *handle, int pam, int gray, double ser, int seed) {
+    Gearbox *g = (Gearbox *)handle;
+    if ((pam != 2 && pam != 4) || ser < 0.0 || ser > 1.0) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_gearbox_set_serial: pam must be 2 or 4, ser in [0, 1]\n");
+        return -1;
+    }
+    g->pam = pam;
+    g->bps = (pam == 4) ? 2 : 1;
+    g->gray = gray ? 1 : 0;
+    g->ser = ser;
+    g->rng = 0x9E3779B97F4A7C15ULL ^ ((uint64_t)(uint32_t)seed * 0xD1B54A32D192ED03ULL);
+    if (g->rng == 0) g->rng = 1;
+    // Errors start at the first symbol not yet complete in the FIFO
+    const uint64_t gap = gb_error_gap(g);
+    g->next_error = (gap == GB_NO_ERROR) ? GB_NO_ERROR
+                                         : g->tail / (uint64_t)g->bps + gap - 1;
+    return 0;
+}
+
+/** DPI-C Function: dpi_gearbox_push - append one in_width word (0, -1 on overflow). */
+int dpi_gearbox_push(void *handle, long long word) {
+    return gb_push((Gearbox *)handle, (uint64_t)word);
+}
+
+/**
+ * DPI-C Function: dpi_gearbox_pop
+ *
+ * Returns:
+ *   1 and the next out_width word in *word, or 0 if not enough bits queued
+ */
+int dpi_gearbox_pop(void *handle, long long *word) {
+    uint64_t w = 0;
+    const int ok = gb_pop((Gearbox *)handle, &w);
+    *word = (long long)w;
+    return ok;
+}
+
+/** DPI-C Function: dpi_gearbox_push_block - push n words (n, -1 on overflow). */
+int dpi_gearbox_push_block(void *handle, const long long *words, int n) {
+    Gearbox *g = (Gearbox *)handle;
+    for (int i = 0; i < n; i++) {
+        if (gb_push(g, (uint64_t)words[i]) != 0) return -1;
+    }
+    return n;
+}
+
+/** DPI-C Function: dpi_gearbox_pop_block - pop up to max words, returns count. */
+int dpi_gearbox_pop_block(void *handle, long long *words, int max) {
+    Gearbox *g = (Gearbox *)handle;
+    int n = 0;
+    uint64_t w;
+    while (n < max && gb_pop(g, &w)) words[n++] = (long long)w;
+    return n;
+}
+
+/**
+ * DPI-C Function: dpi_gearbox_pop_symbols
+ *
+ * Pop n serial symbols as level indices (NRZ 0/1, PAM4 0..3) for a DAC /
+ * channel model. PAM4 is unpacked 32 symbols per 64-bit read via bit planes.
+ *
+ * Returns:
+ *   Number of symbols written (less than n if the FIFO runs short)
+ */
+int dpi_gearbox_pop_symbols(void *handle, int *symbols, int n) {
+    Gearbox *g = (Gearbox *)handle;
+    const uint64_t avail = fifo_available(g) / (uint64_t)g->bps;
+    if ((uint64_t)n > avail) n = (int)avail;
+    int i = 0;
+    if (g->bps == 2) {
+        for (; i + 32 <= n; i += 32) {
+            uint32_t msb, lsb;
+            pam4_split(fifo_read(g, g->head, 64), &msb, &lsb);
+            if (g->gray) lsb ^= msb;
+            for (int s = 0; s < 32; s++)
+                symbols[i + s] = (int)((((msb >> s) & 1) << 1) | ((lsb >> s) & 1));
+            g->head += 64;
+        }
+    }
+    for (; i < n; i++) {
+        symbols[i] = bits_to_level(g, (int)fifo_read(g, g->head, g->bps));
+        g->head += (uint64_t)g->bps;
+    }
+    return n;
+}
+
+/**
+ * DPI-C Function: dpi_gearbox_push_symbols
+ *
+ * Append n slicer decisions (level indices) to the serial stream, the RX
+ * counterpart of dpi_gearbox_pop_symbols().
+ *
+ * Returns:
+ *   n on success, -1 on FIFO overflow
+ */
+int dpi_gearbox_push_symbols(void *handle, const int *symbols, int n) {
+    Gearbox *g = (Gearbox *)handle;
+    if (g->tail - g->head + (uint64_t)n * g->bps > GB_FIFO_BITS) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_gearbox_push_symbols: FIFO overflow\n");
+        return -1;
+    }
+    int i = 0;
+    if (g->bps == 2) {
+        for (; i + 32 <= n; i += 32) {
+            uint32_t msb = 0, lsb = 0;
+            for (int s = 0; s < 32; s++) {
+                msb |= (uint32_t)((symbols[i + s] >> 1) & 1) << s;
+                lsb |= (uint32_t)(symbols[i + s] & 1) << s;
+            }
+            if (g->gray) lsb ^= msb;
+            fifo_write(g, pam4_merge(msb, lsb), 64);
+        }
+    }
+    for (; i < n; i++) fifo_write(g, (uint64_t)level_to_bits(g, symbols[i] & (g->pam - 1)), g->bps);
+    gb_serial_stage(g);
+    return n;
+}
+
+/**
+ * DPI-C Function: dpi_gearbox_slip
+ *
+ * Drop nbits from the head of the serial stream (RX word-alignment slip).
+ *
+ * Returns:
+ *   Number of bits dropped
+ */
+int dpi_gearbox_slip(void *handle, int nbits) {
+    Gearbox *g = (Gearbox *)handle;
+    const uint64_t queued = g->tail - g->head;
+    const uint64_t n = (nbits < 0) ? 0 : ((uint64_t)nbits > queued ? queued : (uint64_t)nbits);
+    g->head += n;
+    g->slipped += (long long)n;
+    return (int)n;
+}
+
+/** DPI-C Function: dpi_gearbox_level - bits currently queued. */
+int dpi_gearbox_level(void *handle) {
+    Gearbox *g = (Gearbox *)handle;
+    return (int)(g->tail - g->head);
+}
+
+/** DPI-C Function: dpi_gearbox_words_in - words pushed so far. */
+long long dpi_gearbox_words_in(void *handle) {
+    return ((Gearbox *)handle)->words_in;
+}
+
+/** DPI-C Function: dpi_gearbox_words_out - words popped so far. */
+long long dpi_gearbox_words_out(void *handle) {
+    return ((Gearbox *)handle)->words_out;
+}
+
+/** DPI-C Function: dpi_gearbox_symbol_errors - symbols corrupted by the serial stage. */
+long long dpi_gearbox_symbol_errors(void *handle) {
+    return ((Gearbox *)handle)->symbol_errors;
+}
+
+/** DPI-C Function: dpi_gearbox_bit_errors - bits flipped by the serial stage. */
+long long dpi_gearbox_bit_errors(void *handle) {
+    return ((Gearbox *)handle)->bit_errors;
+}
+
+/** DPI-C Function: dpi_gearbox_reset - empty the FIFO and clear counters. */
+void dpi_gearbox_reset(void *handle) {
+    Gearbox *g = (Gearbox *)handle;
+    g->head = g->tail = 0;
+    g->words_in = g->words_out = 0;
+    g->symbol_errors = g->bit_errors = g->slipped = 0;
+    const uint64_t gap = gb_error_gap(g);
+    g->next_error = (gap == GB_NO_ERROR) ? GB_NO_ERROR : gap - 1;
+}
+
+/** DPI-C Function: dpi_gearbox_destroy */
+void dpi_gearbox_destroy(void *handle) {
+    dpi_arena_delete((Gearbox *)handle);
+}
+
+/**
+ * DPI-C Function: dpi_pam4_split
+ *
+ * Split 32 packed PAM4 symbols (bit 2i = MSB, bit 2i+1 = LSB of symbol i)
+ * into MSB and LSB planes, e.g. for separate MSB/LSB slicer paths.
+ */
+void dpi_pam4_split(long long word, int *msb_plane, int *lsb_plane) {
+    uint32_t msb, lsb;
+    pam4_split((uint64_t)word, &msb, &lsb);
+    *msb_plane = (int)msb;
+    *lsb_plane = (int)lsb;
+}
+
+/** DPI-C Function: dpi_pam4_merge - inverse of dpi_pam4_split(). */
+long long dpi_pam4_merge(int msb_plane, int lsb_plane) {
+    return (long long)pam4_merge((uint32_t)msb_plane, (uint32_t)lsb_plane);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * =============================================================================
+ * IMPLEMENTATION NOTES
+ * =============================================================================
+ *
+ * 1. Bit FIFO:
+ *    - The serial stream is a ring of GB_FIFO_WORDS 64-bit words indexed by
+ *      absolute bit position; a push or pop of k <= 64 bits touches at most
+ *      two words (shift, mask, or), independent of the width ratio
+ *    - A write masks only its own field in both words: within 64 bits of
+ *      full the tail word and the spill word still hold unread head bits
+ *      (gearbox_tb fills to within one word of capacity to check this)
+ *    - MSB-first order reverses the word (bswap + 3 swap stages) at the
+ *      boundary; the FIFO itself is always in transmit order
+ *    - Capacity 64 Kbit: far more than any rate-matched gearbox needs; an
+ *      overflow means the pop side is not keeping up
+ *
+ * 2. PAM4 Packing:
+ *    - Symbol i of a word occupies bits 2i (MSB, sent first) and 2i+1
+ *    - PEXT/PDEP with 0x5555... gather/scatter one plane in a single
+ *      instruction (BMI2); without BMI2 a 5-stage mask-and-shift network
+ *      does the same
+ *    - Gray coding in plane form is one XOR: lsb_level = msb ^ lsb_bit
+ *
+ * 3. Serial-Domain Stage:
+ *    - Error positions are drawn as geometric gaps (inverse CDF), so the
+ *      cost is per error, not per symbol; error-free links cost nothing
+ *    - A symbol error moves the decision to an adjacent level (the
+ *      dominant PAM4 error); with Gray coding each costs exactly one bit,
+ *      with natural coding the 01 <-> 10 transition costs two
+ *    - Only whole symbols can be popped, so a symbol is never read before
+ *      its error has been applied
+ *
+ * 4. Parallel-Only Link:
+ *    - rtl/gearbox_link.sv pushes TX words on tx_clk and pops RX words on
+ *      rx_clk from one gearbox; no serial clock exists in the simulation
+ *    - Rates match when TX_WIDTH / T_tx = RX_WIDTH / T_rx
+ *    - Asserting rst_n calls dpi_gearbox_reset, so words queued before a
+ *      reset are discarded rather than delivered after it
+ *
+ * 5. Verilator Compilation:
+ *    - Add to test_config.yaml:
+ *      verilator_extra_flags:
+ *        - ../dpi/dpi_gearbox.cpp
+ *        - -CFLAGS
+ *        - -march=native  # BMI2 PEXT/PDEP (optional)
+ *
+ * =============================================================================
+ */
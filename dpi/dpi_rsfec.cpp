@@ -0,0 +1,787 @@
+/**
+ * dpi_rsfec.cpp - DPI-C Reed-Solomon FEC (RS(544,514) "KP4") and Post-FEC BER Estimator
+ *
+ * PAM4 links (spec/serdes_architecture.md §5.2) are specified after FEC, so a
+ * pre-FEC BER alone does not say whether the link passes. This file provides:
+ *
+ * 1. RS encoder/decoder over GF(2^10), p(x) = x^10 + x^3 + 1
+ *    - Default RS(544,514): t = 15 symbol errors (IEEE 802.3 clause 91 KP4);
+ *      any shortened (n, k) with n <= 1023 works, e.g. RS(528,514) "KR4"
+ *    - Encoder: systematic, table-driven LFSR division
+ *    - Syndromes: one 1024-entry multiply table per root (Horner form)
+ *    - Berlekamp-Massey → error locator Λ(x)
+ *    - Chien search: 8 positions per step with AVX2 gathers (scalar fallback)
+ *    - Forney → error values
+ *
+ * 2. Post-FEC estimator driven by recorded pre-FEC errors
+ *    - Error bit positions from the simulation are mapped onto 10-bit
+ *      symbols and codewords (optional symbol interleaving)
+ *    - Measured: symbol errors per codeword histogram, FER, post-FEC BER
+ *    - Model: compound-Poisson burst model built from the measured burst
+ *      length histogram → FER / post-FEC BER at any pre-FEC BER scale,
+ *      without decoding a single extra codeword
+ *
+ * 3. Checkpoint
+ *    - dpi_rsfec_save / dpi_rsfec_restore write and reload the whole engine
+ *      state as one blob
+ *
+ * Author: Generated for SerDes PAM4 FEC evaluation
+ * Date: 2025
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "dpi_alloc.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+//==============================================================================
+// CONFIGURATION
+//==============================================================================
+#define GF_BITS      10
+#define GF_SIZE      1024
+#define GF_ORDER     1023             // Multiplicative group order
+#define GF_POLY      0x409            // x^10 + x^3 + 1
+#define RS_FCR       0                // First consecutive root α^0 (802.3 cl. 91)
+#define RS_MAX_2T    64
+#define RS_KP4_N     544
+#define RS_KP4_K     514
+
+#define EST_MAX_SYMBOLS  128          // Histogram range: symbol errors / codeword
+#define EST_MAX_BURST    1024         // Burst length histogram range (bits)
+#define EST_DEFAULT_GAP  GF_BITS      // Errors closer than this join one burst
+#define RS_ARENA_INTERLEAVE 8         // Interleave depths covered by the declared needs
+
+//==============================================================================
+// GALOIS FIELD TABLES (shared, built once)
+//==============================================================================
+static uint16_t gf_exp[2 * GF_SIZE];
+static int16_t gf_log[GF_SIZE];
+static int gf_ready = 0;
+
+static void gf_init() {
+    if (gf_ready) return;
+    uint32_t x = 1;
+    for (int i = 0; i < GF_ORDER; i++) {
+        gf_exp[i] = (uint16_t)x;
+        gf_log[x] = (int16_t)i;
+        x <<= 1;
+        if (x & GF_SIZE) x ^= GF_POLY;
+    }
+    for (int i = GF_ORDER; i < 2 * GF_SIZE; i++) gf_exp[i] = gf_exp[i - GF_ORDER];
+    gf_log[0] = -1;
+    gf_ready = 1;
+}
+
+static inline uint16_t gf_mul(uint16_t a, uint16_t b) {
+    if (a == 0 || b == 0) return 0;
+    return gf_exp[gf_log[a] + gf_log[b]];
+}
+
+static inline uint16_t gf_div(uint16_t a, uint16_t b) {
+    if (a == 0) return 0;
+    return gf_exp[gf_log[a] + GF_ORDER - gf_log[b]];
+}
+
+static inline uint16_t gf_pow_alpha(int e) {
+    e %= GF_ORDER;
+    if (e < 0) e += GF_ORDER;
+    return gf_exp[e];
+}
+
+//==============================================================================
+// ENGINE STATE
+//==============================================================================
+struct RsCodec {
+    int n, k, two_t, t;
+    uint16_t gen[RS_MAX_2T + 1];           // g(x), gen[2t] = 1
+    dpi_vector<uint16_t> enc_table;        // [feedback][j] = g_j · feedback
+    dpi_vector<uint16_t> syn_table;        // [j][s] = s · α^(fcr+j)
+    uint64_t codewords;
+    uint64_t corrected_symbols;
+    uint64_t uncorrectable;
+};
+
+struct FecEstimator {
+    int interleave;
+    int burst_gap;
+    // Current interleave group (interleave × n symbols)
+    int64_t group;
+    size_t mark;                           // Arena mark below the per-codeword arrays
+    dpi_vector<int> cw_symbols;            // Symbol errors per codeword in group
+    dpi_vector<int> cw_bits;               // Bit errors per codeword in group
+    dpi_vector<int64_t> cw_last_symbol;    // Last errored symbol (dedup)
+    // Bursts
+    int64_t burst_first;
+    int64_t burst_last;
+    dpi_vector<uint64_t> burst_hist;       // [length in bits]
+    // Totals
+    uint64_t error_bits;
+    uint64_t error_symbols;
+    uint64_t failed_codewords;
+    uint64_t failed_bits;
+    uint64_t total_bits;
+    dpi_vector<uint64_t> sym_hist;         // [symbol errors per codeword]
+    int64_t last_bit;
+};
+
+struct RsEngine {
+    RsCodec rs;
+    FecEstimator est;
+};
+
+//==============================================================================
+// RS CODEC
+//==============================================================================
+static void rs_init(RsCodec *c, int n, int k) {
+    gf_init();
+    c->n = n;
+    c->k = k;
+    c->two_t = n - k;
+    c->t = c->two_t / 2;
+    c->codewords = 0;
+    c->corrected_symbols = 0;
+    c->uncorrectable = 0;
+
+    // g(x) = Π (x - α^(fcr+i)), coefficients low degree first
+    memset(c->gen, 0, sizeof(c->gen));
+    c->gen[0] = 1;
+    for (int i = 0; i < c->two_t; i++) {
+        const uint16_t root = gf_pow_alpha(RS_FCR + i);
+        for (int j = i + 1; j > 0; j--) {
+            c->gen[j] = c->gen[j - 1] ^ gf_mul(c->gen[j], root);
+        }
+        c->gen[0] = gf_mul(c->gen[0], root);
+    }
+
+    c->enc_table.assign((size_t)GF_SIZE * c->two_t, 0);
+    for (int fb = 0; fb < GF_SIZE; fb++) {
+        for (int j = 0; j < c->two_t; j++) {
+            c->enc_table[(size_t)fb * c->two_t + j] = gf_mul(c->gen[j], (uint16_t)fb);
+        }
+    }
+
+    c->syn_table.assign((size_t)c->two_t * GF_SIZE, 0);
+    for (int j = 0; j < c->two_t; j++) {
+        const uint16_t root = gf_pow_alpha(RS_FCR + j);
+        for (int s = 0; s < GF_SIZE; s++) {
+            c->syn_table[(size_t)j * GF_SIZE + s] = gf_mul((uint16_t)s, root);
+        }
+    }
+}
+
+/**
+ * Systematic encode. cw[0] is the first transmitted symbol and the
+ * coefficient of x^(n-1); cw[0..k-1] = message, cw[k..n-1] = parity.
+ */
+static void rs_encode(const RsCodec *c, const uint16_t *msg, uint16_t *cw) {
+    uint16_t reg[RS_MAX_2T];
+    memset(reg, 0, sizeof(reg));
+    const int nt = c->two_t;
+    for (int i = 0; i < c->k; i++) {
+        const uint16_t fb = msg[i] ^ reg[nt - 1];
+        const uint16_t *row = &c->enc_table[(size_t)fb * nt];
+        for (int j = nt - 1; j > 0; j--) reg[j] = reg[j - 1] ^ row[j];
+        reg[0] = row[0];
+        cw[i] = msg[i];
+    }
+    for (int j = 0; j < nt; j++) cw[c->k + j] = reg[nt - 1 - j];
+}
+
+/** Table-driven syndromes. Returns 1 if any syndrome is non-zero. */
+static int rs_syndromes(const RsCodec *c, const uint16_t *cw, uint16_t *syn) {
+    int nonzero = 0;
+    for (int j = 0; j < c->two_t; j++) {
+        const uint16_t *mul = &c->syn_table[(size_t)j * GF_SIZE];
+        uint16_t s = 0;
+        for (int i = 0; i < c->n; i++) s = mul[s] ^ cw[i];
+        syn[j] = s;
+        nonzero |= s;
+    }
+    return nonzero != 0;
+}
+
+/** Berlekamp-Massey. Returns the degree L of Λ(x). */
+static int rs_berlekamp_massey(const RsCodec *c, const uint16_t *syn, uint16_t *lambda) {
+    uint16_t b[RS_MAX_2T + 1];
+    uint16_t tmp[RS_MAX_2T + 1];
+    memset(lambda, 0, sizeof(uint16_t) * (RS_MAX_2T + 1));
+    memset(b, 0, sizeof(b));
+    lambda[0] = 1;
+    b[0] = 1;
+    int L = 0;
+    int m = 1;
+    uint16_t bd = 1;
+
+    for (int r = 0; r < c->two_t; r++) {
+        uint16_t d = syn[r];
+        for (int i = 1; i <= L; i++) d ^= gf_mul(lambda[i], syn[r - i]);
+        if (d == 0) {
+            m++;
+            continue;
+        }
+        const uint16_t coef = gf_div(d, bd);
+        if (2 * L <= r) {
+            memcpy(tmp, lambda, sizeof(tmp));
+            for (int i = 0; i + m <= c->two_t; i++) lambda[i + m] ^= gf_mul(coef, b[i]);
+            L = r + 1 - L;
+            memcpy(b, tmp, sizeof(b));
+            bd = d;
+            m = 1;
+        } else {
+            for (int i = 0; i + m <= c->two_t; i++) lambda[i + m] ^= gf_mul(coef, b[i]);
+            m++;
+        }
+    }
+    return L;
+}
+
+/**
+ * Chien search over the n codeword positions. Position p (polynomial
+ * degree) is an error location if Λ(α^-p) = 0. Each coefficient term is
+ * exp[log Λ_j - j·p mod 1023], evaluated for 8 positions per AVX2 step.
+ * Returns the number of roots written to roots[] (as degrees p).
+ */
+static int rs_chien(const RsCodec *c, const uint16_t *lambda, int L, int *roots) {
+    int lam_log[RS_MAX_2T + 1];
+    for (int j = 0; j <= L; j++) lam_log[j] = lambda[j] ? gf_log[lambda[j]] : -1;
+
+    int count = 0;
+    int p = 0;
+#if defined(__AVX2__)
+    const __m256i order = _mm256_set1_epi32(GF_ORDER);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i low10 = _mm256_set1_epi32(0x3FF);
+    for (; p + 8 <= c->n; p += 8) {
+        const __m256i pos = _mm256_setr_epi32(p, p + 1, p + 2, p + 3,
+                                              p + 4, p + 5, p + 6, p + 7);
+        __m256i step = zero;                      // j·p mod 1023, built incrementally
+        __m256i sum = _mm256_set1_epi32(1);       // Λ_0 = 1
+        for (int j = 1; j <= L; j++) {
+            step = _mm256_add_epi32(step, pos);
+            step = _mm256_sub_epi32(step, _mm256_and_si256(
+                _mm256_cmpgt_epi32(step, _mm256_set1_epi32(GF_ORDER - 1)), order));
+            if (lam_log[j] < 0) continue;
+            __m256i e = _mm256_sub_epi32(_mm256_set1_epi32(lam_log[j]), step);
+            e = _mm256_add_epi32(e, _mm256_and_si256(_mm256_cmpgt_epi32(zero, e), order));
+            // 32-bit gather at 2-byte stride: low 10 bits are gf_exp[e]
+            const __m256i g = _mm256_and_si256(
+                _mm256_i32gather_epi32(reinterpret_cast<const int *>(gf_exp), e, 2), low10);
+            sum = _mm256_xor_si256(sum, g);
+        }
+        const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(sum, zero)));
+        for (int i = 0; i < 8; i++) {
+            if (mask & (1 << i)) roots[count++] = p + i;
+        }
+    }
+#endif
+    for (; p < c->n; p++) {
+        uint16_t sum = 1;
+        int step = 0;
+        for (int j = 1; j <= L; j++) {
+            step += p;
+            if (step >= GF_ORDER) step -= GF_ORDER;
+            if (lam_log[j] < 0) continue;
+            int e = lam_log[j] - step;
+            if (e < 0) e += GF_ORDER;
+            sum ^= gf_exp[e];
+        }
+        if (sum == 0) roots[count++] = p;
+    }
+    return count;
+}
+
+/**
+ * Full decode in place. Returns the number of corrected symbols, or -1 if
+ * the codeword is uncorrectable (left unmodified).
+ */
+static int rs_decode(RsCodec *c, uint16_t *cw) {
+    uint16_t syn[RS_MAX_2T];
+    uint16_t lambda[RS_MAX_2T + 1];
+    uint16_t omega[RS_MAX_2T];
+    int roots[RS_MAX_2T];
+
+    c->codewords++;
+    if (!rs_syndromes(c, cw, syn)) return 0;
+
+    const int L = rs_berlekamp_massey(c, syn, lambda);
+    if (L > c->t) {
+        c->uncorrectable++;
+        return -1;
+    }
+    const int nroots = rs_chien(c, lambda, L, roots);
+    if (nroots != L) {
+        c->uncorrectable++;
+        return -1;
+    }
+
+    // Ω(x) = S(x)·Λ(x) mod x^2t
+    for (int i = 0; i < c->two_t; i++) {
+        uint16_t v = 0;
+        for (int j = 0; j <= L && j <= i; j++) v ^= gf_mul(syn[i - j], lambda[j]);
+        omega[i] = v;
+    }
+
+    // Forney: e = X^(1-fcr) Ω(X^-1) / Λ'(X^-1)
+    for (int r = 0; r < nroots; r++) {
+        const int p = roots[r];
+        const uint16_t xinv = gf_pow_alpha(-p);
+        uint16_t num = 0;
+        uint16_t xpow = 1;
+        for (int i = 0; i < c->two_t; i++) {
+            num ^= gf_mul(omega[i], xpow);
+            xpow = gf_mul(xpow, xinv);
+        }
+        uint16_t den = 0;
+        xpow = 1;
+        for (int j = 1; j <= L; j += 2) {          // Odd terms of Λ'(x)
+            den ^= gf_mul(lambda[j], xpow);
+            xpow = gf_mul(xpow, gf_mul(xinv, xinv));
+        }
+        if (den == 0) {
+            c->uncorrectable++;
+            return -1;
+        }
+        const uint16_t err = gf_mul(gf_div(num, den), gf_pow_alpha(p * (1 - RS_FCR)));
+        cw[c->n - 1 - p] ^= err;
+    }
+    c->corrected_symbols += nroots;
+    return nroots;
+}
+
+//==============================================================================
+// POST-FEC ESTIMATOR
+//==============================================================================
+// The per-codeword arrays are sized by the interleave depth: release them,
+// rewind the arena to the mark and allocate them again at the new depth
+static void est_reset(RsEngine *r, int interleave, int burst_gap) {
+    FecEstimator *e = &r->est;
+    e->interleave = interleave;
+    e->burst_gap = burst_gap;
+    e->group = 0;
+    dpi_vector_release(e->cw_symbols);
+    dpi_vector_release(e->cw_bits);
+    dpi_vector_release(e->cw_last_symbol);
+    dpi_arena_rewind(dpi_arena_of(r), e->mark);
+    e->cw_symbols.assign(interleave, 0);
+    e->cw_bits.assign(interleave, 0);
+    e->cw_last_symbol.assign(interleave, -1);
+    e->burst_first = -1;
+    e->burst_last = -1;
+    e->burst_hist.assign(EST_MAX_BURST + 1, 0);
+    e->error_bits = 0;
+    e->error_symbols = 0;
+    e->failed_codewords = 0;
+    e->failed_bits = 0;
+    e->total_bits = 0;
+    e->sym_hist.assign(EST_MAX_SYMBOLS + 1, 0);
+    e->last_bit = -1;
+}
+
+static void est_flush_group(FecEstimator *e, int t) {
+    for (int w = 0; w < e->interleave; w++) {
+        const int s = e->cw_symbols[w];
+        if (s == 0) continue;
+        e->sym_hist[s > EST_MAX_SYMBOLS ? EST_MAX_SYMBOLS : s]++;
+        if (s > t) {
+            e->failed_codewords++;
+            e->failed_bits += e->cw_bits[w];
+        }
+        e->cw_symbols[w] = 0;
+        e->cw_bits[w] = 0;
+        e->cw_last_symbol[w] = -1;
+    }
+}
+
+static void est_close_burst(FecEstimator *e) {
+    if (e->burst_first < 0) return;
+    int64_t len = e->burst_last - e->burst_first + 1;
+    if (len > EST_MAX_BURST) len = EST_MAX_BURST;
+    e->burst_hist[len]++;
+    e->burst_first = -1;
+}
+
+static void est_add_error(FecEstimator *e, int n, int t, int64_t bit) {
+    if (bit <= e->last_bit) return;        // Positions must be increasing
+    e->last_bit = bit;
+    e->error_bits++;
+
+    const int64_t symbol = bit / GF_BITS;
+    const int64_t group_symbols = (int64_t)n * e->interleave;
+    const int64_t group = symbol / group_symbols;
+    if (group != e->group) {
+        est_flush_group(e, t);
+        e->group = group;
+    }
+    const int w = (int)(symbol % e->interleave);
+    e->cw_bits[w]++;
+    if (e->cw_last_symbol[w] != symbol) {
+        e->cw_last_symbol[w] = symbol;
+        e->cw_symbols[w]++;
+        e->error_symbols++;
+    }
+
+    if (e->burst_first >= 0 && bit - e->burst_last > e->burst_gap) est_close_burst(e);
+    if (e->burst_first < 0) e->burst_first = bit;
+    e->burst_last = bit;
+}
+
+static inline uint64_t est_codewords(const FecEstimator *e, int n) {
+    return e->total_bits / ((uint64_t)n * GF_BITS);
+}
+
+/**
+ * Compound-Poisson model of symbol errors per codeword.
+ *
+ * - Bursts arrive at rate λ per codeword span (n × interleave symbols),
+ *   scaled by ber_scale to extrapolate to other pre-FEC BERs
+ * - A burst of L bits at a uniform bit phase touches S symbols; with
+ *   interleaving, a given codeword receives floor or ceil(S / interleave)
+ * - Panjer recursion gives P(k symbol errors); the tail k > t is summed
+ *   directly so FER down to 1e-300 keeps full precision
+ */
+static void est_model(const RsEngine *r, double ber_scale, double *fer, double *post_ber) {
+    const FecEstimator *e = &r->est;
+    const int n = r->rs.n;
+    const int t = r->rs.t;
+    const int w = e->interleave;
+    *fer = 0.0;
+    *post_ber = 0.0;
+
+    uint64_t bursts = 0;
+    for (int L = 1; L <= EST_MAX_BURST; L++) bursts += e->burst_hist[L];
+    const uint64_t cws = est_codewords(e, n);
+    if (bursts == 0 || cws == 0 || e->error_symbols == 0) return;
+
+    // Severity distribution q(s): symbols landing in one codeword per burst
+    std::vector<double> q(EST_MAX_SYMBOLS + 1, 0.0);
+    for (int L = 1; L <= EST_MAX_BURST; L++) {
+        if (e->burst_hist[L] == 0) continue;
+        const double pl = (double)e->burst_hist[L] / (double)bursts;
+        for (int o = 0; o < GF_BITS; o++) {
+            const int S = (o + L - 1) / GF_BITS + 1;
+            for (int ph = 0; ph < w; ph++) {
+                // Symbols of this burst that fall on interleave slot 0
+                const int s = (S + ((w - ph) % w)) / w;
+                q[s > EST_MAX_SYMBOLS ? EST_MAX_SYMBOLS : s] +=
+                    pl / (double)(GF_BITS * w);
+            }
+        }
+    }
+    // Bursts per codeword span (n × w symbols), then thin out q(0)
+    double lambda = (double)bursts / (double)cws * (double)w * ber_scale;
+    const double q0 = q[0];
+    if (q0 >= 1.0) return;
+    lambda *= (1.0 - q0);
+    q[0] = 0.0;
+    for (double &v : q) v /= (1.0 - q0);
+
+    const int kmax = EST_MAX_SYMBOLS;
+    std::vector<double> p(kmax + 1, 0.0);
+    p[0] = exp(-lambda);
+    for (int k = 1; k <= kmax; k++) {
+        double acc = 0.0;
+        for (int j = 1; j <= k; j++) acc += (double)j * q[j] * p[k - j];
+        p[k] = lambda / (double)k * acc;
+    }
+
+    const double bits_per_symbol = (double)e->error_bits / (double)e->error_symbols;
+    for (int k = t + 1; k <= kmax; k++) {
+        *fer += p[k];
+        *post_ber += p[k] * (double)k * bits_per_symbol;
+    }
+    *post_ber /= (double)n * GF_BITS;
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// DPI-C EXPORTED FUNCTIONS: CODEC
+//==============================================================================
+/**
+ * DPI-C Function: dpi_rsfec_create
+ *
+ * Args:
+ *   n, k : Code length and message length in 10-bit symbols
+ *          (544, 514) = KP4, (528, 514) = KR4; n - k must be even, <= 64
+ *
+ * Returns:
+ *   chandle: Codec + estimator handle, or NULL on invalid arguments
+ */
+void *dpi_rsfec_create(int n, int k) {
+    if (n <= k || n > GF_ORDER || k < 1 || (n - k) > RS_MAX_2T || ((n - k) & 1)) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_rsfec_create: invalid RS(%d,%d)\n", n, k);
+        return NULL;
+    }
+    // Declared needs: engine, both GF tables, the estimator histograms and
+    // the per-codeword arrays for interleave depths up to RS_ARENA_INTERLEAVE
+    // (deeper ones spill)
+    const int two_t = n - k;
+    RsEngine *r = dpi_arena_new<RsEngine>(
+        dpi_arena_need<RsEngine>() +
+        2 * dpi_arena_need<uint16_t>((size_t)GF_SIZE * two_t) +
+        2 * dpi_arena_need<int>(RS_ARENA_INTERLEAVE) +
+        dpi_arena_need<int64_t>(RS_ARENA_INTERLEAVE) +
+        dpi_arena_need<uint64_t>(EST_MAX_BURST + 1) +
+        dpi_arena_need<uint64_t>(EST_MAX_SYMBOLS + 1), "rsfec");
+    rs_init(&r->rs, n, k);
+    r->est.burst_hist.reserve(EST_MAX_BURST + 1);
+    r->est.sym_hist.reserve(EST_MAX_SYMBOLS + 1);
+    r->est.mark = dpi_arena_mark(dpi_arena_of(r));
+    est_reset(r, 1, EST_DEFAULT_GAP);
+    return r;
+}
+
+/**
+ * DPI-C Function: dpi_rsfec_encode
+ *
+ * Block API: msg[k] → cw[n] (systematic, cw[0] sent first).
+ */
+void dpi_rsfec_encode(void *handle, const int *msg, int *cw) {
+    RsEngine *r = (RsEngine *)handle;
+    uint16_t m[GF_SIZE];
+    uint16_t c[GF_SIZE];
+    for (int i = 0; i < r->rs.k; i++) m[i] = (uint16_t)(msg[i] & (GF_SIZE - 1));
+    rs_encode(&r->rs, m, c);
+    for (int i = 0; i < r->rs.n; i++) cw[i] = c[i];
+}
+
+/**
+ * DPI-C Function: dpi_rsfec_decode
+ *
+ * Corrects cw[n] in place.
+ *
+ * Returns:
+ *   int: Number of corrected symbols (0..t), or -1 if uncorrectable
+ */
+int dpi_rsfec_decode(void *handle, int *cw) {
+    RsEngine *r = (RsEngine *)handle;
+    uint16_t c[GF_SIZE];
+    for (int i = 0; i < r->rs.n; i++) c[i] = (uint16_t)(cw[i] & (GF_SIZE - 1));
+    const int result = rs_decode(&r->rs, c);
+    if (result > 0) {
+        for (int i = 0; i < r->rs.n; i++) cw[i] = c[i];
+    }
+    return result;
+}
+
+/** DPI-C Function: dpi_rsfec_corrected_symbols */
+long long dpi_rsfec_corrected_symbols(void *handle) {
+    return (long long)((RsEngine *)handle)->rs.corrected_symbols;
+}
+
+/** DPI-C Function: dpi_rsfec_uncorrectable - codewords that failed decode. */
+long long dpi_rsfec_uncorrectable(void *handle) {
+    return (long long)((RsEngine *)handle)->rs.uncorrectable;
+}
+
+//==============================================================================
+// DPI-C EXPORTED FUNCTIONS: POST-FEC ESTIMATOR
+//==============================================================================
+/**
+ * DPI-C Function: dpi_rsfec_est_config
+ *
+ * Resets the estimator.
+ *
+ * Args:
+ *   interleave : Symbol interleave depth (1 = none, 2 = 802.3 2-way)
+ *   burst_gap  : Errors at most this many bits apart form one burst
+ */
+void dpi_rsfec_est_config(void *handle, int interleave, int burst_gap) {
+    RsEngine *r = (RsEngine *)handle;
+    est_reset(r, interleave < 1 ? 1 : interleave, burst_gap < 1 ? 1 : burst_gap);
+}
+
+/**
+ * DPI-C Function: dpi_rsfec_est_error_bit
+ *
+ * Records one pre-FEC bit error at absolute bit index (must increase).
+ */
+void dpi_rsfec_est_error_bit(void *handle, long long bit_index) {
+    RsEngine *r = (RsEngine *)handle;
+    est_add_error(&r->est, r->rs.n, r->rs.t, (int64_t)bit_index);
+}
+
+/**
+ * DPI-C Function: dpi_rsfec_est_error_word
+ *
+ * Records the set bits of a 64-bit error mask (rx ^ expected) covering bits
+ * word_index*64 .. word_index*64+63. Zero masks cost one compare.
+ */
+void dpi_rsfec_est_error_word(void *handle, long long word_index, long long error_mask) {
+    RsEngine *r = (RsEngine *)handle;
+    uint64_t m = (uint64_t)error_mask;
+    while (m) {
+        const int b = __builtin_ctzll(m);
+        est_add_error(&r->est, r->rs.n, r->rs.t, (int64_t)word_index * 64 + b);
+        m &= m - 1;
+    }
+}
+
+/**
+ * DPI-C Function: dpi_rsfec_est_finish
+ *
+ * Closes the open burst/codeword group and sets the total bit count.
+ */
+void dpi_rsfec_est_finish(void *handle, long long total_bits) {
+    RsEngine *r = (RsEngine *)handle;
+    est_close_burst(&r->est);
+    est_flush_group(&r->est, r->rs.t);
+    r->est.total_bits = (uint64_t)total_bits;
+}
+
+/** DPI-C Function: dpi_rsfec_est_pre_fec_ber */
+double dpi_rsfec_est_pre_fec_ber(void *handle) {
+    const FecEstimator *e = &((RsEngine *)handle)->est;
+    return e->total_bits ? (double)e->error_bits / (double)e->total_bits : 0.0;
+}
+
+/** DPI-C Function: dpi_rsfec_est_measured_fer - codewords with > t symbol errors. */
+double dpi_rsfec_est_measured_fer(void *handle) {
+    RsEngine *r = (RsEngine *)handle;
+    const uint64_t cws = est_codewords(&r->est, r->rs.n);
+    return cws ? (double)r->est.failed_codewords / (double)cws : 0.0;
+}
+
+/** DPI-C Function: dpi_rsfec_est_measured_post_fec_ber */
+double dpi_rsfec_est_measured_post_fec_ber(void *handle) {
+    const FecEstimator *e = &((RsEngine *)handle)->est;
+    return e->total_bits ? (double)e->failed_bits / (double)e->total_bits : 0.0;
+}
+
+/**
+ * DPI-C Function: dpi_rsfec_est_model_fer
+ *
+ * Burst-model FER with the burst rate scaled by ber_scale (1.0 = as
+ * measured, 0.1 = ten times fewer error events with the same burst shape).
+ */
+double dpi_rsfec_est_model_fer(void *handle, double ber_scale) {
+    double fer, post_ber;
+    est_model((RsEngine *)handle, ber_scale, &fer, &post_ber);
+    return fer;
+}
+
+/** DPI-C Function: dpi_rsfec_est_model_post_fec_ber */
+double dpi_rsfec_est_model_post_fec_ber(void *handle, double ber_scale) {
+    double fer, post_ber;
+    est_model((RsEngine *)handle, ber_scale, &fer, &post_ber);
+    return post_ber;
+}
+
+/**
+ * DPI-C Function: dpi_rsfec_est_write_report
+ *
+ * Writes a text report: totals, symbol-errors-per-codeword histogram,
+ * burst length histogram and model FER at ber_scale = 1, 0.1, 0.01, 0.001.
+ */
+int dpi_rsfec_est_write_report(void *handle, const char *path) {
+    RsEngine *r = (RsEngine *)handle;
+    const FecEstimator *e = &r->est;
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        fprintf(stderr, "[DPI-C ERROR] rsfec: cannot open %s\n", path);
+        return -1;
+    }
+    fprintf(f, "# RS(%d,%d) t=%d interleave=%d burst_gap=%d\n",
+            r->rs.n, r->rs.k, r->rs.t, e->interleave, e->burst_gap);
+    fprintf(f, "total_bits %llu\nerror_bits %llu\nerror_symbols %llu\n",
+            (unsigned long long)e->total_bits, (unsigned long long)e->error_bits,
+            (unsigned long long)e->error_symbols);
+    fprintf(f, "codewords %llu\nfailed_codewords %llu\n",
+            (unsigned long long)est_codewords(e, r->rs.n),
+            (unsigned long long)e->failed_codewords);
+    fprintf(f, "pre_fec_ber %.6e\nmeasured_fer %.6e\nmeasured_post_fec_ber %.6e\n",
+            dpi_rsfec_est_pre_fec_ber(r), dpi_rsfec_est_measured_fer(r),
+            dpi_rsfec_est_measured_post_fec_ber(r));
+    const double scales[4] = {1.0, 0.1, 0.01, 0.001};
+    for (double s : scales) {
+        double fer, post_ber;
+        est_model(r, s, &fer, &post_ber);
+        fprintf(f, "model scale=%g fer %.6e post_fec_ber %.6e\n", s, fer, post_ber);
+    }
+    fprintf(f, "# symbol_errors_per_codeword count\n");
+    for (int s = 1; s <= EST_MAX_SYMBOLS; s++) {
+        if (e->sym_hist[s]) fprintf(f, "sym %d %llu\n", s, (unsigned long long)e->sym_hist[s]);
+    }
+    fprintf(f, "# burst_length_bits count\n");
+    for (int L = 1; L <= EST_MAX_BURST; L++) {
+        if (e->burst_hist[L]) fprintf(f, "burst %d %llu\n", L, (unsigned long long)e->burst_hist[L]);
+    }
+    fclose(f);
+    return 0;
+}
+
+/**
+ * DPI-C Function: dpi_rsfec_save / dpi_rsfec_restore
+ *
+ * Checkpoint the codec tables and the estimator state to a file and restore it into the same engine
+ * instance later in the run.
+ *
+ * Returns:
+ *   int: 0 on success, -1 on error
+ */
+int dpi_rsfec_save(void *handle, const char *path) {
+    return dpi_arena_save_file(handle, path, "dpi_rsfec_save");
+}
+
+int dpi_rsfec_restore(void *handle, const char *path) {
+    return dpi_arena_restore_file(handle, path, "dpi_rsfec_restore");
+}
+
+/** DPI-C Function: dpi_rsfec_destroy */
+void dpi_rsfec_destroy(void *handle) {
+    dpi_arena_delete((RsEngine *)handle);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * =============================================================================
+ * IMPLEMENTATION NOTES
+ * =============================================================================
+ *
+ * 1. Code Parameters (IEEE 802.3 clause 91 / 119 "KP4"):
+ *    - Symbols: 10 bits, GF(2^10) with p(x) = x^10 + x^3 + 1
+ *    - RS(544,514): 30 parity symbols, corrects t = 15 symbol errors
+ *    - Generator roots α^0 .. α^29 (RS_FCR = 0)
+ *    - Codeword = 5440 bits; cw[0] is the first symbol on the wire
+ *
+ * 2. Decoder Cost per Codeword:
+ *    - Syndromes: 30 × 544 table lookups (skipped decode if all zero)
+ *    - Berlekamp-Massey: O(t^2)
+ *    - Chien: 544 positions × deg Λ terms, 8 positions per AVX2 gather
+ *    - Error-free codewords exit after the syndrome step
+ *
+ * 3. Estimator vs Full Decode:
+ *    - Measured numbers assume the decoder corrects every codeword with
+ *      <= t symbol errors and fails (leaves errors) otherwise; miscorrection
+ *      is ignored (probability ~1/t! for RS)
+ *    - Model numbers reuse the measured burst shape and only rescale the
+ *      burst rate, so a 1e7-bit run at pre-FEC BER 1e-4 predicts FER at
+ *      1e-5, 1e-6, ... where direct counting would need 1e12+ bits
+ *    - DFE error propagation shows up as long bursts → heavier q(s) tail →
+ *      higher FER than the random-error binomial formula predicts
+ *
+ * 4. SIMD:
+ *    - Compile with -march=native (or -mavx2) to enable the gather path;
+ *      the scalar loop computes the identical sum and handles the tail
+ *
+ * 5. Verilator Compilation:
+ *    - Add to test_config.yaml:
+ *      verilator_extra_flags:
+ *        - ../dpi/dpi_rsfec.cpp
+ *        - -CFLAGS
+ *        - -march=native
+ *
+ * =============================================================================
+ */
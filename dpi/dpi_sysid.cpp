@@ -0,0 +1,486 @@
+/**
+ * dpi_sysid.cpp - DPI-C MLS/PRBS System Identification Engine
+ *
+ * Recovers the impulse and frequency response of an RTL block (e.g. the
+ * planned ctle_rnm.sv) from ONE short simulation instead of one sine-sweep
+ * run per frequency (spec/ctle_specification.md §5.1).
+ *
+ * Flow (all inside C++, driven sample-by-sample from SystemVerilog):
+ * 1. dpi_sysid_next_stimulus() returns the next ±A sample of a maximum
+ *    length sequence (MLS, i.e. PRBS7/PRBS9/.../PRBS23)
+ * 2. dpi_sysid_capture() records the DUT output of the same sample slot
+ *    - the first WARMUP periods are discarded (filter transient)
+ *    - the next AVG periods are summed into one period (noise averaging)
+ * 3. dpi_sysid_solve() computes the circular cross-correlation with a
+ *    Fast Walsh-Hadamard Transform (O(N log N), no FFT of odd length needed)
+ * 4. Query impulse taps, gain/phase at any frequency, or write a Bode CSV
+ *
+ * Features:
+ * - Handle-based (chandle): several DUTs can be identified in one simulation
+ * - Deterministic (LFSR seed fixed to all-ones state)
+ * - Exact for impulse responses shorter than one MLS period (2^m - 1 samples)
+ * - No external library dependencies (C++ standard library only)
+ *
+ * Author: Generated for SerDes CTLE characterization
+ * Date: 2025
+ */
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "dpi_alloc.h"
+
+//==============================================================================
+// CONFIGURATION
+//==============================================================================
+#define SYSID_MIN_ORDER 3
+#define SYSID_MAX_ORDER 24   // 2^24 FWHT buffer = 128 MB of doubles
+
+// Primitive polynomial taps x^m + ... + 1 (Fibonacci LFSR exponents).
+// Orders 7/9/15/23 match the ITU-T O.150 PRBS polynomials.
+static const int MLS_TAPS[SYSID_MAX_ORDER + 1][5] = {
+    {0}, {0}, {0},
+    {3, 2, 0},        //  3
+    {4, 3, 0},        //  4
+    {5, 3, 0},        //  5
+    {6, 5, 0},        //  6
+    {7, 6, 0},        //  7  PRBS7
+    {8, 6, 5, 4, 0},  //  8
+    {9, 5, 0},        //  9  PRBS9
+    {10, 7, 0},       // 10
+    {11, 9, 0},       // 11  PRBS11
+    {12, 6, 4, 1, 0}, // 12
+    {13, 4, 3, 1, 0}, // 13
+    {14, 5, 3, 1, 0}, // 14
+    {15, 14, 0},      // 15  PRBS15
+    {16, 15, 13, 4, 0}, // 16
+    {17, 14, 0},      // 17
+    {18, 11, 0},      // 18
+    {19, 6, 2, 1, 0}, // 19
+    {20, 17, 0},      // 20
+    {21, 19, 0},      // 21
+    {22, 21, 0},      // 22
+    {23, 18, 0},      // 23  PRBS23
+    {24, 23, 22, 17, 0}, // 24
+};
+
+//==============================================================================
+// ENGINE STATE (one instance per chandle)
+//==============================================================================
+struct SysIdEngine {
+    int order;                       // MLS order m
+    uint32_t period;                 // P = 2^m - 1
+    double amplitude;                // Stimulus amplitude A (output is ±A)
+    double sample_rate;              // Sample rate (Hz) for frequency queries
+    int warmup_periods;              // Periods discarded before averaging
+    int avg_periods;                 // Periods summed into the accumulator
+
+    // Up to 2^24 entries each: huge-page buffers (dpi_alloc.h)
+    dpi_vector<uint8_t> mls{DpiAllocator<uint8_t>("sysid.mls")};             // a[n] in {0,1}, one period
+    dpi_vector<uint32_t> in_index{DpiAllocator<uint32_t>("sysid.in_index")};  // n -> FWHT index (LFSR state s_n)
+    dpi_vector<uint32_t> out_index{DpiAllocator<uint32_t>("sysid.out_index")}; // k -> FWHT index (functional l_{P-k})
+    dpi_vector<double> acc{DpiAllocator<double>("sysid.acc")};               // Period-folded output accumulator
+    dpi_vector<double> impulse{DpiAllocator<double>("sysid.impulse")};       // Identified impulse response h[k]
+
+    uint64_t stim_count;             // Stimulus samples emitted
+    uint64_t capture_count;          // Output samples captured
+    int solved;
+};
+
+//==============================================================================
+// INTERNAL HELPERS
+//==============================================================================
+static inline int parity32(uint32_t v) {
+    return __builtin_parity(v);
+}
+
+/**
+ * Build one MLS period plus the two index permutations that map the
+ * circulant MLS correlation onto a Walsh-Hadamard transform.
+ *
+ * With s_n = (a[n], ..., a[n+m-1]) and a linear functional l_i such that
+ * a[n+i] = <l_i, s_n> (mod 2), the correlation
+ *     R[k] = sum_n y[n] (-1)^a[n-k] = sum_n y[n] (-1)^<l_{P-k}, s_n>
+ * is exactly the WHT of y scattered to positions s_n, read at l_{P-k}.
+ */
+static void build_sequence(SysIdEngine *e) {
+    const int m = e->order;
+    const uint32_t P = e->period;
+
+    // Recurrence offsets: a[n+m] = XOR_t a[n+t], t = m - k for each tap k
+    std::vector<int> rec;
+    for (int i = 0; MLS_TAPS[m][i] != 0; i++) {
+        rec.push_back(m - MLS_TAPS[m][i]);
+    }
+
+    e->mls.assign(P, 0);
+    e->in_index.assign(P, 0);
+    e->out_index.assign(P, 0);
+
+    // Sequence: seed state = all ones
+    std::vector<uint8_t> a(P + m);
+    for (int i = 0; i < m; i++) a[i] = 1;
+    for (uint32_t n = 0; n + m < P + m; n++) {
+        uint8_t bit = 0;
+        for (int t : rec) bit ^= a[n + t];
+        a[n + m] = bit;
+    }
+
+    uint32_t state = (1u << m) - 1;  // bit t of s_n = a[n+t]
+    for (uint32_t n = 0; n < P; n++) {
+        e->mls[n] = a[n];
+        e->in_index[n] = state;
+        state = (state >> 1) | ((uint32_t)a[n + m] << (m - 1));
+    }
+
+    // Functionals: l_i = e_i for i < m, then the same recurrence on masks
+    std::vector<uint32_t> l(P);
+    for (uint32_t i = 0; i < P; i++) {
+        if (i < (uint32_t)m) {
+            l[i] = 1u << i;
+        } else {
+            uint32_t mask = 0;
+            for (int t : rec) mask ^= l[i - m + t];
+            l[i] = mask;
+        }
+    }
+    for (uint32_t k = 0; k < P; k++) {
+        e->out_index[k] = l[(P - k) % P];
+    }
+}
+
+/** In-place unnormalized Fast Walsh-Hadamard Transform (length 2^m). */
+static void fwht(double *x, uint32_t n) {
+    for (uint32_t len = 1; len < n; len <<= 1) {
+        for (uint32_t i = 0; i < n; i += len << 1) {
+            for (uint32_t j = i; j < i + len; j++) {
+                const double a = x[j];
+                const double b = x[j + len];
+                x[j] = a + b;
+                x[j + len] = a - b;
+            }
+        }
+    }
+}
+
+/** In-place iterative radix-2 FFT (n must be a power of two). */
+static void fft_radix2(std::vector<std::complex<double>> &x) {
+    const size_t n = x.size();
+    for (size_t i = 1, j = 0; i < n; i++) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(x[i], x[j]);
+    }
+    for (size_t len = 2; len <= n; len <<= 1) {
+        const double ang = -2.0 * M_PI / (double)len;
+        const std::complex<double> wlen(cos(ang), sin(ang));
+        for (size_t i = 0; i < n; i += len) {
+            std::complex<double> w(1.0, 0.0);
+            for (size_t j = 0; j < len / 2; j++) {
+                const std::complex<double> u = x[i + j];
+                const std::complex<double> v = x[i + j + len / 2] * w;
+                x[i + j] = u + v;
+                x[i + j + len / 2] = u - v;
+                w *= wlen;
+            }
+        }
+    }
+}
+
+/** Direct DTFT of the identified impulse at one frequency. */
+static std::complex<double> response_at(const SysIdEngine *e, double freq_hz) {
+    const double w = -2.0 * M_PI * freq_hz / e->sample_rate;
+    const std::complex<double> step(cos(w), sin(w));
+    std::complex<double> rot(1.0, 0.0);
+    std::complex<double> sum(0.0, 0.0);
+    for (double h : e->impulse) {
+        sum += h * rot;
+        rot *= step;
+    }
+    return sum;
+}
+
+static inline uint64_t samples_needed(const SysIdEngine *e) {
+    return (uint64_t)(e->warmup_periods + e->avg_periods) * e->period;
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// DPI-C EXPORTED FUNCTIONS
+//==============================================================================
+/**
+ * DPI-C Function: dpi_sysid_create
+ *
+ * Allocates an identification engine.
+ *
+ * Args:
+ *   order          : MLS order m (3..24); period is 2^m - 1 samples
+ *   amplitude      : Stimulus amplitude A (V); stimulus is ±A
+ *   sample_rate_hz : Rate at which next_stimulus/capture are called
+ *   warmup_periods : Periods discarded while the DUT settles (>= 0)
+ *   avg_periods    : Periods averaged for the estimate (>= 1)
+ *
+ * Returns:
+ *   chandle: Engine handle, or NULL on invalid arguments
+ */
+void *dpi_sysid_create(int order, double amplitude, double sample_rate_hz,
+                       int warmup_periods, int avg_periods) {
+    if (order < SYSID_MIN_ORDER || order > SYSID_MAX_ORDER ||
+        amplitude <= 0.0 || sample_rate_hz <= 0.0 ||
+        warmup_periods < 0 || avg_periods < 1) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_sysid_create: invalid arguments "
+                "(order=%d, A=%g, fs=%g, warmup=%d, avg=%d)\n",
+                order, amplitude, sample_rate_hz, warmup_periods, avg_periods);
+        return NULL;
+    }
+
+    // Declared needs: engine plus the per-period tables, including the
+    // impulse response that solve() fills later
+    const size_t P = ((size_t)1 << order) - 1;
+    SysIdEngine *e = dpi_arena_new<SysIdEngine>(
+        dpi_arena_need<SysIdEngine>() + dpi_arena_need<uint8_t>(P) +
+        2 * dpi_arena_need<uint32_t>(P) + 2 * dpi_arena_need<double>(P), "sysid");
+    e->order = order;
+    e->period = (uint32_t)P;
+    e->amplitude = amplitude;
+    e->sample_rate = sample_rate_hz;
+    e->warmup_periods = warmup_periods;
+    e->avg_periods = avg_periods;
+    e->stim_count = 0;
+    e->capture_count = 0;
+    e->solved = 0;
+
+    build_sequence(e);
+    e->acc.assign(e->period, 0.0);
+    e->impulse.reserve(e->period);
+
+    fprintf(stderr, "[DPI-C INFO] sysid: MLS order %d (P=%u), %d warmup + %d "
+            "averaged periods = %llu samples\n",
+            order, e->period, warmup_periods, avg_periods,
+            (unsigned long long)samples_needed(e));
+    return e;
+}
+
+/**
+ * DPI-C Function: dpi_sysid_next_stimulus
+ *
+ * Returns the next stimulus sample (+A for a[n]=0, -A for a[n]=1).
+ * The sequence repeats every period for as long as it is called.
+ */
+double dpi_sysid_next_stimulus(void *handle) {
+    SysIdEngine *e = (SysIdEngine *)handle;
+    if (e == NULL) return 0.0;
+    const uint8_t bit = e->mls[e->stim_count % e->period];
+    e->stim_count++;
+    return bit ? -e->amplitude : e->amplitude;
+}
+
+/**
+ * DPI-C Function: dpi_sysid_capture
+ *
+ * Records one DUT output sample. Sample i is paired with stimulus i, so any
+ * pipeline latency of the DUT simply shows up as delay in the impulse.
+ *
+ * Returns:
+ *   int: 1 once enough periods have been captured to solve, else 0
+ */
+int dpi_sysid_capture(void *handle, double y) {
+    SysIdEngine *e = (SysIdEngine *)handle;
+    if (e == NULL) return 0;
+
+    const uint64_t n = e->capture_count++;
+    const uint64_t skip = (uint64_t)e->warmup_periods * e->period;
+    if (n >= skip && n < samples_needed(e)) {
+        e->acc[n % e->period] += y;
+    }
+    return e->capture_count >= samples_needed(e) ? 1 : 0;
+}
+
+/**
+ * DPI-C Function: dpi_sysid_solve
+ *
+ * Runs the FWHT cross-correlation and fills the impulse response.
+ *
+ * Returns:
+ *   int: 0 on success, -1 if not enough samples have been captured
+ */
+int dpi_sysid_solve(void *handle) {
+    SysIdEngine *e = (SysIdEngine *)handle;
+    if (e == NULL) return -1;
+    if (e->capture_count < samples_needed(e)) {
+        fprintf(stderr, "[DPI-C ERROR] sysid: solve() after %llu of %llu samples\n",
+                (unsigned long long)e->capture_count,
+                (unsigned long long)samples_needed(e));
+        return -1;
+    }
+
+    const uint32_t P = e->period;
+    const uint32_t N = P + 1;
+    const double inv_avg = 1.0 / (double)e->avg_periods;
+
+    dpi_vector<double> buf(N, 0.0, DpiAllocator<double>("sysid.fwht"));
+    for (uint32_t n = 0; n < P; n++) {
+        buf[e->in_index[n]] = e->acc[n] * inv_avg;
+    }
+    fwht(buf.data(), N);
+
+    // R[k] = A*((P+1) h[k] - sum h) and sum_k R[k] = A * sum h
+    dpi_vector<double> r(P, DpiAllocator<double>("sysid.xcorr"));
+    double r_sum = 0.0;
+    for (uint32_t k = 0; k < P; k++) {
+        r[k] = buf[e->out_index[k]];
+        r_sum += r[k];
+    }
+    const double scale = 1.0 / (e->amplitude * (double)N);
+    e->impulse.resize(P);
+    for (uint32_t k = 0; k < P; k++) {
+        e->impulse[k] = (r[k] + r_sum) * scale;
+    }
+
+    e->solved = 1;
+    return 0;
+}
+
+/**
+ * DPI-C Function: dpi_sysid_impulse
+ *
+ * Returns impulse tap h[k] (0 <= k < 2^m - 1); 0.0 before solve().
+ */
+double dpi_sysid_impulse(void *handle, int k) {
+    SysIdEngine *e = (SysIdEngine *)handle;
+    if (e == NULL || !e->solved || k < 0 || (uint32_t)k >= e->period) return 0.0;
+    return e->impulse[k];
+}
+
+/**
+ * DPI-C Function: dpi_sysid_gain_db
+ *
+ * Returns |H(f)| in dB at an arbitrary frequency (direct DTFT of the
+ * identified impulse, O(P)). Use for spot checks against §5.2 key points.
+ */
+double dpi_sysid_gain_db(void *handle, double freq_hz) {
+    SysIdEngine *e = (SysIdEngine *)handle;
+    if (e == NULL || !e->solved) return -INFINITY;
+    return 20.0 * log10(std::abs(response_at(e, freq_hz)));
+}
+
+/**
+ * DPI-C Function: dpi_sysid_phase_deg
+ *
+ * Returns arg(H(f)) in degrees at an arbitrary frequency.
+ */
+double dpi_sysid_phase_deg(void *handle, double freq_hz) {
+    SysIdEngine *e = (SysIdEngine *)handle;
+    if (e == NULL || !e->solved) return 0.0;
+    return std::arg(response_at(e, freq_hz)) * 180.0 / M_PI;
+}
+
+/**
+ * DPI-C Function: dpi_sysid_write_bode
+ *
+ * Writes the full Bode plot (every FFT bin from DC to Nyquist) as CSV:
+ *   freq_hz,gain_db,phase_deg
+ * The impulse is zero-padded from P to P+1 = 2^m points for a radix-2 FFT.
+ *
+ * Returns:
+ *   int: Number of frequency points written, or -1 on error
+ */
+int dpi_sysid_write_bode(void *handle, const char *path) {
+    SysIdEngine *e = (SysIdEngine *)handle;
+    if (e == NULL || !e->solved) return -1;
+
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        fprintf(stderr, "[DPI-C ERROR] sysid: cannot open %s\n", path);
+        return -1;
+    }
+
+    const size_t n = (size_t)e->period + 1;
+    std::vector<std::complex<double>> spec(n);
+    for (size_t i = 0; i < e->period; i++) spec[i] = e->impulse[i];
+    spec[n - 1] = 0.0;
+    fft_radix2(spec);
+
+    fprintf(f, "freq_hz,gain_db,phase_deg\n");
+    int points = 0;
+    for (size_t k = 0; k <= n / 2; k++) {
+        const double freq = e->sample_rate * (double)k / (double)n;
+        fprintf(f, "%.9e,%.6f,%.4f\n", freq,
+                20.0 * log10(std::abs(spec[k])),
+                std::arg(spec[k]) * 180.0 / M_PI);
+        points++;
+    }
+    fclose(f);
+
+    fprintf(stderr, "[DPI-C INFO] sysid: wrote %d Bode points to %s\n", points, path);
+    return points;
+}
+
+/**
+ * DPI-C Function: dpi_sysid_destroy
+ *
+ * Frees the engine. The handle must not be used afterwards.
+ */
+void dpi_sysid_destroy(void *handle) {
+    dpi_arena_delete((SysIdEngine *)handle);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * =============================================================================
+ * IMPLEMENTATION NOTES
+ * =============================================================================
+ *
+ * 1. Why MLS + Hadamard instead of a sine sweep:
+ *    - Sine sweep (§5.1): one steady-state run per frequency point
+ *    - MLS: one run of (WARMUP + AVG) × (2^m - 1) samples gives every
+ *      frequency bin at once, e.g. PRBS15 @ 1 sample/UI = 32767 samples
+ *    - MLS autocorrelation is two-valued (P at lag 0, -1 elsewhere), so the
+ *      cross-correlation is an exact deconvolution after the DC correction
+ *
+ * 2. Scaling:
+ *    - R[k] = A × ((P+1)·h[k] - Σh), Σ_k R[k] = A × Σh
+ *    - h[k] = (R[k] + ΣR) / (A × (P+1))
+ *    - Exact as long as the DUT impulse fits in one period (choose m so that
+ *      2^m - 1 exceeds the settling time in samples)
+ *
+ * 3. Fast Walsh-Hadamard Transform:
+ *    - The circulant MLS matrix is a row/column permutation of a Sylvester
+ *      Hadamard matrix; in_index/out_index are those permutations
+ *    - Cost: m × 2^m additions (no multiplies), vs O(P^2) direct correlation
+ *
+ * 4. Averaging and nonlinearity:
+ *    - Noise drops as 1/sqrt(AVG); keep A small enough for the DUT to stay
+ *      linear (saturation spreads as spikes across the impulse)
+ *
+ * 5. Memory (order 24): 3 × 2^24 × 4 B indices + 2^24 × 8 B accumulator
+ *    + 2^24 × 8 B FWHT buffer ≈ 450 MB. Orders 7..15 need < 2 MB.
+ *
+ * 6. Verilator Compilation:
+ *    - Add to test_config.yaml:
+ *      verilator_extra_flags:
+ *        - ../dpi/dpi_sysid.cpp
+ *    - SystemVerilog imports:
+ *      import "DPI-C" function chandle dpi_sysid_create(input int order,
+ *          input real amplitude, input real sample_rate_hz,
+ *          input int warmup_periods, input int avg_periods);
+ *      import "DPI-C" function real dpi_sysid_next_stimulus(input chandle h);
+ *      import "DPI-C" function int  dpi_sysid_capture(input chandle h, input real y);
+ *      import "DPI-C" function int  dpi_sysid_solve(input chandle h);
+ *
+ * 7. Thread Safety:
+ *    - Each handle is independent; a single handle must not be shared
+ *      between threads without external locking
+ *
+ * =============================================================================
+ */
@@ -0,0 +1,683 @@
+/**
+ * dpi_tie.cpp - DPI-C Time-Interval-Error Capture and Jitter Decomposition
+ *
+ * rx_jitter_tolerance and the PLL jitter requirements in spec/test_strategy.md
+ * (TX.6: RJ < 2 ps, TJ < 0.25 UI) need RJ / DJ / PJ / DCD numbers. Extracting
+ * edges from VCD files and post-processing them in Python does not scale to
+ * 1e7-UI runs; this engine measures the edges during simulation instead.
+ *
+ * Features:
+ * - Edge capture from `real` waveform blocks (vref crossings, linear
+ *   interpolation, also across block boundaries) or from edge times directly
+ * - TIE against an ideal clock (fixed UI, phase of the first edge) or a
+ *   recovered clock (second-order CDR loop with a configurable bandwidth)
+ * - Jitter decomposition:
+ *   - DCD: mean TIE of rising minus falling edges
+ *   - DDJ: peak-to-peak of the TIE mean conditioned on the preceding bits
+ *   - PJ:  spectral peaks of the averaged residual TIE spectrum
+ *   - RJ:  residual RMS after DDJ and PJ are removed
+ *   - TJ(BER) = DDJ + PJ(p-p) + 2·Q(BER)·RJ
+ * - TIE histogram, residual spectrum (CSV) and a text report
+ * - Checkpoint: dpi_tie_save / dpi_tie_restore write and reload the whole
+ *   engine state as one blob
+ *
+ * Everything is streaming: memory is the FFT segment, the spectrum
+ * accumulator, the histogram and the pattern table (~200 KB at the default
+ * FFT length), independent of run length.
+ *
+ * Author: Generated for SerDes jitter analysis
+ * Date: 2025
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "dpi_alloc.h"
+
+//==============================================================================
+// CONFIGURATION
+//==============================================================================
+#define TIE_HIST_BINS       2048      // TIE histogram bins over ±TIE_HIST_RANGE
+#define TIE_HIST_RANGE      0.5       // UI
+#define TIE_DDJ_BITS        5         // Preceding bits in the DDJ pattern key
+#define TIE_DDJ_MIN_HITS    32        // Patterns with fewer edges are ignored
+#define TIE_MIN_FFT         256
+#define TIE_MAX_FFT         65536
+#define TIE_MIN_SEGMENTS    4         // PJ detection needs this many averages
+#define TIE_PJ_FACTOR       20.0      // Spur threshold: 13 dB over median floor
+#define TIE_PJ_SPAN         3         // Bins either side of a spur (Hann lobe)
+#define TIE_MAX_PJ          16
+
+//==============================================================================
+// ENGINE STATE
+//==============================================================================
+struct PjTone {
+    double freq_ui;                 // Cycles per UI
+    double amp_ui;                  // Amplitude (UI, 0-peak)
+};
+
+struct PatternStat {
+    uint64_t n;
+    double sum;
+};
+
+struct TieEngine {
+    // Configuration
+    double ui_s;
+    double vref;
+    double kp, ki;                  // CDR loop gains per edge (0 = ideal clock)
+    int fft_len;
+
+    // Edge detection
+    double prev_v, prev_t;
+    int have_prev;
+
+    // Reference clock: boundary k_clk sits at t_clk, period t_ui
+    int locked;
+    long long k_clk;
+    double t_clk;
+    double t_ui;
+    double last_tie;
+
+    // TIE statistics (UI)
+    uint64_t edges;
+    double mean, m2;                // Welford
+    double tie_min, tie_max;
+    uint64_t n_rise, n_fall;
+    double sum_rise, sum_fall;
+    dpi_vector<uint64_t> hist;
+
+    // Bit history for DDJ (bit value after each UI, newest in bit 0)
+    uint64_t bits;
+    int bits_known;
+    int level;                      // Current data level (1 after a rising edge)
+    dpi_vector<PatternStat> pattern;    // [polarity << TIE_DDJ_BITS | history]
+
+    // Residual (TIE minus pattern mean)
+    uint64_t res_n;
+    double res_mean, res_m2;
+    long long res_k;                // UI index of the last residual
+    double res_prev;
+
+    // Spectrum: residual resampled per UI, Hann-windowed segments
+    dpi_vector<double> seg;
+    int seg_fill;
+    dpi_vector<double> window;
+    double window_power;            // Σ w²
+    dpi_vector<std::complex<double>> fft_buf;
+    dpi_vector<double> psd;         // Accumulated one-sided power per bin
+    int segments;
+
+    // Analysis results
+    int analyzed;
+    dpi_vector<PjTone> pj;
+    double dcd, ddj, pj_pp, rj;
+};
+
+//==============================================================================
+// HELPERS
+//==============================================================================
+/** Q such that Φc(Q) = p (bisection on erfc, p in (0, 0.5]). */
+static double tie_q_of_p(double p) {
+    if (p >= 0.5) return 0.0;
+    double lo = 0.0, hi = 40.0;
+    for (int i = 0; i < 100; i++) {
+        const double mid = 0.5 * (lo + hi);
+        if (0.5 * erfc(mid / M_SQRT2) > p) lo = mid; else hi = mid;
+    }
+    return 0.5 * (lo + hi);
+}
+
+/** In-place iterative radix-2 FFT (n = power of two). */
+static void tie_fft(dpi_vector<std::complex<double>> &a) {
+    const size_t n = a.size();
+    for (size_t i = 1, j = 0; i < n; i++) {
+        size_t bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j) std::swap(a[i], a[j]);
+    }
+    for (size_t len = 2; len <= n; len <<= 1) {
+        const double ang = -2.0 * M_PI / (double)len;
+        const std::complex<double> wl(cos(ang), sin(ang));
+        for (size_t i = 0; i < n; i += len) {
+            std::complex<double> w(1.0, 0.0);
+            for (size_t k = 0; k < len / 2; k++) {
+                const std::complex<double> u = a[i + k];
+                const std::complex<double> v = a[i + k + len / 2] * w;
+                a[i + k] = u + v;
+                a[i + k + len / 2] = u - v;
+                w *= wl;
+            }
+        }
+    }
+}
+
+//==============================================================================
+// SPECTRUM ACCUMULATION
+//==============================================================================
+static void tie_flush_segment(TieEngine *e) {
+    const int n = e->fft_len;
+    for (int i = 0; i < n; i++) e->fft_buf[i] = std::complex<double>(e->seg[i] * e->window[i], 0.0);
+    tie_fft(e->fft_buf);
+    // One-sided power per bin; Σ over bins 1..n/2 equals the segment variance
+    const double norm = 1.0 / (n * e->window_power);
+    for (int k = 0; k <= n / 2; k++) {
+        const double p = std::norm(e->fft_buf[k]) * norm;
+        e->psd[k] += (k == 0 || k == n / 2) ? p : 2.0 * p;
+    }
+    e->segments++;
+    e->seg_fill = 0;
+}
+
+static void tie_push_residual(TieEngine *e, long long k, double r) {
+    const long long gap = k - e->res_k;
+    if (e->edges == 1 || gap <= 0 || gap > e->fft_len) {
+        // Start (or restart after a long gap) a segment at this edge
+        e->seg_fill = 0;
+    } else {
+        // Linear interpolation over the UIs without an edge
+        for (long long j = 1; j < gap; j++) {
+            e->seg[e->seg_fill++] = e->res_prev + (r - e->res_prev) * (double)j / (double)gap;
+            if (e->seg_fill == e->fft_len) tie_flush_segment(e);
+        }
+    }
+    e->seg[e->seg_fill++] = r;
+    if (e->seg_fill == e->fft_len) tie_flush_segment(e);
+    e->res_k = k;
+    e->res_prev = r;
+}
+
+//==============================================================================
+// EDGE PROCESSING
+//==============================================================================
+static void tie_add_edge(TieEngine *e, double t, int rising) {
+    if (!e->locked) {
+        e->t_clk = t;
+        e->k_clk = 0;
+        e->locked = 1;
+    }
+    // Nearest reference boundary
+    const long long m = (long long)floor((t - e->t_clk) / e->t_ui + 0.5);
+    const long long k = e->k_clk + m;
+    const double expected = e->t_clk + (double)m * e->t_ui;
+    const double tie = (t - expected) / e->ui_s;
+    e->last_tie = tie;
+
+    // Recovered clock: proportional phase step + integral period correction
+    e->t_clk = expected + e->kp * tie * e->ui_s;
+    e->t_ui += e->ki * tie * e->ui_s;
+    e->k_clk = k;
+
+    // TIE statistics
+    e->edges++;
+    const double d = tie - e->mean;
+    e->mean += d / (double)e->edges;
+    e->m2 += d * (tie - e->mean);
+    if (tie < e->tie_min) e->tie_min = tie;
+    if (tie > e->tie_max) e->tie_max = tie;
+    if (rising) { e->n_rise++; e->sum_rise += tie; }
+    else        { e->n_fall++; e->sum_fall += tie; }
+    int hb = (int)((tie + TIE_HIST_RANGE) / (2.0 * TIE_HIST_RANGE) * TIE_HIST_BINS);
+    hb = hb < 0 ? 0 : (hb >= TIE_HIST_BINS ? TIE_HIST_BINS - 1 : hb);
+    e->hist[hb]++;
+
+    // Bit history: the previous level held for the m UIs since the last edge
+    if (e->edges > 1 && m > 0) {
+        const int run = (int)std::min<long long>(m, 64);
+        e->bits = (run >= 64) ? (e->level ? ~0ULL : 0ULL)
+                              : ((e->bits << run) | (e->level ? ((1ULL << run) - 1) : 0ULL));
+        e->bits_known = std::min(e->bits_known + run, 64);
+    }
+    e->level = rising ? 1 : 0;
+
+    // DDJ pattern mean and residual
+    double r = tie - e->mean;
+    int settled = 0;
+    if (e->bits_known >= TIE_DDJ_BITS) {
+        const int key = (rising << TIE_DDJ_BITS) | (int)(e->bits & ((1u << TIE_DDJ_BITS) - 1));
+        PatternStat &ps = e->pattern[key];
+        if (ps.n >= TIE_DDJ_MIN_HITS) {
+            r = tie - ps.sum / (double)ps.n;
+            settled = 1;
+        }
+        ps.n++;
+        ps.sum += tie;
+    }
+    tie_push_residual(e, k, r);
+    // Residual statistics only once the pattern mean has settled
+    if (settled) {
+        e->res_n++;
+        const double dr = r - e->res_mean;
+        e->res_mean += dr / (double)e->res_n;
+        e->res_m2 += dr * (r - e->res_mean);
+    }
+    e->analyzed = 0;
+}
+
+//==============================================================================
+// ANALYSIS
+//==============================================================================
+static void tie_analyze(TieEngine *e) {
+    e->dcd = (e->n_rise && e->n_fall)
+                 ? e->sum_rise / (double)e->n_rise - e->sum_fall / (double)e->n_fall : 0.0;
+
+    double pmin = INFINITY, pmax = -INFINITY;
+    for (const PatternStat &ps : e->pattern) {
+        if (ps.n < TIE_DDJ_MIN_HITS) continue;
+        const double mu = ps.sum / (double)ps.n;
+        pmin = std::min(pmin, mu);
+        pmax = std::max(pmax, mu);
+    }
+    e->ddj = (pmax > pmin) ? pmax - pmin : 0.0;
+
+    // Spurs: contiguous runs of bins above TIE_PJ_FACTOR × median floor
+    e->pj.clear();
+    double pj_power = 0.0;
+    const int half = e->fft_len / 2;
+    if (e->segments >= TIE_MIN_SEGMENTS) {
+        std::vector<double> p(e->psd.begin() + 1, e->psd.end());
+        std::nth_element(p.begin(), p.begin() + p.size() / 2, p.end());
+        const double floor_p = p[p.size() / 2];
+        const double thr = TIE_PJ_FACTOR * floor_p;
+        int k = 2;                  // Bins 0-1 hold the window leakage of DC
+        while (k <= half) {
+            if (e->psd[k] <= thr) { k++; continue; }
+            int hi = k;
+            while (hi + 1 <= half && e->psd[hi + 1] > thr) hi++;
+            const int a = std::max(1, k - TIE_PJ_SPAN);
+            const int b = std::min(half, hi + TIE_PJ_SPAN);
+            double pw = 0.0, moment = 0.0;
+            for (int j = a; j <= b; j++) {
+                const double x = e->psd[j] / e->segments - floor_p / e->segments;
+                if (x <= 0.0) continue;
+                pw += x;
+                moment += x * j;
+            }
+            if (pw > 0.0 && (int)e->pj.size() < TIE_MAX_PJ) {
+                PjTone tone = {moment / pw / e->fft_len, sqrt(2.0 * pw)};
+                e->pj.push_back(tone);
+                pj_power += pw;
+            }
+            k = b + 1;
+        }
+        std::sort(e->pj.begin(), e->pj.end(),
+                  [](const PjTone &x, const PjTone &y) { return x.amp_ui > y.amp_ui; });
+    }
+    e->pj_pp = 0.0;
+    for (const PjTone &t : e->pj) e->pj_pp += 2.0 * t.amp_ui;
+
+    const double res_var = e->res_n > 1 ? e->res_m2 / (double)(e->res_n - 1) : 0.0;
+    e->rj = sqrt(std::max(0.0, res_var - pj_power));
+    e->analyzed = 1;
+}
+
+static inline void tie_ensure(TieEngine *e) {
+    if (!e->analyzed) tie_analyze(e);
+}
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//==============================================================================
+// DPI-C EXPORTED FUNCTIONS
+//==============================================================================
+/**
+ * DPI-C Function: dpi_tie_create
+ *
+ * Args:
+ *   ui_s    : Nominal unit interval (s) - the edge spacing of the reference
+ *             clock (half the period for a clock signal)
+ *   vref    : Crossing threshold for waveform input (V)
+ *   cdr_bw  : 0 = ideal clock at ui_s; > 0 = recovered clock with this
+ *             loop bandwidth in cycles per edge (e.g. 1/1667 × 2 for a PCIe
+ *             CDR on data with transition density 0.5), at most 0.05
+ *   fft_len : Spectrum segment length in UIs (power of two, 256..65536);
+ *             frequency resolution = 1 / fft_len cycles per UI
+ *
+ * Returns:
+ *   chandle: Engine handle, or NULL on invalid arguments
+ */
+void *dpi_tie_create(double ui_s, double vref, double cdr_bw, int fft_len) {
+    if (ui_s <= 0.0 || cdr_bw < 0.0 || cdr_bw > 0.05 || fft_len < TIE_MIN_FFT ||
+        fft_len > TIE_MAX_FFT || (fft_len & (fft_len - 1)) != 0) {
+        fprintf(stderr, "[DPI-C ERROR] dpi_tie_create: invalid arguments\n");
+        return NULL;
+    }
+    // Declared needs: engine, TIE histogram, pattern table, the spectrum
+    // buffers (segment, window, FFT, PSD) and the tone list
+    TieEngine *e = dpi_arena_new<TieEngine>(
+        dpi_arena_need<TieEngine>() + dpi_arena_need<uint64_t>(TIE_HIST_BINS) +
+        dpi_arena_need<PatternStat>(2u << TIE_DDJ_BITS) +
+        2 * dpi_arena_need<double>(fft_len) +
+        dpi_arena_need<std::complex<double>>(fft_len) +
+        dpi_arena_need<double>(fft_len / 2 + 1) +
+        dpi_arena_need<PjTone>(TIE_MAX_PJ), "tie");
+    e->ui_s = ui_s;
+    e->vref = vref;
+    // Second-order loop, damping 1: ωn·2ζ = kp per edge, ki = kp² / 4
+    e->kp = 2.0 * M_PI * cdr_bw;
+    e->ki = e->kp * e->kp / 4.0;
+    e->fft_len = fft_len;
+    e->have_prev = 0;
+    e->locked = 0;
+    e->t_ui = ui_s;
+    e->last_tie = 0.0;
+    e->edges = 0;
+    e->mean = e->m2 = 0.0;
+    e->tie_min = INFINITY;
+    e->tie_max = -INFINITY;
+    e->n_rise = e->n_fall = 0;
+    e->sum_rise = e->sum_fall = 0.0;
+    e->hist.assign(TIE_HIST_BINS, 0);
+    e->bits = 0;
+    e->bits_known = 0;
+    e->level = 0;
+    e->pattern.assign(2u << TIE_DDJ_BITS, PatternStat{0, 0.0});
+    e->res_n = 0;
+    e->res_mean = e->res_m2 = 0.0;
+    e->res_k = 0;
+    e->res_prev = 0.0;
+    e->seg.assign(fft_len, 0.0);
+    e->seg_fill = 0;
+    e->window.resize(fft_len);
+    e->window_power = 0.0;
+    for (int i = 0; i < fft_len; i++) {
+        e->window[i] = 0.5 - 0.5 * cos(2.0 * M_PI * i / fft_len);
+        e->window_power += e->window[i] * e->window[i];
+    }
+    e->fft_buf.resize(fft_len);
+    e->psd.assign(fft_len / 2 + 1, 0.0);
+    e->pj.reserve(TIE_MAX_PJ);
+    e->segments = 0;
+    e->analyzed = 0;
+    return e;
+}
+
+/**
+ * DPI-C Function: dpi_tie_add_waveform
+ *
+ * Records the vref crossings of a uniformly sampled block v[0..n-1] at
+ * times t0 + i·dt (linear interpolation between samples).
+ *
+ * Returns:
+ *   int: Number of edges found in this block
+ */
+int dpi_tie_add_waveform(void *handle, const double *v, int n, double t0, double dt) {
+    TieEngine *e = (TieEngine *)handle;
+    int found = 0;
+    for (int i = 0; i < n; i++) {
+        const double t = t0 + i * dt;
+        if (e->have_prev) {
+            const double a = e->prev_v - e->vref;
+            const double b = v[i] - e->vref;
+            if ((a < 0.0 && b >= 0.0) || (a >= 0.0 && b < 0.0)) {
+                tie_add_edge(e, e->prev_t + (t - e->prev_t) * a / (a - b), b >= 0.0);
+                found++;
+            }
+        }
+        e->prev_v = v[i];
+        e->prev_t = t;
+        e->have_prev = 1;
+    }
+    return found;
+}
+
+/** DPI-C Function: dpi_tie_add_edge - one edge time (s), rising = 1 / falling = 0. */
+void dpi_tie_add_edge(void *handle, double t, int rising) {
+    tie_add_edge((TieEngine *)handle, t, rising != 0);
+}
+
+/** DPI-C Function: dpi_tie_last - TIE of the most recent edge (UI). */
+double dpi_tie_last(void *handle) {
+    return ((TieEngine *)handle)->last_tie;
+}
+
+/** DPI-C Function: dpi_tie_period - current reference UI (s); tracks frequency offset. */
+double dpi_tie_period(void *handle) {
+    return ((TieEngine *)handle)->t_ui;
+}
+
+/** DPI-C Function: dpi_tie_edges */
+long long dpi_tie_edges(void *handle) {
+    return (long long)((TieEngine *)handle)->edges;
+}
+
+/** DPI-C Function: dpi_tie_rms - total TIE RMS (UI). */
+double dpi_tie_rms(void *handle) {
+    const TieEngine *e = (const TieEngine *)handle;
+    return e->edges > 1 ? sqrt(e->m2 / (double)(e->edges - 1)) : 0.0;
+}
+
+/** DPI-C Function: dpi_tie_pk_pk - measured TIE peak-to-peak (UI). */
+double dpi_tie_pk_pk(void *handle) {
+    const TieEngine *e = (const TieEngine *)handle;
+    return e->edges ? e->tie_max - e->tie_min : 0.0;
+}
+
+/** DPI-C Function: dpi_tie_dcd - duty-cycle distortion, mean rise - mean fall TIE (UI). */
+double dpi_tie_dcd(void *handle) {
+    TieEngine *e = (TieEngine *)handle;
+    tie_ensure(e);
+    return e->dcd;
+}
+
+/** DPI-C Function: dpi_tie_ddj - data-dependent jitter p-p, includes DCD (UI). */
+double dpi_tie_ddj(void *handle) {
+    TieEngine *e = (TieEngine *)handle;
+    tie_ensure(e);
+    return e->ddj;
+}
+
+/** DPI-C Function: dpi_tie_pj - periodic jitter p-p, sum of 2 × tone amplitudes (UI). */
+double dpi_tie_pj(void *handle) {
+    TieEngine *e = (TieEngine *)handle;
+    tie_ensure(e);
+    return e->pj_pp;
+}
+
+/** DPI-C Function: dpi_tie_pj_count - number of detected PJ tones. */
+int dpi_tie_pj_count(void *handle) {
+    TieEngine *e = (TieEngine *)handle;
+    tie_ensure(e);
+    return (int)e->pj.size();
+}
+
+/** DPI-C Function: dpi_tie_pj_freq - frequency of tone i (Hz), largest first. */
+double dpi_tie_pj_freq(void *handle, int i) {
+    TieEngine *e = (TieEngine *)handle;
+    tie_ensure(e);
+    if (i < 0 || i >= (int)e->pj.size()) return 0.0;
+    return e->pj[i].freq_ui / e->ui_s;
+}
+
+/** DPI-C Function: dpi_tie_pj_amp - amplitude of tone i (UI, 0-peak). */
+double dpi_tie_pj_amp(void *handle, int i) {
+    TieEngine *e = (TieEngine *)handle;
+    tie_ensure(e);
+    if (i < 0 || i >= (int)e->pj.size()) return 0.0;
+    return e->pj[i].amp_ui;
+}
+
+/** DPI-C Function: dpi_tie_rj - random jitter RMS (UI). */
+double dpi_tie_rj(void *handle) {
+    TieEngine *e = (TieEngine *)handle;
+    tie_ensure(e);
+    return e->rj;
+}
+
+/** DPI-C Function: dpi_tie_dj - deterministic jitter p-p = DDJ + PJ (UI). */
+double dpi_tie_dj(void *handle) {
+    TieEngine *e = (TieEngine *)handle;
+    tie_ensure(e);
+    return e->ddj + e->pj_pp;
+}
+
+/**
+ * DPI-C Function: dpi_tie_tj
+ *
+ * Total jitter at the target BER (UI): DJ(p-p) + 2·Q·RJ, with Q from
+ * Φc(Q) = 2·BER / D_T (two Dirac tails, D_T = edges per UI).
+ */
+double dpi_tie_tj(void *handle, double ber) {
+    TieEngine *e = (TieEngine *)handle;
+    tie_ensure(e);
+    const double span = (double)(e->k_clk + 1);
+    const double dt = (e->edges && span > 0.0) ? std::min(1.0, (double)e->edges / span) : 0.5;
+    return e->ddj + e->pj_pp + 2.0 * tie_q_of_p(2.0 * ber / dt) * e->rj;
+}
+
+/**
+ * DPI-C Function: dpi_tie_write_histogram
+ *
+ * CSV: tie_ui,count (non-zero bins only).
+ */
+int dpi_tie_write_histogram(void *handle, const char *path) {
+    const TieEngine *e = (const TieEngine *)handle;
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        fprintf(stderr, "[DPI-C ERROR] tie: cannot open %s\n", path);
+        return -1;
+    }
+    fprintf(f, "tie_ui,count\n");
+    for (int b = 0; b < TIE_HIST_BINS; b++) {
+        if (e->hist[b]) fprintf(f, "%.6f,%llu\n",
+                                -TIE_HIST_RANGE + (b + 0.5) * 2.0 * TIE_HIST_RANGE / TIE_HIST_BINS,
+                                (unsigned long long)e->hist[b]);
+    }
+    fclose(f);
+    return 0;
+}
+
+/**
+ * DPI-C Function: dpi_tie_write_spectrum
+ *
+ * CSV of the averaged residual TIE spectrum: freq_hz,power_ui2
+ * (one-sided power per bin; the bins sum to the residual variance).
+ */
+int dpi_tie_write_spectrum(void *handle, const char *path) {
+    const TieEngine *e = (const TieEngine *)handle;
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        fprintf(stderr, "[DPI-C ERROR] tie: cannot open %s\n", path);
+        return -1;
+    }
+    fprintf(f, "freq_hz,power_ui2\n");
+    const double s = e->segments ? 1.0 / e->segments : 0.0;
+    for (int k = 1; k <= e->fft_len / 2; k++) {
+        fprintf(f, "%.6e,%.6e\n", (double)k / e->fft_len / e->ui_s, e->psd[k] * s);
+    }
+    fclose(f);
+    return 0;
+}
+
+/** DPI-C Function: dpi_tie_write_report - text summary of the decomposition. */
+int dpi_tie_write_report(void *handle, const char *path) {
+    TieEngine *e = (TieEngine *)handle;
+    tie_ensure(e);
+    FILE *f = fopen(path, "w");
+    if (f == NULL) {
+        fprintf(stderr, "[DPI-C ERROR] tie: cannot open %s\n", path);
+        return -1;
+    }
+    const double ps = e->ui_s * 1e12;
+    fprintf(f, "TIE jitter decomposition\n");
+    fprintf(f, "  UI              : %.4f ps (%s clock)\n", ps, e->kp > 0.0 ? "recovered" : "ideal");
+    fprintf(f, "  Edges           : %llu\n", (unsigned long long)e->edges);
+    fprintf(f, "  Spectrum        : %d x %d UI segments\n", e->segments, e->fft_len);
+    fprintf(f, "  TIE RMS         : %.5f UI (%.4f ps)\n", dpi_tie_rms(e), dpi_tie_rms(e) * ps);
+    fprintf(f, "  TIE p-p         : %.5f UI (%.4f ps)\n", dpi_tie_pk_pk(e), dpi_tie_pk_pk(e) * ps);
+    fprintf(f, "  RJ (RMS)        : %.5f UI (%.4f ps)\n", e->rj, e->rj * ps);
+    fprintf(f, "  DCD             : %.5f UI (%.4f ps)\n", e->dcd, e->dcd * ps);
+    fprintf(f, "  DDJ (p-p)       : %.5f UI (%.4f ps)\n", e->ddj, e->ddj * ps);
+    fprintf(f, "  PJ (p-p)        : %.5f UI (%.4f ps)\n", e->pj_pp, e->pj_pp * ps);
+    for (const PjTone &t : e->pj) {
+        fprintf(f, "    tone %.6e Hz : %.5f UI 0-pk\n", t.freq_ui / e->ui_s, t.amp_ui);
+    }
+    fprintf(f, "  DJ (p-p)        : %.5f UI\n", e->ddj + e->pj_pp);
+    fprintf(f, "  TJ @ 1e-12      : %.5f UI\n", dpi_tie_tj(e, 1e-12));
+    fclose(f);
+    return 0;
+}
+
+/**
+ * DPI-C Function: dpi_tie_save / dpi_tie_restore
+ *
+ * Checkpoint the edge, CDR and jitter statistics state to a file and restore it into the same engine
+ * instance later in the run.
+ *
+ * Returns:
+ *   int: 0 on success, -1 on error
+ */
+int dpi_tie_save(void *handle, const char *path) {
+    return dpi_arena_save_file(handle, path, "dpi_tie_save");
+}
+
+int dpi_tie_restore(void *handle, const char *path) {
+    return dpi_arena_restore_file(handle, path, "dpi_tie_restore");
+}
+
+/** DPI-C Function: dpi_tie_destroy */
+void dpi_tie_destroy(void *handle) {
+    dpi_arena_delete((TieEngine *)handle);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * =============================================================================
+ * IMPLEMENTATION NOTES
+ * =============================================================================
+ *
+ * 1. Reference Clock:
+ *    - Each edge is assigned to the nearest reference boundary k;
+ *      TIE = t_edge - t_boundary(k), in UI
+ *    - Ideal clock (cdr_bw = 0): boundaries at the first edge + k·ui_s.
+ *      A frequency offset shows up as a TIE ramp - use the recovered clock
+ *    - Recovered clock: per edge, phase += kp·TIE and UI += kp²/4·TIE
+ *      (second-order loop, damping 1). Jitter below the loop bandwidth is
+ *      tracked and disappears from the TIE, as in a real CDR
+ *
+ * 2. Decomposition (all in UI):
+ *    - DCD = mean(TIE | rising) - mean(TIE | falling)
+ *    - DDJ = max - min of mean(TIE | polarity, previous 5 bits); the bits
+ *      come from the edge spacing, so this needs data or a clock, not
+ *      arbitrary edge streams. DDJ includes DCD
+ *    - Residual = TIE - running pattern mean, resampled once per UI by
+ *      linear interpolation between edges and split into Hann-windowed
+ *      segments; the averaged spectrum is normalized so the bins sum to
+ *      the residual variance
+ *    - PJ tones: runs of bins > 13 dB above the median floor (after >= 4
+ *      segments); tone power = Σ (bin - floor) over the run ± 3 bins,
+ *      amplitude = √(2·power)
+ *    - RJ = √(residual variance - Σ tone power), from the edge residuals
+ *      (the per-UI interpolation low-passes the white floor)
+ *    - TJ(BER) = DDJ + PJ(p-p) + 2·Q·RJ: DJ peak-to-peak, so TJ is
+ *      conservative compared with a dual-Dirac DJ(δδ) (see dpi_eye.cpp)
+ *
+ * 3. Limits:
+ *    - PJ below 2 / fft_len cycles per UI is not resolved; a 4096-UI
+ *      segment resolves tones down to ~UI rate / 2048
+ *    - Pattern means converge after TIE_DDJ_MIN_HITS edges per pattern;
+ *      until then the residual uses the overall mean and is left out of
+ *      the RJ statistics (~2000 edges for random data)
+ *    - TIE outside ±0.5 UI is counted in the histogram end bins
+ *
+ * 4. Memory (fft_len = 4096):
+ *    - Segment + FFT buffer + window + spectrum: ~130 KB
+ *    - Histogram 16 KB, pattern table 1 KB
+ *
+ * 5. Verilator Compilation:
+ *    - Add to test_config.yaml:
+ *      verilator_extra_flags:
+ *        - ../dpi/dpi_tie.cpp
+ *
+ * =============================================================================
+ */
@@ -0,0 +1,78 @@
+/**
+ * adc_model.sv - Behavioral RX ADC (spec/serdes_architecture.md §3.1.1)
+ *
+ * Samples the analog RX signal on each clock and converts it to a signed
+ * code through the DPI-C ADC engine (dpi/dpi_adc.cpp).
+ *
+ * Features:
+ * - Ideal transfer (defaults): adc_out = clamp(round(analog_in × 128), -128, 127)
+ * - Parameterized resolution and full scale
+ * - Optional offset, gain error, thermal noise and INL profile
+ * - One-cycle latency (registered output)
+ *
+ * NOT SYNTHESIZABLE: Uses 'real' type and DPI-C (simulation only)
+ *
+ * Author: Generated for SerDes RX front-end modeling
+ * Date: 2025
+ */
+
+`timescale 1ns / 1ps
+
+module adc_model #(
+    parameter int  BITS = 8,              // Resolution
+    parameter real FULL_SCALE = 1.0,      // Half range (V): [-FS, +FS) → full code range
+    parameter real SAMPLE_RATE = 10.0e9,  // Sample rate (Hz), used for skew only
+    parameter real OFFSET_V = 0.0,        // Input-referred offset (V)
+    parameter real GAIN_ERROR = 0.0,      // Fractional gain error (0.01 = +1%)
+    parameter real NOISE_RMS = 0.0,       // Input-referred thermal noise (V RMS)
+    parameter int  INL_SHAPE = 0,         // 0 = none, 1 = bow, 2 = S-curve
+    parameter real INL_AMPLITUDE = 0.0,   // Peak INL of the shape (LSB)
+    parameter int  SEED = 1               // Noise seed
+) (
+    input  logic                   clk,       // Sample clock
+    input  logic                   rst_n,     // Active-low reset
+    input  real                    analog_in, // Analog input (V)
+    output logic signed [BITS-1:0] adc_out    // Signed output code
+);
+
+    //==========================================================================
+    // DPI-C IMPORTS
+    //==========================================================================
+    import "DPI-C" function chandle dpi_adc_create(input int bits,
+        input real full_scale_v, input real sample_rate_hz, input int num_lanes,
+        input int seed);
+    import "DPI-C" function void dpi_adc_set_lane(input chandle h, input int lane,
+        input real offset_v, input real gain_error, input real skew_s);
+    import "DPI-C" function void dpi_adc_set_noise(input chandle h, input real rms_v);
+    import "DPI-C" function int  dpi_adc_set_inl_profile(input chandle h,
+        input int shape, input real amplitude_lsb, input real sigma_lsb);
+    import "DPI-C" function int  dpi_adc_convert(input chandle h, input real x);
+
+    //==========================================================================
+    // ENGINE SETUP
+    //==========================================================================
+    chandle adc;
+
+    initial begin
+        adc = dpi_adc_create(BITS, FULL_SCALE, SAMPLE_RATE, 1, SEED);
+        if (adc == null) begin
+            $display("ERROR: adc_model: dpi_adc_create failed");
+            $finish;
+        end
+        dpi_adc_set_lane(adc, 0, OFFSET_V, GAIN_ERROR, 0.0);
+        dpi_adc_set_noise(adc, NOISE_RMS);
+        if (INL_SHAPE != 0) void'(dpi_adc_set_inl_profile(adc, INL_SHAPE, INL_AMPLITUDE, 0.0));
+    end
+
+    //==========================================================================
+    // SAMPLING
+    //==========================================================================
+    always_ff @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            adc_out <= '0;
+        end else begin
+            adc_out <= BITS'(dpi_adc_convert(adc, analog_in));
+        end
+    end
+
+endmodule
@@ -1,25 +1,29 @@
-// 8-bit counter with synchronous reset
+// Parameterized-width counter with synchronous reset (8-bit by default)
 // Design Under Test (DUT) for Verilator simulation verification
 
 `timescale 1ns / 1ps
 
-module counter (
-    input  logic       clk,      // Clock input
-    input  logic       rst_n,    // Active-low synchronous reset
-    output logic [7:0] count,    // 8-bit counter output
-    output logic       overflow  // Overflow flag (goes high when counter wraps)
+module counter #(
+    parameter int WIDTH    = 8,      // Counter width (bits)
+    parameter int SATURATE = 0       // 0 = wrap to 0 after max, 1 = hold at max
+) (
+    input  logic             clk,      // Clock input
+    input  logic             rst_n,    // Active-low synchronous reset
+    output logic [WIDTH-1:0] count,    // Counter output
+    output logic             overflow  // Overflow flag (goes high when counter wraps)
 );
 
     // Counter logic
     always_ff @(posedge clk) begin
         if (!rst_n) begin
-            count <= 8'h00;
-        end else begin
+            count <= '0;
+        end else if (SATURATE == 0 || count != '1) begin
             count <= count + 1'b1;
         end
     end
 
     // Combinational overflow flag - high when count is at maximum
-    assign overflow = (count == 8'hFF);
+    // (stays high while a saturating counter holds its maximum)
+    assign overflow = (count == '1);
 
 endmodule
@@ -0,0 +1,85 @@
+/**
+ * dac_model.sv - Behavioral TX DAC (spec/serdes_architecture.md §2.1.4)
+ *
+ * Converts one serial symbol per UI clock to an analog output level through
+ * the DPI-C DAC engine (dpi/dpi_dac.cpp).
+ *
+ * Features:
+ * - Ideal mapping (defaults), × FULL_SCALE:
+ *   NRZ: 0 → -1.0 V, 1 → +1.0 V; PAM4: 00 → -0.75, 01 → -0.25, 10 → +0.25, 11 → +0.75
+ * - PAM4 level mismatch (RLM), finite output bandwidth (single pole) and
+ *   duty-cycle distortion
+ * - analog_out is the driver output at the end of each UI (one sample per
+ *   UI); use the block API of dpi_dac.cpp for oversampled waveforms
+ * - One-cycle latency (registered output)
+ *
+ * NOT SYNTHESIZABLE: Uses 'real' type and DPI-C (simulation only)
+ *
+ * Author: Generated for SerDes TX front-end modeling
+ * Date: 2025
+ */
+
+`timescale 1ns / 1ps
+
+module dac_model #(
+    parameter int  PAM_LEVELS = 2,          // 2 = NRZ, 4 = PAM4
+    parameter real FULL_SCALE = 1.0,        // Output for the outer level (V)
+    parameter real UI_S = 100.0e-12,        // Unit interval (s), for the pole
+    parameter real BANDWIDTH_HZ = 0.0,      // Output pole -3 dB frequency (0 = ideal)
+    parameter real RLM = 1.0,               // PAM4 level-mismatch ratio (1.0 = ideal)
+    parameter real DCD_UI = 0.0             // Duty-cycle distortion (UI)
+) (
+    input  logic       clk,                 // UI clock
+    input  logic       rst_n,               // Active-low reset
+    input  logic [1:0] symbol,              // NRZ: bit 0; PAM4: {MSB, LSB}
+    output real        analog_out           // Output voltage (V)
+);
+
+    //==========================================================================
+    // DPI-C IMPORTS
+    //==========================================================================
+    import "DPI-C" function chandle dpi_dac_create(input int bits, input real full_scale_v,
+        input real ui_s, input int samples_per_ui);
+    import "DPI-C" function int  dpi_dac_set_rlm(input chandle h, input real rlm);
+    import "DPI-C" function void dpi_dac_set_bandwidth(input chandle h, input real f3db_hz);
+    import "DPI-C" function int  dpi_dac_set_dcd(input chandle h, input real dcd_ui);
+    import "DPI-C" function int  dpi_dac_symbols_block(input chandle h, input int symbols[1],
+        input int n, input int pam, output real out[1]);
+
+    //==========================================================================
+    // ENGINE SETUP
+    //==========================================================================
+    chandle dac;
+
+    initial begin
+        dac = dpi_dac_create(8, FULL_SCALE, UI_S, 1);
+        if (dac == null) begin
+            $display("ERROR: dac_model: dpi_dac_create failed");
+            $finish;
+        end
+        if (RLM < 1.0) void'(dpi_dac_set_rlm(dac, RLM));
+        dpi_dac_set_bandwidth(dac, BANDWIDTH_HZ);
+        if (DCD_UI > 0.0) void'(dpi_dac_set_dcd(dac, DCD_UI));
+    end
+
+    //==========================================================================
+    // CONVERSION
+    //==========================================================================
+    // One-symbol block (samples_per_ui = 1)
+    function automatic real dac_convert(input int sym);
+        int  s[1];
+        real o[1];
+        s[0] = sym;
+        void'(dpi_dac_symbols_block(dac, s, 1, PAM_LEVELS, o));
+        return o[0];
+    endfunction
+
+    always_ff @(posedge clk or negedge rst_n) begin
+        if (!rst_n) begin
+            analog_out <= 0.0;
+        end else begin
+            analog_out <= dac_convert(int'(symbol));
+        end
+    end
+
+endmodule
@@ -0,0 +1,115 @@
+/**
+ * gearbox_link.sv - Parallel-Only Serializer → Deserializer Link
+ *
+ * Replaces a serializer (§2.1.3) / deserializer (§3.1.5) pair with one
+ * DPI-C gearbox (dpi/dpi_gearbox.cpp). The serial domain exists only inside
+ * the C++ model: no serial clock is simulated, the RTL sees TX words on
+ * tx_clk and RX words on rx_clk.
+ *
+ * Features:
+ * - Any TX_WIDTH:RX_WIDTH ratio (1..64 bits); rates match when
+ *   TX_WIDTH / T(tx_clk) = RX_WIDTH / T(rx_clk)
+ * - NRZ or PAM4 (optional Gray coding) serial symbols with symbol errors
+ *   at SER (adjacent-level for PAM4)
+ * - slip: one-cycle pulse on rx_clk drops one serial bit (word alignment)
+ * - rx_valid is high for each cycle that delivers a word; low while the
+ *   gearbox holds fewer than RX_WIDTH bits
+ * - rst_n gates pushes, pops and slips; asserting it empties the gearbox
+ *   (queued bits, counters, error position), so no word pushed before the
+ *   reset is delivered after it
+ *
+ * NOT SYNTHESIZABLE: Uses DPI-C (simulation only)
+ *
+ * Author: Generated for SerDes parallel/serial conversion
+ * Date: 2025
+ */
+
+`timescale 1ns / 1ps
+
+module gearbox_link #(
+    parameter int  TX_WIDTH = 32,           // Parallel TX word width (bits)
+    parameter int  RX_WIDTH = 32,           // Parallel RX word width (bits)
+    parameter int  MSB_FIRST = 0,           // 0 = bit 0 sent first (PCIe)
+    parameter int  PAM_LEVELS = 2,          // 2 = NRZ, 4 = PAM4
+    parameter int  GRAY = 0,                // PAM4 Gray coding
+    parameter real SER = 0.0,               // Serial symbol error rate
+    parameter int  SEED = 1                 // Error placement seed
+) (
+    input  logic                tx_clk,     // TX parallel clock
+    input  logic                rx_clk,     // RX parallel clock
+    input  logic                rst_n,      // Active-low reset
+    input  logic                tx_valid,
+    input  logic [TX_WIDTH-1:0] tx_word,
+    input  logic                slip,       // Drop one serial bit (rx_clk)
+    output logic                rx_valid,
+    output logic [RX_WIDTH-1:0] rx_word
+);
+
+    //==========================================================================
+    // DPI-C IMPORTS
+    //==========================================================================
+    import "DPI-C" function chandle dpi_gearbox_create(input int in_width, input int out_width,
+        input int msb_first);
+    import "DPI-C" function int  dpi_gearbox_set_serial(input chandle h, input int pam,
+        input int gray, input real ser, input int seed);
+    import "DPI-C" function int  dpi_gearbox_push(input chandle h, input longint word);
+    import "DPI-C" function int  dpi_gearbox_pop(input chandle h, output longint word);
+    import "DPI-C" function int  dpi_gearbox_slip(input chandle h, input int nbits);
+    import "DPI-C" function void dpi_gearbox_reset(input chandle h);
+    import "DPI-C" function void dpi_gearbox_destroy(input chandle h);
+
+    //==========================================================================
+    // ENGINE SETUP
+    //==========================================================================
+    chandle gb;
+
+    initial begin
+        gb = dpi_gearbox_create(TX_WIDTH, RX_WIDTH, MSB_FIRST);
+        if (gb == null) begin
+            $display("ERROR: gearbox_link: dpi_gearbox_create failed");
+            $finish;
+        end
+        void'(dpi_gearbox_set_serial(gb, PAM_LEVELS, GRAY, SER, SEED));
+    end
+
+    // Harnesses that build and delete many models (tb/gearbox_fuzz.cpp)
+    // call final() on each; free the engine with its model
+    final begin
+        if (gb != null) dpi_gearbox_destroy(gb);
+    end
+
+    // The FIFO lives in C++, so the reset has to reach it explicitly; later
+    // cycles in reset neither push nor pop, one call at assertion suffices
+    always @(negedge rst_n) begin
+        if (gb != null) dpi_gearbox_reset(gb);
+    end
+
+    //==========================================================================
+    // TX SIDE
+    //==========================================================================
+    always_ff @(posedge tx_clk) begin
+        if (rst_n && tx_valid) void'(dpi_gearbox_push(gb, longint'(tx_word)));
+    end
+
+    //==========================================================================
+    // RX SIDE
+    //==========================================================================
+    // {valid, word}
+    function automatic logic [RX_WIDTH:0] rx_pop(input bit do_slip);
+        longint w;
+        int     ok;
+        if (do_slip) void'(dpi_gearbox_slip(gb, 1));
+        ok = dpi_gearbox_pop(gb, w);
+        return {ok[0], RX_WIDTH'(w)};
+    endfunction
+
+    always_ff @(posedge rx_clk or negedge rst_n) begin
+        if (!rst_n) begin
+            rx_valid <= 1'b0;
+            rx_word  <= '0;
+        end else begin
+            {rx_valid, rx_word} <= rx_pop(slip);
+        end
+    end
+
+endmodule
@@ -20,11 +20,15 @@ FFT, IFFTの際の周波数ベクトルの並びはscipy.fft.fft, ifftの仕様
 である．
 負の周波数要素が必要であることに注意．
 
+DPI-C用バイナリのサンプル型は --precision float64 | float32 | int16 で選択する
+(scripts/sample_format.py)．量子化誤差がノイズRMSに対して --tolerance を超えると警告する．
+
 データ数はeven前提でコーディングする．
 このfアレイは scipy.fft.fftfreq() で生成することができるのでそれを使っているが，
 ターゲットNoise Spectrumからtwo-sidedゲインアレイを作る際にはそれが使えないので手動で生成している．
 """
 
+import argparse
 from dataclasses import dataclass
 from typing import NamedTuple
 import numpy as np
@@ -32,11 +36,19 @@ from scipy import fft
 from scipy import signal
 from scipy import interpolate
 import matplotlib.pyplot as plt
-from pathlib import Path
+
+from sample_format import PRECISIONS, DEFAULT_TOLERANCE, HEADER, write_samples, check_precision
 
 
 def main():
-    param = Param(debug=False)
+    parser = argparse.ArgumentParser(description='Custom Noise Generator - Batch Mode (Method 2)')
+    parser.add_argument('--precision', choices=list(PRECISIONS), default='float64',
+                        help='DPI-C用バイナリのサンプル型 (default: float64)')
+    parser.add_argument('--tolerance', type=float, default=DEFAULT_TOLERANCE,
+                        help='量子化誤差RMS / ノイズRMS の上限 (default: %(default)g)')
+    args = parser.parse_args()
+
+    param = Param(debug=False, precision=args.precision, tolerance=args.tolerance)
     gsn = GenShapedNoise(param)
 
     white_noise: np.ndarray = gsn.gen_white_noise_0db()
@@ -104,10 +116,12 @@ def main():
 
     # Save binary for DPI-C loading (Method 2)
     print(f"      Saving binary for DPI-C (Method 2)...")
-    binary_size = gsn.save_binary(shaped_noise, param.bin_path)
+    info = gsn.save_binary(shaped_noise, param.bin_path)
+    binary_size = info['bytes']
+    check_precision(info, param.tolerance)
 
     # Verify binary size
-    expected_size = param.samples * 8  # 8 bytes per double
+    expected_size = HEADER.size + param.samples * np.dtype(PRECISIONS[param.precision][1]).itemsize
     if binary_size == expected_size:
         print(f"      ✓ Binary size correct: {binary_size} == {expected_size}")
     else:
@@ -121,6 +135,8 @@ class Param(NamedTuple):
     debug: bool = False
     npy_path: str = 'scripts/shaped_noise_reference.npy'
     bin_path: str = 'dpi/shaped_noise.bin'
+    precision: str = 'float64'  # DPI-C用バイナリのサンプル型: float64 / float32 / int16
+    tolerance: float = DEFAULT_TOLERANCE  # 量子化誤差RMS / ノイズRMS の上限
 
 
 @dataclass
@@ -330,33 +346,25 @@ class GenShapedNoise():
         """
         Save noise samples to binary file for DPI-C loading (Method 2).
 
-        Binary Format:
-        - Data type: IEEE 754 double precision (float64)
-        - Byte order: Native (little-endian on x86/ARM)
-        - Size: N samples × 8 bytes/sample
-        - No header, just raw double array
+        Binary Format (scripts/sample_format.py):
+        - 56-byte header: magic, sample type, count, scale, precision error
+        - Samples: self.param.precision (float64 / float32 / int16), little-endian
 
         Args:
             noise: Noise samples (numpy array)
             filepath: Output binary file path
 
         Returns:
-            int: Number of bytes written
+            dict: write_samples() result (bytes, precision error, ...)
         """
-        # Convert to Path object for easier file size retrieval
-        filepath = Path(filepath)
-
-        # Save as binary (IEEE 754 double precision)
-        noise.astype(np.float64).tofile(str(filepath))
-
-        # Get file size
-        file_size = filepath.stat().st_size
+        info = write_samples(noise, filepath, self.param.precision)
 
         print(f"      Binary saved: {filepath}")
-        print(f"      File size: {file_size:,} bytes ({file_size/1024:.1f} KB)")
-        print(f"      Format: IEEE 754 double precision (8 bytes/sample)")
+        print(f"      File size: {info['bytes']:,} bytes ({info['bytes']/1024:.1f} KB)")
+        print(f"      Format: {self.param.precision} "
+              f"({np.dtype(PRECISIONS[self.param.precision][1]).itemsize} bytes/sample)")
 
-        return file_size
+        return info
 
 
 if __name__ == "__main__":
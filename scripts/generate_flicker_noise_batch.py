@@ -10,14 +10,22 @@ Key Differences from Streaming Version (generate_flicker_noise.py):
 - Sample count: 4096 (vs 1024 for streaming)
 - Output: Binary file (dpi/flicker_noise_batch.bin) for DPI-C loading
 - Purpose: Exact sample-by-sample matching with SystemVerilog
+- Precision: --precision float64 (default) | float32 | int16 selects the
+  stored sample type (scripts/sample_format.py); the precision error is
+  checked against --tolerance
+
+Usage:
+    uv run python3 scripts/generate_flicker_noise_batch.py [--precision int16]
 
 Author: Generated for SerDes flicker noise PoC - Batch Mode
 """
 
+import argparse
 import random
 import numpy as np
 import matplotlib.pyplot as plt
-from pathlib import Path
+
+from sample_format import PRECISIONS, DEFAULT_TOLERANCE, HEADER, write_samples, check_precision
 
 # Algorithm parameters
 N_SOURCES = 10          # Number of noise sources (covers ~100kHz to 50MHz range)
@@ -173,41 +181,42 @@ def compute_raw_rms(n_samples, n_sources, seed):
     return raw_rms
 
 
-def save_binary(noise, filepath='dpi/flicker_noise_batch.bin'):
+def save_binary(noise, filepath='dpi/flicker_noise_batch.bin', precision='float64'):
     """
     Save noise samples to binary file for DPI-C loading (Method 2).
 
-    Binary Format:
-    - Data type: IEEE 754 double precision (float64)
-    - Byte order: Native (little-endian on x86/ARM)
-    - Size: N samples × 8 bytes/sample
-    - No header, just raw double array
+    Binary Format (scripts/sample_format.py):
+    - 56-byte header: magic, sample type, count, scale, precision error
+    - Samples: float64 (8 bytes), float32 (4 bytes) or int16 (2 bytes,
+      value = stored × scale), little-endian
 
     Args:
         noise: Noise samples (numpy array)
         filepath: Output binary file path
+        precision: 'float64', 'float32' or 'int16'
 
     Returns:
-        int: Number of bytes written
+        dict: write_samples() result (bytes, precision error, ...)
     """
-    # Convert to Path object for easier file size retrieval
-    filepath = Path(filepath)
-
-    # Save as binary (IEEE 754 double precision)
-    noise.astype(np.float64).tofile(str(filepath))
-
-    # Get file size
-    file_size = filepath.stat().st_size
+    info = write_samples(noise, filepath, precision)
 
     print(f"      Binary saved: {filepath}")
-    print(f"      File size: {file_size:,} bytes ({file_size/1024:.1f} KB)")
-    print(f"      Format: IEEE 754 double precision (8 bytes/sample)")
+    print(f"      File size: {info['bytes']:,} bytes ({info['bytes']/1024:.1f} KB)")
+    print(f"      Format: {precision} ({np.dtype(PRECISIONS[precision][1]).itemsize} bytes/sample)")
 
-    return file_size
+    return info
 
 
 def main():
     """Main execution: generate noise, analyze spectrum, save reference data."""
+    parser = argparse.ArgumentParser(description=__doc__.split('\n')[1])
+    parser.add_argument('--precision', choices=list(PRECISIONS), default='float64',
+                        help='Stored sample type of the DPI-C binary (default: float64)')
+    parser.add_argument('--tolerance', type=float, default=DEFAULT_TOLERANCE,
+                        help='Max precision error RMS relative to the noise RMS '
+                             f'(default: {DEFAULT_TOLERANCE:g})')
+    args = parser.parse_args()
+
     print("=" * 70)
     print("Flicker Noise Generation - Batch Mode (Method 2)")
     print("=" * 70)
@@ -266,10 +275,12 @@ def main():
 
     # Save binary for DPI-C loading (Method 2)
     print(f"[5/5] Saving binary for DPI-C (Method 2)...")
-    binary_size = save_binary(noise, 'dpi/flicker_noise_batch.bin')
+    info = save_binary(noise, 'dpi/flicker_noise_batch.bin', args.precision)
+    binary_size = info['bytes']
+    precision_pass = check_precision(info, args.tolerance)
 
     # Verify binary size
-    expected_size = SAMPLES * 8  # 8 bytes per double
+    expected_size = HEADER.size + SAMPLES * np.dtype(PRECISIONS[args.precision][1]).itemsize
     if binary_size == expected_size:
         print(f"      ✓ Binary size correct: {binary_size} == {expected_size}")
     else:
@@ -281,8 +292,9 @@ def main():
     print("=" * 70)
     print(f"RMS Error        : {abs(rms - TARGET_RMS)/TARGET_RMS * 100:.2f}%")
     print(f"Spectral Slope   : {slope:.3f}")
-    print(f"Binary File      : dpi/flicker_noise_batch.bin ({binary_size:,} bytes)")
-    print(f"Status           : {'PASS' if slope_pass else 'WARNING'}")
+    print(f"Binary File      : dpi/flicker_noise_batch.bin ({binary_size:,} bytes, {args.precision})")
+    print(f"Precision Error  : {info['rel_err']:.2e} of RMS (tolerance {args.tolerance:.0e})")
+    print(f"Status           : {'PASS' if slope_pass and precision_pass else 'WARNING'}")
     print("=" * 70)
     print("")
     print("Next Steps:")
@@ -296,7 +308,7 @@ def main():
     print("     - Log file:  scripts/flicker_noise_batch_verification.log")
     print("=" * 70)
 
-    return 0 if slope_pass else 1
+    return 0 if slope_pass and precision_pass else 1
 
 
 if __name__ == "__main__":
@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""
+Error Statistics Reader
+
+Reads the columnar file written by dpi_errstat_write() (dpi/dpi_errstat.cpp):
+1. Print a summary (BER, bursts, burst/run/gap distributions, worst slots)
+2. Dump any column as CSV (--column NAME)
+3. Decode the delta/run-length position log (--positions N)
+
+Usage:
+    python3 scripts/read_errstat.py sim/errstat.errstat
+    python3 scripts/read_errstat.py sim/errstat.errstat --column burst_span_hist
+    python3 scripts/read_errstat.py sim/errstat.errstat --positions 20
+
+Only the Python standard library is required.
+
+Author: Generated for SerDes BER structure analysis
+"""
+
+import argparse
+import struct
+import sys
+from pathlib import Path
+
+MAGIC = b"ERRSTAT1"
+COL_U64, COL_F64, COL_BYTES = 0, 1, 2
+
+
+def read_columns(path):
+    """
+    Parse an errstat file.
+
+    Args:
+        path: Path to the columnar file
+
+    Returns:
+        dict: column name -> list of ints/floats (or bytes for the log)
+    """
+    data = Path(path).read_bytes()
+    if data[:8] != MAGIC:
+        raise ValueError(f"{path}: not an errstat file")
+    _version, ncols = struct.unpack_from("<II", data, 8)
+    pos = 16
+    columns = {}
+    for _ in range(ncols):
+        name_len = data[pos]
+        name = data[pos + 1:pos + 1 + name_len].decode()
+        pos += 1 + name_len
+        col_type = data[pos]
+        (count,) = struct.unpack_from("<Q", data, pos + 1)
+        pos += 9
+        if col_type == COL_BYTES:
+            columns[name] = data[pos:pos + count]
+            pos += count
+        else:
+            fmt = "<%d%s" % (count, "Q" if col_type == COL_U64 else "d")
+            columns[name] = list(struct.unpack_from(fmt, data, pos))
+            pos += 8 * count
+    return columns
+
+
+def decode_positions(log, limit=None):
+    """
+    Decode the position log into (first_error_bit, run_length) tuples.
+
+    Each token is varint(gap from previous run end) + varint(run length).
+    """
+    runs = []
+    pos = 0
+    prev_end = 0
+
+    def varint():
+        nonlocal pos
+        value, shift = 0, 0
+        while True:
+            b = log[pos]
+            pos += 1
+            value |= (b & 0x7F) << shift
+            if b < 0x80:
+                return value
+            shift += 7
+
+    while pos < len(log) and (limit is None or len(runs) < limit):
+        start = prev_end + varint()
+        length = varint()
+        runs.append((start, length))
+        prev_end = start + length
+    return runs
+
+
+def print_histogram(title, hist, first=1, top=10):
+    """Print the non-zero bins of a histogram, largest first."""
+    total = sum(hist[first:])
+    print(f"\n{title} (total {total})")
+    if total == 0:
+        return
+    bins = sorted(((c, i) for i, c in enumerate(hist) if i >= first and c), reverse=True)
+    for count, index in bins[:top]:
+        print(f"  {index:>6}: {count:>12}  ({100.0 * count / total:6.2f}%)")
+
+
+def print_summary(cols):
+    """Print the headline statistics of an errstat file."""
+    total = cols["total_bits"][0]
+    errors = cols["error_bits"][0]
+    bursts = cols["bursts"][0]
+    print("=" * 50)
+    print("  Error Statistics Summary")
+    print("=" * 50)
+    print(f"  Total bits        : {total}")
+    print(f"  Error bits        : {errors}")
+    print(f"  BER               : {errors / total if total else 0.0:.3e}")
+    print(f"  Bursts            : {bursts} (burst_gap = {cols['burst_gap'][0]} bits)")
+    if bursts:
+        print(f"  Errors per burst  : {errors / bursts:.3f}")
+    print(f"  Max burst span    : {cols['max_burst_span'][0]} bits")
+    mean_gap, cv2 = cols["gap_mean_cv2"]
+    print(f"  Gap mean / CV^2   : {mean_gap:.1f} bits / {cv2:.3f} (1.0 = random)")
+    print(f"  Position log      : {len(cols['position_log'])} bytes, "
+          f"{cols['dropped_runs'][0]} runs dropped")
+
+    print_histogram("Burst span [bits]", cols["burst_span_hist"])
+    print_histogram("Errors per burst", cols["burst_errors_hist"])
+    print_histogram("Run length [bits]", cols["run_hist"])
+
+    slots = cols["slot_errors"]
+    if len(slots) > 1 and errors:
+        expected = errors / len(slots)
+        worst = max(range(len(slots)), key=lambda i: slots[i])
+        print(f"\nSlots: {len(slots)} x {cols['slot_bits'][0]} bits, "
+              f"worst slot {worst} = {slots[worst]} errors "
+              f"({slots[worst] / expected:.2f}x average)")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Read dpi_errstat columnar files")
+    parser.add_argument("file", help="errstat file written by dpi_errstat_write()")
+    parser.add_argument("--column", help="Dump one column as CSV (index,value)")
+    parser.add_argument("--positions", type=int, metavar="N",
+                        help="Print the first N logged error runs")
+    args = parser.parse_args()
+
+    try:
+        cols = read_columns(args.file)
+    except (OSError, ValueError) as e:
+        print(f"ERROR: {e}")
+        sys.exit(1)
+
+    if args.column:
+        if args.column not in cols or args.column == "position_log":
+            print(f"ERROR: unknown column '{args.column}'. Available: {', '.join(cols)}")
+            sys.exit(1)
+        print("index,value")
+        for i, v in enumerate(cols[args.column]):
+            print(f"{i},{v}")
+    elif args.positions:
+        print("first_error_bit,run_length")
+        for start, length in decode_positions(cols["position_log"], args.positions):
+            print(f"{start},{length}")
+    else:
+        print_summary(cols)
+
+
+if __name__ == "__main__":
+    main()
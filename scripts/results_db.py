@@ -0,0 +1,479 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+Local SQLite Result Store and Query CLI
+
+Every simulation launched by run_test.py (single runs and sweep points) and
+threshold_search.py is recorded in a local SQLite database (default
+sim/results.db), so trends and comparisons are queries instead of re-runs.
+
+Schema:
+    sessions   one row per command invocation (command line, git revision)
+    runs       one row per simulation: test, simulator, kind (run / sweep /
+               search), sweep point, config hash, source hash, build
+               (git revision), status, return code, compile / sim seconds,
+               parameters (JSON)
+    params     run parameters, one row per name (indexed for "X vs param")
+    metrics    "[METRIC] name = value" lines (kind 'metric') and performance
+               counters (kind 'perf': wall/cpu seconds, memory, peak RSS of
+               compile and simulation, simulated ns and ns per wall second)
+    artifacts  waveform / log / CSV paths produced by the run
+
+Queries:
+    python3 scripts/results_db.py runs --test counter --since 7d
+    python3 scripts/results_db.py slowest --since 7d
+    python3 scripts/results_db.py metric ber --vs SJ_AMP_UI --build 81e25f1
+    python3 scripts/results_db.py builds
+    python3 scripts/results_db.py sql "SELECT test, COUNT(*) FROM runs GROUP BY test"
+
+Author: Generated for SystemVerilog test automation
+"""
+
+import argparse
+import csv
+import hashlib
+import json
+import re
+import socket
+import sqlite3
+import subprocess
+import sys
+import time
+from datetime import datetime
+from pathlib import Path
+
+SCHEMA_VERSION = 1
+
+SCHEMA = """
+CREATE TABLE IF NOT EXISTS sessions (
+    id          INTEGER PRIMARY KEY,
+    started     REAL NOT NULL,
+    command     TEXT,
+    git_rev     TEXT,
+    host        TEXT
+);
+CREATE TABLE IF NOT EXISTS runs (
+    id          INTEGER PRIMARY KEY,
+    session_id  INTEGER REFERENCES sessions(id),
+    started     REAL NOT NULL,
+    test        TEXT NOT NULL,
+    simulator   TEXT,
+    kind        TEXT NOT NULL,
+    point       INTEGER,
+    config_hash TEXT,
+    source_hash TEXT,
+    git_rev     TEXT,
+    status      TEXT NOT NULL,
+    returncode  INTEGER,
+    compile_s   REAL,
+    sim_s       REAL,
+    params      TEXT
+);
+CREATE TABLE IF NOT EXISTS params (
+    run_id      INTEGER NOT NULL REFERENCES runs(id),
+    name        TEXT NOT NULL,
+    value       REAL,
+    text        TEXT
+);
+CREATE TABLE IF NOT EXISTS metrics (
+    run_id      INTEGER NOT NULL REFERENCES runs(id),
+    name        TEXT NOT NULL,
+    value       REAL,
+    kind        TEXT NOT NULL DEFAULT 'metric'
+);
+CREATE TABLE IF NOT EXISTS artifacts (
+    run_id      INTEGER NOT NULL REFERENCES runs(id),
+    kind        TEXT NOT NULL,
+    path        TEXT NOT NULL
+);
+CREATE INDEX IF NOT EXISTS idx_runs_test_started ON runs(test, started);
+CREATE INDEX IF NOT EXISTS idx_runs_started ON runs(started);
+CREATE INDEX IF NOT EXISTS idx_runs_git_rev ON runs(git_rev);
+CREATE INDEX IF NOT EXISTS idx_runs_config_hash ON runs(config_hash);
+CREATE INDEX IF NOT EXISTS idx_runs_status ON runs(status);
+CREATE INDEX IF NOT EXISTS idx_params_name_value ON params(name, value);
+CREATE INDEX IF NOT EXISTS idx_params_run ON params(run_id);
+CREATE INDEX IF NOT EXISTS idx_metrics_name_run ON metrics(name, run_id);
+CREATE INDEX IF NOT EXISTS idx_metrics_run ON metrics(run_id);
+CREATE INDEX IF NOT EXISTS idx_artifacts_run ON artifacts(run_id);
+"""
+
+# Verilator --binary end-of-run report, e.g.
+#   - Verilator: $finish at 10us; walltime 0.012 s; speed 812.345 us/s
+#   - Verilator: cpu 0.011 s on 1 threads; alloced 12 MB
+PERF_PATTERNS = [
+    (re.compile(r'walltime\s+([\d.]+)\s*s'), 'perf.wall_s', 1.0),
+    (re.compile(r'cpu\s+([\d.]+)\s*s'), 'perf.cpu_s', 1.0),
+    (re.compile(r'on\s+(\d+)\s+threads'), 'perf.threads', 1.0),
+    (re.compile(r'alloced\s+([\d.]+)\s*MB'), 'perf.alloc_mb', 1.0),
+    (re.compile(r'alloced\s+([\d.]+)\s*KB'), 'perf.alloc_mb', 1.0 / 1024.0),
+]
+FINISH_RE = re.compile(r'\$finish at\s+([\d.]+)\s*(fs|ps|ns|us|ms|s)\b')
+NS_PER_UNIT = {'fs': 1e-6, 'ps': 1e-3, 'ns': 1.0, 'us': 1e3, 'ms': 1e6, 's': 1e9}
+
+
+#==============================================================================
+# FINGERPRINTS
+#==============================================================================
+
+def git_revision(project_root):
+    """Short HEAD revision, with '-dirty' for uncommitted tracked changes"""
+    try:
+        rev = subprocess.run(['git', 'rev-parse', '--short', 'HEAD'], cwd=project_root,
+                             capture_output=True, text=True, timeout=10).stdout.strip()
+        dirty = subprocess.run(['git', 'status', '--porcelain', '--untracked-files=no'],
+                               cwd=project_root, capture_output=True, text=True,
+                               timeout=30).stdout.strip()
+    except (OSError, subprocess.SubprocessError):
+        return None
+    if not rev:
+        return None
+    return rev + ('-dirty' if dirty else '')
+
+
+def config_fingerprint(project_root, project_config, test_config):
+    """
+    (config_hash, source_hash) of a test.
+
+    config_hash covers the test's YAML entry (flags, timeouts, sweep), and
+    source_hash the testbench, RTL and C/C++ sources it compiles.
+    """
+    project_root = Path(project_root)
+    config_hash = hashlib.sha256(
+        json.dumps(test_config, sort_keys=True, default=str).encode()).hexdigest()[:16]
+
+    tb_dir = project_root / project_config.get('tb_dir', 'tb')
+    rtl_dir = project_root / project_config.get('rtl_dir', 'rtl')
+    sources = [tb_dir / test_config['testbench_file']]
+    sources += [rtl_dir / f for f in test_config.get('rtl_files', [])]
+    obj_dir = project_root / project_config.get('obj_dir', 'sim/obj_dir')
+    for flag in test_config.get('verilator_extra_flags', []):
+        if str(flag).endswith(('.c', '.cpp', '.cc', '.h')):
+            # C/C++ paths are written as ../dpi/x.cpp; accept any base that exists
+            candidates = [obj_dir / flag, project_root / flag, project_root / 'dpi' / Path(flag).name]
+            sources.append(next((c for c in candidates if c.exists()), candidates[-1]))
+
+    digest = hashlib.sha256()
+    for path in sources:
+        digest.update(str(path.name).encode())
+        try:
+            digest.update(path.read_bytes())
+        except OSError:
+            digest.update(b'<missing>')
+    return config_hash, digest.hexdigest()[:16]
+
+
+def parse_perf(stdout):
+    """Simulator performance counters found in the run output"""
+    perf = {}
+    for pattern, name, scale in PERF_PATTERNS:
+        match = pattern.search(stdout or '')
+        if match:
+            perf[name] = float(match.group(1)) * scale
+    match = FINISH_RE.search(stdout or '')
+    if match:
+        perf['perf.sim_ns'] = float(match.group(1)) * NS_PER_UNIT[match.group(2)]
+    return perf
+
+
+#==============================================================================
+# STORE
+#==============================================================================
+
+class ResultStore:
+    """Append-only SQLite store; use from one thread"""
+
+    def __init__(self, db_path):
+        self.db_path = Path(db_path)
+        self.db_path.parent.mkdir(parents=True, exist_ok=True)
+        self.conn = sqlite3.connect(str(self.db_path))
+        self.conn.execute("PRAGMA journal_mode=WAL")
+        self.conn.execute("PRAGMA foreign_keys=ON")
+        self.conn.executescript(SCHEMA)
+        self.conn.execute(f"PRAGMA user_version={SCHEMA_VERSION}")
+        self.conn.commit()
+
+    def close(self):
+        self.conn.close()
+
+    def begin_session(self, command, git_rev=None):
+        cur = self.conn.execute(
+            "INSERT INTO sessions (started, command, git_rev, host) VALUES (?, ?, ?, ?)",
+            (time.time(), command, git_rev, socket.gethostname()))
+        self.conn.commit()
+        return cur.lastrowid
+
+    def add_run(self, session_id, test, status, kind='run', simulator=None, point=None,
+                config_hash=None, source_hash=None, git_rev=None, returncode=None,
+                compile_s=None, sim_s=None, params=None, metrics=None, perf=None,
+                artifacts=None, started=None, commit=True):
+        """
+        Insert one simulation record.
+
+        Args:
+            params: {name: value} run parameters (plusargs)
+            metrics: {name: value} testbench metrics
+            perf: {name: value} performance counters
+            artifacts: {kind: path} produced files
+
+        Returns:
+            int: Run id
+        """
+        params = params or {}
+        cur = self.conn.execute(
+            "INSERT INTO runs (session_id, started, test, simulator, kind, point, config_hash, "
+            "source_hash, git_rev, status, returncode, compile_s, sim_s, params) "
+            "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)",
+            (session_id, started or time.time(), test, simulator, kind, point, config_hash,
+             source_hash, git_rev, status, returncode, compile_s, sim_s,
+             json.dumps(params, default=str)))
+        run_id = cur.lastrowid
+
+        self.conn.executemany(
+            "INSERT INTO params (run_id, name, value, text) VALUES (?, ?, ?, ?)",
+            [(run_id, n, _as_real(v), str(v)) for n, v in params.items()])
+        rows = [(run_id, n, _as_real(v), 'metric') for n, v in (metrics or {}).items()]
+        rows += [(run_id, n, _as_real(v), 'perf') for n, v in (perf or {}).items()]
+        self.conn.executemany(
+            "INSERT INTO metrics (run_id, name, value, kind) VALUES (?, ?, ?, ?)", rows)
+        self.conn.executemany(
+            "INSERT INTO artifacts (run_id, kind, path) VALUES (?, ?, ?)",
+            [(run_id, k, str(p)) for k, p in (artifacts or {}).items()])
+
+        if commit:
+            self.conn.commit()
+        return run_id
+
+    def commit(self):
+        self.conn.commit()
+
+    def test_history(self, tests, last=5):
+        """
+        Recent runtime, memory and simulation speed of each test, for
+        scheduling and timeout prediction.
+
+        Uses the last `last` single runs (kind 'run') that got past
+        compilation.
+
+        Returns:
+            dict: {test: {'seconds': median compile+sim seconds,
+                          'rss_mb': max peak RSS or None,
+                          'sim_ns_per_s': median simulated ns per wall
+                                          second or None, 'runs': count}}
+        """
+        history = {}
+        for test in tests:
+            rows = self.conn.execute(
+                "SELECT r.id, COALESCE(r.compile_s, 0) + COALESCE(r.sim_s, 0) FROM runs r "
+                "WHERE r.test = ? AND r.kind = 'run' AND r.status != 'COMPILE_ERROR' "
+                "ORDER BY r.started DESC LIMIT ?", (test, last)).fetchall()
+            if not rows:
+                continue
+            seconds = sorted(r[1] for r in rows)
+            ids = [r[0] for r in rows]
+            in_ids = f"run_id IN ({','.join('?' * len(ids))})"
+            rss = self.conn.execute(
+                f"SELECT MAX(value) FROM metrics WHERE {in_ids} "
+                "AND name IN ('perf.compile_rss_mb', 'perf.sim_rss_mb')", ids).fetchone()[0]
+            speeds = sorted(r[0] for r in self.conn.execute(
+                f"SELECT value FROM metrics WHERE {in_ids} AND name = 'perf.sim_ns_per_s'", ids))
+            history[test] = {'seconds': seconds[len(seconds) // 2], 'rss_mb': rss,
+                             'sim_ns_per_s': speeds[len(speeds) // 2] if speeds else None,
+                             'runs': len(rows)}
+        return history
+
+    def query(self, sql, args=()):
+        cur = self.conn.execute(sql, args)
+        header = [d[0] for d in cur.description] if cur.description else []
+        return header, cur.fetchall()
+
+
+def _as_real(value):
+    try:
+        return float(value)
+    except (TypeError, ValueError):
+        return None
+
+
+#==============================================================================
+# QUERY CLI
+#==============================================================================
+
+def parse_since(text):
+    """'7d' / '24h' / '30m' / ISO date → unix time"""
+    match = re.match(r'^(\d+(?:\.\d+)?)\s*([dhm])$', text.strip())
+    if match:
+        scale = {'d': 86400.0, 'h': 3600.0, 'm': 60.0}[match.group(2)]
+        return time.time() - float(match.group(1)) * scale
+    return datetime.fromisoformat(text).timestamp()
+
+
+def _filters(args, alias='r'):
+    """WHERE clause pieces shared by the run-level queries"""
+    where, values = [], []
+    if getattr(args, 'test', None):
+        where.append(f"{alias}.test = ?")
+        values.append(args.test)
+    if getattr(args, 'status', None):
+        where.append(f"{alias}.status = ?")
+        values.append(args.status.upper())
+    if getattr(args, 'build', None):
+        where.append(f"{alias}.git_rev LIKE ?")
+        values.append(args.build + '%')
+    if getattr(args, 'kind', None):
+        where.append(f"{alias}.kind = ?")
+        values.append(args.kind)
+    if getattr(args, 'since', None):
+        where.append(f"{alias}.started >= ?")
+        values.append(parse_since(args.since))
+    return (" WHERE " + " AND ".join(where)) if where else "", values
+
+
+def _fmt_cell(value):
+    if value is None:
+        return ''
+    if isinstance(value, float):
+        return f"{value:.6g}"
+    return str(value)
+
+
+def print_table(header, rows, csv_out=False):
+    if csv_out:
+        writer = csv.writer(sys.stdout)
+        writer.writerow(header)
+        writer.writerows(rows)
+        return
+    cells = [[_fmt_cell(c) for c in row] for row in rows]
+    widths = [max([len(h)] + [len(r[i]) for r in cells]) for i, h in enumerate(header)]
+    print("  " + "  ".join(h.ljust(w) for h, w in zip(header, widths)))
+    print("  " + "  ".join('-' * w for w in widths))
+    for r in cells:
+        print("  " + "  ".join(c.ljust(w) for c, w in zip(r, widths)))
+    print(f"\n  {len(rows)} rows")
+
+
+def cmd_runs(store, args):
+    where, values = _filters(args)
+    return store.query(
+        "SELECT r.id, datetime(r.started, 'unixepoch', 'localtime') AS started, r.test, "
+        "r.kind, r.point, r.status, r.git_rev AS build, r.compile_s, r.sim_s, r.params "
+        f"FROM runs r{where} ORDER BY r.started DESC LIMIT ?", values + [args.limit])
+
+
+def cmd_slowest(store, args):
+    where, values = _filters(args)
+    return store.query(
+        "SELECT r.test, COUNT(*) AS runs, AVG(r.sim_s) AS avg_sim_s, MAX(r.sim_s) AS max_sim_s, "
+        "AVG(r.compile_s) AS avg_compile_s, "
+        "SUM(CASE WHEN r.status = 'PASS' THEN 1 ELSE 0 END) AS passed "
+        f"FROM runs r{where} GROUP BY r.test ORDER BY avg_sim_s DESC LIMIT ?",
+        values + [args.limit])
+
+
+def cmd_metric(store, args):
+    where, values = _filters(args)
+    metric_join = "JOIN metrics m ON m.run_id = r.id AND m.name = ?"
+    if args.vs:
+        return store.query(
+            "SELECT p.value AS " + _ident(args.vs) + ", COUNT(*) AS n, AVG(m.value) AS mean, "
+            "MIN(m.value) AS min, MAX(m.value) AS max "
+            f"FROM runs r {metric_join} JOIN params p ON p.run_id = r.id AND p.name = ?"
+            f"{where} GROUP BY p.value ORDER BY p.value",
+            [args.name, args.vs] + values)
+    return store.query(
+        "SELECT r.id, datetime(r.started, 'unixepoch', 'localtime') AS started, r.test, "
+        "r.git_rev AS build, r.point, m.value AS " + _ident(args.name) + " "
+        f"FROM runs r {metric_join}{where} ORDER BY r.started DESC LIMIT ?",
+        [args.name] + values + [args.limit])
+
+
+def cmd_builds(store, args):
+    where, values = _filters(args)
+    return store.query(
+        "SELECT r.git_rev AS build, MIN(datetime(r.started, 'unixepoch', 'localtime')) AS first, "
+        "COUNT(*) AS runs, SUM(CASE WHEN r.status = 'PASS' THEN 1 ELSE 0 END) AS passed, "
+        "SUM(CASE WHEN r.status != 'PASS' THEN 1 ELSE 0 END) AS failed "
+        f"FROM runs r{where} GROUP BY r.git_rev ORDER BY MIN(r.started) DESC LIMIT ?",
+        values + [args.limit])
+
+
+def cmd_sql(store, args):
+    return store.query(args.query)
+
+
+def _ident(name):
+    """Quote a user-supplied name for use as a column alias"""
+    return '"' + name.replace('"', '""') + '"'
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Query the local simulation result store",
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog="""
+Examples:
+  python3 scripts/results_db.py runs --test counter --since 7d
+  python3 scripts/results_db.py slowest --since 7d
+  python3 scripts/results_db.py metric ber --vs SJ_AMP_UI --test jtol --build 81e25f1
+  python3 scripts/results_db.py metric perf.wall_s --test diff_pair
+  python3 scripts/results_db.py builds --test counter
+  python3 scripts/results_db.py sql "SELECT name, COUNT(*) FROM metrics GROUP BY name"
+        """
+    )
+    parser.add_argument("--db", default=None,
+                        help="Database path (default: sim/results.db)")
+    parser.add_argument("--csv", action="store_true", help="CSV output")
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    def add_filters(p):
+        p.add_argument("--test", help="Test name")
+        p.add_argument("--status", help="PASS / FAIL / ERROR / TIMEOUT / COMPILE_ERROR")
+        p.add_argument("--build", help="Git revision prefix")
+        p.add_argument("--kind", choices=["run", "sweep", "search"], help="Run kind")
+        p.add_argument("--since", help="Age ('7d', '24h', '30m') or ISO date")
+        p.add_argument("--limit", type=int, default=50, help="Row limit (default: 50)")
+
+    p = sub.add_parser("runs", help="Recent runs")
+    add_filters(p)
+    p.set_defaults(func=cmd_runs)
+
+    p = sub.add_parser("slowest", help="Tests by average simulation time")
+    add_filters(p)
+    p.set_defaults(func=cmd_slowest)
+
+    p = sub.add_parser("metric", help="One metric over runs, or grouped by a parameter")
+    p.add_argument("name", help="Metric name (perf counters: perf.wall_s, ...)")
+    p.add_argument("--vs", help="Group by this run parameter")
+    add_filters(p)
+    p.set_defaults(func=cmd_metric)
+
+    p = sub.add_parser("builds", help="Pass/fail counts per build")
+    add_filters(p)
+    p.set_defaults(func=cmd_builds)
+
+    p = sub.add_parser("sql", help="Raw SQL query")
+    p.add_argument("query")
+    p.set_defaults(func=cmd_sql)
+
+    args = parser.parse_args()
+
+    db_path = Path(args.db) if args.db else Path(__file__).parent.parent / 'sim' / 'results.db'
+    if not db_path.exists():
+        print(f"Error: Result database not found: {db_path}")
+        return 1
+
+    store = ResultStore(db_path)
+    try:
+        header, rows = args.func(store, args)
+    except (sqlite3.Error, ValueError) as e:
+        print(f"Error: {e}")
+        return 1
+    finally:
+        store.close()
+
+    print_table(header, rows, csv_out=args.csv)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -11,6 +11,7 @@ import subprocess
 import argparse
 from pathlib import Path
 import shutil
+import time
 
 try:
     import yaml
@@ -21,7 +22,10 @@ except ImportError:
 import re
 
 # Import simulator abstraction layer
-from simulators import SimulatorFactory
+from simulators import SimulatorFactory, extract_timescale
+import sweep
+import results_db
+import scheduler
 
 
 class TestConfig:
@@ -94,6 +98,12 @@ class TestRunner:
         self.test_name = test_config['name']
         self.vcd_file = self.simulator.vcd_file
 
+        # Outcome of the last run() / run_sweep() (for the result store)
+        self.status = None
+        self.compile_seconds = None
+        self.sim_seconds = None
+        self.sweep_results = None
+
     def clean(self):
         """Clean simulation artifacts for this test"""
         self.simulator.clean()
@@ -130,11 +140,23 @@ class TestRunner:
         print()
 
         # Compile
-        if not self.simulator.compile():
+        start = time.monotonic()
+        compiled = self.simulator.compile()
+        self.compile_seconds = time.monotonic() - start
+        if not compiled:
+            self.status = 'COMPILE_ERROR'
             return False
 
         # Simulate
-        if not self.simulator.run_simulation():
+        start = time.monotonic()
+        simulated = self.simulator.run_simulation()
+        self.sim_seconds = time.monotonic() - start
+        if self.simulator.last_result is not None:
+            self.status = self.simulator.last_result.status
+        else:
+            self.status = sweep.point_status(self.simulator.last_returncode,
+                                             self.simulator.last_stdout)
+        if not simulated:
             return False
 
         # View waveform if requested
@@ -143,6 +165,96 @@ class TestRunner:
 
         return True
 
+    def run_sweep(self, jobs=None, samples=None, seed=None):
+        """Compile once, run every point of the test's sweep section, aggregate"""
+        sweep_config = self.test_config.get('sweep')
+        if not sweep_config:
+            print(f"✗ Test '{self.test_name}' has no sweep section")
+            return False
+
+        try:
+            points = sweep.expand_sweep(sweep_config, samples=samples, seed=seed)
+        except ValueError as e:
+            print(f"✗ Invalid sweep section: {e}")
+            return False
+
+        jobs = jobs or sweep_config.get('jobs')
+        print("=" * 70)
+        print(f"  Sweep: {self.test_name} ({sweep_config.get('method', 'grid')}, "
+              f"{len(points)} points)")
+        print(f"  Simulator: {self.simulator_type}")
+        print("=" * 70)
+        print()
+
+        start = time.monotonic()
+        compiled = self.simulator.compile()
+        self.compile_seconds = time.monotonic() - start
+        if not compiled:
+            self.status = 'COMPILE_ERROR'
+            return False
+
+        out_dir = self.simulator.project_root / self.project_config.get('sim_dir', 'sim') / 'sweep'
+        print(f"🚀 Running {len(points)} points ({jobs or 'all CPUs'} parallel)...")
+        results = sweep.run_sweep(self.simulator, points, jobs=jobs,
+                                  log_dir=out_dir / self.test_name)
+        self.sweep_results = results
+
+        csv_path = out_dir / f"{self.test_name}.csv"
+        sweep.write_results(results, csv_path)
+        print()
+        sweep.print_results(results)
+
+        passed = sum(1 for r in results if r['status'] == 'PASS')
+        print()
+        print(f"  Points: {len(results)}  |  Passed: {passed}  |  Failed: {len(results) - passed}")
+        print(f"  Results: {csv_path}")
+        self.status = 'PASS' if passed == len(results) else 'FAIL'
+        return passed == len(results)
+
+    def record(self, store, session_id, git_rev=None):
+        """Insert the last run (or every sweep point) into the result store"""
+        if self.status is None:
+            return
+        config_hash, source_hash = results_db.config_fingerprint(
+            self.project_root, self.project_config, self.test_config)
+        common = dict(simulator=self.simulator_type, config_hash=config_hash,
+                      source_hash=source_hash, git_rev=git_rev)
+
+        if self.sweep_results is None:
+            stream = self.simulator.last_result
+            artifacts = {'vcd': self.vcd_file} if self.vcd_file.exists() else {}
+            if stream is not None and stream.log_path is not None:
+                artifacts['log'] = stream.log_path
+            metrics = stream.metrics if stream is not None else \
+                sweep.parse_metrics(self.simulator.last_stdout)
+            perf = results_db.parse_perf(self.simulator.last_stdout)
+            if self.simulator.last_compile_rss_mb is not None:
+                perf['perf.compile_rss_mb'] = self.simulator.last_compile_rss_mb
+            if stream is not None and stream.peak_rss_mb is not None:
+                perf['perf.sim_rss_mb'] = stream.peak_rss_mb
+            if self.simulator.last_speed is not None:
+                perf['perf.sim_ns_per_s'] = self.simulator.last_speed
+            if self.simulator.last_slowdown is not None:
+                perf['perf.slowdown'] = self.simulator.last_slowdown
+            if self.simulator.last_coverage is not None:
+                metrics = {**metrics, 'coverage.hit': self.simulator.last_coverage[0],
+                           'coverage.points': self.simulator.last_coverage[1]}
+                artifacts['coverage'] = self.simulator.last_coverage_file
+            store.add_run(session_id, self.test_name, self.status, kind='run',
+                          returncode=self.simulator.last_returncode,
+                          compile_s=self.compile_seconds, sim_s=self.sim_seconds,
+                          metrics=metrics, perf=perf, artifacts=artifacts, **common)
+            return
+
+        for r in self.sweep_results:
+            artifacts = {k: r[k] for k in ('log', 'coverage') if r.get(k)}
+            store.add_run(session_id, self.test_name, r['status'], kind='sweep',
+                          point=r['index'], returncode=r['returncode'],
+                          compile_s=self.compile_seconds, sim_s=r['seconds'],
+                          params=r['params'], metrics=r['metrics'], perf=r['perf'],
+                          artifacts=artifacts or None, commit=False, **common)
+        store.commit()
+
 
 def main():
     parser = argparse.ArgumentParser(
@@ -161,6 +273,16 @@ Examples:
 
   # Use custom config file
   python3 run_test.py --config my_tests.yaml --test counter
+
+  # Run the test's sweep section (one compile, parallel points)
+  python3 run_test.py --test diff_pair --sweep --jobs 8
+
+  # Shard 2 of 4, tests in parallel within a 16 GB memory budget
+  python3 run_test.py --all --shard 2/4 --jobs 8 --mem-budget 16000
+
+  # Coverage run of every sweep point, then rank the points
+  python3 run_test.py --test diff_pair --sweep --coverage
+  python3 sim_coverage.py rank ../sim/coverage/diff_pair
         """
     )
 
@@ -203,6 +325,55 @@ Examples:
         choices=["verilator", "vcs"],
         help="Override simulator selection (default: from config)"
     )
+    parser.add_argument(
+        "--sweep",
+        action="store_true",
+        help="Run the test's sweep section instead of a single simulation"
+    )
+    parser.add_argument(
+        "--jobs",
+        type=int,
+        help="Parallel simulations for --sweep (default: sweep.jobs or CPU count); "
+             "parallel tests otherwise"
+    )
+    parser.add_argument(
+        "--samples",
+        type=int,
+        help="Override sweep.samples (random / lhs methods)"
+    )
+    parser.add_argument(
+        "--seed",
+        type=int,
+        help="Override sweep.seed"
+    )
+    parser.add_argument(
+        "--shard",
+        help="Run only shard i of N (e.g. 2/4), split by recorded test durations"
+    )
+    parser.add_argument(
+        "--mem-budget",
+        type=float,
+        help="Peak RSS budget in MB for parallel tests (default: project.mem_budget_mb)"
+    )
+    parser.add_argument(
+        "--isolate",
+        action="store_true",
+        help="Use a per-test work directory (implied for parallel tests)"
+    )
+    parser.add_argument(
+        "--coverage",
+        action="store_true",
+        help="Build with coverage_flags and write one coverage file per run (sim/coverage/<test>/)"
+    )
+    parser.add_argument(
+        "--db",
+        help="Result database (default: project.results_db or sim/results.db)"
+    )
+    parser.add_argument(
+        "--no-db",
+        action="store_true",
+        help="Do not record results in the result database"
+    )
 
     args = parser.parse_args()
 
@@ -245,6 +416,13 @@ Examples:
 
         tests_to_run = [test_config]
 
+    elif args.sweep:
+        # Sweep every enabled test that has a sweep section
+        tests_to_run = [t for t in config.get_enabled_tests() if t.get('sweep')]
+        if not tests_to_run:
+            print("No enabled tests with a sweep section found in config")
+            return 1
+
     elif args.all:
         # Run all enabled tests
         tests_to_run = config.get_enabled_tests()
@@ -260,6 +438,48 @@ Examples:
             print("Use --list to see available tests")
             return 1
 
+    # Shard selection: LPT split over the duration snapshot, so every
+    # invocation computes the same partition
+    durations_path = project_root / config.project.get('durations_file',
+                                                       scheduler.DEFAULT_DURATIONS_FILE)
+    durations = scheduler.load_durations(durations_path)
+    if not durations and (args.shard or (args.jobs and args.jobs > 1)):
+        print(f"Note: no duration snapshot at {durations_path}; tests are ordered by name "
+              f"(run scripts/scheduler.py store after a full run)")
+    if args.shard:
+        names = [t['name'] for t in tests_to_run]
+        try:
+            shard = set(scheduler.select_shard(names, durations, args.shard))
+        except ValueError as e:
+            print(f"Error: {e}")
+            return 1
+        tests_to_run = [t for t in tests_to_run if t['name'] in shard]
+        print(f"Shard {args.shard}: {len(tests_to_run)} of {len(names)} tests")
+        if not tests_to_run:
+            return 0
+
+    # Several tests with --jobs: one worker process per test
+    if args.jobs and args.jobs > 1 and len(tests_to_run) > 1 and \
+            not args.sweep and not args.clean_only:
+        return run_parallel(args, config, project_root, tests_to_run, durations)
+
+    # Result store: every run is recorded for later queries (results_db.py)
+    store = session_id = git_rev = None
+    if not args.no_db and not args.clean_only:
+        db_path = Path(args.db) if args.db else \
+            project_root / config.project.get('results_db', 'sim/results.db')
+        store = results_db.ResultStore(db_path)
+        git_rev = results_db.git_revision(project_root)
+        session_id = store.begin_session(' '.join(sys.argv), git_rev)
+
+    # Measured simulation speed per test, for the adaptive execution timeout
+    # (all tests: one without history borrows from same-timescale peers)
+    history = store.test_history(config.list_tests()) if store else {}
+    tb_dir = project_root / config.project.get('tb_dir', 'tb')
+    timescales = {t['name']: extract_timescale(tb_dir / t['testbench_file'])[0] or '1ns'
+                  for t in config.tests if (tb_dir / t['testbench_file']).exists()}
+    speeds = scheduler.speed_estimates(timescales, history, durations)
+
     # Execute tests
     results = {}
     for test_config in tests_to_run:
@@ -267,7 +487,9 @@ Examples:
         full_config = {
             **config.project,
             'simulators': config.config.get('simulators', {}),
-            'verilator': config.config.get('verilator', {})  # Backward compatibility
+            'verilator': config.config.get('verilator', {}),  # Backward compatibility
+            'isolate_work_dirs': args.isolate or config.project.get('isolate_work_dirs', False),
+            'coverage': args.coverage or config.project.get('coverage', False)
         }
         runner = TestRunner(
             project_root=project_root,
@@ -275,6 +497,7 @@ Examples:
             test_config=test_config,
             simulator_type=args.simulator  # CLI override (None if not specified)
         )
+        runner.simulator.expected_speed = speeds.get(test_config['name'])
 
         # Clean if requested
         if args.clean or args.clean_only:
@@ -285,29 +508,74 @@ Examples:
             continue
 
         # Run test
-        success = runner.run(view=args.view)
+        if args.sweep:
+            success = runner.run_sweep(jobs=args.jobs, samples=args.samples, seed=args.seed)
+        else:
+            success = runner.run(view=args.view)
         results[test_config['name']] = success
 
-    # Print summary
-    if not args.clean_only and results:
-        print("\n" + "=" * 70)
-        print("  TEST SUMMARY")
-        print("=" * 70)
+        if store is not None:
+            runner.record(store, session_id, git_rev)
 
-        passed = sum(1 for v in results.values() if v)
-        failed = sum(1 for v in results.values() if not v)
+    if store is not None:
+        store.close()
 
-        for test_name, success in results.items():
-            status = "✓ PASSED" if success else "✗ FAILED"
-            print(f"  {test_name:30s} {status}")
+    # Print summary
+    if not args.clean_only and results:
+        return print_summary(results)
 
-        print("-" * 70)
-        print(f"  Total: {len(results)}  |  Passed: {passed}  |  Failed: {failed}")
-        print("=" * 70)
+    return 0
 
-        return 0 if failed == 0 else 1
 
-    return 0
+def print_summary(results):
+    """Print the pass/fail table; returns the process exit code"""
+    print("\n" + "=" * 70)
+    print("  TEST SUMMARY")
+    print("=" * 70)
+
+    passed = sum(1 for v in results.values() if v)
+    failed = sum(1 for v in results.values() if not v)
+
+    for test_name, success in results.items():
+        status = "✓ PASSED" if success else "✗ FAILED"
+        print(f"  {test_name:30s} {status}")
+
+    print("-" * 70)
+    print(f"  Total: {len(results)}  |  Passed: {passed}  |  Failed: {failed}")
+    print("=" * 70)
+
+    return 0 if failed == 0 else 1
+
+
+def run_parallel(args, config, project_root, tests_to_run, durations):
+    """Run tests as parallel worker invocations of this script (LPT order)"""
+    names = [t['name'] for t in tests_to_run]
+    est = scheduler.estimates(names, durations)
+    mem_budget = args.mem_budget or config.project.get('mem_budget_mb')
+
+    def worker_cmd(name):
+        cmd = [sys.executable, str(Path(__file__).resolve()), "--config", args.config,
+               "--test", name, "--isolate"]
+        if args.simulator:
+            cmd += ["--simulator", args.simulator]
+        if args.clean:
+            cmd.append("--clean")
+        if args.coverage:
+            cmd.append("--coverage")
+        if args.no_db:
+            cmd.append("--no-db")
+        elif args.db:
+            cmd += ["--db", args.db]
+        return cmd
+
+    print("=" * 70)
+    print(f"  Parallel run: {len(names)} tests, {args.jobs} jobs"
+          f"{f', {mem_budget:.0f} MB budget' if mem_budget else ''}")
+    print("=" * 70)
+    log_dir = project_root / config.project.get('log_dir', 'sim/logs')
+    done = scheduler.run_parallel(names, est, worker_cmd, log_dir, args.jobs, mem_budget)
+
+    return print_summary({name: done[name][0] for name in names})
 
 
 if __name__ == "__main__":
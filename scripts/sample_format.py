@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""
+Sample File Format - Selectable Precision for DPI-C Sample Files
+
+Writes and reads the .bin sample files loaded by the DPI-C batch engines
+(dpi/dpi_flicker_noise_batch.c). Samples are stored as float64, float32
+or int16; the engine keeps them in that precision and converts to double
+only when a sample is returned to SystemVerilog (real).
+
+File layout (little-endian):
+    0   8s  magic "DPISAMP1"
+    8   I   version (1)
+    12  I   dtype: 0 = float64, 1 = float32, 2 = int16
+    16  Q   sample count
+    24  d   scale: value = stored × scale (1.0 for float types)
+    32  d   RMS of the float64 source samples
+    40  d   RMS of (stored - source), the precision error
+    48  d   max |stored - source|
+    56      samples
+A file without the magic is the original headerless float64 array.
+
+Usage:
+    from sample_format import write_samples, read_samples
+    info = write_samples(noise, 'dpi/flicker_noise_batch.bin', 'int16')
+    samples, header = read_samples('dpi/flicker_noise_batch.bin')
+
+Author: Generated for SerDes flicker noise PoC - Batch Mode
+"""
+
+import struct
+from pathlib import Path
+
+import numpy as np
+
+MAGIC = b"DPISAMP1"
+VERSION = 1
+HEADER = struct.Struct("<8sIIQdddd")
+
+PRECISIONS = {
+    "float64": (0, np.float64),
+    "float32": (1, np.float32),
+    "int16": (2, np.int16),
+}
+DTYPE_NAMES = {code: name for name, (code, _) in PRECISIONS.items()}
+
+# Default accuracy guard: precision error RMS relative to the signal RMS
+# (1e-3 = -60 dB; int16 at full scale is ~-90 dB, float32 ~-150 dB)
+DEFAULT_TOLERANCE = 1e-3
+
+
+def quantize(samples, precision):
+    """
+    Convert float64 samples to the stored representation.
+
+    int16 uses the full range: scale = max|x| / 32767.
+
+    Returns:
+        tuple: (stored array, scale)
+    """
+    samples = np.asarray(samples, dtype=np.float64)
+    if precision not in PRECISIONS:
+        raise ValueError(f"unknown precision {precision!r} (use {', '.join(PRECISIONS)})")
+    if precision == "int16":
+        peak = float(np.max(np.abs(samples))) if samples.size else 0.0
+        scale = peak / 32767.0 if peak > 0.0 else 1.0
+        return np.round(samples / scale).astype(np.int16), scale
+    return samples.astype(PRECISIONS[precision][1]), 1.0
+
+
+def write_samples(samples, filepath, precision="float64"):
+    """
+    Write samples with the header above.
+
+    Args:
+        samples: float64 source samples
+        filepath: Output path
+        precision: 'float64', 'float32' or 'int16'
+
+    Returns:
+        dict: precision, scale, bytes, rms, err_rms, err_max, rel_err
+    """
+    samples = np.asarray(samples, dtype=np.float64)
+    stored, scale = quantize(samples, precision)
+    err = stored.astype(np.float64) * scale - samples
+    rms = float(np.sqrt(np.mean(samples ** 2))) if samples.size else 0.0
+    err_rms = float(np.sqrt(np.mean(err ** 2))) if samples.size else 0.0
+    err_max = float(np.max(np.abs(err))) if samples.size else 0.0
+
+    filepath = Path(filepath)
+    with open(filepath, "wb") as f:
+        f.write(HEADER.pack(MAGIC, VERSION, PRECISIONS[precision][0], samples.size,
+                            scale, rms, err_rms, err_max))
+        f.write(stored.astype(stored.dtype.newbyteorder("<")).tobytes())
+
+    return {
+        "precision": precision,
+        "scale": scale,
+        "bytes": filepath.stat().st_size,
+        "rms": rms,
+        "err_rms": err_rms,
+        "err_max": err_max,
+        "rel_err": err_rms / rms if rms > 0.0 else 0.0,
+    }
+
+
+def read_samples(filepath):
+    """
+    Read a sample file (headered or legacy float64) as float64 values.
+
+    Returns:
+        tuple: (float64 array of the stored values, header dict or None)
+    """
+    data = Path(filepath).read_bytes()
+    if data[:8] != MAGIC:
+        return np.frombuffer(data[:len(data) // 8 * 8], dtype="<f8").copy(), None
+    _, version, dtype, count, scale, rms, err_rms, err_max = HEADER.unpack_from(data, 0)
+    if dtype not in DTYPE_NAMES:
+        raise ValueError(f"{filepath}: unknown sample dtype {dtype}")
+    np_type = np.dtype(PRECISIONS[DTYPE_NAMES[dtype]][1]).newbyteorder("<")
+    stored = np.frombuffer(data, dtype=np_type, count=count, offset=HEADER.size)
+    header = {
+        "version": version,
+        "precision": DTYPE_NAMES[dtype],
+        "count": count,
+        "scale": scale,
+        "rms": rms,
+        "err_rms": err_rms,
+        "err_max": err_max,
+    }
+    return stored.astype(np.float64) * scale, header
+
+
+def check_precision(info, tolerance=DEFAULT_TOLERANCE):
+    """
+    Accuracy guard: print the precision error and compare it to tolerance.
+
+    Args:
+        info: dict from write_samples()
+        tolerance: Max precision error RMS relative to the signal RMS
+
+    Returns:
+        bool: True if within tolerance
+    """
+    rel = info["rel_err"]
+    db = 20.0 * np.log10(rel) if rel > 0.0 else float("-inf")
+    print(f"      Precision: {info['precision']} (error RMS {info['err_rms']:.3e}, "
+          f"max {info['err_max']:.3e}, {db:.1f} dB re signal RMS)")
+    if rel > tolerance:
+        print(f"      ✗ WARNING: precision error {rel:.2e} exceeds tolerance {tolerance:.0e}")
+        return False
+    return True
@@ -0,0 +1,323 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+Runtime-Aware Test Scheduling and Sharding
+
+Orders and distributes a test list using what earlier runs cost, so a long
+test starts first instead of last and N machines finish at about the same
+time:
+
+    - History: each run's compile / simulation seconds and peak RSS are in
+      the result database (results_db.py); `store` condenses the last runs
+      of every test into a small JSON snapshot (tests/test_durations.json)
+      meant to be committed and shared. The tree does not ship one: it
+      appears once a machine with a simulator has run the tests and
+      `store`. Until then every test is estimated at 1.0 s
+    - Sharding: `--shard i/N` splits the tests by longest-processing-time-
+      first (LPT) bin packing over the snapshot. The split only depends on
+      the snapshot and the config, so N independent invocations (CI jobs,
+      machines) agree on it without talking to each other. Without a
+      snapshot all estimates tie and LPT degenerates to a round-robin over
+      the test names (still identical on every machine, but not balanced)
+    - Local parallel runs: `--jobs N` runs the tests as worker processes in
+      LPT order; a test starts when a slot is free and its recorded peak RSS
+      fits the remaining `--mem-budget` (one test always runs, so a test
+      larger than the budget still completes, alone)
+    - Timeouts: the measured simulation speed (simulated ns per wall second)
+      lets the simulator derive each test's kill timeout from its
+      sim_timeout instead of one flat execution_timeout
+
+Usage:
+    python3 scripts/scheduler.py store               # DB -> snapshot
+    python3 scripts/scheduler.py plan --shards 4     # show the partition
+    python3 scripts/run_test.py --all --shard 2/4 --jobs 8 --mem-budget 16000
+
+Author: Generated for SystemVerilog test automation
+"""
+
+import argparse
+import json
+import subprocess
+import sys
+import time
+from pathlib import Path
+
+DEFAULT_DURATIONS_FILE = 'tests/test_durations.json'
+HISTORY_RUNS = 5
+POLL_INTERVAL_S = 0.1
+
+
+#==============================================================================
+# HISTORY
+#==============================================================================
+
+def load_durations(path):
+    """Snapshot {test: {'seconds': s, 'rss_mb': mb}} ({} if missing)"""
+    try:
+        with open(path) as f:
+            return json.load(f).get('tests', {})
+    except (OSError, ValueError):
+        return {}
+
+
+def store_durations(path, history):
+    """
+    Write the snapshot, keeping entries of tests absent from `history`.
+
+    Values are rounded so re-running the same suite does not churn the file.
+    """
+    durations = load_durations(path)
+    for test, h in history.items():
+        entry = {'seconds': round(h['seconds'], 1)}
+        if h.get('rss_mb') is not None:
+            entry['rss_mb'] = int(round(h['rss_mb']))
+        if h.get('sim_ns_per_s'):
+            entry['sim_ns_per_s'] = float(f"{h['sim_ns_per_s']:.3g}")
+        durations[test] = entry
+
+    path = Path(path)
+    path.parent.mkdir(parents=True, exist_ok=True)
+    with open(path, 'w') as f:
+        json.dump({'history_runs': HISTORY_RUNS, 'tests': dict(sorted(durations.items()))},
+                  f, indent=2)
+        f.write('\n')
+    return durations
+
+
+def estimates(names, durations):
+    """
+    (seconds, rss_mb) per test; unknown tests get the median of known ones.
+
+    Returns:
+        dict: {test: (seconds, rss_mb)}
+    """
+    def median(values, default):
+        values = sorted(values)
+        return values[len(values) // 2] if values else default
+
+    default_s = median([d['seconds'] for d in durations.values() if 'seconds' in d], 1.0)
+    default_mb = median([d['rss_mb'] for d in durations.values() if d.get('rss_mb')], 0.0)
+    return {name: (float(durations.get(name, {}).get('seconds', default_s)),
+                   float(durations.get(name, {}).get('rss_mb', default_mb)))
+            for name in names}
+
+
+def speed_estimates(timescales, history, durations):
+    """
+    Expected simulated ns per wall second of each test.
+
+    A test's own speed comes from the local result database (`history`),
+    else the duration snapshot. A test without either gets the median
+    speed of tests with the same timescale unit: a 1ps/1fs SerDes bench
+    runs orders of magnitude fewer ns per second than a 1ns/1ps counter.
+
+    Args:
+        timescales: {test: timescale unit, e.g. '1ns'}
+        history: ResultStore.test_history() output ({} without a database)
+        durations: load_durations() output
+
+    Returns:
+        dict: {test: ns per second or None}
+    """
+    own = {}
+    for name in timescales:
+        speed = history.get(name, {}).get('sim_ns_per_s') or \
+            durations.get(name, {}).get('sim_ns_per_s')
+        if speed:
+            own[name] = float(speed)
+
+    by_unit = {}
+    for name, speed in own.items():
+        by_unit.setdefault(timescales[name], []).append(speed)
+
+    speeds = {}
+    for name, unit in timescales.items():
+        peers = sorted(by_unit.get(unit, []))
+        speeds[name] = own.get(name) or (peers[len(peers) // 2] if peers else None)
+    return speeds
+
+
+#==============================================================================
+# PARTITIONING
+#==============================================================================
+
+def lpt_order(names, est):
+    """Longest first; ties broken by name so the order is reproducible"""
+    return sorted(names, key=lambda n: (-est[n][0], n))
+
+
+def lpt_partition(names, est, count):
+    """
+    Split tests into `count` shards by LPT bin packing.
+
+    Every test, longest first, goes to the shard with the least total time
+    (lowest index on ties). LPT is within 4/3 of the optimal makespan.
+
+    Returns:
+        list[list[str]]: Test names per shard
+    """
+    shards = [[] for _ in range(count)]
+    loads = [0.0] * count
+    for name in lpt_order(names, est):
+        i = min(range(count), key=lambda k: (loads[k], k))
+        shards[i].append(name)
+        loads[i] += est[name][0]
+    return shards
+
+
+def parse_shard(text):
+    """'i/N' (1-based) -> (i, N)"""
+    try:
+        index, count = (int(v) for v in text.split('/'))
+    except ValueError:
+        raise ValueError(f"Invalid shard '{text}' (expected i/N, e.g. 2/4)")
+    if count < 1 or not 1 <= index <= count:
+        raise ValueError(f"Invalid shard '{text}' (need 1 <= i <= N)")
+    return index, count
+
+
+def select_shard(names, durations, shard):
+    """Tests of shard 'i/N', in LPT order"""
+    index, count = parse_shard(shard)
+    est = estimates(names, durations)
+    return lpt_partition(names, est, count)[index - 1]
+
+
+#==============================================================================
+# LOCAL PARALLEL EXECUTION
+#==============================================================================
+
+def run_parallel(names, est, worker_cmd, log_dir, jobs, mem_budget_mb=None):
+    """
+    Run one worker process per test under CPU and memory budgets.
+
+    Args:
+        names: Tests to run
+        est: estimates() output (seconds, rss_mb)
+        worker_cmd: Function test name -> command list
+        log_dir: Directory for worker output (<test>.runner.log)
+        jobs: Maximum concurrent workers
+        mem_budget_mb: Sum of recorded peak RSS allowed at once (None: no limit)
+
+    Returns:
+        dict: {test: (success, seconds)} in completion order
+    """
+    log_dir = Path(log_dir)
+    log_dir.mkdir(parents=True, exist_ok=True)
+    pending = lpt_order(names, est)
+    running = {}        # test -> (Popen, log file, start time)
+    results = {}
+
+    def start(name):
+        log = open(log_dir / f"{name}.runner.log", 'w')
+        proc = subprocess.Popen(worker_cmd(name), stdout=log, stderr=subprocess.STDOUT)
+        running[name] = (proc, log, time.monotonic())
+        print(f"   ▶ {name:30s} (est. {est[name][0]:.1f}s"
+              f"{f', {est[name][1]:.0f} MB' if est[name][1] else ''})", flush=True)
+
+    try:
+        while pending or running:
+            # Fill free slots: longest pending test that fits the memory left
+            while pending and len(running) < jobs:
+                used = sum(est[n][1] for n in running)
+                fits = [n for n in pending
+                        if mem_budget_mb is None or used + est[n][1] <= mem_budget_mb]
+                if not fits and running:
+                    break
+                name = fits[0] if fits else pending[0]
+                pending.remove(name)
+                start(name)
+
+            time.sleep(POLL_INTERVAL_S)
+            for name, (proc, log, started) in list(running.items()):
+                if proc.poll() is None:
+                    continue
+                log.close()
+                del running[name]
+                seconds = time.monotonic() - started
+                results[name] = (proc.returncode == 0, seconds)
+                mark = "✓" if proc.returncode == 0 else "✗"
+                print(f"   {mark} {name:30s} {seconds:7.1f}s  "
+                      f"[{len(results)}/{len(names)}]", flush=True)
+                if proc.returncode != 0:
+                    print(f"     log: {log_dir / f'{name}.runner.log'}")
+    except KeyboardInterrupt:
+        for proc, log, _ in running.values():
+            proc.kill()
+            log.close()
+        raise
+
+    return results
+
+
+#==============================================================================
+# COMMAND LINE
+#==============================================================================
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Runtime-aware test scheduling: duration snapshot and shard plans",
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog="""
+Examples:
+  # Refresh tests/test_durations.json from the result database
+  python3 scheduler.py store
+
+  # Show how the enabled tests split over 4 shards
+  python3 scheduler.py plan --shards 4
+        """
+    )
+    parser.add_argument("command", choices=["store", "plan"])
+    parser.add_argument("--config", default="tests/test_config.yaml",
+                        help="Path to YAML config file (default: tests/test_config.yaml)")
+    parser.add_argument("--db", help="Result database (default: project.results_db or sim/results.db)")
+    parser.add_argument("--durations",
+                        help=f"Duration snapshot (default: project.durations_file or "
+                             f"{DEFAULT_DURATIONS_FILE})")
+    parser.add_argument("--shards", type=int, default=1, help="Shard count for 'plan'")
+    args = parser.parse_args()
+
+    from run_test import TestConfig
+    import results_db
+
+    project_root = Path(__file__).parent.parent
+    config = TestConfig(project_root / args.config)
+    durations_path = Path(args.durations) if args.durations else \
+        project_root / config.project.get('durations_file', DEFAULT_DURATIONS_FILE)
+    names = [t['name'] for t in config.get_enabled_tests()]
+
+    if args.command == 'store':
+        db_path = Path(args.db) if args.db else \
+            project_root / config.project.get('results_db', 'sim/results.db')
+        if not db_path.exists():
+            print(f"Error: result database not found: {db_path}")
+            return 1
+        store = results_db.ResultStore(db_path)
+        history = store.test_history(config.list_tests(), last=HISTORY_RUNS)
+        store.close()
+        store_durations(durations_path, history)
+        print(f"✓ {len(history)} test durations written to {durations_path}")
+        missing = [n for n in names if n not in history]
+        if missing:
+            print(f"  No history yet: {', '.join(missing)}")
+        return 0
+
+    if args.shards < 1:
+        print("Error: --shards must be >= 1")
+        return 1
+    durations = load_durations(durations_path)
+    if not durations:
+        print(f"Note: no duration snapshot at {durations_path}; every test is "
+              f"estimated at 1.0 s (name-ordered round-robin)")
+    est = estimates(names, durations)
+    for i, shard in enumerate(lpt_partition(names, est, args.shards), 1):
+        total = sum(est[n][0] for n in shard)
+        print(f"Shard {i}/{args.shards}: {len(shard)} tests, {total:.1f}s")
+        for n in shard:
+            known = '' if n in durations else '  (no history)'
+            print(f"    {n:30s} {est[n][0]:8.1f}s {est[n][1]:7.0f} MB{known}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
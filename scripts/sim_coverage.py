@@ -0,0 +1,304 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+Coverage Collection, Parallel Merge and Test Ranking
+
+Coverage runs (run_test.py --coverage) compile the model with the
+simulator's `coverage_flags` and write one coverage file per run:
+
+    sim/coverage/<test>/run_<timestamp>.dat     single runs
+    sim/coverage/<test>/point_<i>.dat           sweep points
+
+This module reads those files (Verilator coverage.dat format), merges any
+number of them in parallel, and ranks runs by the coverage points they add,
+so a regression can drop runs (seeds, sweep points) that cover nothing new.
+
+Coverage points:
+    Every "C '<key>' <count>" line is one point; the key encodes file, line,
+    hierarchy and point type. A point is hit when its count reaches
+    `--threshold` (default 1).
+
+Usage:
+    python3 scripts/sim_coverage.py summary sim/coverage/counter
+    python3 scripts/sim_coverage.py merge sim/coverage -o sim/coverage_merged.dat --jobs 8
+    python3 scripts/sim_coverage.py rank sim/coverage/diff_pair --csv rank.csv
+    python3 scripts/sim_coverage.py rank sim/coverage --by-test
+
+Merged files keep the Verilator format, so `verilator_coverage --annotate`
+works on them.
+
+Author: Generated for SystemVerilog test automation
+"""
+
+import argparse
+import csv
+import os
+import sys
+from concurrent.futures import ProcessPoolExecutor
+from pathlib import Path
+
+HEADER = "# SystemC::Coverage-3\n"
+COVERAGE_SUFFIX = '.dat'
+
+
+#==============================================================================
+# READING AND WRITING
+#==============================================================================
+
+def read_coverage(path, counts=None):
+    """
+    Parse one coverage file, adding to `counts` if given.
+
+    Returns:
+        dict: {point key: count}
+    """
+    counts = {} if counts is None else counts
+    get = counts.get
+    with open(path, encoding='utf-8', errors='surrogateescape') as f:
+        for line in f:
+            if line.startswith("C '"):
+                # The key may contain quotes; the count follows the last "' "
+                key, _, count = line[3:].rpartition("' ")
+                counts[key] = get(key, 0) + int(count)
+    return counts
+
+
+def write_coverage(path, counts):
+    """Write counts in the Verilator coverage.dat format"""
+    path = Path(path)
+    path.parent.mkdir(parents=True, exist_ok=True)
+    with open(path, 'w', encoding='utf-8', errors='surrogateescape') as f:
+        f.write(HEADER)
+        for key in sorted(counts):
+            f.write(f"C '{key}' {counts[key]}\n")
+
+
+def coverage_files(paths, exclude=None):
+    """Expand files and directories (searched recursively) into .dat files
+
+    exclude: file skipped in directory scans (the merge output, so a re-run
+    into the scanned directory does not merge its own previous result)
+    """
+    skip = Path(exclude).resolve() if exclude else None
+    files = []
+    for p in map(Path, paths):
+        if p.is_dir():
+            files.extend(f for f in sorted(p.rglob(f"*{COVERAGE_SUFFIX}"))
+                         if f.resolve() != skip)
+        elif p.exists():
+            files.append(p)
+        else:
+            raise FileNotFoundError(f"Coverage file not found: {p}")
+    return files
+
+
+def summarize(counts, threshold=1):
+    """(hit points, total points)"""
+    return sum(1 for c in counts.values() if c >= threshold), len(counts)
+
+
+#==============================================================================
+# PARALLEL MERGE
+#==============================================================================
+
+def _merge_group(files):
+    total = {}
+    for f in files:
+        read_coverage(f, total)
+    return total
+
+
+def merge(files, jobs=None):
+    """
+    Sum point counts over many files.
+
+    Files are split into one group per worker process (parsing is CPU bound,
+    so processes rather than threads); each worker returns its partial sum
+    and the parent adds the partial sums.
+
+    Returns:
+        dict: Merged {point key: count}
+    """
+    jobs = max(1, min(jobs or os.cpu_count() or 1, len(files)))
+    if jobs == 1:
+        return _merge_group(files)
+
+    groups = [files[i::jobs] for i in range(jobs)]
+    total = {}
+    get = total.get
+    with ProcessPoolExecutor(max_workers=jobs) as pool:
+        for partial in pool.map(_merge_group, groups):
+            for key, count in partial.items():
+                total[key] = get(key, 0) + count
+    return total
+
+
+#==============================================================================
+# RANKING
+#==============================================================================
+
+def _split_keys(path, threshold):
+    hit, missed = [], []
+    for key, count in read_coverage(path).items():
+        (hit if count >= threshold else missed).append(key)
+    return path, hit, missed
+
+
+def _bitset(positions, size):
+    # Set bits in a byte buffer, then convert once (OR-ing 1 << i per point
+    # would copy the whole big integer for every point)
+    buf = bytearray((size + 7) // 8)
+    for i in positions:
+        buf[i >> 3] |= 1 << (i & 7)
+    return int.from_bytes(buf, 'little')
+
+
+def rank(files, threshold=1, jobs=None, group=None):
+    """
+    Greedy set-cover ranking of runs by coverage contribution.
+
+    Each step picks the run that adds the most points not yet covered.
+    Runs that add nothing once the earlier ones are in are redundant: the
+    suite reaches the same coverage without them. Hit-point sets are kept
+    as integer bitsets over a shared point index, so a step is a few big-
+    integer AND/popcount operations per run.
+
+    Args:
+        files: Coverage files
+        threshold: Count at which a point is hit
+        jobs: Parallel readers
+        group: Function path -> run name (default: the path itself); files
+               with the same name are united (e.g. all seeds of a test)
+
+    Returns:
+        tuple: (ranking, total_points) with ranking a list of
+               (name, hit points, new points, cumulative points)
+    """
+    jobs = max(1, min(jobs or os.cpu_count() or 1, len(files)))
+    if jobs == 1:
+        split = [_split_keys(f, threshold) for f in files]
+    else:
+        with ProcessPoolExecutor(max_workers=jobs) as pool:
+            split = list(pool.map(_split_keys, files, [threshold] * len(files)))
+
+    index = {}
+    bits = {}
+    for path, hit, missed in split:
+        name = group(path) if group else str(path)
+        positions = [index.setdefault(key, len(index)) for key in hit]
+        bits[name] = bits.get(name, 0) | _bitset(positions, len(index))
+        for key in missed:
+            index.setdefault(key, len(index))
+
+    ranking = []
+    covered = 0
+    remaining = dict(sorted(bits.items()))
+    while remaining:
+        # Most new points first; ties go to the run with fewer points overall,
+        # then to the first name (max() keeps the first of equal keys)
+        name = max(remaining, key=lambda n: ((remaining[n] & ~covered).bit_count(),
+                                             -remaining[n].bit_count()))
+        mask = remaining.pop(name)
+        new = (mask & ~covered).bit_count()
+        covered |= mask
+        ranking.append((name, mask.bit_count(), new, covered.bit_count()))
+    return ranking, len(index)
+
+
+#==============================================================================
+# COMMAND LINE
+#==============================================================================
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Coverage summary, parallel merge and run ranking",
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog="""
+Examples:
+  # Hit / total points per file
+  python3 sim_coverage.py summary sim/coverage/counter
+
+  # Merge every coverage file of all tests (8 processes)
+  python3 sim_coverage.py merge sim/coverage -o sim/coverage_merged.dat --jobs 8
+
+  # Rank the runs of a test; runs adding 0 points are redundant
+  python3 sim_coverage.py rank sim/coverage/diff_pair
+
+  # Rank whole tests (all runs of a test united)
+  python3 sim_coverage.py rank sim/coverage --by-test
+        """
+    )
+    sub = parser.add_subparsers(dest='command', required=True)
+
+    p = sub.add_parser('summary', help="Hit / total points per coverage file")
+    p.add_argument('paths', nargs='+', help="Coverage files or directories")
+    p.add_argument('--threshold', type=int, default=1, help="Count at which a point is hit")
+
+    p = sub.add_parser('merge', help="Merge coverage files (parallel)")
+    p.add_argument('paths', nargs='+', help="Coverage files or directories")
+    p.add_argument('-o', '--output', required=True, help="Merged coverage file")
+    p.add_argument('--jobs', type=int, help="Worker processes (default: CPU count)")
+    p.add_argument('--threshold', type=int, default=1, help="Count at which a point is hit")
+
+    p = sub.add_parser('rank', help="Rank runs by new coverage (suite minimization)")
+    p.add_argument('paths', nargs='+', help="Coverage files or directories")
+    p.add_argument('--by-test', action='store_true',
+                   help="Unite the runs of each test (files grouped by directory)")
+    p.add_argument('--jobs', type=int, help="Worker processes (default: CPU count)")
+    p.add_argument('--threshold', type=int, default=1, help="Count at which a point is hit")
+    p.add_argument('--csv', help="Write the ranking as CSV")
+
+    args = parser.parse_args()
+
+    try:
+        files = coverage_files(args.paths, args.output if args.command == 'merge' else None)
+    except FileNotFoundError as e:
+        print(f"Error: {e}")
+        return 1
+    if not files:
+        print("Error: no coverage files found")
+        return 1
+
+    if args.command == 'summary':
+        for f in files:
+            hit, total = summarize(read_coverage(f), args.threshold)
+            pct = 100.0 * hit / total if total else 0.0
+            print(f"  {str(f):60s} {hit:8d} / {total:<8d} {pct:6.2f}%")
+        return 0
+
+    if args.command == 'merge':
+        merged = merge(files, args.jobs)
+        write_coverage(args.output, merged)
+        hit, total = summarize(merged, args.threshold)
+        pct = 100.0 * hit / total if total else 0.0
+        print(f"✓ Merged {len(files)} files: {hit} / {total} points hit ({pct:.2f}%)")
+        print(f"  Output: {args.output}")
+        return 0
+
+    group = (lambda path: Path(path).parent.name) if args.by_test else None
+    ranking, total = rank(files, args.threshold, args.jobs, group)
+
+    print(f"  {'rank':>4s}  {'run':50s} {'points':>8s} {'new':>8s} {'cumulative':>12s}")
+    print(f"  {'-' * 4}  {'-' * 50} {'-' * 8} {'-' * 8} {'-' * 12}")
+    for i, (name, hit, new, cumulative) in enumerate(ranking, 1):
+        pct = 100.0 * cumulative / total if total else 0.0
+        print(f"  {i:4d}  {name:50s} {hit:8d} {new:8d} {cumulative:7d} {pct:3.0f}%")
+
+    redundant = [name for name, _, new, _ in ranking if new == 0]
+    print()
+    print(f"  Points hit: {ranking[-1][3] if ranking else 0} / {total}  |  "
+          f"Runs: {len(ranking)}  |  Needed: {len(ranking) - len(redundant)}  |  "
+          f"Redundant: {len(redundant)}")
+
+    if args.csv:
+        with open(args.csv, 'w', newline='') as f:
+            writer = csv.writer(f)
+            writer.writerow(['rank', 'run', 'points', 'new', 'cumulative'])
+            for i, row in enumerate(ranking, 1):
+                writer.writerow([i, *row])
+        print(f"  Ranking: {args.csv}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,279 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+Streaming Simulator Output Pipeline
+
+Runs a simulation executable and handles its output line by line while it
+runs, instead of buffering everything until the process exits:
+
+    - Tee: every line is echoed to the console and written to a per-test
+      log file (sim/logs/<test>.log); past `max_log_bytes` the log keeps
+      the head, a truncation marker, and the last `tail_lines` lines
+    - Parse: PASS/FAIL banners, simulation-timeout messages and
+      "[METRIC] name = value" lines are picked up as they appear
+    - Progress: on a terminal, a live status line shows elapsed time,
+      line count, log size and simulated time ("[1234 ns] ..." prefixes)
+      against the configured sim_timeout
+    - Bounded memory: only the last `tail_lines` lines are kept in memory;
+      the log file and the parsed results survive a timeout kill
+    - Peak RSS: the child is reaped with wait4(), so its peak resident set
+      (including its own reaped children, e.g. make / g++) is exact per run
+
+Author: Generated for SystemVerilog test automation
+"""
+
+import os
+import queue
+import re
+import subprocess
+import sys
+import threading
+import time
+from collections import deque
+from pathlib import Path
+
+from sweep import parse_metrics
+
+DEFAULT_MAX_LOG_BYTES = 50 * 1024 * 1024
+DEFAULT_TAIL_LINES = 1000
+PROGRESS_INTERVAL_S = 0.2
+
+SIM_TIME_RE = re.compile(r'^\[(\d+(?:\.\d+)?)\s*(fs|ps|ns|us|ms|s)\]')
+TIME_UNITS = {'fs': 1e-15, 'ps': 1e-12, 'ns': 1e-9, 'us': 1e-6, 'ms': 1e-3, 's': 1.0}
+
+
+class StreamResult:
+    """Everything known about a streamed run, complete or killed"""
+
+    def __init__(self):
+        self.returncode = None
+        self.timed_out = False
+        self.passed = False         # "*** PASSED" seen
+        self.failed = False         # "*** FAILED" or testbench timeout seen
+        self.metrics = {}
+        self.lines = 0
+        self.log_bytes = 0
+        self.log_truncated = False
+        self.log_path = None
+        self.sim_time_s = None      # Last "[<t> <unit>]" line prefix
+        self.peak_rss_mb = None
+        self.tail = deque(maxlen=DEFAULT_TAIL_LINES)
+
+    @property
+    def tail_text(self):
+        return ''.join(self.tail)
+
+    @property
+    def status(self):
+        """PASS / FAIL / TIMEOUT / ERROR (same vocabulary as sweep.point_status)"""
+        if self.timed_out:
+            return 'TIMEOUT'
+        if self.returncode != 0:
+            return 'ERROR'
+        return 'FAIL' if self.failed else 'PASS'
+
+
+class _LogWriter:
+    """Size-limited log: head up to max_bytes, then marker + tail at close"""
+
+    def __init__(self, path, max_bytes, result):
+        self.path = Path(path)
+        self.path.parent.mkdir(parents=True, exist_ok=True)
+        self.f = open(self.path, 'w', encoding='utf-8', errors='replace')
+        self.max_bytes = max_bytes
+        self.result = result
+        self.head_lines = 0
+
+    def write(self, line):
+        size = len(line.encode('utf-8', errors='replace'))
+        if not self.result.log_truncated and self.result.log_bytes + size <= self.max_bytes:
+            self.f.write(line)
+            self.result.log_bytes += size
+            self.head_lines += 1
+            # Flush per line: the log must be complete up to a kill
+            self.f.flush()
+        else:
+            self.result.log_truncated = True
+
+    def close(self):
+        if self.result.log_truncated:
+            skipped = self.result.lines - self.head_lines - len(self.result.tail)
+            self.f.write(f"\n... [log truncated at {self.max_bytes} bytes: {max(skipped, 0)} "
+                         f"lines skipped, last {len(self.result.tail)} lines follow] ...\n\n")
+            self.f.writelines(self.result.tail)
+        self.f.close()
+
+
+def _reader(stream, lines):
+    for line in iter(stream.readline, ''):
+        lines.put(line)
+    lines.put(None)
+
+
+def wait_rusage(proc):
+    """
+    Reap proc with wait4() and return its peak RSS in MB.
+
+    Linux reports the maximum over the child and all descendants it reaped,
+    so a compiler driver's peak covers its sub-processes.
+    """
+    try:
+        _, status, usage = os.wait4(proc.pid, 0)
+    except ChildProcessError:
+        # Already reaped elsewhere; no usage available
+        proc.wait()
+        return None
+    proc.returncode = os.waitstatus_to_exitcode(status)
+    return usage.ru_maxrss / 1024.0
+
+
+def run_capture(cmd, cwd):
+    """
+    subprocess.run(capture_output=True) equivalent that also measures peak RSS.
+
+    Returns:
+        tuple: (returncode, stdout, stderr, peak_rss_mb)
+    """
+    proc = subprocess.Popen(cmd, cwd=cwd, stdout=subprocess.PIPE, stderr=subprocess.PIPE,
+                            text=True, errors='replace')
+    chunks = {'out': [], 'err': []}
+    readers = [threading.Thread(target=lambda s=stream, k=key: chunks[k].append(s.read()),
+                                daemon=True)
+               for stream, key in ((proc.stdout, 'out'), (proc.stderr, 'err'))]
+    for r in readers:
+        r.start()
+    peak = wait_rusage(proc)
+    for r in readers:
+        r.join()
+    return proc.returncode, ''.join(chunks['out']), ''.join(chunks['err']), peak
+
+
+def run_streaming(cmd, cwd, log_path=None, timeout=None, max_log_bytes=DEFAULT_MAX_LOG_BYTES,
+                  tail_lines=DEFAULT_TAIL_LINES, echo=True, progress=None, sim_timeout_s=None):
+    """
+    Run cmd, streaming merged stdout/stderr through the pipeline.
+
+    Args:
+        cmd: Command list
+        cwd: Working directory
+        log_path: Per-run log file (None: no log)
+        timeout: Wall-clock limit in seconds (process is killed past it)
+        max_log_bytes: Log size limit before head/tail truncation
+        tail_lines: Lines kept in memory (and appended to a truncated log)
+        echo: Print every line to the console
+        progress: Live status line (default: only when stdout is a terminal)
+        sim_timeout_s: Testbench timeout in seconds, for the progress fraction
+
+    Returns:
+        StreamResult
+    """
+    result = StreamResult()
+    result.tail = deque(maxlen=tail_lines)
+    if progress is None:
+        progress = sys.stdout.isatty()
+
+    log = _LogWriter(log_path, max_log_bytes, result) if log_path else None
+    result.log_path = log.path if log else None
+
+    proc = subprocess.Popen(cmd, cwd=cwd, stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                            text=True, errors='replace', bufsize=1)
+    lines = queue.Queue()
+    reader = threading.Thread(target=_reader, args=(proc.stdout, lines), daemon=True)
+    reader.start()
+
+    start = time.monotonic()
+    deadline = start + timeout if timeout else None
+    last_progress = 0.0
+    progress_shown = False
+
+    def clear_progress():
+        nonlocal progress_shown
+        if progress_shown:
+            sys.stdout.write('\r\033[K')
+            progress_shown = False
+
+    def consume(line):
+        result.lines += 1
+        result.tail.append(line)
+        if log:
+            log.write(line)
+        _parse_line(line, result)
+        if echo:
+            clear_progress()
+            sys.stdout.write(line)
+
+    try:
+        while True:
+            wait = PROGRESS_INTERVAL_S
+            if deadline is not None:
+                wait = max(0.0, min(wait, deadline - time.monotonic()))
+            try:
+                line = lines.get(timeout=wait)
+            except queue.Empty:
+                line = ''
+
+            if line is None:
+                break
+
+            if line:
+                consume(line)
+
+            now = time.monotonic()
+            if deadline is not None and now >= deadline:
+                result.timed_out = True
+                proc.kill()
+                break
+
+            if progress and now - last_progress >= PROGRESS_INTERVAL_S:
+                clear_progress()
+                sys.stdout.write(_progress_text(result, now - start, sim_timeout_s))
+                sys.stdout.flush()
+                progress_shown = True
+                last_progress = now
+    except KeyboardInterrupt:
+        proc.kill()
+        raise
+    finally:
+        clear_progress()
+        sys.stdout.flush()
+        result.peak_rss_mb = wait_rusage(proc)
+        reader.join(timeout=1.0)
+        # Lines still queued when the process was killed
+        while True:
+            try:
+                line = lines.get_nowait()
+            except queue.Empty:
+                break
+            if line:
+                consume(line)
+        sys.stdout.flush()
+        if log:
+            log.close()
+
+    result.returncode = None if result.timed_out else proc.returncode
+    return result
+
+
+def _parse_line(line, result):
+    if '*** PASSED' in line:
+        result.passed = True
+    elif '*** FAILED' in line or 'Simulation timeout' in line:
+        result.failed = True
+
+    if '[METRIC]' in line:
+        result.metrics.update(parse_metrics(line))
+
+    match = SIM_TIME_RE.match(line)
+    if match:
+        result.sim_time_s = float(match.group(1)) * TIME_UNITS[match.group(2)]
+
+
+def _progress_text(result, elapsed, sim_timeout_s):
+    text = f"   ⏳ {elapsed:6.1f}s | {result.lines} lines | {result.log_bytes / 1024:.0f} KB"
+    if result.sim_time_s is not None:
+        text += f" | sim {result.sim_time_s * 1e6:.3f} us"
+        if sim_timeout_s:
+            text += f" ({100.0 * result.sim_time_s / sim_timeout_s:.0f}% of timeout)"
+    if result.failed:
+        text += " | ✗ failure seen"
+    return text
@@ -11,14 +11,20 @@ from abc import ABC, abstractmethod
 from pathlib import Path
 import subprocess
 import shutil
+import os
 import re
+import time
+
+from sim_stream import run_capture, run_streaming, DEFAULT_MAX_LOG_BYTES
+from results_db import parse_perf
+from sim_coverage import read_coverage, summarize
 
 
 def parse_timeout(timeout_str):
     """
     Parse timeout string with unit suffix and convert to seconds.
 
-    Supports formats: "10000ns", "50us", "100ms", "5s"
+    Supports formats: "10000ns", "50us", "100ms", "5s", "10m", "2h"
     Also supports integers (us assumed for backward compatibility)
 
     Args:
@@ -37,7 +43,7 @@ def parse_timeout(timeout_str):
     if not isinstance(timeout_str, str):
         raise ValueError(f"Invalid timeout format: {timeout_str}")
 
-    match = re.match(r'^(\d+\.?\d*)\s*(ns|us|ms|s)$', timeout_str.strip())
+    match = re.match(r'^(\d+\.?\d*)\s*(ns|us|ms|s|m|h)$', timeout_str.strip())
     if not match:
         raise ValueError(
             f"Invalid timeout format: {timeout_str}. "
@@ -51,12 +57,35 @@ def parse_timeout(timeout_str):
         'ns': 1e-9,
         'us': 1e-6,
         'ms': 1e-3,
-        's': 1.0
+        's': 1.0,
+        'm': 60.0,
+        'h': 3600.0
     }
 
     return value * conversions[unit]
 
 
+def parse_size(size_str):
+    """
+    Parse a size with unit suffix ("50MB", "512KB", "1GB", or plain bytes).
+
+    Returns:
+        int: Size in bytes
+
+    Raises:
+        ValueError: If format is invalid
+    """
+    if isinstance(size_str, int):
+        return size_str
+
+    match = re.match(r'^(\d+\.?\d*)\s*(B|KB|MB|GB)?$', str(size_str).strip(), re.IGNORECASE)
+    if not match:
+        raise ValueError(f"Invalid size format: {size_str}. Expected e.g. '50MB', '512KB'")
+
+    scale = {'B': 1, 'KB': 1024, 'MB': 1024 ** 2, 'GB': 1024 ** 3}[(match.group(2) or 'B').upper()]
+    return int(float(match.group(1)) * scale)
+
+
 def parse_sim_timeout(timeout_str, timescale_unit_str='1ns'):
     """
     Parse simulation timeout string and convert to numeric value in timescale units.
@@ -175,6 +204,35 @@ class BaseSimulator(ABC):
         self.rtl_files = test_config.get('rtl_files', [])
         self.vcd_file = self.waves_dir / f"{self.test_name}.vcd"
 
+        self.log_file = self.project_root / project_config.get('log_dir', 'sim/logs') / \
+            f"{self.test_name}.log"
+
+        # Parallel runs give every test its own work directory (a sibling of
+        # the shared one, so relative paths in extra flags still resolve)
+        self.isolated = bool(project_config.get('isolate_work_dirs', False))
+
+        # Last run_simulation() outcome (for result recording); last_stdout
+        # holds only the output tail, last_result the streamed parse results
+        self.last_stdout = ''
+        self.last_returncode = None
+        self.last_result = None
+        self.last_compile_rss_mb = None
+
+        # Adaptive execution timeout: simulated ns per wall second measured
+        # on earlier runs (set by the runner from the result history)
+        self.expected_speed = None
+        self.last_speed = None
+        self.last_slowdown = None
+
+        # Coverage runs: the model is built with `coverage_flags` in its own
+        # work directory (<work_dir>_cov, so the normal build stays cached)
+        # and every run writes its own file under coverage_dir/<test>/
+        self.coverage = bool(project_config.get('coverage', False))
+        self.coverage_dir = self.project_root / \
+            project_config.get('coverage_dir', 'sim/coverage') / self.test_name
+        self.last_coverage_file = None
+        self.last_coverage = None   # (hit points, total points)
+
     @abstractmethod
     def get_work_dir(self) -> Path:
         """Return simulator-specific work directory for compilation artifacts."""
@@ -210,6 +268,188 @@ class BaseSimulator(ABC):
         """Clean simulator-specific artifacts."""
         pass
 
+    @abstractmethod
+    def coverage_run_args(self, coverage_file) -> list:
+        """Executable arguments that direct a run's coverage into coverage_file."""
+        pass
+
+    def coverage_args(self, tag):
+        """
+        Coverage arguments for one run (empty unless coverage is enabled).
+
+        Args:
+            tag: Run name, unique within the test (e.g. 'point_00012')
+        """
+        if not self.coverage:
+            self.last_coverage_file = None
+            return []
+        self.coverage_dir.mkdir(parents=True, exist_ok=True)
+        self.last_coverage_file = self.coverage_dir / f"{tag}.dat"
+        return self.coverage_run_args(self.last_coverage_file)
+
+    def report_coverage(self):
+        """Print hit / total points of the last coverage file"""
+        self.last_coverage = None
+        if self.last_coverage_file is None:
+            return
+        if not self.last_coverage_file.exists():
+            print(f"⚠ Coverage file not written: {self.last_coverage_file}")
+            return
+        hit, total = summarize(read_coverage(self.last_coverage_file))
+        self.last_coverage = (hit, total)
+        pct = 100.0 * hit / total if total else 0.0
+        print(f"   Coverage: {hit} / {total} points ({pct:.1f}%) → {self.last_coverage_file}")
+
+    def stream_simulation(self, cmd, timeout_seconds):
+        """
+        Run the simulation through the streaming output pipeline.
+
+        Output is echoed and teed to the per-test log (sim/logs/<test>.log,
+        size-limited by `max_log_size`) as it is produced, PASS/FAIL and
+        metric lines are parsed on the fly, and a live progress line is
+        shown on terminals. The log and parse results survive a timeout.
+
+        Args:
+            cmd: Executable command list
+            timeout_seconds: Wall-clock limit (None: unlimited)
+
+        Returns:
+            bool: True if the executable exited normally, False otherwise
+        """
+        max_bytes = parse_size(self.sim_config.get('max_log_size', DEFAULT_MAX_LOG_BYTES))
+
+        start = time.monotonic()
+        result = run_streaming(cmd, self.project_root, log_path=self.log_file,
+                               timeout=timeout_seconds, max_log_bytes=max_bytes,
+                               sim_timeout_s=self.sim_timeout_seconds())
+        wall = time.monotonic() - start
+        self.last_result = result
+        self.last_stdout = result.tail_text
+        self.last_returncode = result.returncode
+
+        note = " (truncated)" if result.log_truncated else ""
+        print(f"   Log: {self.log_file} ({result.lines} lines){note}")
+
+        if not result.timed_out and result.returncode == 0:
+            self.check_speed(result, wall)
+        if self.coverage:
+            self.report_coverage()
+
+        if result.timed_out:
+            print(f"✗ Simulation TIMEOUT (exceeded {timeout_seconds:.1f}s)")
+            print(f"   The testbench may have an infinite loop or insufficient timeout value")
+            print(f"   Output up to the kill is in {self.log_file}")
+            return False
+
+        if result.returncode != 0:
+            print(f"✗ Simulation FAILED (exit code {result.returncode})")
+            return False
+
+        if self.vcd_file.exists():
+            vcd_size = self.vcd_file.stat().st_size
+            print(f"✓ Simulation complete (VCD: {vcd_size} bytes)\n")
+        else:
+            print("⚠ VCD file not generated (may be normal for some tests)\n")
+        return True
+
+    def sim_timeout_seconds(self):
+        """The test's sim_timeout in seconds of simulated time (None if unset)"""
+        if 'sim_timeout' not in self.test_config:
+            return None
+        try:
+            return parse_timeout(self.test_config['sim_timeout'])
+        except ValueError:
+            return None
+
+    def execution_timeout(self):
+        """
+        Wall-clock kill timeout for one simulation.
+
+        With `adaptive_timeout` configured and a measured speed for this test
+        (expected_speed, simulated ns per wall second), the timeout is the
+        predicted wall time to reach sim_timeout times `margin`, clamped to
+        [min, max]. Otherwise the test's own `execution_timeout`, falling
+        back to the simulator's.
+
+        Returns:
+            tuple: (seconds or None, description for the console)
+        """
+        configured = self.test_config.get('execution_timeout',
+                                          self.sim_config.get('execution_timeout'))
+        fixed = parse_timeout(configured) if configured is not None else None
+
+        adaptive = self.sim_config.get('adaptive_timeout')
+        sim_timeout_s = self.sim_timeout_seconds()
+        if not adaptive or not self.expected_speed or sim_timeout_s is None or \
+                'execution_timeout' in self.test_config:
+            return fixed, f"{configured} ({fixed}s)"
+
+        predicted = sim_timeout_s * 1e9 / self.expected_speed
+        timeout = predicted * float(adaptive.get('margin', 3.0))
+        timeout = max(timeout, parse_timeout(adaptive.get('min', '5s')))
+        if 'max' in adaptive:
+            timeout = min(timeout, parse_timeout(adaptive['max']))
+        return timeout, (f"{timeout:.1f}s (adaptive: {self.test_config['sim_timeout']} at "
+                         f"{self.expected_speed:.4g} ns/s → {predicted:.2f}s predicted)")
+
+    def check_speed(self, result, wall_seconds):
+        """
+        Measure simulated ns per wall second and flag abnormally slow runs.
+
+        The simulated time is the "$finish at" time of the Verilator report,
+        else the last "[<t> <unit>]" line prefix.
+        """
+        sim_ns = parse_perf(result.tail_text).get('perf.sim_ns')
+        if sim_ns is None and result.sim_time_s is not None:
+            sim_ns = result.sim_time_s * 1e9
+        if not sim_ns or wall_seconds <= 0.0:
+            return
+        self.last_speed = sim_ns / wall_seconds
+
+        if not self.expected_speed:
+            return
+        self.last_slowdown = self.expected_speed / self.last_speed
+        adaptive = self.sim_config.get('adaptive_timeout') or {}
+        slow_factor = float(adaptive.get('slow_factor', 2.0))
+        if self.last_slowdown >= slow_factor:
+            print(f"⚠ SLOW RUN: {self.last_speed:.4g} ns/s is {self.last_slowdown:.1f}x slower "
+                  f"than this test's history ({self.expected_speed:.4g} ns/s)")
+
+    def run_executable(self, plusargs, coverage_tag=None):
+        """
+        Run the compiled executable once with extra plusargs, capturing output.
+
+        Used by parameter sweeps: one compile, many runs. Nothing is printed;
+        the caller owns reporting. Every point is bounded by sim_timeout, so
+        the adaptive timeout applies to each of them.
+
+        Args:
+            plusargs: List of simulator arguments (e.g., ['+NO_VCD', '+GAIN=0.1'])
+            coverage_tag: Coverage file name for coverage runs (e.g. 'point_00012')
+
+        Returns:
+            tuple: (returncode, stdout, stderr); returncode is None on timeout
+        """
+        timeout_seconds, _ = self.execution_timeout()
+        if self.coverage and coverage_tag:
+            self.coverage_dir.mkdir(parents=True, exist_ok=True)
+            plusargs = list(plusargs) + \
+                self.coverage_run_args(self.coverage_dir / f"{coverage_tag}.dat")
+
+        try:
+            result = subprocess.run(
+                [str(self.get_executable_path())] + list(plusargs),
+                cwd=self.project_root,
+                capture_output=True,
+                text=True,
+                timeout=timeout_seconds
+            )
+            return result.returncode, result.stdout, result.stderr
+
+        except subprocess.TimeoutExpired as e:
+            stdout = e.stdout.decode(errors='replace') if isinstance(e.stdout, bytes) else (e.stdout or '')
+            return None, stdout, f"Execution timeout ({timeout_seconds}s)\n"
+
     def get_effective_timescale(self):
         """
         Determine effective timescale for this test.
@@ -266,7 +506,12 @@ class VerilatorSimulator(BaseSimulator):
     """Verilator simulator implementation."""
 
     def get_work_dir(self) -> Path:
-        return self.project_root / self.project_config.get('obj_dir', 'sim/obj_dir')
+        work_dir = self.project_config.get('obj_dir', 'sim/obj_dir')
+        if self.isolated:
+            work_dir += f"_{self.test_name}"
+        if self.coverage:
+            work_dir += "_cov"
+        return self.project_root / work_dir
 
     def get_executable_path(self) -> Path:
         return self.get_work_dir() / f"V{self.top_module}"
@@ -280,6 +525,12 @@ class VerilatorSimulator(BaseSimulator):
         # Add common flags
         cmd.extend(self.sim_config.get('common_flags', []))
 
+        # Coverage instrumentation (line + user cover points by default;
+        # toggle coverage costs far more simulation speed)
+        if self.coverage:
+            cmd.extend(self.sim_config.get('coverage_flags',
+                                           ['--coverage-line', '--coverage-user']))
+
         # Add test-specific flags
         cmd.extend(self.test_config.get('verilator_extra_flags', []))
 
@@ -313,29 +564,22 @@ class VerilatorSimulator(BaseSimulator):
 
         print(f"   Command: {' '.join(cmd)}")
 
-        try:
-            result = subprocess.run(
-                cmd,
-                cwd=self.project_root,
-                check=True,
-                capture_output=True,
-                text=True
-            )
-
-            if result.stdout:
-                print(result.stdout)
-            if result.stderr:
-                print(result.stderr)
-
-            print("✓ Compilation successful\n")
-            return True
+        returncode, stdout, stderr, self.last_compile_rss_mb = run_capture(cmd, self.project_root)
 
-        except subprocess.CalledProcessError as e:
+        if returncode != 0:
             print("✗ Compilation FAILED")
-            print(f"\nStdout:\n{e.stdout}")
-            print(f"\nStderr:\n{e.stderr}")
+            print(f"\nStdout:\n{stdout}")
+            print(f"\nStderr:\n{stderr}")
             return False
 
+        if stdout:
+            print(stdout)
+        if stderr:
+            print(stderr)
+
+        print("✓ Compilation successful\n")
+        return True
+
     def run_simulation(self) -> bool:
         """Execute Verilator simulation."""
         print(f"🚀 Running simulation for '{self.test_name}'...")
@@ -345,45 +589,17 @@ class VerilatorSimulator(BaseSimulator):
             print(f"✗ Executable not found: {executable}")
             return False
 
-        timeout_seconds = None
-        if 'execution_timeout' in self.sim_config:
-            timeout_seconds = parse_timeout(self.sim_config['execution_timeout'])
-            print(f"   Execution timeout: {self.sim_config['execution_timeout']} ({timeout_seconds}s)")
-
-        try:
-            self.waves_dir.mkdir(parents=True, exist_ok=True)
-
-            result = subprocess.run(
-                [str(executable)],
-                cwd=self.project_root,
-                check=True,
-                capture_output=True,
-                text=True,
-                timeout=timeout_seconds
-            )
-
-            print(result.stdout)
-            if result.stderr:
-                print(result.stderr)
-
-            if self.vcd_file.exists():
-                vcd_size = self.vcd_file.stat().st_size
-                print(f"✓ Simulation complete (VCD: {vcd_size} bytes)\n")
-                return True
-            else:
-                print("⚠ VCD file not generated (may be normal for some tests)\n")
-                return True
+        timeout_seconds, description = self.execution_timeout()
+        if timeout_seconds is not None:
+            print(f"   Execution timeout: {description}")
 
-        except subprocess.TimeoutExpired:
-            print(f"✗ Simulation TIMEOUT (exceeded {timeout_seconds}s)")
-            print(f"   The testbench may have an infinite loop or insufficient timeout value")
-            return False
+        self.waves_dir.mkdir(parents=True, exist_ok=True)
+        tag = f"run_{time.strftime('%Y%m%d_%H%M%S')}_{os.getpid()}"
+        return self.stream_simulation([str(executable)] + self.coverage_args(tag),
+                                      timeout_seconds)
 
-        except subprocess.CalledProcessError as e:
-            print("✗ Simulation FAILED")
-            print(f"\nStdout:\n{e.stdout}")
-            print(f"\nStderr:\n{e.stderr}")
-            return False
+    def coverage_run_args(self, coverage_file) -> list:
+        return [f"+verilator+coverage+file+{coverage_file}"]
 
     def clean(self):
         """Clean Verilator artifacts."""
@@ -398,6 +614,10 @@ class VerilatorSimulator(BaseSimulator):
             self.vcd_file.unlink()
             print(f"   Removed {self.vcd_file}")
 
+        if self.log_file.exists():
+            self.log_file.unlink()
+            print(f"   Removed {self.log_file}")
+
         print("✓ Clean complete\n")
 
 
@@ -405,7 +625,12 @@ class VCSSimulator(BaseSimulator):
     """Synopsys VCS simulator implementation."""
 
     def get_work_dir(self) -> Path:
-        return self.project_root / self.project_config.get('vcs_dir', 'sim/vcs')
+        work_dir = self.project_config.get('vcs_dir', 'sim/vcs')
+        if self.isolated:
+            work_dir += f"_{self.test_name}"
+        if self.coverage:
+            work_dir += "_cov"
+        return self.project_root / work_dir
 
     def get_executable_path(self) -> Path:
         return self.get_work_dir() / "simv"
@@ -422,12 +647,20 @@ class VCSSimulator(BaseSimulator):
         # Add common flags
         cmd.extend(self.sim_config.get('common_flags', []))
 
+        # Coverage instrumentation
+        if self.coverage:
+            cmd.extend(self.sim_config.get('coverage_flags', ['-cm', 'line+cond+assert']))
+
         # Add test-specific flags
         cmd.extend(self.test_config.get('vcs_extra_flags', []))
 
         # Output executable path
         cmd.extend(["-o", str(self.get_executable_path())])
 
+        # Keep intermediate files out of the shared csrc/ in parallel runs
+        if self.isolated:
+            cmd.append(f"-Mdir={work_dir / 'csrc'}")
+
         # Add simulation timeout parameter if specified
         if 'sim_timeout' in self.test_config:
             self.validate_timescales()
@@ -450,29 +683,22 @@ class VCSSimulator(BaseSimulator):
 
         print(f"   Command: {' '.join(cmd)}")
 
-        try:
-            result = subprocess.run(
-                cmd,
-                cwd=self.project_root,
-                check=True,
-                capture_output=True,
-                text=True
-            )
-
-            if result.stdout:
-                print(result.stdout)
-            if result.stderr:
-                print(result.stderr)
+        returncode, stdout, stderr, self.last_compile_rss_mb = run_capture(cmd, self.project_root)
 
-            print("✓ Compilation successful\n")
-            return True
-
-        except subprocess.CalledProcessError as e:
+        if returncode != 0:
             print("✗ Compilation FAILED")
-            print(f"\nStdout:\n{e.stdout}")
-            print(f"\nStderr:\n{e.stderr}")
+            print(f"\nStdout:\n{stdout}")
+            print(f"\nStderr:\n{stderr}")
             return False
 
+        if stdout:
+            print(stdout)
+        if stderr:
+            print(stderr)
+
+        print("✓ Compilation successful\n")
+        return True
+
     def run_simulation(self) -> bool:
         """Execute VCS simulation."""
         print(f"🚀 Running simulation for '{self.test_name}'...")
@@ -482,45 +708,27 @@ class VCSSimulator(BaseSimulator):
             print(f"✗ Executable not found: {executable}")
             return False
 
-        timeout_seconds = None
-        if 'execution_timeout' in self.sim_config:
-            timeout_seconds = parse_timeout(self.sim_config['execution_timeout'])
-            print(f"   Execution timeout: {self.sim_config['execution_timeout']} ({timeout_seconds}s)")
+        timeout_seconds, description = self.execution_timeout()
+        if timeout_seconds is not None:
+            print(f"   Execution timeout: {description}")
 
-        try:
-            self.waves_dir.mkdir(parents=True, exist_ok=True)
-
-            result = subprocess.run(
-                [str(executable)],
-                cwd=self.project_root,
-                check=True,
-                capture_output=True,
-                text=True,
-                timeout=timeout_seconds
-            )
-
-            print(result.stdout)
-            if result.stderr:
-                print(result.stderr)
+        self.waves_dir.mkdir(parents=True, exist_ok=True)
+        tag = f"run_{time.strftime('%Y%m%d_%H%M%S')}_{os.getpid()}"
+        return self.stream_simulation([str(executable)] + self.coverage_args(tag),
+                                      timeout_seconds)
 
-            if self.vcd_file.exists():
-                vcd_size = self.vcd_file.stat().st_size
-                print(f"✓ Simulation complete (VCD: {vcd_size} bytes)\n")
-                return True
-            else:
-                print("⚠ VCD file not generated (may be normal for some tests)\n")
-                return True
+    def coverage_run_args(self, coverage_file) -> list:
+        # VCS writes a coverage database, one test entry per run
+        # (merge and rank with urg; sim_coverage.py reads Verilator files)
+        metrics = self.sim_config.get('coverage_flags', ['-cm', 'line+cond+assert'])
+        return metrics + ["-cm_dir", str(self.coverage_dir / f"{self.test_name}.vdb"),
+                          "-cm_name", coverage_file.stem]
 
-        except subprocess.TimeoutExpired:
-            print(f"✗ Simulation TIMEOUT (exceeded {timeout_seconds}s)")
-            print(f"   The testbench may have an infinite loop or insufficient timeout value")
-            return False
-
-        except subprocess.CalledProcessError as e:
-            print("✗ Simulation FAILED")
-            print(f"\nStdout:\n{e.stdout}")
-            print(f"\nStderr:\n{e.stderr}")
-            return False
+    def report_coverage(self):
+        self.last_coverage = None
+        if self.last_coverage_file is not None:
+            print(f"   Coverage: {self.coverage_dir / f'{self.test_name}.vdb'} "
+                  f"(test {self.last_coverage_file.stem})")
 
     def clean(self):
         """Clean VCS artifacts."""
@@ -551,6 +759,10 @@ class VCSSimulator(BaseSimulator):
             self.vcd_file.unlink()
             print(f"   Removed {self.vcd_file}")
 
+        if self.log_file.exists():
+            self.log_file.unlink()
+            print(f"   Removed {self.log_file}")
+
         print("✓ Clean complete\n")
 
 
@@ -0,0 +1,319 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+Parameter Sweep Engine for the SystemVerilog Test Framework
+
+Expands the `sweep:` section of a test in test_config.yaml into a list of
+parameter points, runs every point against ONE compiled simulation model
+(parameters are passed as +NAME=value plusargs), and aggregates per-point
+metrics into one table.
+
+Sweep section:
+    sweep:
+      method: lhs            # grid | random | lhs (Latin hypercube)
+      samples: 100           # point count for random / lhs
+      seed: 88               # expansion seed (reproducible point sets)
+      jobs: 8                # parallel simulations (default: CPU count)
+      parameters:
+        SKEW_PS: {min: 2.0, max: 30.0}           # continuous range
+        F_HZ:    {min: 1.0e8, max: 1.0e10, log: true}
+        SEED:    {min: 1, max: 1000, type: int}
+        MODE:    [0, 1, 2]                       # discrete values
+        GAIN:    {min: 0.0, max: 0.2, steps: 5}  # grid: 5 evenly spaced
+
+Testbench contract:
+    - Read parameters with $value$plusargs("NAME=%f", var) (or %d)
+    - Skip the VCD dump when $test$plusargs("NO_VCD") (parallel points
+      must not all write the same waveform file)
+    - Report metrics as lines "[METRIC] name = value"
+    - The usual "*** PASSED" / "*** FAILED" banners decide point status
+
+Author: Generated for SystemVerilog test automation
+"""
+
+import csv
+import itertools
+import math
+import os
+import random
+import re
+import time
+from concurrent.futures import ThreadPoolExecutor
+from pathlib import Path
+
+from results_db import parse_perf
+
+METRIC_RE = re.compile(r'^\s*\[METRIC\]\s+([\w.]+)\s*=\s*(\S+)')
+
+SWEEP_METHODS = ('grid', 'random', 'lhs')
+
+
+class SweepParameter:
+    """One swept parameter: a discrete value list or a (log-)uniform range"""
+
+    def __init__(self, name, spec):
+        self.name = name
+        self.values = None
+        self.low = self.high = None
+        self.log = False
+        self.is_int = False
+        self.steps = None
+
+        if isinstance(spec, list):
+            if not spec:
+                raise ValueError(f"Sweep parameter '{name}': empty value list")
+            self.values = spec
+            return
+
+        if not isinstance(spec, dict) or 'min' not in spec or 'max' not in spec:
+            raise ValueError(
+                f"Sweep parameter '{name}': expected a value list or "
+                f"{{min: .., max: ..}} range, got {spec!r}"
+            )
+
+        self.low = float(spec['min'])
+        self.high = float(spec['max'])
+        self.log = bool(spec.get('log', False))
+        self.is_int = spec.get('type', 'float') == 'int'
+        self.steps = spec.get('steps')
+
+        if self.high < self.low:
+            raise ValueError(f"Sweep parameter '{name}': max < min")
+        if self.log and self.low <= 0.0:
+            raise ValueError(f"Sweep parameter '{name}': log range needs min > 0")
+
+    def at(self, u):
+        """Map u in [0, 1) to a parameter value"""
+        if self.values is not None:
+            return self.values[min(int(u * len(self.values)), len(self.values) - 1)]
+
+        if self.is_int and not self.log:
+            # Integer ranges include both end points
+            return min(int(math.floor(self.low + u * (self.high - self.low + 1))), int(self.high))
+
+        if self.log:
+            value = math.exp(math.log(self.low) + u * (math.log(self.high) - math.log(self.low)))
+        else:
+            value = self.low + u * (self.high - self.low)
+        return int(round(value)) if self.is_int else value
+
+    def grid(self):
+        """Grid values: the list itself, or `steps` points spanning [min, max]"""
+        if self.values is not None:
+            return list(self.values)
+
+        if self.is_int and self.steps is None:
+            return list(range(int(self.low), int(self.high) + 1))
+
+        steps = int(self.steps or 5)
+        if steps == 1:
+            return [self.at(0.0)]
+
+        points = []
+        for i in range(steps):
+            u = i / (steps - 1)
+            if self.log:
+                value = math.exp(math.log(self.low) + u * (math.log(self.high) - math.log(self.low)))
+            else:
+                value = self.low + u * (self.high - self.low)
+            points.append(int(round(value)) if self.is_int else value)
+        return points
+
+
+def expand_sweep(sweep_config, samples=None, seed=None):
+    """
+    Expand a sweep section into a list of parameter dictionaries.
+
+    Args:
+        sweep_config: The test's `sweep:` dictionary
+        samples: Override of `samples` (random / lhs)
+        seed: Override of `seed`
+
+    Returns:
+        list[dict]: One {name: value} dictionary per point
+
+    Raises:
+        ValueError: If the section is malformed
+    """
+    method = sweep_config.get('method', 'grid')
+    if method not in SWEEP_METHODS:
+        raise ValueError(f"Unknown sweep method: {method}. "
+                         f"Available methods: {', '.join(SWEEP_METHODS)}")
+
+    specs = sweep_config.get('parameters', {})
+    if not specs:
+        raise ValueError("Sweep section has no parameters")
+    params = [SweepParameter(name, spec) for name, spec in specs.items()]
+
+    samples = int(samples if samples is not None else sweep_config.get('samples', 10))
+    seed = seed if seed is not None else sweep_config.get('seed', 0)
+    rng = random.Random(seed)
+
+    if method == 'grid':
+        grids = [p.grid() for p in params]
+        return [dict(zip((p.name for p in params), combo)) for combo in itertools.product(*grids)]
+
+    if samples < 1:
+        raise ValueError("Sweep samples must be >= 1")
+
+    if method == 'random':
+        return [{p.name: p.at(rng.random()) for p in params} for _ in range(samples)]
+
+    # Latin hypercube: every parameter's range is cut into `samples` equal
+    # strata, each stratum is hit exactly once, and the strata are paired
+    # across parameters by independent random permutations.
+    columns = []
+    for _ in params:
+        strata = list(range(samples))
+        rng.shuffle(strata)
+        columns.append([(s + rng.random()) / samples for s in strata])
+
+    return [{p.name: p.at(columns[j][i]) for j, p in enumerate(params)}
+            for i in range(samples)]
+
+
+def format_plusarg(name, value):
+    """Format one point parameter as a simulator plusarg"""
+    if isinstance(value, float):
+        return f"+{name}={value:.12g}"
+    return f"+{name}={value}"
+
+
+def parse_metrics(stdout):
+    """Collect "[METRIC] name = value" lines (last value wins)"""
+    metrics = {}
+    for line in stdout.splitlines():
+        match = METRIC_RE.match(line)
+        if match:
+            try:
+                metrics[match.group(1)] = float(match.group(2))
+            except ValueError:
+                metrics[match.group(1)] = match.group(2)
+    return metrics
+
+
+def point_status(returncode, stdout):
+    """PASS / FAIL / TIMEOUT / ERROR from the exit code and testbench banners"""
+    if returncode is None:
+        return 'TIMEOUT'
+    if returncode != 0:
+        return 'ERROR'
+    if '*** FAILED' in stdout or 'Simulation timeout' in stdout:
+        return 'FAIL'
+    return 'PASS'
+
+
+def run_sweep(simulator, points, jobs=None, log_dir=None):
+    """
+    Run every point against the already-compiled simulator executable.
+
+    Args:
+        simulator: BaseSimulator whose compile() has succeeded
+        points: Output of expand_sweep()
+        jobs: Parallel simulations (default: CPU count)
+        log_dir: Directory for per-point stdout logs (None: no logs)
+
+    Returns:
+        list[dict]: One result per point, in point order, with keys
+                    'index', 'params', 'status', 'returncode', 'seconds',
+                    'metrics', 'perf', 'log', 'coverage' (file or None)
+    """
+    jobs = jobs or os.cpu_count() or 1
+    if log_dir is not None:
+        log_dir = Path(log_dir)
+        log_dir.mkdir(parents=True, exist_ok=True)
+
+    def run_one(index):
+        params = points[index]
+        plusargs = ['+NO_VCD', f'+SWEEP_POINT={index}']
+        plusargs += [format_plusarg(name, value) for name, value in params.items()]
+
+        start = time.monotonic()
+        returncode, stdout, stderr = simulator.run_executable(
+            plusargs, coverage_tag=f"point_{index:05d}")
+        seconds = time.monotonic() - start
+
+        log_path = None
+        if log_dir is not None:
+            log_path = log_dir / f"point_{index:05d}.log"
+            log_path.write_text(' '.join(plusargs) + '\n\n' + stdout + stderr)
+
+        return {
+            'index': index,
+            'params': params,
+            'status': point_status(returncode, stdout),
+            'returncode': returncode,
+            'seconds': seconds,
+            'metrics': parse_metrics(stdout),
+            'perf': parse_perf(stdout),
+            'log': log_path,
+            'coverage': simulator.coverage_dir / f"point_{index:05d}.dat"
+                        if simulator.coverage else None,
+        }
+
+    results = [None] * len(points)
+    done = 0
+    with ThreadPoolExecutor(max_workers=jobs) as pool:
+        for result in pool.map(run_one, range(len(points))):
+            results[result['index']] = result
+            done += 1
+            if done % max(1, len(points) // 20) == 0 or done == len(points):
+                print(f"   [{done}/{len(points)}] points complete", flush=True)
+
+    return results
+
+
+def _fmt(value):
+    if isinstance(value, float):
+        return f"{value:.6g}"
+    return str(value)
+
+
+def write_results(results, csv_path):
+    """Write the aggregated table as CSV (one row per point)"""
+    param_names = list(results[0]['params'].keys()) if results else []
+    metric_names = sorted({name for r in results for name in r['metrics']})
+
+    csv_path = Path(csv_path)
+    csv_path.parent.mkdir(parents=True, exist_ok=True)
+    with open(csv_path, 'w', newline='') as f:
+        writer = csv.writer(f)
+        writer.writerow(['point'] + param_names + ['status', 'seconds'] + metric_names)
+        for r in results:
+            writer.writerow([r['index']] + [r['params'][n] for n in param_names] +
+                            [r['status'], f"{r['seconds']:.3f}"] +
+                            [r['metrics'].get(n, '') for n in metric_names])
+    return metric_names
+
+
+def print_results(results, max_rows=40):
+    """Print the per-point table (truncated) and per-metric statistics"""
+    if not results:
+        return
+
+    param_names = list(results[0]['params'].keys())
+    metric_names = sorted({name for r in results for name in r['metrics']})
+    header = ['point'] + param_names + ['status'] + metric_names
+    rows = [[str(r['index'])] + [_fmt(r['params'][n]) for n in param_names] + [r['status']] +
+            [_fmt(r['metrics'].get(n, '')) for n in metric_names] for r in results]
+
+    shown = rows if len(rows) <= max_rows else rows[:max_rows // 2] + rows[-max_rows // 2:]
+    widths = [max(len(h), *(len(row[i]) for row in shown)) for i, h in enumerate(header)]
+
+    print("  " + "  ".join(h.rjust(w) for h, w in zip(header, widths)))
+    print("  " + "  ".join('-' * w for w in widths))
+    for i, row in enumerate(shown):
+        if len(rows) > max_rows and i == max_rows // 2:
+            print(f"  ... {len(rows) - max_rows} more points (see CSV) ...")
+        print("  " + "  ".join(c.rjust(w) for c, w in zip(row, widths)))
+
+    passed = [r for r in results if r['status'] == 'PASS']
+    if metric_names and passed:
+        print()
+        print(f"  {'metric':24s} {'min':>12s} {'mean':>12s} {'max':>12s}  (passing points)")
+        for name in metric_names:
+            values = [r['metrics'][name] for r in passed
+                      if isinstance(r['metrics'].get(name), float)]
+            if values:
+                print(f"  {name:24s} {min(values):12.6g} {sum(values) / len(values):12.6g} "
+                      f"{max(values):12.6g}")
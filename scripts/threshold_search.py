@@ -0,0 +1,415 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+Adaptive Threshold Search (Jitter Tolerance / Noise Margin Curves)
+
+For every value of an outer parameter (e.g. SJ frequency), finds the largest
+value of a searched parameter (e.g. SJ amplitude) at which the measured BER
+is still demonstrably below a target - without a dense grid sweep.
+
+Flow:
+    1. Compile the test once (same model as run_test.py)
+    2. For every outer value keep a bracket [lo, hi]: lo = largest passing
+       value, hi = smallest failing value
+    3. Each round places `probes` points evenly inside every open bracket
+       and runs all of them in parallel (multisection: the bracket shrinks
+       by probes+1 per round; probes = 1 is plain bisection)
+    4. A run is PASS only when the upper confidence bound of its BER is
+       below target, FAIL when the lower bound is above target; an
+       inconclusive interval counts as FAIL (the reported threshold is
+       always a demonstrated pass) or, with --bits-param, is re-run with
+       more bits first
+    5. Stop when the bracket is narrower than --tol / --rtol
+
+The first round also runs the floor and the ceiling themselves: a floor
+that fails is reported as "floor fails", a ceiling that passes as
+"ceiling passes" (the threshold lies above --hi; raise it and re-run).
+
+BER confidence bounds are exact Poisson (Garwood) bounds on the error
+count: with zero errors a run needs about 3/target bits to pass at 95%.
+
+Testbench contract: same as sweeps (scripts/sweep.py) - parameters arrive
+as +NAME=value plusargs and the testbench prints "[METRIC] errors = .."
+and "[METRIC] bits = .." lines.
+
+Usage:
+    python3 scripts/threshold_search.py --test jtol \\
+        --outer SJ_FREQ_HZ=1e6,3e6,1e7,3e7,1e8 \\
+        --param SJ_AMP_UI --lo 0.0 --hi 16.0 --rtol 0.02 \\
+        --target-ber 1e-4 --set BITS=200000 --jobs 8
+
+Author: Generated for SystemVerilog test automation
+"""
+
+import argparse
+import csv
+import math
+import os
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor
+from pathlib import Path
+from statistics import NormalDist
+
+import results_db
+import sweep
+from run_test import TestConfig, TestRunner
+
+
+#==============================================================================
+# BER CONFIDENCE INTERVAL
+#==============================================================================
+
+EXACT_POISSON_LIMIT = 100   # Error counts above this use Wilson-Hilferty
+
+def poisson_cdf(k, mu):
+    """P(X <= k) for X ~ Poisson(mu)"""
+    if mu <= 0.0:
+        return 1.0
+    total = 0.0
+    log_mu = math.log(mu)
+    for i in range(k + 1):
+        total += math.exp(-mu + i * log_mu - math.lgamma(i + 1))
+    return min(total, 1.0)
+
+
+def _solve_mu(k, p):
+    """mu such that poisson_cdf(k, mu) = p (decreasing in mu; bisection)"""
+    lo, hi = 0.0, max(10.0, 4.0 * (k + 10))
+    while poisson_cdf(k, hi) > p:
+        hi *= 2.0
+    for _ in range(100):
+        mid = 0.5 * (lo + hi)
+        if poisson_cdf(k, mid) > p:
+            lo = mid
+        else:
+            hi = mid
+    return 0.5 * (lo + hi)
+
+
+def ber_bounds(errors, bits, confidence):
+    """One-sided (lower, upper) BER bounds at the given confidence"""
+    if bits <= 0:
+        return 0.0, 1.0
+    if errors > EXACT_POISSON_LIMIT:
+        # Wilson-Hilferty approximation of the Garwood chi-square bounds
+        z = NormalDist().inv_cdf(confidence)
+        k = float(errors)
+        upper = (k + 1.0) * (1.0 - 1.0 / (9.0 * (k + 1.0)) + z / (3.0 * math.sqrt(k + 1.0))) ** 3
+        lower = k * (1.0 - 1.0 / (9.0 * k) - z / (3.0 * math.sqrt(k))) ** 3
+        return lower / bits, min(upper / bits, 1.0)
+    upper = _solve_mu(errors, 1.0 - confidence) / bits
+    lower = 0.0 if errors == 0 else _solve_mu(errors - 1, confidence) / bits
+    return lower, min(upper, 1.0)
+
+
+def classify(errors, bits, target, confidence):
+    """PASS / FAIL / INCONCLUSIVE against the BER target"""
+    lower, upper = ber_bounds(errors, bits, confidence)
+    if upper < target:
+        return 'PASS'
+    if lower > target:
+        return 'FAIL'
+    return 'INCONCLUSIVE'
+
+
+#==============================================================================
+# SEARCH
+#==============================================================================
+
+class Bracket:
+    """Search state for one outer value"""
+
+    def __init__(self, outer_value, lo, hi):
+        self.outer_value = outer_value
+        self.lo = lo            # Largest demonstrated pass (or search floor)
+        self.hi = hi            # Smallest failing value (or search ceiling)
+        self.lo_verified = False
+        self.ceiling_passes = False
+        self.runs = []
+
+    def width(self):
+        return self.hi - self.lo
+
+    def done(self, tol, rtol):
+        return self.width() <= max(tol, rtol * abs(self.hi))
+
+    def probes(self, count):
+        step = self.width() / (count + 1)
+        return [self.lo + step * (i + 1) for i in range(count)]
+
+    def update(self, results):
+        """Shrink the bracket from (value, verdict) pairs of one round"""
+        fails = [v for v, verdict in results if verdict != 'PASS']
+        if fails:
+            self.hi = min(self.hi, min(fails))
+        passes = [v for v, verdict in results if verdict == 'PASS' and v < self.hi]
+        if passes and max(passes) >= self.lo:
+            self.lo = max(passes)
+            self.lo_verified = True
+
+
+def run_probe(simulator, args, fixed, outer_value, value):
+    """One simulation (with optional bit-count escalation); returns a run record"""
+    params = dict(fixed)
+    params[args.outer_name] = outer_value
+    params[args.param] = value
+    bits_scale = 1
+    start = time.monotonic()
+
+    while True:
+        plusargs = ['+NO_VCD'] + [sweep.format_plusarg(n, v) for n, v in params.items()]
+        returncode, stdout, stderr = simulator.run_executable(plusargs)
+        status = sweep.point_status(returncode, stdout)
+        metrics = sweep.parse_metrics(stdout)
+
+        if status in ('TIMEOUT', 'ERROR') or args.errors_metric not in metrics or \
+                args.bits_metric not in metrics:
+            verdict = 'FAIL'
+            errors = bits = None
+            break
+
+        errors = int(metrics[args.errors_metric])
+        bits = int(metrics[args.bits_metric])
+        verdict = classify(errors, bits, args.target_ber, args.confidence)
+        if verdict != 'INCONCLUSIVE' or not args.bits_param or bits_scale >= args.max_bits_scale:
+            break
+        bits_scale *= 4
+        params[args.bits_param] = int(params.get(args.bits_param, bits) * 4)
+
+    return {
+        'outer': outer_value,
+        'value': value,
+        'params': params,
+        'returncode': returncode,
+        'seconds': time.monotonic() - start,
+        'metrics': metrics,
+        'perf': results_db.parse_perf(stdout),
+        'status': status,
+        'errors': errors,
+        'bits': bits,
+        'verdict': 'FAIL' if verdict == 'INCONCLUSIVE' else verdict,
+        'raw_verdict': verdict,
+    }
+
+
+def search(simulator, args, fixed, outer_values):
+    """Run the multisection search for every outer value; returns the brackets"""
+    brackets = [Bracket(v, args.lo, args.hi) for v in outer_values]
+    probes = args.probes or max(1, args.jobs // len(brackets))
+    round_index = 0
+
+    with ThreadPoolExecutor(max_workers=args.jobs) as pool:
+        while True:
+            active = [b for b in brackets
+                      if not b.done(args.tol, args.rtol) and len(b.runs) < args.max_runs]
+            if not active:
+                break
+
+            round_index += 1
+            jobs = []
+            for b in active:
+                values = b.probes(min(probes, args.max_runs - len(b.runs)))
+                # First round also verifies the floor and the ceiling, so a floor
+                # that already fails or a ceiling that still passes is reported
+                # instead of silently returned as threshold / first fail
+                if not b.lo_verified and not b.runs:
+                    values = [b.lo] + values + [b.hi]
+                for v in values:
+                    jobs.append((b, v, pool.submit(run_probe, simulator, args, fixed,
+                                                   b.outer_value, v)))
+
+            per_bracket = {}
+            for b, v, future in jobs:
+                record = future.result()
+                b.runs.append(record)
+                per_bracket.setdefault(id(b), (b, []))[1].append((v, record['verdict']))
+
+            for b, results in per_bracket.values():
+                if not b.lo_verified and not any(v == b.lo and verdict == 'PASS'
+                                                 for v, verdict in results):
+                    # Floor fails: nothing below it to search
+                    b.hi = b.lo
+                    continue
+                b.update(results)
+                if any(v == b.hi and verdict == 'PASS' for v, verdict in results):
+                    # Ceiling passes (and nothing below it failed): the
+                    # threshold is above the search range
+                    b.lo = b.hi
+                    b.lo_verified = True
+                    b.ceiling_passes = True
+
+            print(f"   Round {round_index}: " + ", ".join(
+                f"{sweep._fmt(b.outer_value)}→[{b.lo:.4g}, {b.hi:.4g}]" for b in brackets),
+                flush=True)
+
+    return brackets
+
+
+#==============================================================================
+# MAIN
+#==============================================================================
+
+def parse_assignments(items):
+    """NAME=value strings → dict (numbers converted where possible)"""
+    result = {}
+    for item in items or []:
+        name, _, value = item.partition('=')
+        if not name or not value:
+            raise ValueError(f"Expected NAME=value, got '{item}'")
+        result[name] = _number(value)
+    return result
+
+
+def _number(text):
+    try:
+        return int(text)
+    except ValueError:
+        try:
+            return float(text)
+        except ValueError:
+            return text
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Adaptive threshold search (jitter tolerance / noise margin curves)",
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog="""
+Examples:
+  # Jitter tolerance of the bang-bang CDR model at BER 1e-4
+  python3 scripts/threshold_search.py --test jtol \\
+      --outer SJ_FREQ_HZ=1e6,3e6,1e7,3e7,1e8 --param SJ_AMP_UI --lo 0 --hi 16 \\
+      --target-ber 1e-4 --set BITS=200000 --bits-param BITS --rtol 0.02
+        """
+    )
+    parser.add_argument("--config", default="tests/test_config.yaml",
+                        help="Path to YAML config file (default: tests/test_config.yaml)")
+    parser.add_argument("--test", required=True, help="Test to characterize")
+    parser.add_argument("--simulator", choices=["verilator", "vcs"],
+                        help="Override simulator selection (default: from config)")
+    parser.add_argument("--outer", required=True,
+                        help="Outer axis as NAME=v1,v2,... (one threshold per value)")
+    parser.add_argument("--param", required=True, help="Searched plusarg name")
+    parser.add_argument("--lo", type=float, required=True, help="Search floor (expected to pass)")
+    parser.add_argument("--hi", type=float, required=True, help="Search ceiling (expected to fail)")
+    parser.add_argument("--tol", type=float, default=0.0, help="Absolute bracket tolerance")
+    parser.add_argument("--rtol", type=float, default=0.02,
+                        help="Relative bracket tolerance (default: 0.02)")
+    parser.add_argument("--target-ber", type=float, required=True, help="BER target")
+    parser.add_argument("--confidence", type=float, default=0.95,
+                        help="Confidence level of the BER bounds (default: 0.95)")
+    parser.add_argument("--errors-metric", default="errors", help="Error-count metric name")
+    parser.add_argument("--bits-metric", default="bits", help="Bit-count metric name")
+    parser.add_argument("--bits-param", help="Plusarg scaling the bit count; inconclusive "
+                        "runs are repeated with 4x bits")
+    parser.add_argument("--max-bits-scale", type=int, default=16,
+                        help="Largest bit-count escalation (default: 16)")
+    parser.add_argument("--set", action="append", metavar="NAME=VALUE",
+                        help="Fixed plusarg for every run (repeatable)")
+    parser.add_argument("--jobs", type=int, default=None,
+                        help="Parallel simulations (default: CPU count)")
+    parser.add_argument("--probes", type=int, default=None,
+                        help="Probes per bracket per round (default: jobs / outer values)")
+    parser.add_argument("--max-runs", type=int, default=40,
+                        help="Simulation budget per outer value (default: 40)")
+    parser.add_argument("--output", help="CSV output (default: sim/search/<test>.csv)")
+    parser.add_argument("--db", help="Result database (default: project.results_db or "
+                        "sim/results.db)")
+    parser.add_argument("--no-db", action="store_true",
+                        help="Do not record runs in the result database")
+
+    args = parser.parse_args()
+    args.jobs = args.jobs or os.cpu_count() or 1
+
+    try:
+        fixed = parse_assignments(args.set)
+        args.outer_name, _, outer_text = args.outer.partition('=')
+        outer_values = [_number(v) for v in outer_text.split(',') if v]
+        if not args.outer_name or not outer_values:
+            raise ValueError(f"Expected --outer NAME=v1,v2,..., got '{args.outer}'")
+        if args.hi <= args.lo:
+            raise ValueError("--hi must be greater than --lo")
+        if not 0.0 < args.confidence < 1.0:
+            raise ValueError("--confidence must be in (0, 1)")
+    except ValueError as e:
+        print(f"Error: {e}")
+        return 1
+
+    project_root = Path(__file__).parent.parent
+    config = TestConfig(project_root / args.config)
+    test_config = config.get_test(args.test)
+    if not test_config:
+        print(f"Error: Test '{args.test}' not found")
+        return 1
+
+    full_config = {
+        **config.project,
+        'simulators': config.config.get('simulators', {}),
+        'verilator': config.config.get('verilator', {})
+    }
+    runner = TestRunner(project_root, full_config, test_config, args.simulator)
+
+    print("=" * 70)
+    print(f"  Threshold search: {args.test}")
+    print(f"  {args.param} in [{args.lo}, {args.hi}] for {args.outer_name} = "
+          f"{', '.join(sweep._fmt(v) for v in outer_values)}")
+    print(f"  Target BER {args.target_ber:.1e} at {args.confidence * 100:.0f}% confidence")
+    print("=" * 70)
+    print()
+
+    if not runner.simulator.compile():
+        return 1
+
+    brackets = search(runner.simulator, args, fixed, outer_values)
+
+    output = Path(args.output) if args.output else \
+        project_root / config.project.get('sim_dir', 'sim') / 'search' / f"{args.test}.csv"
+    output.parent.mkdir(parents=True, exist_ok=True)
+    with open(output, 'w', newline='') as f:
+        writer = csv.writer(f)
+        writer.writerow([args.outer_name, args.param, 'status', 'errors', 'bits', 'verdict'])
+        for b in brackets:
+            for r in b.runs:
+                writer.writerow([r['outer'], r['value'], r['status'], r['errors'], r['bits'],
+                                 r['raw_verdict']])
+
+    if not args.no_db:
+        db_path = Path(args.db) if args.db else \
+            project_root / config.project.get('results_db', 'sim/results.db')
+        store = results_db.ResultStore(db_path)
+        git_rev = results_db.git_revision(project_root)
+        session_id = store.begin_session(' '.join(sys.argv), git_rev)
+        config_hash, source_hash = results_db.config_fingerprint(project_root, full_config,
+                                                                 test_config)
+        for b in brackets:
+            for r in b.runs:
+                store.add_run(session_id, args.test, r['status'], kind='search',
+                              simulator=runner.simulator_type, config_hash=config_hash,
+                              source_hash=source_hash, git_rev=git_rev,
+                              returncode=r['returncode'], sim_s=r['seconds'],
+                              params=r['params'], metrics=r['metrics'], perf=r['perf'],
+                              artifacts={'csv': output}, commit=False)
+        store.commit()
+        store.close()
+
+    print()
+    print(f"  {args.outer_name:>16s} {'threshold':>12s} {'first fail':>12s} {'runs':>6s}")
+    print(f"  {'-' * 16} {'-' * 12} {'-' * 12} {'-' * 6}")
+    for b in brackets:
+        if b.ceiling_passes:
+            threshold, first_fail = "ceiling passes", "-"
+        else:
+            threshold = f"{b.lo:.6g}" if b.lo_verified else "floor fails"
+            first_fail = f"{b.hi:.6g}"
+        print(f"  {sweep._fmt(b.outer_value):>16s} {threshold:>12s} {first_fail:>12s} "
+              f"{len(b.runs):6d}")
+    print()
+    print(f"  Total simulations: {sum(len(b.runs) for b in brackets)}")
+    print(f"  Runs: {output}")
+
+    return 0 if all(b.lo_verified and not b.ceiling_passes for b in brackets) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
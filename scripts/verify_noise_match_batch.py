@@ -17,16 +17,22 @@ Verification Strategy:
 - Epsilon tolerance: rtol=1e-10, atol=1e-9 (1 nanovolt)
 - Pass criteria: >99.9% samples match (allow 1-2 edge cases)
 - Spectral analysis: Both should show 1/f characteristic
+- Reduced precision (dpi/flicker_noise_batch.bin written with --precision
+  float32 / int16): the exact comparison uses the stored samples, and the
+  stored samples must stay within --tolerance of the float64 reference
 
 Author: Generated for SerDes flicker noise PoC - Batch Mode
 """
 
+import argparse
 import numpy as np
 import matplotlib.pyplot as plt
 from vcdvcd import VCDVCD
 from pathlib import Path
 import sys
 
+from sample_format import DEFAULT_TOLERANCE, read_samples
+
 # Test parameters (must match generate_flicker_noise_batch.py and testbench)
 SAMPLE_RATE = 100e6
 EXPECTED_RMS = 0.25
@@ -182,6 +188,12 @@ def compare_exact(noise_py, noise_sv):
 
 
 def main():
+    parser = argparse.ArgumentParser(description='Flicker Noise Verification - Batch Mode')
+    parser.add_argument('--tolerance', type=float, default=DEFAULT_TOLERANCE,
+                        help='Max precision error RMS of the stored samples relative to the '
+                             f'float64 reference RMS (default: {DEFAULT_TOLERANCE:g})')
+    args = parser.parse_args()
+
     print("=" * 70)
     print("Flicker Noise Verification - Batch Mode (Exact Match)")
     print("=" * 70)
@@ -199,6 +211,25 @@ def main():
     noise_python = np.load(ref_path)
     print(f"[INFO] Loaded Python reference: {len(noise_python)} samples from {ref_path}")
 
+    # Accuracy guard: samples stored at reduced precision are what DPI-C
+    # returns, so they are the exact-match reference; the precision error
+    # against float64 is checked separately
+    bin_path = 'dpi/flicker_noise_batch.bin'
+    precision = 'float64'
+    precision_err = 0.0
+    if Path(bin_path).exists():
+        noise_stored, header = read_samples(bin_path)
+        if header is not None and header['precision'] != 'float64':
+            precision = header['precision']
+            n = min(len(noise_stored), len(noise_python))
+            diff = noise_stored[:n] - noise_python[:n]
+            precision_err = np.sqrt(np.mean(diff**2)) / np.sqrt(np.mean(noise_python[:n]**2))
+            noise_python = noise_stored
+            print(f"[INFO] {bin_path} stores {precision}: comparing against the stored samples")
+    precision_pass = precision_err <= args.tolerance
+    print(f"[INFO] Sample precision: {precision}, error {precision_err:.2e} of RMS "
+          f"(tolerance {args.tolerance:.0e}) {'✓' if precision_pass else '✗ FAIL'}")
+
     # Load SystemVerilog from VCD
     vcd_path = 'sim/waves/ideal_amp_with_noise_batch.vcd'
     if not Path(vcd_path).exists():
@@ -379,6 +410,8 @@ def main():
         log.write(f"  VCD reset skip:    {RESET_SKIP_VCD} samples\n")
         log.write(f"  Gain:              {GAIN}\n")
         log.write(f"  DC Input:          {DC_INPUT} V\n")
+        log.write(f"  Sample precision:  {precision} (error {precision_err:.3e} of RMS, "
+                  f"tolerance {args.tolerance:.0e}, {'PASS' if precision_pass else 'FAIL'})\n")
         log.write("\n")
 
         # RMS comparison
@@ -461,7 +494,7 @@ def main():
         log.write("FINAL VERDICT\n")
         log.write("=" * 80 + "\n")
 
-        all_pass_log = rms_pass and exact_pass and slope_pass
+        all_pass_log = rms_pass and exact_pass and slope_pass and precision_pass
 
         if all_pass_log:
             log.write("✓✓✓ ALL TESTS PASSED ✓✓✓\n\n")
@@ -480,6 +513,8 @@ def main():
                 log.write("  ✗ Sample-by-sample comparison failed\n")
             if not slope_pass:
                 log.write("  ✗ Spectral slope mismatch\n")
+            if not precision_pass:
+                log.write("  ✗ Sample precision error exceeds tolerance\n")
 
         log.write("=" * 80 + "\n")
 
@@ -491,7 +526,7 @@ def main():
     print("FINAL VERDICT - BATCH MODE")
     print("=" * 70)
 
-    all_pass = rms_pass and exact_pass and slope_pass
+    all_pass = rms_pass and exact_pass and slope_pass and precision_pass
 
     if all_pass:
         print("✓✓✓ ALL TESTS PASSED ✓✓✓")
@@ -514,6 +549,8 @@ def main():
             print("  - Sample-by-sample comparison failed")
         if not slope_pass:
             print("  - Spectral slope mismatch")
+        if not precision_pass:
+            print("  - Sample precision error exceeds tolerance")
         print("=" * 70)
         return 1
 
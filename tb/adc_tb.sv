@@ -0,0 +1,330 @@
+/**
+ * adc_tb.sv - Self-Checking Testbench for the ADC Quantization Model
+ *
+ * Test Strategy:
+ * - RTL (adc_model, ideal 8-bit): sweep a ramp over ±1.2 V one sample per
+ *   clock and compare with the spec formula clamp(round(x × 128), -128, 127)
+ * - Block API, INL profile: code-density test with a slow full-scale ramp
+ *   converted in blocks; measured DNL must match the programmed table
+ * - Block API, offset + gain error: DC points land on the shifted codes
+ * - Block API, thermal noise: code spread at a DC input matches the RMS
+ * - Block API, 2-lane skew: one block and one-sample calls give the same
+ *   codes; output k is the skewed sample k - 1 (one sample of latency)
+ *
+ * Author: Generated for SerDes RX front-end modeling
+ * Date: 2025
+ */
+
+`timescale 1ns / 1ps
+
+module adc_tb #(
+    parameter SIM_TIMEOUT = 20000  // 20us timeout (1201 ramp samples @ 100MHz = 12us + margin)
+);
+
+    //==========================================================================
+    // TEST PARAMETERS
+    //==========================================================================
+    localparam int  BITS = 8;
+    localparam int  RAMP_STEPS = 1200;          // ±1.2 V in 2 mV steps
+    localparam int  BLOCK = 256;                // Block API size
+    localparam int  HITS_PER_CODE = 64;         // Code-density ramp resolution
+    localparam real INL_AMPLITUDE = 1.5;        // Bow INL peak (LSB)
+    localparam real DNL_TOL = 0.05;             // Code-density vs table (LSB)
+    localparam real OFFSET_V = 0.02;            // 2.56 LSB
+    localparam real GAIN_ERROR = -0.03;
+    localparam real NOISE_LSB = 2.0;
+    localparam real SKEW_S = 10.0e-12;          // Lane 1 of 2 at 10 GS/s: 0.1 UI
+
+    //==========================================================================
+    // DPI-C IMPORTS
+    //==========================================================================
+    import "DPI-C" function chandle dpi_adc_create(input int bits,
+        input real full_scale_v, input real sample_rate_hz, input int num_lanes,
+        input int seed);
+    import "DPI-C" function void dpi_adc_set_lane(input chandle h, input int lane,
+        input real offset_v, input real gain_error, input real skew_s);
+    import "DPI-C" function void dpi_adc_set_noise(input chandle h, input real rms_v);
+    import "DPI-C" function int  dpi_adc_set_inl_profile(input chandle h,
+        input int shape, input real amplitude_lsb, input real sigma_lsb);
+    import "DPI-C" function int  dpi_adc_convert_block(input chandle h,
+        input real x[BLOCK], output int codes[BLOCK], input int n);
+    import "DPI-C" function real dpi_adc_dnl(input chandle h, input int code);
+    import "DPI-C" function void dpi_adc_destroy(input chandle h);
+
+    //==========================================================================
+    // TESTBENCH SIGNALS
+    //==========================================================================
+    logic                   clk;
+    logic                   rst_n;
+    real                    analog_in;
+    logic signed [BITS-1:0] adc_out;
+
+    //==========================================================================
+    // VERIFICATION VARIABLES
+    //==========================================================================
+    int  error_count = 0;
+    real x_blk[BLOCK];
+    int  code_blk[BLOCK];
+    int  hist[1 << BITS];
+
+    //==========================================================================
+    // DUT INSTANTIATION
+    //==========================================================================
+    adc_model #(
+        .BITS(BITS),
+        .FULL_SCALE(1.0)
+    ) dut (
+        .clk(clk),
+        .rst_n(rst_n),
+        .analog_in(analog_in),
+        .adc_out(adc_out)
+    );
+
+    //==========================================================================
+    // CLOCK GENERATION
+    //==========================================================================
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    //==========================================================================
+    // VCD WAVEFORM DUMP
+    //==========================================================================
+    initial begin
+        $dumpfile("sim/waves/adc.vcd");
+        $dumpvars(0, adc_tb);
+    end
+
+    //==========================================================================
+    // HELPERS
+    //==========================================================================
+    // Spec §3.1.1 reference: clamp(round(x × 128), -128, 127)
+    function automatic int spec_code(input real x);
+        int c;
+        c = int'($rtoi(x * 128.0 + ((x < 0.0) ? -0.5 : 0.5)));
+        if (c < -128) c = -128;
+        if (c > 127) c = 127;
+        return c;
+    endfunction
+
+    // Skew test input: 1 GHz sine at 10 GS/s, n in samples
+    function automatic real skew_sine(input real n);
+        return 0.9 * $sin(2.0 * 3.14159265358979 * n / 10.0 + 0.3);
+    endfunction
+
+    //==========================================================================
+    // TEST: RTL IDEAL TRANSFER
+    //==========================================================================
+    task automatic test_rtl_ideal();
+        real x;
+        int  mismatches = 0;
+        $display("[%0t ns] RTL ideal transfer (%0d points)", $time, RAMP_STEPS + 1);
+        for (int i = 0; i <= RAMP_STEPS; i++) begin
+            x = -1.2 + 2.4 * real'(i) / real'(RAMP_STEPS);
+            analog_in = x;
+            @(posedge clk);
+            #1;
+            if (int'(adc_out) != spec_code(x)) begin
+                if (mismatches < 5)
+                    $display("  ✗ x=%0.4f: adc_out=%0d expected %0d", x, adc_out, spec_code(x));
+                mismatches++;
+            end
+        end
+        if (mismatches != 0) begin
+            $display("  ✗ ERROR: %0d mismatches against spec formula", mismatches);
+            error_count++;
+        end else begin
+            $display("  ✓ All codes match clamp(round(x*128))");
+        end
+    endtask
+
+    //==========================================================================
+    // TEST: CODE-DENSITY DNL
+    //==========================================================================
+    task automatic test_dnl();
+        chandle adc;
+        int     total;
+        real    meas;
+        real    worst = 0.0;
+        real    max_dnl = 0.0;
+
+        adc = dpi_adc_create(BITS, 1.0, 10.0e9, 1, 80);
+        void'(dpi_adc_set_inl_profile(adc, 1, INL_AMPLITUDE, 0.1));
+        for (int k = 0; k < (1 << BITS); k++) hist[k] = 0;
+
+        total = (1 << BITS) * HITS_PER_CODE;
+        for (int base = 0; base < total; base += BLOCK) begin
+            for (int i = 0; i < BLOCK; i++)
+                x_blk[i] = -1.0 + 2.0 * (real'(base + i) + 0.5) / real'(total);
+            void'(dpi_adc_convert_block(adc, x_blk, code_blk, BLOCK));
+            for (int i = 0; i < BLOCK; i++) hist[code_blk[i] + 128]++;
+        end
+
+        // End codes are open-ended; compare inner codes
+        for (int c = -127; c < 127; c++) begin
+            meas = real'(hist[c + 128]) / real'(HITS_PER_CODE) - 1.0;
+            if (meas - dpi_adc_dnl(adc, c) > worst) worst = meas - dpi_adc_dnl(adc, c);
+            if (dpi_adc_dnl(adc, c) - meas > worst) worst = dpi_adc_dnl(adc, c) - meas;
+            if (dpi_adc_dnl(adc, c) > max_dnl) max_dnl = dpi_adc_dnl(adc, c);
+            if (-dpi_adc_dnl(adc, c) > max_dnl) max_dnl = -dpi_adc_dnl(adc, c);
+        end
+        $display("[%0t ns] Code density: max |DNL| = %0.3f LSB, measured vs table = %0.4f LSB",
+                 $time, max_dnl, worst);
+        // Resolution of the histogram is 1 / HITS_PER_CODE LSB
+        if (worst > DNL_TOL || max_dnl < 0.1) begin
+            $display("  ✗ ERROR: code-density DNL does not match the INL table");
+            error_count++;
+        end
+        dpi_adc_destroy(adc);
+    endtask
+
+    //==========================================================================
+    // TEST: OFFSET / GAIN ERROR
+    //==========================================================================
+    task automatic test_offset_gain();
+        chandle adc;
+        int     mismatches = 0;
+
+        adc = dpi_adc_create(BITS, 1.0, 10.0e9, 1, 81);
+        dpi_adc_set_lane(adc, 0, OFFSET_V, GAIN_ERROR, 0.0);
+        for (int i = 0; i < BLOCK; i++) x_blk[i] = -0.9 + 1.8 * real'(i) / real'(BLOCK - 1);
+        void'(dpi_adc_convert_block(adc, x_blk, code_blk, BLOCK));
+        for (int i = 0; i < BLOCK; i++) begin
+            if (code_blk[i] != spec_code(x_blk[i] * (1.0 + GAIN_ERROR) + OFFSET_V)) mismatches++;
+        end
+        $display("[%0t ns] Offset %0.0f mV, gain error %0.1f%%: %0d mismatches",
+                 $time, OFFSET_V * 1000.0, GAIN_ERROR * 100.0, mismatches);
+        if (mismatches != 0) begin
+            $display("  ✗ ERROR: offset/gain transfer mismatch");
+            error_count++;
+        end
+        dpi_adc_destroy(adc);
+    endtask
+
+    //==========================================================================
+    // TEST: THERMAL NOISE
+    //==========================================================================
+    task automatic test_noise();
+        chandle adc;
+        real    sum = 0.0;
+        real    sum_sq = 0.0;
+        real    mean;
+        real    rms;
+        int     n = 0;
+
+        adc = dpi_adc_create(BITS, 1.0, 10.0e9, 1, 82);
+        dpi_adc_set_noise(adc, NOISE_LSB / 128.0);
+        for (int i = 0; i < BLOCK; i++) x_blk[i] = 0.0;
+        for (int b = 0; b < 64; b++) begin
+            void'(dpi_adc_convert_block(adc, x_blk, code_blk, BLOCK));
+            for (int i = 0; i < BLOCK; i++) begin
+                sum += real'(code_blk[i]);
+                sum_sq += real'(code_blk[i]) * real'(code_blk[i]);
+                n++;
+            end
+        end
+        mean = sum / real'(n);
+        rms = $sqrt(sum_sq / real'(n) - mean * mean);
+        // Quantization adds 1/12 LSB^2 to the noise variance
+        $display("[%0t ns] Noise: code mean %0.3f, RMS %0.3f LSB (expected %0.3f)",
+                 $time, mean, rms, $sqrt(NOISE_LSB * NOISE_LSB + 1.0 / 12.0));
+        if (rms < 1.9 || rms > 2.2 || mean > 0.1 || mean < -0.1) begin
+            $display("  ✗ ERROR: noise statistics out of range");
+            error_count++;
+        end
+        dpi_adc_destroy(adc);
+    endtask
+
+    //==========================================================================
+    // TEST: SAMPLING SKEW
+    //==========================================================================
+    task automatic test_skew();
+        chandle adc_blk;
+        chandle adc_one;
+        real    x_one[BLOCK];
+        int     code_one[BLOCK];
+        real    t;
+        int     d;
+        int     split = 0;
+        int     off = 0;
+        int     moved = 0;
+
+        adc_blk = dpi_adc_create(BITS, 1.0, 10.0e9, 2, 80);
+        adc_one = dpi_adc_create(BITS, 1.0, 10.0e9, 2, 80);
+        dpi_adc_set_lane(adc_blk, 1, 0.0, 0.0, SKEW_S);
+        dpi_adc_set_lane(adc_one, 1, 0.0, 0.0, SKEW_S);
+        for (int i = 0; i < BLOCK; i++) x_blk[i] = skew_sine(real'(i));
+        void'(dpi_adc_convert_block(adc_blk, x_blk, code_blk, BLOCK));
+        for (int i = 0; i < BLOCK; i++) begin
+            x_one[0] = x_blk[i];
+            void'(dpi_adc_convert_block(adc_one, x_one, code_one, 1));
+            if (code_one[0] != code_blk[i]) split++;
+        end
+        // Output k is input k - 1, taken by lane (k - 1) % 2
+        for (int k = 1; k < BLOCK; k++) begin
+            t = real'(k - 1) + (((k - 1) % 2 == 1) ? SKEW_S * 10.0e9 : 0.0);
+            d = code_blk[k] - spec_code(skew_sine(t));
+            if (d > 1 || d < -1) off++;
+            d = code_blk[k] - spec_code(x_blk[k - 1]);
+            if (d > 1 || d < -1) moved++;
+        end
+        $display("[%0t ns] Skew %0.0f ps on lane 1: %0d block / per-sample mismatches",
+                 $time, SKEW_S * 1.0e12, split);
+        $display("  %0d codes > 1 LSB from the skewed sample, %0d moved > 1 LSB by skew",
+                 off, moved);
+        if (split != 0) begin
+            $display("  ✗ ERROR: codes depend on the call size");
+            error_count++;
+        end
+        if (off != 0 || moved == 0) begin
+            $display("  ✗ ERROR: skewed samples not reproduced one sample late");
+            error_count++;
+        end
+        dpi_adc_destroy(adc_blk);
+        dpi_adc_destroy(adc_one);
+    endtask
+
+    //==========================================================================
+    // MAIN TEST SEQUENCE
+    //==========================================================================
+    initial begin
+        $display("========================================");
+        $display("  ADC Quantization Model Test");
+        $display("========================================");
+        $display("  Resolution    : %0d bits, full scale ±1.0 V", BITS);
+        $display("========================================");
+
+        rst_n = 0;
+        analog_in = 0.0;
+        repeat (2) @(posedge clk);
+        rst_n = 1;
+
+        test_rtl_ideal();
+        test_dnl();
+        test_offset_gain();
+        test_noise();
+        test_skew();
+
+        $display("");
+        if (error_count == 0) begin
+            $display("========================================");
+            $display("*** PASSED: All tests passed ***");
+            $display("========================================");
+        end else begin
+            $display("========================================");
+            $display("*** FAILED: %0d errors detected ***", error_count);
+            $display("========================================");
+        end
+
+        $finish;
+    end
+
+    //==========================================================================
+    // TIMEOUT WATCHDOG
+    //==========================================================================
+    initial begin
+        #SIM_TIMEOUT;
+        $display("ERROR: Simulation timeout after %0d time units", SIM_TIMEOUT);
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,163 @@
+// Long-run stress testbench for wide counters (wrap-around and saturation)
+// Jumps the counters next to each carry boundary instead of counting there:
+// the state is deposited (force + release of dut.count on a falling edge),
+// then every cycle across the boundary is simulated and checked.
+// A 48-bit counter needs 2^48 cycles (~33 days at 100MHz) to wrap;
+// here each boundary costs WINDOW cycles.
+
+`timescale 1ns / 1ps
+
+module counter_stress_tb #(
+    parameter SIM_TIMEOUT = 50000,  // Simulation timeout in timescale units (default: 50us)
+    parameter WIDTH       = 48,     // Counter width under test (any width >= 2)
+    parameter STRIDE      = 8,      // Carry boundaries checked every STRIDE bits
+    parameter WINDOW      = 32      // Cycles simulated across each boundary
+);
+
+    localparam logic [WIDTH-1:0] MAX = '1;
+
+    // Clock and reset signals
+    logic             clk;
+    logic             rst_n;
+    logic [WIDTH-1:0] count_wrap;
+    logic [WIDTH-1:0] count_sat;
+    logic             overflow_wrap;
+    logic             overflow_sat;
+
+    // Expected values for checking
+    logic [WIDTH-1:0] expected_wrap;
+    logic [WIDTH-1:0] expected_sat;
+    int               error_count;
+    longint           cycles;
+
+    // Instantiate DUTs: same width, wrapping and saturating
+    counter #(.WIDTH(WIDTH), .SATURATE(0)) dut_wrap (
+        .clk(clk),
+        .rst_n(rst_n),
+        .count(count_wrap),
+        .overflow(overflow_wrap)
+    );
+
+    counter #(.WIDTH(WIDTH), .SATURATE(1)) dut_sat (
+        .clk(clk),
+        .rst_n(rst_n),
+        .count(count_sat),
+        .overflow(overflow_sat)
+    );
+
+    // Clock generation (10ns period = 100MHz)
+    initial begin
+        clk = 0;
+        forever #5 clk = ~clk;
+    end
+
+    // Deposit a counter state: call on a falling edge. After the release
+    // the variables keep the value until the next clock edge updates them
+    task automatic deposit(input logic [WIDTH-1:0] value);
+        force dut_wrap.count = value;
+        force dut_sat.count  = value;
+        #1;
+        release dut_wrap.count;
+        release dut_sat.count;
+        expected_wrap = value;
+        expected_sat  = value;
+    endtask
+
+    // Compare both counters and their flags against the expected values
+    task automatic check(input string what);
+        if (count_wrap !== expected_wrap || overflow_wrap !== (expected_wrap == MAX)) begin
+            $display("ERROR at Time=%0t (%s): wrap count=0x%0h overflow=%b, expected 0x%0h / %b",
+                     $time, what, count_wrap, overflow_wrap, expected_wrap, expected_wrap == MAX);
+            error_count++;
+        end
+        if (count_sat !== expected_sat || overflow_sat !== (expected_sat == MAX)) begin
+            $display("ERROR at Time=%0t (%s): saturating count=0x%0h overflow=%b, expected 0x%0h / %b",
+                     $time, what, count_sat, overflow_sat, expected_sat, expected_sat == MAX);
+            error_count++;
+        end
+    endtask
+
+    // Jump to WINDOW/2 cycles before `boundary`, then clock across it
+    task automatic cross(input logic [WIDTH-1:0] boundary, input string what);
+        @(negedge clk);
+        deposit(boundary - WIDTH'(WINDOW / 2));
+        check({what, " (deposit)"});
+        for (int i = 0; i < WINDOW; i++) begin
+            expected_wrap = expected_wrap + 1'b1;
+            expected_sat  = (expected_sat == MAX) ? MAX : expected_sat + 1'b1;
+            @(posedge clk);
+            #1;
+            cycles++;
+            check(what);
+        end
+        $display("Time=%0t: %s: wrap 0x%0h, saturating 0x%0h", $time, what,
+                 count_wrap, count_sat);
+    endtask
+
+    // VCD dump for GTKWave
+    initial begin
+        if (!$test$plusargs("NO_VCD")) begin
+            $dumpfile("sim/waves/counter_stress.vcd");
+            $dumpvars(0, counter_stress_tb);
+        end
+    end
+
+    // Test sequence
+    initial begin
+        // Initialize
+        error_count = 0;
+        cycles = 0;
+        expected_wrap = '0;
+        expected_sat = '0;
+        rst_n = 0;
+
+        $display("=== Starting Counter Stress Testbench (WIDTH=%0d, WINDOW=%0d) ===",
+                 WIDTH, WINDOW);
+        repeat(3) @(posedge clk);
+        #1;
+        check("reset");
+
+        @(negedge clk);
+        rst_n = 1;
+
+        // Carry into bit k for k = STRIDE, 2*STRIDE, ... below WIDTH
+        for (int k = STRIDE; k < WIDTH; k += STRIDE) begin
+            cross(WIDTH'(1) << k, $sformatf("carry into bit %0d", k));
+        end
+
+        // Top boundary: the wrapping counter rolls over to 0, the
+        // saturating one reaches MAX and holds it
+        cross('0, "wrap / saturate at max");
+
+        // Reset from a wide value
+        @(negedge clk);
+        deposit(MAX - 1'b1);
+        rst_n = 0;
+        @(posedge clk);
+        #1;
+        expected_wrap = '0;
+        expected_sat  = '0;
+        check("reset from max-1");
+
+        $display("=== Test Completed: %0d cycles simulated (full range: 2^%0d) ===",
+                 cycles, WIDTH);
+        $display("[METRIC] cycles = %0d", cycles);
+        if (error_count == 0) begin
+            $display("*** PASSED: All tests passed successfully ***");
+        end else begin
+            $display("*** FAILED: %0d errors detected ***", error_count);
+        end
+
+        // Finish simulation
+        #100;
+        $finish;
+    end
+
+    // Timeout watchdog
+    initial begin
+        #SIM_TIMEOUT;
+        $display("ERROR: Simulation timeout after %0d time units", SIM_TIMEOUT);
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,296 @@
+/**
+ * ctle_adapt_tb.sv - Self-Checking Testbench for CTLE Peaking Auto-Selection
+ *
+ * Test Strategy:
+ * - Channel: NRZ ±0.4 V through two 2 GHz poles at 10 Gb/s (16 samples
+ *   per UI, ~17 dB loss at Nyquist); 2000 UIs captured once
+ * - 16 candidate codes: fp1 = 10 GHz, fp2 = 20 GHz, fz stepped down from
+ *   10 GHz (0 .. 26 dB peaking); check peaking is monotonic and every
+ *   biquad has the programmed DC gain
+ * - Eye metric (4 threads): code 0 leaves the eye closed, the choice is an
+ *   interior code with a wide-open eye; a 1-thread engine must reproduce
+ *   every score bit-exactly
+ * - ISI metric: choice within ±2 codes of the eye choice
+ * - float32 precision: an engine fed the same capture must choose the same
+ *   code, with every score within 1e-4 of float64 and a guard error below
+ *   the engine tolerance
+ * - Bring-up: the chosen code, applied to 500 fresh UIs at its sampling
+ *   point, must recover every bit
+ *
+ * Author: Generated for SerDes CTLE adaptation
+ * Date: 2025
+ */
+
+`timescale 1ns / 1ps
+
+module ctle_adapt_tb #(
+    parameter SIM_TIMEOUT = 10000  // 10us timeout (25 blocks @ 100MHz = 250ns + margin)
+);
+
+    //==========================================================================
+    // TEST PARAMETERS
+    //==========================================================================
+    localparam real UI = 100.0e-12;             // 10 Gb/s
+    localparam int  SPU = 16;                   // Samples per UI
+    localparam real FS = real'(SPU) / UI;
+    localparam real F_CH = 2.0e9;               // Channel poles (2x)
+    localparam real AMP = 0.4;                  // V
+    localparam int  BLK_UI = 100;
+    localparam int  BLK_N = BLK_UI * SPU;
+    localparam int  CAPTURE_BLOCKS = 20;        // 2000 UIs
+    localparam int  CHECK_BLOCKS = 5;           // 500 UIs
+    localparam int  CODES = 16;
+    localparam int  THREADS = 4;
+
+    //==========================================================================
+    // DPI-C IMPORTS
+    //==========================================================================
+    import "DPI-C" function chandle dpi_ctle_adapt_create(input real fs_hz, input real ui_s,
+        input int threads);
+    import "DPI-C" function int  dpi_ctle_adapt_add_code(input chandle h, input real fz_hz,
+        input real fp1_hz, input real fp2_hz, input real dc_gain);
+    import "DPI-C" function real dpi_ctle_adapt_peaking(input chandle h, input int code);
+    import "DPI-C" function int  dpi_ctle_adapt_biquad(input chandle h, input int code,
+        output real coef[5]);
+    import "DPI-C" function void dpi_ctle_adapt_load(input chandle h, input real x[BLK_N],
+        input int n);
+    import "DPI-C" function void dpi_ctle_adapt_load_bits(input chandle h, input int bits[BLK_UI],
+        input int n);
+    import "DPI-C" function int  dpi_ctle_adapt_set_precision(input chandle h,
+                                                              input int precision);
+    import "DPI-C" function int  dpi_ctle_adapt_run(input chandle h, input int metric);
+    import "DPI-C" function real dpi_ctle_adapt_guard_error(input chandle h);
+    import "DPI-C" function int  dpi_ctle_adapt_best(input chandle h);
+    import "DPI-C" function real dpi_ctle_adapt_score(input chandle h, input int code);
+    import "DPI-C" function int  dpi_ctle_adapt_phase(input chandle h, input int code);
+    import "DPI-C" function int  dpi_ctle_adapt_apply(input chandle h, input int code,
+        input real x[BLK_N], input int n, output real y[BLK_N]);
+    import "DPI-C" function int  dpi_ctle_adapt_write_report(input chandle h, input string path);
+    import "DPI-C" function void dpi_ctle_adapt_destroy(input chandle h);
+
+    //==========================================================================
+    // TESTBENCH SIGNALS
+    //==========================================================================
+    logic clk;
+
+    //==========================================================================
+    // VERIFICATION VARIABLES
+    //==========================================================================
+    int     error_count = 0;
+    chandle ctle;
+    chandle ctle_1t;                            // Single-thread reference
+    chandle ctle_f32;                           // float32 samples
+    real    x_blk[BLK_N];
+    real    y_blk[BLK_N];
+    int     bit_blk[BLK_UI];
+    real    ch_y1 = 0.0;                        // Channel pole states
+    real    ch_y2 = 0.0;
+    real    eye_score[CODES];
+
+    //==========================================================================
+    // CLOCK GENERATION
+    //==========================================================================
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    //==========================================================================
+    // VCD WAVEFORM DUMP
+    //==========================================================================
+    initial begin
+        $dumpfile("sim/waves/ctle_adapt.vcd");
+        $dumpvars(0, ctle_adapt_tb);
+    end
+
+    //==========================================================================
+    // HELPERS
+    //==========================================================================
+    task automatic check(input string name, input bit ok);
+        if (ok) begin
+            $display("  ✓ %s", name);
+        end else begin
+            $display("  ✗ ERROR: %s", name);
+            error_count++;
+        end
+    endtask
+
+    // Next BLK_UI random bits through the channel into x_blk / bit_blk
+    task automatic channel_block();
+        real a;
+        a = 1.0 - $exp(-2.0 * 3.14159265358979 * F_CH / FS);
+        for (int k = 0; k < BLK_UI; k++) begin
+            bit_blk[k] = int'($urandom % 2);
+            for (int i = 0; i < SPU; i++) begin
+                ch_y1 += ((bit_blk[k] == 1 ? AMP : -AMP) - ch_y1) * a;
+                ch_y2 += (ch_y1 - ch_y2) * a;
+                x_blk[k * SPU + i] = ch_y2;
+            end
+        end
+    endtask
+
+    //==========================================================================
+    // TEST: CODE TABLE
+    //==========================================================================
+    task automatic test_code_table();
+        real coef[5];
+        int  monotonic = 1;
+        int  dc_err = 0;
+
+        ctle = dpi_ctle_adapt_create(FS, UI, THREADS);
+        ctle_1t = dpi_ctle_adapt_create(FS, UI, 1);
+        ctle_f32 = dpi_ctle_adapt_create(FS, UI, THREADS);
+        check("float32 precision accepted", dpi_ctle_adapt_set_precision(ctle_f32, 1) == 0);
+        for (int c = 0; c < CODES; c++) begin
+            void'(dpi_ctle_adapt_add_code(ctle, 10.0e9 / (10.0 ** (real'(c) / 10.0)), 10.0e9,
+                                          20.0e9, 1.0));
+            void'(dpi_ctle_adapt_add_code(ctle_1t, 10.0e9 / (10.0 ** (real'(c) / 10.0)), 10.0e9,
+                                          20.0e9, 1.0));
+            void'(dpi_ctle_adapt_add_code(ctle_f32, 10.0e9 / (10.0 ** (real'(c) / 10.0)), 10.0e9,
+                                          20.0e9, 1.0));
+            void'(dpi_ctle_adapt_biquad(ctle, c, coef));
+            if ((coef[0] + coef[1] + coef[2]) / (1.0 + coef[3] + coef[4]) - 1.0 > 1.0e-9 ||
+                (coef[0] + coef[1] + coef[2]) / (1.0 + coef[3] + coef[4]) - 1.0 < -1.0e-9)
+                dc_err++;
+            if (c > 0 && dpi_ctle_adapt_peaking(ctle, c) <= dpi_ctle_adapt_peaking(ctle, c - 1))
+                monotonic = 0;
+        end
+        $display("[%0t ns] %0d codes: peaking %0.2f .. %0.2f dB", $time, CODES,
+                 dpi_ctle_adapt_peaking(ctle, 0), dpi_ctle_adapt_peaking(ctle, CODES - 1));
+        check("peaking increases with code", monotonic == 1);
+        check("biquad DC gain = programmed gain", dc_err == 0);
+    endtask
+
+    //==========================================================================
+    // TEST: ONE-PASS ADAPTATION
+    //==========================================================================
+    task automatic test_adapt();
+        int best_eye;
+        int best_isi;
+        int best_f32;
+        int mismatch = 0;
+        real d;
+
+        for (int blk = 0; blk < CAPTURE_BLOCKS; blk++) begin
+            @(posedge clk);
+            channel_block();
+            dpi_ctle_adapt_load(ctle, x_blk, BLK_N);
+            dpi_ctle_adapt_load_bits(ctle, bit_blk, BLK_UI);
+            dpi_ctle_adapt_load(ctle_1t, x_blk, BLK_N);
+            dpi_ctle_adapt_load_bits(ctle_1t, bit_blk, BLK_UI);
+            dpi_ctle_adapt_load(ctle_f32, x_blk, BLK_N);
+            dpi_ctle_adapt_load_bits(ctle_f32, bit_blk, BLK_UI);
+        end
+
+        best_eye = dpi_ctle_adapt_run(ctle, 0);
+        void'(dpi_ctle_adapt_write_report(ctle, "sim/ctle_adapt.csv"));
+        for (int c = 0; c < CODES; c++) eye_score[c] = dpi_ctle_adapt_score(ctle, c);
+        $display("[%0t ns] Eye metric: code %0d (%0.2f dB), eye %0.3f at sample %0d",
+                 $time, best_eye, dpi_ctle_adapt_peaking(ctle, best_eye), eye_score[best_eye],
+                 dpi_ctle_adapt_phase(ctle, best_eye));
+        $display("  Code 0 (no peaking): eye %0.3f", eye_score[0]);
+        check("no peaking leaves the eye closed", eye_score[0] < 0.0);
+        check("interior code chosen with an open eye", best_eye > 0 && best_eye < CODES - 1 &&
+              eye_score[best_eye] > 0.5);
+
+        void'(dpi_ctle_adapt_run(ctle_1t, 0));
+        for (int c = 0; c < CODES; c++) begin
+            if (dpi_ctle_adapt_score(ctle_1t, c) != eye_score[c]) mismatch++;
+        end
+        check($sformatf("%0d threads reproduce 1-thread scores", THREADS), mismatch == 0);
+
+        // float32: same choice, scores close to float64
+        mismatch = 0;
+        best_f32 = dpi_ctle_adapt_run(ctle_f32, 0);
+        for (int c = 0; c < CODES; c++) begin
+            d = dpi_ctle_adapt_score(ctle_f32, c) - eye_score[c];
+            if ((d > 1.0e-4 || d < -1.0e-4) && eye_score[c] > -1.0e9) mismatch++;
+        end
+        $display("[%0t ns] float32: code %0d, eye %0.6f, guard error %0.2e", $time, best_f32,
+                 dpi_ctle_adapt_score(ctle_f32, best_f32), dpi_ctle_adapt_guard_error(ctle_f32));
+        check("float32 chooses the float64 code", best_f32 == best_eye);
+        check("float32 scores within 1e-4 of float64", mismatch == 0);
+        check("float32 guard error below tolerance", dpi_ctle_adapt_guard_error(ctle_f32) < 1.0e-3);
+
+        best_isi = dpi_ctle_adapt_run(ctle, 1);
+        $display("[%0t ns] ISI metric: code %0d (%0.2f dB), ISI/cursor %0.4f; code 0 %0.4f",
+                 $time, best_isi, dpi_ctle_adapt_peaking(ctle, best_isi),
+                 -dpi_ctle_adapt_score(ctle, best_isi), -dpi_ctle_adapt_score(ctle, 0));
+        check("ISI choice within ±2 codes of eye choice", best_isi - best_eye <= 2 &&
+              best_eye - best_isi <= 2);
+
+        // Restore the eye-metric result for bring-up
+        void'(dpi_ctle_adapt_run(ctle, 0));
+    endtask
+
+    //==========================================================================
+    // TEST: BRING-UP WITH THE CHOSEN CODE
+    //==========================================================================
+    task automatic test_bringup();
+        int code;
+        int lag;
+        int tx_hist[$];
+        int errors = 0;
+        int checked = 0;
+        int k;
+
+        code = dpi_ctle_adapt_best(ctle);
+        lag = dpi_ctle_adapt_phase(ctle, code);
+        // Sample UI k at k·SPU + lag (lag includes the latency in UIs)
+        for (int blk = 0; blk < CHECK_BLOCKS; blk++) begin
+            @(posedge clk);
+            channel_block();
+            for (int i = 0; i < BLK_UI; i++) tx_hist.push_back(bit_blk[i]);
+            void'(dpi_ctle_adapt_apply(ctle, code, x_blk, BLK_N, y_blk));
+            for (int n = 0; n < BLK_N; n++) begin
+                k = (blk * BLK_N + n - lag) / SPU;
+                if ((blk * BLK_N + n - lag) % SPU == 0 && blk * BLK_N + n >= lag && k >= 32) begin
+                    if ((y_blk[n] >= 0.0 ? 1 : 0) != tx_hist[k]) errors++;
+                    checked++;
+                end
+            end
+        end
+        $display("[%0t ns] Bring-up: code %0d, %0d bits checked, %0d errors", $time, code,
+                 checked, errors);
+        check("chosen code recovers every bit", checked > 400 && errors == 0);
+    endtask
+
+    //==========================================================================
+    // MAIN TEST SEQUENCE
+    //==========================================================================
+    initial begin
+        $display("========================================");
+        $display("  CTLE Peaking Auto-Selection Test");
+        $display("========================================");
+
+        void'($urandom(86));
+        test_code_table();
+        test_adapt();
+        test_bringup();
+
+        dpi_ctle_adapt_destroy(ctle);
+        dpi_ctle_adapt_destroy(ctle_1t);
+        dpi_ctle_adapt_destroy(ctle_f32);
+
+        $display("");
+        if (error_count == 0) begin
+            $display("========================================");
+            $display("*** PASSED: All tests passed ***");
+            $display("========================================");
+        end else begin
+            $display("========================================");
+            $display("*** FAILED: %0d errors detected ***", error_count);
+            $display("========================================");
+        end
+
+        $finish;
+    end
+
+    //==========================================================================
+    // TIMEOUT WATCHDOG
+    //==========================================================================
+    initial begin
+        #SIM_TIMEOUT;
+        $display("ERROR: Simulation timeout after %0d time units", SIM_TIMEOUT);
+        $finish;
+    end
+
+endmodule
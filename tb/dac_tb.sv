@@ -0,0 +1,275 @@
+/**
+ * dac_tb.sv - Self-Checking Testbench for the TX DAC Model
+ *
+ * Test Strategy:
+ * - RTL (dac_model, ideal NRZ and PAM4): random symbols one per clock must
+ *   map to the spec levels (±1.0 V; ±0.75 / ±0.25 V)
+ * - RTL (PAM4, 5 GHz output pole at 10 Gb/s): output must follow the
+ *   exact UI-rate recursion y = x + (y - x)·e^(-2π·f3dB·UI)
+ * - Block API, INL / DNL tables: code levels match (code + INL) / 128 and
+ *   a DNL table reads back as programmed
+ * - Block API, RLM 0.95: measured RLM of the symbol levels and the settled
+ *   waveform levels
+ * - Block API, DCD 0.1 UI on a 1010 pattern at 64 samples per UI: high
+ *   time is (1 - DCD) / 2 of the period
+ *
+ * Author: Generated for SerDes TX front-end modeling
+ * Date: 2025
+ */
+
+`timescale 1ns / 1ps
+
+module dac_tb #(
+    parameter SIM_TIMEOUT = 10000  // 10us timeout (200 symbols @ 100MHz = 2us + margin)
+);
+
+    //==========================================================================
+    // TEST PARAMETERS
+    //==========================================================================
+    localparam real UI = 100.0e-12;             // 10 Gb/s
+    localparam real F3DB = 5.0e9;               // Output pole
+    localparam int  NUM_SYMBOLS = 200;
+    localparam int  BITS = 8;
+    localparam int  NCODES = 1 << BITS;
+    localparam int  SPU = 64;                   // Block API samples per UI
+    localparam int  BLOCK_UIS = 100;
+    localparam int  BLOCK_N = BLOCK_UIS * SPU;
+    localparam real RLM = 0.95;
+    localparam real DCD = 0.1;                  // UI
+
+    //==========================================================================
+    // DPI-C IMPORTS
+    //==========================================================================
+    import "DPI-C" function chandle dpi_dac_create(input int bits, input real full_scale_v,
+        input real ui_s, input int samples_per_ui);
+    import "DPI-C" function int  dpi_dac_set_inl_table(input chandle h, input real inl_lsb[NCODES],
+        input int n);
+    import "DPI-C" function int  dpi_dac_set_dnl_table(input chandle h, input real dnl_lsb[NCODES],
+        input int n);
+    import "DPI-C" function real dpi_dac_dnl(input chandle h, input int code);
+    import "DPI-C" function real dpi_dac_code_level(input chandle h, input int code);
+    import "DPI-C" function int  dpi_dac_set_rlm(input chandle h, input real rlm);
+    import "DPI-C" function real dpi_dac_rlm(input chandle h);
+    import "DPI-C" function real dpi_dac_level(input chandle h, input int symbol, input int pam);
+    import "DPI-C" function int  dpi_dac_set_dcd(input chandle h, input real dcd_ui);
+    import "DPI-C" function int  dpi_dac_symbols_block(input chandle h, input int symbols[BLOCK_UIS],
+        input int n, input int pam, output real out[BLOCK_N]);
+    import "DPI-C" function void dpi_dac_destroy(input chandle h);
+
+    //==========================================================================
+    // TESTBENCH SIGNALS
+    //==========================================================================
+    logic       clk;
+    logic       rst_n;
+    logic [1:0] symbol;
+    real        nrz_out;
+    real        pam4_out;
+    real        pole_out;
+
+    //==========================================================================
+    // VERIFICATION VARIABLES
+    //==========================================================================
+    int  error_count = 0;
+    real table_buf[NCODES];
+    int  sym_blk[BLOCK_UIS];
+    real wave[BLOCK_N];
+
+    //==========================================================================
+    // DUT INSTANTIATION
+    //==========================================================================
+    dac_model #(.PAM_LEVELS(2)) dut_nrz (
+        .clk(clk), .rst_n(rst_n), .symbol(symbol), .analog_out(nrz_out)
+    );
+
+    dac_model #(.PAM_LEVELS(4)) dut_pam4 (
+        .clk(clk), .rst_n(rst_n), .symbol(symbol), .analog_out(pam4_out)
+    );
+
+    dac_model #(.PAM_LEVELS(4), .UI_S(UI), .BANDWIDTH_HZ(F3DB)) dut_pole (
+        .clk(clk), .rst_n(rst_n), .symbol(symbol), .analog_out(pole_out)
+    );
+
+    //==========================================================================
+    // CLOCK GENERATION
+    //==========================================================================
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    //==========================================================================
+    // VCD WAVEFORM DUMP
+    //==========================================================================
+    initial begin
+        $dumpfile("sim/waves/dac.vcd");
+        $dumpvars(0, dac_tb);
+    end
+
+    //==========================================================================
+    // HELPERS
+    //==========================================================================
+    function automatic bit near(input real a, input real b, input real tol);
+        return (a - b <= tol) && (b - a <= tol);
+    endfunction
+
+    task automatic check(input string name, input bit ok);
+        if (ok) begin
+            $display("  ✓ %s", name);
+        end else begin
+            $display("  ✗ ERROR: %s", name);
+            error_count++;
+        end
+    endtask
+
+    //==========================================================================
+    // TEST: RTL LEVELS AND OUTPUT POLE
+    //==========================================================================
+    task automatic test_rtl();
+        real nrz_exp;
+        real pam4_exp;
+        real pole_exp = 0.0;
+        real a;
+        int  level_err = 0;
+        int  pole_err = 0;
+
+        a = $exp(-2.0 * 3.14159265358979 * F3DB * UI);
+        for (int i = 0; i < NUM_SYMBOLS; i++) begin
+            symbol = 2'($urandom % 4);
+            @(posedge clk);
+            #1;
+            nrz_exp = symbol[0] ? 1.0 : -1.0;
+            pam4_exp = -0.75 + 0.5 * real'(int'(symbol));
+            pole_exp = pam4_exp + (pole_exp - pam4_exp) * a;
+            if (!near(nrz_out, nrz_exp, 1.0e-12) || !near(pam4_out, pam4_exp, 1.0e-12)) begin
+                if (level_err < 5)
+                    $display("  ✗ symbol %0d: NRZ %0.4f (exp %0.4f), PAM4 %0.4f (exp %0.4f)",
+                             symbol, nrz_out, nrz_exp, pam4_out, pam4_exp);
+                level_err++;
+            end
+            if (!near(pole_out, pole_exp, 1.0e-9)) pole_err++;
+        end
+        $display("[%0t ns] RTL: %0d symbols", $time, NUM_SYMBOLS);
+        check("NRZ / PAM4 levels match spec §2.1.4", level_err == 0);
+        check($sformatf("Output pole follows UI-rate recursion (a = %0.4f)", a), pole_err == 0);
+    endtask
+
+    //==========================================================================
+    // TEST: INL / DNL TABLES
+    //==========================================================================
+    task automatic test_inl_dnl();
+        chandle dac;
+        real    x;
+        int     mismatches = 0;
+
+        dac = dpi_dac_create(BITS, 1.0, UI, 1);
+        // Bow INL, 1.5 LSB peak at mid code
+        for (int i = 0; i < NCODES; i++) begin
+            x = 2.0 * real'(i) / real'(NCODES - 1) - 1.0;
+            table_buf[i] = 1.5 * (1.0 - x * x);
+        end
+        void'(dpi_dac_set_inl_table(dac, table_buf, NCODES));
+        for (int c = -128; c < 128; c++) begin
+            if (!near(dpi_dac_code_level(dac, c), (real'(c) + table_buf[c + 128]) / 128.0, 1.0e-12))
+                mismatches++;
+        end
+        $display("[%0t ns] INL table: %0d code-level mismatches", $time, mismatches);
+        check("code levels = (code + INL) / 2^(BITS-1)", mismatches == 0);
+
+        // One wide and one narrow step around mid code
+        for (int i = 0; i < NCODES; i++) table_buf[i] = 0.0;
+        table_buf[128] = 0.4;
+        table_buf[129] = -0.4;
+        check("DNL table accepted", dpi_dac_set_dnl_table(dac, table_buf, NCODES) == 0);
+        check("DNL reads back (+0.4 / -0.4 / 0 LSB)", near(dpi_dac_dnl(dac, 0), 0.4, 1.0e-9) &&
+              near(dpi_dac_dnl(dac, 1), -0.4, 1.0e-9) && near(dpi_dac_dnl(dac, 50), 0.0, 1.0e-9));
+        dpi_dac_destroy(dac);
+    endtask
+
+    //==========================================================================
+    // TEST: PAM4 RLM
+    //==========================================================================
+    task automatic test_rlm();
+        chandle dac;
+        int     mismatches = 0;
+
+        dac = dpi_dac_create(BITS, 1.0, UI, SPU);
+        check("ideal RLM = 1", near(dpi_dac_rlm(dac), 1.0, 1.0e-9));
+        void'(dpi_dac_set_rlm(dac, RLM));
+        $display("[%0t ns] RLM set %0.3f, measured %0.4f (levels %0.4f %0.4f %0.4f %0.4f)", $time,
+                 RLM, dpi_dac_rlm(dac), dpi_dac_level(dac, 0, 4), dpi_dac_level(dac, 1, 4),
+                 dpi_dac_level(dac, 2, 4), dpi_dac_level(dac, 3, 4));
+        check("measured RLM matches", near(dpi_dac_rlm(dac), RLM, 1.0e-6));
+        // No pole: every sample of a UI sits at its symbol level
+        for (int i = 0; i < BLOCK_UIS; i++) sym_blk[i] = int'($urandom % 4);
+        void'(dpi_dac_symbols_block(dac, sym_blk, BLOCK_UIS, 4, wave));
+        for (int i = 0; i < BLOCK_UIS; i++) begin
+            if (!near(wave[i * SPU + SPU / 2], dpi_dac_level(dac, sym_blk[i], 4), 1.0e-12))
+                mismatches++;
+        end
+        check("waveform levels match the RLM levels", mismatches == 0);
+        dpi_dac_destroy(dac);
+    endtask
+
+    //==========================================================================
+    // TEST: DCD
+    //==========================================================================
+    task automatic test_dcd();
+        chandle dac;
+        int     high = 0;
+        real    duty;
+
+        dac = dpi_dac_create(BITS, 1.0, UI, SPU);
+        void'(dpi_dac_set_dcd(dac, DCD));
+        // Odd UIs are '1': the rising edge into them is late by DCD
+        for (int i = 0; i < BLOCK_UIS; i++) sym_blk[i] = i % 2;
+        void'(dpi_dac_symbols_block(dac, sym_blk, BLOCK_UIS, 2, wave));
+        for (int n = 0; n < BLOCK_N; n++) high += (wave[n] > 0.0) ? 1 : 0;
+        duty = real'(high) / real'(BLOCK_N);
+        $display("[%0t ns] DCD %0.2f UI: high fraction %0.4f (expected %0.4f)", $time, DCD, duty,
+                 (1.0 - DCD) / 2.0);
+        // Edge resolution: one sample per UI of the period (1 / 128)
+        check("duty cycle reflects DCD", near(duty, (1.0 - DCD) / 2.0, 1.0 / 128.0));
+        dpi_dac_destroy(dac);
+    endtask
+
+    //==========================================================================
+    // MAIN TEST SEQUENCE
+    //==========================================================================
+    initial begin
+        $display("========================================");
+        $display("  TX DAC Model Test");
+        $display("========================================");
+
+        void'($urandom(84));
+        rst_n = 0;
+        symbol = 2'b00;
+        repeat (2) @(posedge clk);
+        rst_n = 1;
+
+        test_rtl();
+        test_inl_dnl();
+        test_rlm();
+        test_dcd();
+
+        $display("");
+        if (error_count == 0) begin
+            $display("========================================");
+            $display("*** PASSED: All tests passed ***");
+            $display("========================================");
+        end else begin
+            $display("========================================");
+            $display("*** FAILED: %0d errors detected ***", error_count);
+            $display("========================================");
+        end
+
+        $finish;
+    end
+
+    //==========================================================================
+    // TIMEOUT WATCHDOG
+    //==========================================================================
+    initial begin
+        #SIM_TIMEOUT;
+        $display("ERROR: Simulation timeout after %0d time units", SIM_TIMEOUT);
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,138 @@
+/**
+ * demux_4bit_equiv.cpp - Exhaustive Equivalence Check: demux_4bit vs Reference
+ *
+ * Proves rtl/demux_4bit.sv against a C++ reference over its complete input
+ * space ({sel, data_in}, 6 bits) using the equiv_check.h engine. Where
+ * demux_4bit_tb.sv walks the vectors through the SystemVerilog scheduler
+ * with a delay per vector, this drives the Verilated module directly.
+ *
+ * Test Strategy:
+ * - Input vector: bits [3:0] = data_in, bits [5:4] = sel
+ * - Packed outputs: {out3, out2, out1, out0} (16 bits)
+ * - Reference: out[sel] = data_in, the other outputs 0
+ * - --inject V corrupts the reference at vector V; the run must then fail
+ *   at exactly V (checks the checker)
+ *
+ * Build:
+ *   verilator --cc --exe --build -O3 -j 0 --top-module demux_4bit \
+ *     -CFLAGS "-O2 -std=c++17" -LDFLAGS -pthread -Mdir sim/obj_dir_equiv \
+ *     rtl/demux_4bit.sv tb/demux_4bit_equiv.cpp
+ *
+ * Run:
+ *   sim/obj_dir_equiv/Vdemux_4bit [--threads N] [--keep-going] [--inject V]
+ *
+ * Author: Generated for SystemVerilog test automation
+ * Date: 2025
+ */
+
+#include <verilated.h>
+#include "Vdemux_4bit.h"
+#include "equiv_check.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+//==============================================================================
+// CONFIGURATION
+//==============================================================================
+#define INPUT_BITS      6               // data_in (4) + sel (2)
+#define NO_INJECT       UINT64_MAX
+
+//==============================================================================
+// REFERENCE MODEL
+//==============================================================================
+static inline uint64_t demux_reference(uint64_t v) {
+    const uint64_t data = v & 0xF;
+    const unsigned sel = (unsigned)(v >> 4) & 3;
+    return data << (4 * sel);
+}
+
+//==============================================================================
+// MAIN
+//==============================================================================
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+
+    int threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    bool stop_on_fail = true;
+    uint64_t inject = NO_INJECT;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string a = argv[i];
+        if (a == "--threads" && i + 1 < argc) threads = std::max(1, atoi(argv[++i]));
+        else if (a == "--keep-going") stop_on_fail = false;
+        else if (a == "--inject" && i + 1 < argc) inject = strtoull(argv[++i], nullptr, 0);
+        else if (a[0] == '+') continue;   // Verilator runtime arguments
+        else {
+            printf("Usage: %s [--threads N] [--keep-going] [--inject V]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    printf("=== demux_4bit exhaustive equivalence (%d input bits, %d threads) ===\n",
+           INPUT_BITS, threads);
+
+    const EquivResult r = equiv_exhaustive<Vdemux_4bit>(
+        INPUT_BITS, threads, stop_on_fail,
+        [](Vdemux_4bit &m, uint64_t v) {
+            m.data_in = v & 0xF;
+            m.sel = (v >> 4) & 3;
+        },
+        [](const Vdemux_4bit &m) {
+            return (uint64_t)m.out0 | ((uint64_t)m.out1 << 4) | ((uint64_t)m.out2 << 8) |
+                   ((uint64_t)m.out3 << 12);
+        },
+        [inject](uint64_t v) { return demux_reference(v) ^ (v == inject ? 1 : 0); });
+
+    printf("  Checked: %llu / %llu vectors in %.3f s (%.1f Mvec/s)\n",
+           (unsigned long long)r.checked, (unsigned long long)r.space, r.seconds,
+           r.checked / std::max(r.seconds, 1e-9) / 1e6);
+
+    for (const EquivFailure &f : r.failures) {
+        printf("  ✗ sel=%llu data_in=0x%llx: outputs {out3..out0} = 0x%04llx, expected 0x%04llx\n",
+               (unsigned long long)(f.vector >> 4), (unsigned long long)(f.vector & 0xF),
+               (unsigned long long)f.got, (unsigned long long)f.want);
+    }
+
+    if (!r.proven()) {
+        printf("*** FAILED: %llu mismatching vectors (first: %llu) ***\n",
+               (unsigned long long)r.mismatches,
+               r.failures.empty() ? 0ULL : (unsigned long long)r.failures[0].vector);
+        return 1;
+    }
+    printf("*** PASSED: demux_4bit equals the reference on all %llu inputs ***\n",
+           (unsigned long long)r.space);
+    return 0;
+}
+
+/**
+ * =============================================================================
+ * IMPLEMENTATION NOTES
+ * =============================================================================
+ *
+ * 1. Why Not demux_4bit_tb.sv:
+ *    - The SV testbench spends a #10 delay, a scheduler pass and a compare
+ *      per vector; fine for 64 vectors, not for the 2^16..2^24 input
+ *      spaces of control logic. Here one vector is one eval() of the
+ *      combinational model, with no scheduler or delay around it
+ *    - Throughput depends on the model and the host; no figure is
+ *      assumed here. The run prints its measured rate ("Mvec/s"), which
+ *      is the number to use when sizing a larger input space
+ *
+ * 2. Adding Another Module:
+ *    - Copy this file, set INPUT_BITS, and write the three lambdas: input
+ *      packing, output packing and the reference. Outputs wider than 64
+ *      bits need a hash or a second pass over a different output slice
+ *    - Only combinational modules: no clock is toggled, so registered
+ *      outputs would compare against their reset values
+ *
+ * 3. Verilator Compilation:
+ *    - See the build line in the header (no --timing / --binary: this file
+ *      provides main()). equiv_check.h needs no -I: a quoted include is
+ *      looked up next to the including source first
+ *
+ * =============================================================================
+ */
@@ -0,0 +1,290 @@
+/**
+ * diff_pair_tb.sv - Self-Checking Testbench for the Differential-Pair Engine
+ *
+ * Test Strategy (100 GS/s, Vcm = 0.5 V):
+ * - Balance (ctle spec §6.7): DC differential 0.2 V → legs 0.6 / 0.4 V,
+ *   differential 0.2 V (±5%), common mode 0.5 V (±0.02 V)
+ * - CM rejection (ctle spec §6.8): 0.2 V / 100 MHz CM tone + 10 mV RMS CM
+ *   noise on a matched pair → |differential| < 1 mV, CM carries the tone
+ * - Intra-pair skew 12.5 ps on a 1 GHz, 0.4 V sine: differential
+ *   A·cos(ωτ/2), common mode (A/2)·sin(ωτ/2)
+ * - Gain mismatch 10%: common mode = A·m/4
+ * - Bandwidth mismatch (20 / 18 GHz legs), 2 GHz CM tone: differential =
+ *   |H_P - H_N|·A_cm (CM-to-differential conversion)
+ * - External-leg path: legs generated by one engine and decomposed by a
+ *   second (ideal) engine must match the first engine's own decomposition
+ * - Sweepable (run_test.py --sweep): +SKEW_PS=<ps> and +GAIN_MM=<ratio>
+ *   override the skew / gain-mismatch points; measured amplitudes are
+ *   reported as [METRIC] lines
+ *
+ * Author: Generated for SerDes differential signal modeling
+ * Date: 2025
+ */
+
+`timescale 1ns / 1ps
+
+module diff_pair_tb #(
+    parameter SIM_TIMEOUT = 10000  // 10us timeout (18 blocks @ 100MHz = 180ns + margin)
+);
+
+    //==========================================================================
+    // TEST PARAMETERS
+    //==========================================================================
+    localparam real FS = 100.0e9;
+    localparam real VCM = 0.5;
+    localparam int  N = 2000;                   // Samples per block
+    localparam real PI = 3.14159265358979;
+    localparam real A = 0.4;                    // Sine amplitude (V)
+    localparam real F_SIG = 1.0e9;
+    localparam real SKEW = 12.5e-12;
+    localparam real GAIN_MM = 0.1;
+    localparam real BW_P = 20.0e9;
+    localparam real BW_N = 18.0e9;
+
+    //==========================================================================
+    // DPI-C IMPORTS
+    //==========================================================================
+    import "DPI-C" function chandle dpi_diff_create(input real fs_hz, input real vcm);
+    import "DPI-C" function int  dpi_diff_set_skew(input chandle h, input real skew_s);
+    import "DPI-C" function int  dpi_diff_set_mismatch(input chandle h, input real gain_mismatch,
+        input real bw_p_hz, input real bw_n_hz);
+    import "DPI-C" function void dpi_diff_set_cm_noise(input chandle h, input real tone_amp_v,
+        input real tone_freq_hz, input real rms_v, input int seed);
+    import "DPI-C" function int  dpi_diff_process(input chandle h, input real vdiff[N], input int n,
+        output real diff_out[N], output real cm_out[N]);
+    import "DPI-C" function int  dpi_diff_legs(input chandle h, input real vdiff[N], input int n,
+        output real p_out[N], output real n_out[N]);
+    import "DPI-C" function int  dpi_diff_process_legs(input chandle h, input real p_in[N],
+        input real n_in[N], input int n, output real diff_out[N], output real cm_out[N]);
+    import "DPI-C" function void dpi_diff_reset_stats(input chandle h);
+    import "DPI-C" function real dpi_diff_mean_diff(input chandle h);
+    import "DPI-C" function real dpi_diff_mean_cm(input chandle h);
+    import "DPI-C" function real dpi_diff_ac_diff(input chandle h);
+    import "DPI-C" function real dpi_diff_ac_cm(input chandle h);
+    import "DPI-C" function void dpi_diff_destroy(input chandle h);
+
+    //==========================================================================
+    // TESTBENCH SIGNALS
+    //==========================================================================
+    logic clk;
+
+    //==========================================================================
+    // VERIFICATION VARIABLES
+    //==========================================================================
+    int  error_count = 0;
+    real vin[N];
+    real vd[N];
+    real vc[N];
+    real leg_p[N];
+    real leg_n[N];
+    real vd2[N];
+    real vc2[N];
+    real skew = SKEW;                           // +SKEW_PS override
+    real gain_mm = GAIN_MM;                     // +GAIN_MM override
+
+    //==========================================================================
+    // CLOCK GENERATION
+    //==========================================================================
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    //==========================================================================
+    // VCD WAVEFORM DUMP
+    //==========================================================================
+    initial begin
+        if (!$test$plusargs("NO_VCD")) begin
+            $dumpfile("sim/waves/diff_pair.vcd");
+            $dumpvars(0, diff_pair_tb);
+        end
+    end
+
+    //==========================================================================
+    // HELPERS
+    //==========================================================================
+    task automatic check(input string name, input bit ok);
+        if (ok) begin
+            $display("  ✓ %s", name);
+        end else begin
+            $display("  ✗ ERROR: %s", name);
+            error_count++;
+        end
+    endtask
+
+    task automatic check_range(input string name, input real value, input real expected,
+                               input real tol);
+        check($sformatf("%s = %0.6f (expected %0.6f ± %0.6f)", name, value, expected, tol),
+              value <= expected + tol && value >= expected - tol);
+    endtask
+
+    // Block blk of a 1 GHz sine (continuous across blocks)
+    task automatic sine_block(input int blk);
+        for (int i = 0; i < N; i++) vin[i] = A * $sin(2.0 * PI * F_SIG * real'(blk * N + i) / FS);
+    endtask
+
+    // One warm-up block, then stats over two blocks of the sine (or zeros)
+    task automatic run_sine(input chandle h, input bit zero);
+        for (int blk = 0; blk < 3; blk++) begin
+            @(posedge clk);
+            if (zero) begin
+                for (int i = 0; i < N; i++) vin[i] = 0.0;
+            end else begin
+                sine_block(blk);
+            end
+            void'(dpi_diff_process(h, vin, N, vd, vc));
+            if (blk == 0) dpi_diff_reset_stats(h);
+        end
+    endtask
+
+    //==========================================================================
+    // TEST: BALANCE AND CM REJECTION
+    //==========================================================================
+    task automatic test_balance();
+        chandle d;
+        real    max_diff = 0.0;
+
+        d = dpi_diff_create(FS, VCM);
+        for (int i = 0; i < N; i++) vin[i] = 0.2;
+        void'(dpi_diff_legs(d, vin, N, leg_p, leg_n));
+        void'(dpi_diff_process(d, vin, N, vd, vc));
+        $display("[%0t ns] Differential balance (DC 0.2 V)", $time);
+        check_range("P leg (V)", leg_p[N - 1], 0.6, 1.0e-12);
+        check_range("N leg (V)", leg_n[N - 1], 0.4, 1.0e-12);
+        check_range("differential (V)", dpi_diff_mean_diff(d), 0.2, 0.01);
+        check_range("common mode (V)", dpi_diff_mean_cm(d), VCM, 0.02);
+        dpi_diff_destroy(d);
+
+        d = dpi_diff_create(FS, VCM);
+        dpi_diff_set_cm_noise(d, 0.2, 100.0e6, 0.01, 87);
+        for (int i = 0; i < N; i++) vin[i] = 0.0;
+        void'(dpi_diff_process(d, vin, N, vd, vc));
+        for (int i = 0; i < N; i++) begin
+            if (vd[i] > max_diff) max_diff = vd[i];
+            if (-vd[i] > max_diff) max_diff = -vd[i];
+        end
+        $display("[%0t ns] Common-mode rejection (0.2 V tone + 10 mV RMS)", $time);
+        check_range("max |differential| (V)", max_diff, 0.0, 1.0e-3);
+        check_range("CM AC RMS (V)", dpi_diff_ac_cm(d), $sqrt(0.02 + 1.0e-4), 0.002);
+        dpi_diff_destroy(d);
+    endtask
+
+    //==========================================================================
+    // TEST: SKEW AND MISMATCH (MODE CONVERSION)
+    //==========================================================================
+    task automatic test_mode_conversion();
+        chandle d;
+        real    w;
+        real    re;
+        real    im;
+
+        w = 2.0 * PI * F_SIG;
+        d = dpi_diff_create(FS, VCM);
+        void'(dpi_diff_set_skew(d, skew));
+        run_sine(d, 0);
+        $display("[%0t ns] Skew %0.1f ps, %0.1f GHz sine", $time, skew * 1.0e12, F_SIG / 1.0e9);
+        check_range("differential amp (V)", dpi_diff_ac_diff(d) * $sqrt(2.0),
+                    A * $cos(w * skew / 2.0), 0.01 * A);
+        check_range("CM amp (V)", dpi_diff_ac_cm(d) * $sqrt(2.0),
+                    A / 2.0 * $sin(w * skew / 2.0), 0.01 * A / 2.0 * $sin(w * skew / 2.0));
+        $display("[METRIC] skew_diff_amp = %0.9f", dpi_diff_ac_diff(d) * $sqrt(2.0));
+        $display("[METRIC] skew_cm_amp = %0.9f", dpi_diff_ac_cm(d) * $sqrt(2.0));
+        dpi_diff_destroy(d);
+
+        d = dpi_diff_create(FS, VCM);
+        void'(dpi_diff_set_mismatch(d, gain_mm, 0.0, 0.0));
+        run_sine(d, 0);
+        $display("[%0t ns] Gain mismatch %0.1f%%", $time, gain_mm * 100.0);
+        check_range("CM amp (V)", dpi_diff_ac_cm(d) * $sqrt(2.0), A * gain_mm / 4.0,
+                    0.01 * A * gain_mm / 4.0);
+        $display("[METRIC] mismatch_cm_amp = %0.9f", dpi_diff_ac_cm(d) * $sqrt(2.0));
+        dpi_diff_destroy(d);
+
+        // H(f) = 1 / (1 + j·f/fp) = (1 - j·r) / (1 + r²)
+        d = dpi_diff_create(FS, VCM);
+        void'(dpi_diff_set_mismatch(d, 0.0, BW_P, BW_N));
+        dpi_diff_set_cm_noise(d, 0.2, 2.0 * F_SIG, 0.0, 1);
+        run_sine(d, 1);
+        re = 1.0 / (1.0 + (2.0 * F_SIG / BW_P) ** 2) - 1.0 / (1.0 + (2.0 * F_SIG / BW_N) ** 2);
+        im = (2.0 * F_SIG / BW_N) / (1.0 + (2.0 * F_SIG / BW_N) ** 2) -
+             (2.0 * F_SIG / BW_P) / (1.0 + (2.0 * F_SIG / BW_P) ** 2);
+        $display("[%0t ns] Bandwidth mismatch %0.0f / %0.0f GHz, 0.2 V CM tone at %0.0f GHz",
+                 $time, BW_P / 1.0e9, BW_N / 1.0e9, 2.0 * F_SIG / 1.0e9);
+        check_range("differential amp (V)", dpi_diff_ac_diff(d) * $sqrt(2.0),
+                    0.2 * $sqrt(re * re + im * im), 0.02 * 0.2 * $sqrt(re * re + im * im));
+        dpi_diff_destroy(d);
+    endtask
+
+    //==========================================================================
+    // TEST: EXTERNAL-LEG PATH
+    //==========================================================================
+    task automatic test_external_legs();
+        chandle gen;
+        chandle ref_e;
+        chandle ideal;
+        real    dev = 0.0;
+
+        gen = dpi_diff_create(FS, VCM);
+        ref_e = dpi_diff_create(FS, VCM);
+        ideal = dpi_diff_create(FS, VCM);
+        void'(dpi_diff_set_skew(gen, 7.0e-12));
+        void'(dpi_diff_set_mismatch(gen, 0.05, 30.0e9, 25.0e9));
+        void'(dpi_diff_set_skew(ref_e, 7.0e-12));
+        void'(dpi_diff_set_mismatch(ref_e, 0.05, 30.0e9, 25.0e9));
+        for (int blk = 0; blk < 2; blk++) begin
+            @(posedge clk);
+            sine_block(blk);
+            void'(dpi_diff_legs(gen, vin, N, leg_p, leg_n));
+            void'(dpi_diff_process_legs(ideal, leg_p, leg_n, N, vd, vc));
+            void'(dpi_diff_process(ref_e, vin, N, vd2, vc2));
+            for (int i = 0; i < N; i++) begin
+                if (vd[i] - vd2[i] > dev) dev = vd[i] - vd2[i];
+                if (vd2[i] - vd[i] > dev) dev = vd2[i] - vd[i];
+                if (vc[i] - vc2[i] > dev) dev = vc[i] - vc2[i];
+                if (vc2[i] - vc[i] > dev) dev = vc2[i] - vc[i];
+            end
+        end
+        $display("[%0t ns] External legs through an ideal engine", $time);
+        check_range("max deviation (V)", dev, 0.0, 1.0e-12);
+        dpi_diff_destroy(gen);
+        dpi_diff_destroy(ref_e);
+        dpi_diff_destroy(ideal);
+    endtask
+
+    //==========================================================================
+    // MAIN TEST SEQUENCE
+    //==========================================================================
+    initial begin
+        $display("========================================");
+        $display("  Differential-Pair Engine Test");
+        $display("========================================");
+
+        if ($value$plusargs("SKEW_PS=%f", skew)) skew = skew * 1.0e-12;
+        void'($value$plusargs("GAIN_MM=%f", gain_mm));
+
+        test_balance();
+        test_mode_conversion();
+        test_external_legs();
+
+        $display("");
+        if (error_count == 0) begin
+            $display("========================================");
+            $display("*** PASSED: All tests passed ***");
+            $display("========================================");
+        end else begin
+            $display("========================================");
+            $display("*** FAILED: %0d errors detected ***", error_count);
+            $display("========================================");
+        end
+
+        $finish;
+    end
+
+    //==========================================================================
+    // TIMEOUT WATCHDOG
+    //==========================================================================
+    initial begin
+        #SIM_TIMEOUT;
+        $display("ERROR: Simulation timeout after %0d time units", SIM_TIMEOUT);
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,158 @@
+/**
+ * equiv_check.h - Exhaustive Equivalence Checking of Combinational Models
+ *
+ * Enumerates the complete input space of a small combinational Verilated
+ * model and compares every output against a C++ reference function. The
+ * model is driven directly (set inputs, eval()) with no testbench, time
+ * wheel or $display in the loop, so one vector costs one eval() call.
+ *
+ * Features:
+ * - Input spaces up to 2^40 vectors, split into chunks that worker
+ *   threads claim from a shared counter (one model per thread)
+ * - Vectors run in blocks of 64 with a branch-free mismatch mask per
+ *   block (bit i = vector base + i failed); the slow path only runs for
+ *   blocks that contain a failure
+ * - Reports the lowest failing vector, independent of the thread count:
+ *   after a failure no new chunks are claimed, but every claimed chunk
+ *   (all lower chunks included) is finished
+ *
+ * Usage (see tb/demux_4bit_equiv.cpp):
+ *   EquivResult r = equiv_exhaustive<Vdemux_4bit>(6, threads, stop_on_fail,
+ *       [](Vdemux_4bit &m, uint64_t v) { m.data_in = v & 15; m.sel = v >> 4; },
+ *       [](const Vdemux_4bit &m) { return (uint64_t)m.out0 | ...; },
+ *       [](uint64_t v) { return reference(v); });
+ *
+ * Author: Generated for SystemVerilog test automation
+ * Date: 2025
+ */
+
+#ifndef EQUIV_CHECK_H
+#define EQUIV_CHECK_H
+
+#include <verilated.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//==============================================================================
+// CONFIGURATION
+//==============================================================================
+#define EQUIV_MAX_INPUT_BITS    40
+#define EQUIV_CHUNK_BITS        16      // Vectors per claimed chunk: 2^16
+#define EQUIV_MAX_REPORTED      16      // Failing vectors kept for the report
+
+//==============================================================================
+// RESULT
+//==============================================================================
+struct EquivFailure {
+    uint64_t vector;
+    uint64_t got;                       // Packed model outputs
+    uint64_t want;                      // Packed reference outputs
+};
+
+struct EquivResult {
+    uint64_t space = 0;                 // 2^input_bits
+    uint64_t checked = 0;               // Vectors evaluated
+    uint64_t mismatches = 0;
+    std::vector<EquivFailure> failures; // Lowest failing vectors, ascending
+    double seconds = 0.0;
+
+    bool proven() const { return mismatches == 0 && checked == space; }
+};
+
+//==============================================================================
+// ENGINE
+//==============================================================================
+/**
+ * Check model == reference for every input vector in [0, 2^input_bits).
+ *
+ * Args:
+ *   input_bits:   Width of the packed input vector (<= EQUIV_MAX_INPUT_BITS)
+ *   threads:      Worker threads (each builds its own model and context)
+ *   stop_on_fail: Stop claiming chunks after the first failure
+ *   apply:        (Model &, uint64_t vector) -> sets the model inputs
+ *   read:         (const Model &) -> uint64_t packed outputs
+ *   reference:    (uint64_t vector) -> uint64_t packed expected outputs
+ *
+ * Returns:
+ *   EquivResult (space = 0 if input_bits is out of range)
+ */
+template <class Model, class Apply, class Read, class Reference>
+EquivResult equiv_exhaustive(int input_bits, int threads, bool stop_on_fail,
+                             Apply apply, Read read, Reference reference) {
+    EquivResult result;
+    if (input_bits < 0 || input_bits > EQUIV_MAX_INPUT_BITS) return result;
+
+    const uint64_t space = 1ULL << input_bits;
+    const uint64_t chunk = std::min<uint64_t>(space, 1ULL << EQUIV_CHUNK_BITS);
+    const uint64_t chunks = space / chunk;
+    threads = (int)std::max<uint64_t>(1, std::min<uint64_t>((uint64_t)threads, chunks));
+
+    std::atomic<uint64_t> next_chunk{0};
+    std::atomic<bool> failed{false};
+    std::mutex lock;
+    const auto start = std::chrono::steady_clock::now();
+
+    auto worker = [&]() {
+        VerilatedContext ctx;
+        ctx.quiet(true);
+        Model model(&ctx);
+        uint64_t checked = 0;
+        uint64_t mismatches = 0;
+        std::vector<EquivFailure> failures;
+
+        for (;;) {
+            if (stop_on_fail && failed.load(std::memory_order_relaxed)) break;
+            const uint64_t c = next_chunk.fetch_add(1);
+            if (c >= chunks) break;
+
+            const uint64_t end = (c + 1) * chunk;
+            for (uint64_t base = c * chunk; base < end; base += 64) {
+                const int lanes = (int)std::min<uint64_t>(64, end - base);
+                uint64_t mask = 0;
+                for (int i = 0; i < lanes; i++) {
+                    apply(model, base + i);
+                    model.eval();
+                    mask |= (uint64_t)(read(model) != reference(base + i)) << i;
+                }
+                checked += (uint64_t)lanes;
+                if (!mask) continue;
+
+                // Slow path: re-evaluate the failing lanes for the report
+                mismatches += (uint64_t)__builtin_popcountll(mask);
+                for (; mask && failures.size() < EQUIV_MAX_REPORTED; mask &= mask - 1) {
+                    const uint64_t v = base + (uint64_t)__builtin_ctzll(mask);
+                    apply(model, v);
+                    model.eval();
+                    failures.push_back({v, read(model), reference(v)});
+                }
+                failed = true;
+            }
+        }
+
+        model.final();
+        std::lock_guard<std::mutex> guard(lock);
+        result.checked += checked;
+        result.mismatches += mismatches;
+        result.failures.insert(result.failures.end(), failures.begin(), failures.end());
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++) pool.emplace_back(worker);
+    worker();
+    for (std::thread &t : pool) t.join();
+
+    std::sort(result.failures.begin(), result.failures.end(),
+              [](const EquivFailure &a, const EquivFailure &b) { return a.vector < b.vector; });
+    if (result.failures.size() > EQUIV_MAX_REPORTED) result.failures.resize(EQUIV_MAX_REPORTED);
+    result.space = space;
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+#endif // EQUIV_CHECK_H
@@ -0,0 +1,247 @@
+/**
+ * errstat_tb.sv - Self-Checking Testbench for the Error-Burst Statistics Engine
+ *
+ * Test Strategy:
+ * - Generate a 1M-bit error stream with a 1-tap DFE error-propagation model:
+ *   random errors at P_ERR, and each error repeats on the next bit with
+ *   probability P_PROP (expected 1 / (1 - P_PROP) = 2 errors per burst)
+ * - Slot 7 of a 16 x 4-bit frame gets extra errors (a "weak" slot)
+ * - Push the stream as 64-bit error masks, one word per clock
+ * - Self-check: error count, errors per burst, run-length shape, gap
+ *   clustering (CV^2 > 1) and worst slot
+ * - Checkpoint: save the engine half way, finish the run, restore and
+ *   replay the second half; every statistic must come out identical
+ * - Write the columnar statistics to sim/errstat.errstat
+ *   (view with: python3 scripts/read_errstat.py sim/errstat.errstat)
+ *
+ * Author: Generated for SerDes BER structure analysis
+ * Date: 2025
+ */
+
+`timescale 1ns / 1ps
+
+module errstat_tb #(
+    parameter SIM_TIMEOUT = 200000  // 200us timeout (16384 words @ 100MHz = 164us + margin)
+);
+
+    //==========================================================================
+    // TEST PARAMETERS
+    //==========================================================================
+    localparam int  NUM_WORDS = 16384;          // 1M bits
+    localparam int  P_ERR_PPM = 1000;           // Random error probability (1e-3)
+    localparam int  P_PROP_PPM = 500000;        // DFE propagation probability (0.5)
+    localparam int  P_SLOT_PPM = 20000;         // Extra errors in the weak slot
+    localparam int  BURST_GAP = 2;
+    localparam int  SLOT_BITS = 4;
+    localparam int  NUM_SLOTS = 16;
+    localparam int  WEAK_SLOT = 7;
+    localparam int  CKPT_WORD = NUM_WORDS / 2;  // Checkpoint before this word
+    localparam int  LOG_MB = 1;                 // Log budget (checkpoint size)
+
+    //==========================================================================
+    // DPI-C IMPORTS
+    //==========================================================================
+    import "DPI-C" function chandle dpi_errstat_create(input int burst_gap,
+        input int slot_bits, input int num_slots, input int log_mb);
+    import "DPI-C" function void dpi_errstat_push_word(input chandle h,
+        input longint error_mask, input int nbits);
+    import "DPI-C" function void dpi_errstat_flush(input chandle h);
+    import "DPI-C" function longint dpi_errstat_error_bits(input chandle h);
+    import "DPI-C" function longint dpi_errstat_bursts(input chandle h);
+    import "DPI-C" function real dpi_errstat_mean_errors_per_burst(input chandle h);
+    import "DPI-C" function longint dpi_errstat_run_hist(input chandle h, input int len);
+    import "DPI-C" function real dpi_errstat_gap_cv2(input chandle h);
+    import "DPI-C" function longint dpi_errstat_slot_errors(input chandle h, input int slot);
+    import "DPI-C" function longint dpi_errstat_log_bytes(input chandle h);
+    import "DPI-C" function int  dpi_errstat_write(input chandle h, input string path);
+    import "DPI-C" function int  dpi_errstat_save(input chandle h, input string path);
+    import "DPI-C" function int  dpi_errstat_restore(input chandle h, input string path);
+    import "DPI-C" function void dpi_errstat_destroy(input chandle h);
+
+    //==========================================================================
+    // TESTBENCH SIGNALS
+    //==========================================================================
+    logic        clk;
+    logic [63:0] error_mask;
+    chandle      stats;
+
+    //==========================================================================
+    // VERIFICATION VARIABLES
+    //==========================================================================
+    int     error_count = 0;
+    longint injected = 0;
+    bit     prev_error = 1'b0;
+    real    per_burst;
+    real    cv2;
+    real    run1_frac;
+    longint slot_max;
+    int     worst_slot;
+    logic [63:0] replay[$];                     // Words pushed after the checkpoint
+    longint ckpt_bits;
+    longint final_bits;
+    longint final_bursts;
+    longint final_log;
+
+    //==========================================================================
+    // CLOCK GENERATION
+    //==========================================================================
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    //==========================================================================
+    // VCD WAVEFORM DUMP
+    //==========================================================================
+    initial begin
+        $dumpfile("sim/waves/errstat.vcd");
+        $dumpvars(0, errstat_tb);
+    end
+
+    //==========================================================================
+    // ERROR STREAM MODEL
+    //==========================================================================
+    function automatic logic [63:0] next_word(input longint word_index);
+        logic [63:0] m;
+        int          p;
+        longint      bit_index;
+        m = '0;
+        for (int b = 0; b < 64; b++) begin
+            bit_index = word_index * 64 + b;
+            p = P_ERR_PPM;
+            if (int'((bit_index / SLOT_BITS) % NUM_SLOTS) == WEAK_SLOT) p += P_SLOT_PPM;
+            if (prev_error) p += P_PROP_PPM;
+            prev_error = (($urandom % 1000000) < p);
+            m[b] = prev_error;
+        end
+        return m;
+    endfunction
+
+    //==========================================================================
+    // MAIN TEST SEQUENCE
+    //==========================================================================
+    initial begin
+        $display("========================================");
+        $display("  Error-Burst Statistics Test");
+        $display("========================================");
+        $display("  Bits          : %0d", NUM_WORDS * 64);
+        $display("  P(error)      : %0d ppm, propagation %0d ppm", P_ERR_PPM, P_PROP_PPM);
+        $display("  Frame         : %0d slots x %0d bits, weak slot %0d",
+                 NUM_SLOTS, SLOT_BITS, WEAK_SLOT);
+        $display("========================================");
+
+        void'($urandom(79));
+        error_mask = '0;
+        stats = dpi_errstat_create(BURST_GAP, SLOT_BITS, NUM_SLOTS, LOG_MB);
+        if (stats == null) begin
+            $display("✗ FAIL: dpi_errstat_create returned null");
+            $finish;
+        end
+
+        for (int w = 0; w < NUM_WORDS; w++) begin
+            @(posedge clk);
+            if (w == CKPT_WORD) begin
+                ckpt_bits = dpi_errstat_error_bits(stats);
+                if (dpi_errstat_save(stats, "sim/errstat.ckpt") != 0) begin
+                    $display("  ✗ ERROR: checkpoint not saved");
+                    error_count++;
+                end
+            end
+            error_mask = next_word(longint'(w));
+            injected += longint'($countones(error_mask));
+            dpi_errstat_push_word(stats, error_mask, 64);
+            if (w >= CKPT_WORD) replay.push_back(error_mask);
+        end
+        dpi_errstat_flush(stats);
+
+        per_burst = dpi_errstat_mean_errors_per_burst(stats);
+        cv2 = dpi_errstat_gap_cv2(stats);
+        run1_frac = real'(dpi_errstat_run_hist(stats, 1)) /
+                    real'(dpi_errstat_bursts(stats));
+        slot_max = 0;
+        worst_slot = -1;
+        for (int s = 0; s < NUM_SLOTS; s++) begin
+            if (dpi_errstat_slot_errors(stats, s) > slot_max) begin
+                slot_max = dpi_errstat_slot_errors(stats, s);
+                worst_slot = s;
+            end
+        end
+
+        $display("[%0t ns] Results:", $time);
+        $display("  Error bits        = %0d (injected %0d)", dpi_errstat_error_bits(stats), injected);
+        $display("  Bursts            = %0d", dpi_errstat_bursts(stats));
+        $display("  Errors per burst  = %0.3f (expected ~2)", per_burst);
+        $display("  Single-error runs = %0.3f of bursts (expected ~0.5)", run1_frac);
+        $display("  Gap CV^2          = %0.2f (1.0 = random)", cv2);
+        $display("  Worst slot        = %0d (%0d errors)", worst_slot, slot_max);
+        $display("  Position log      = %0d bytes", dpi_errstat_log_bytes(stats));
+
+        if (dpi_errstat_error_bits(stats) != injected) begin
+            $display("  ✗ ERROR: error count mismatch");
+            error_count++;
+        end
+        if (per_burst < 1.8 || per_burst > 2.3) begin
+            $display("  ✗ ERROR: errors per burst outside [1.8, 2.3]");
+            error_count++;
+        end
+        if (run1_frac < 0.4 || run1_frac > 0.6) begin
+            $display("  ✗ ERROR: single-error run fraction outside [0.4, 0.6]");
+            error_count++;
+        end
+        if (cv2 < 1.5) begin
+            $display("  ✗ ERROR: propagation bursts not detected as clustering");
+            error_count++;
+        end
+        if (worst_slot != WEAK_SLOT) begin
+            $display("  ✗ ERROR: weak slot not identified");
+            error_count++;
+        end
+        if (dpi_errstat_write(stats, "sim/errstat.errstat") <= 0) begin
+            $display("  ✗ ERROR: statistics file not written");
+            error_count++;
+        end
+
+        // Checkpoint round trip: back to word CKPT_WORD, replay the rest
+        final_bits = dpi_errstat_error_bits(stats);
+        final_bursts = dpi_errstat_bursts(stats);
+        final_log = dpi_errstat_log_bytes(stats);
+        if (dpi_errstat_restore(stats, "sim/errstat.ckpt") != 0 ||
+            dpi_errstat_error_bits(stats) != ckpt_bits) begin
+            $display("  ✗ ERROR: checkpoint not restored");
+            error_count++;
+        end
+        foreach (replay[i]) dpi_errstat_push_word(stats, replay[i], 64);
+        dpi_errstat_flush(stats);
+        $display("  Checkpoint        : word %0d, %0d error bits; replayed %0d words",
+                 CKPT_WORD, ckpt_bits, replay.size());
+        if (dpi_errstat_error_bits(stats) != final_bits ||
+            dpi_errstat_bursts(stats) != final_bursts ||
+            dpi_errstat_log_bytes(stats) != final_log ||
+            dpi_errstat_gap_cv2(stats) != cv2) begin
+            $display("  ✗ ERROR: statistics differ after restore + replay");
+            error_count++;
+        end
+        dpi_errstat_destroy(stats);
+
+        $display("");
+        if (error_count == 0) begin
+            $display("========================================");
+            $display("*** PASSED: All tests passed ***");
+            $display("========================================");
+        end else begin
+            $display("========================================");
+            $display("*** FAILED: %0d errors detected ***", error_count);
+            $display("========================================");
+        end
+
+        $finish;
+    end
+
+    //==========================================================================
+    // TIMEOUT WATCHDOG
+    //==========================================================================
+    initial begin
+        #SIM_TIMEOUT;
+        $display("ERROR: Simulation timeout after %0d time units", SIM_TIMEOUT);
+        $finish;
+    end
+
+endmodule
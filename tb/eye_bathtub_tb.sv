@@ -0,0 +1,252 @@
+/**
+ * eye_bathtub_tb.sv - Self-Checking Testbench for Bathtub / Dual-Dirac Analysis
+ *
+ * Test Strategy:
+ * - Known-answer test: feed 400k UIs of edges and eye-center samples with a
+ *   dual-Dirac jitter/noise model (DJ = 0.1 UI, RJ = 0.02 UI RMS; levels
+ *   ±0.4 V ± 0.05 V, noise 20 mV RMS) and compare the fitted RJ/DJ and the
+ *   extrapolated eye width and height at 1e-12 with the closed-form values
+ * - Waveform path: a 32x-oversampled NRZ waveform with jittered linear
+ *   edges goes through dpi_eye_add_waveform(); check crossing detection,
+ *   crossing phase and a sanity range for RJ
+ * - Write bathtub curves to sim/eye_bathtub.csv and the 2D eye to
+ *   sim/eye_histogram.csv
+ *
+ * Author: Generated for SerDes eye / BER analysis
+ * Date: 2025
+ */
+
+`timescale 1ns / 1ps
+
+module eye_bathtub_tb #(
+    parameter SIM_TIMEOUT = 20000  // 20us timeout (400 + 50 blocks @ 100MHz = 4.5us + margin)
+);
+
+    //==========================================================================
+    // TEST PARAMETERS
+    //==========================================================================
+    localparam real UI = 100.0e-12;             // 10 Gb/s
+    localparam int  KAT_BLOCKS = 400;           // x 1000 UIs
+    localparam real DJ = 0.1;                   // Dual-Dirac DJ (UI)
+    localparam real RJ = 0.02;                  // RJ (UI RMS)
+    localparam real CROSS_PHASE = 0.3;          // Crossing phase (UI)
+    localparam real LEVEL = 0.4;                // NRZ level (V)
+    localparam real V_DJ = 0.1;                 // Level dual-Dirac spread (V p-p)
+    localparam real V_NOISE = 0.02;             // Vertical noise (V RMS)
+    localparam real Q_1E12 = 6.8340;            // Q(1e-12 / (0.5 x 0.5)) horizontal
+    localparam real Q_V_1E12 = 6.8340;          // Q(1e-12 / 0.25) vertical
+    localparam int  WAVE_BLOCKS = 50;           // x 200 UIs
+    localparam int  WAVE_UIS = 200;
+    localparam int  SPU = 32;                   // Samples per UI
+    localparam int  WAVE_N = WAVE_UIS * SPU;
+    localparam real WAVE_RJ = 0.015;            // UI RMS
+    localparam real RISE = 0.3;                 // Edge 0-100% time (UI)
+
+    //==========================================================================
+    // DPI-C IMPORTS
+    //==========================================================================
+    import "DPI-C" function chandle dpi_eye_create(input real ui_s, input int time_bins,
+        input real v_min, input real v_max, input int v_bins, input real vref);
+    import "DPI-C" function void dpi_eye_add_waveform(input chandle h,
+        input real v[WAVE_N], input int n, input real t0, input real dt);
+    import "DPI-C" function void dpi_eye_add_sample(input chandle h, input real t, input real v);
+    import "DPI-C" function void dpi_eye_add_edge(input chandle h, input real t);
+    import "DPI-C" function int  dpi_eye_analyze(input chandle h);
+    import "DPI-C" function real dpi_eye_center_phase(input chandle h);
+    import "DPI-C" function real dpi_eye_rj(input chandle h);
+    import "DPI-C" function real dpi_eye_dj(input chandle h);
+    import "DPI-C" function real dpi_eye_width(input chandle h, input real ber);
+    import "DPI-C" function real dpi_eye_height(input chandle h, input real ber);
+    import "DPI-C" function longint dpi_eye_crossings(input chandle h);
+    import "DPI-C" function int  dpi_eye_write_bathtub(input chandle h, input string path);
+    import "DPI-C" function int  dpi_eye_write_histogram(input chandle h, input string path);
+    import "DPI-C" function void dpi_eye_destroy(input chandle h);
+
+    //==========================================================================
+    // TESTBENCH SIGNALS
+    //==========================================================================
+    logic clk;
+
+    //==========================================================================
+    // VERIFICATION VARIABLES
+    //==========================================================================
+    int  error_count = 0;
+    real wave[WAVE_N];
+    int  bits[WAVE_UIS + 2];
+    real jit[WAVE_UIS + 2];
+
+    //==========================================================================
+    // CLOCK GENERATION
+    //==========================================================================
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    //==========================================================================
+    // VCD WAVEFORM DUMP
+    //==========================================================================
+    initial begin
+        $dumpfile("sim/waves/eye_bathtub.vcd");
+        $dumpvars(0, eye_bathtub_tb);
+    end
+
+    //==========================================================================
+    // HELPERS
+    //==========================================================================
+    function automatic real urand();
+        return (real'($urandom % 1000000) + 1.0) / 1000001.0;
+    endfunction
+
+    function automatic real gauss();
+        return $sqrt(-2.0 * $ln(urand())) * $cos(2.0 * 3.14159265358979 * urand());
+    endfunction
+
+    function automatic real pm(input real a);
+        return ($urandom % 2 == 0) ? a : -a;
+    endfunction
+
+    task automatic check_range(input string name, input real value, input real expected,
+                               input real tol);
+        $display("  %-16s = %9.5f (expected %9.5f ± %0.4f)", name, value, expected, tol);
+        if (value > expected + tol || value < expected - tol) begin
+            $display("  ✗ ERROR: %s out of range", name);
+            error_count++;
+        end
+    endtask
+
+    //==========================================================================
+    // TEST: DUAL-DIRAC KNOWN ANSWER
+    //==========================================================================
+    task automatic test_known_answer();
+        chandle eye;
+        real    t;
+        real    width_exp;
+        real    height_exp;
+
+        eye = dpi_eye_create(UI, 64, -1.0, 1.0, 1024, 0.0);
+        for (int blk = 0; blk < KAT_BLOCKS; blk++) begin
+            @(posedge clk);
+            for (int i = 0; i < 1000; i++) begin
+                t = real'(blk * 1000 + i);
+                if ($urandom % 2 == 0)
+                    dpi_eye_add_edge(eye, (t + CROSS_PHASE + pm(DJ / 2.0) + RJ * gauss()) * UI);
+                dpi_eye_add_sample(eye, (t + CROSS_PHASE + 0.501) * UI,
+                                   pm(LEVEL) + pm(V_DJ / 2.0) + V_NOISE * gauss());
+            end
+        end
+        void'(dpi_eye_analyze(eye));
+
+        width_exp = 1.0 - DJ - 2.0 * Q_1E12 * RJ;
+        height_exp = 2.0 * (LEVEL - V_DJ / 2.0 - Q_V_1E12 * V_NOISE);
+        $display("[%0t ns] Dual-Dirac known answer (%0d UIs, %0d crossings)", $time,
+                 KAT_BLOCKS * 1000, dpi_eye_crossings(eye));
+        check_range("Crossing phase", dpi_eye_center_phase(eye), CROSS_PHASE, 0.005);
+        check_range("RJ (UI)", dpi_eye_rj(eye), RJ, 0.002);
+        check_range("DJ (UI)", dpi_eye_dj(eye), DJ, 0.015);
+        check_range("Width@1e-12 (UI)", dpi_eye_width(eye, 1.0e-12), width_exp, 0.02);
+        check_range("Height@1e-12 (V)", dpi_eye_height(eye, 1.0e-12), height_exp, 0.025);
+        $display("  Width@1e-15 (UI)  = %9.5f", dpi_eye_width(eye, 1.0e-15));
+        if (dpi_eye_width(eye, 1.0e-15) >= dpi_eye_width(eye, 1.0e-12)) begin
+            $display("  ✗ ERROR: eye must close further at 1e-15");
+            error_count++;
+        end
+        if (dpi_eye_write_bathtub(eye, "sim/eye_bathtub.csv") != 0) error_count++;
+        dpi_eye_destroy(eye);
+    endtask
+
+    //==========================================================================
+    // TEST: WAVEFORM PATH
+    //==========================================================================
+    task automatic test_waveform();
+        chandle eye;
+        longint transitions = 0;
+        int     k;
+        real    f;
+        real    b;
+        real    u;
+
+        eye = dpi_eye_create(UI, 64, -1.0, 1.0, 512, 0.0);
+        bits[WAVE_UIS] = 0;
+        bits[WAVE_UIS + 1] = int'($urandom % 2);
+        jit[WAVE_UIS + 1] = WAVE_RJ * gauss();
+        for (int blk = 0; blk < WAVE_BLOCKS; blk++) begin
+            @(posedge clk);
+            // Bit i occupies UI [i-1, i); boundary k (bits k-1 → k) sits at
+            // UI k-1+jit[k]. The last two bits run into the next block.
+            bits[0] = bits[WAVE_UIS];
+            bits[1] = bits[WAVE_UIS + 1];
+            jit[1] = jit[WAVE_UIS + 1];
+            for (int i = 2; i <= WAVE_UIS + 1; i++) begin
+                bits[i] = int'($urandom % 2);
+                jit[i] = WAVE_RJ * gauss();
+            end
+            for (int i = 1; i <= WAVE_UIS; i++) begin
+                if (blk > 0 || i > 1) transitions += (bits[i] != bits[i - 1]) ? 1 : 0;
+            end
+            // Each sample follows its nearest boundary
+            for (int n = 0; n < WAVE_N; n++) begin
+                u = real'(n) / real'(SPU);
+                k = int'($floor(u + 0.5)) + 1;
+                b = real'(k - 1) + jit[k];
+                f = (u - b) / RISE + 0.5;
+                f = (f < 0.0) ? 0.0 : ((f > 1.0) ? 1.0 : f);
+                wave[n] = LEVEL * (2.0 * (real'(bits[k - 1]) + (real'(bits[k]) -
+                          real'(bits[k - 1])) * f) - 1.0);
+            end
+            dpi_eye_add_waveform(eye, wave, WAVE_N, real'(blk * WAVE_UIS) * UI, UI / SPU);
+        end
+
+        $display("[%0t ns] Waveform path (%0d UIs at %0dx oversampling)", $time,
+                 WAVE_BLOCKS * WAVE_UIS, SPU);
+        $display("  Crossings        = %0d (transitions %0d)", dpi_eye_crossings(eye), transitions);
+        // Only the very first boundary of the run may be missed or added
+        if (dpi_eye_crossings(eye) > transitions + 1 || dpi_eye_crossings(eye) < transitions - 1) begin
+            $display("  ✗ ERROR: crossing count mismatch");
+            error_count++;
+        end
+        void'(dpi_eye_analyze(eye));
+        // Crossings sit at phase 0 (wraps to ~1.0)
+        f = dpi_eye_center_phase(eye);
+        check_range("Crossing phase", (f > 0.5) ? f - 1.0 : f, 0.0, 0.005);
+        // ~5k crossings only resolve the tail to ~1e-3: sanity range for RJ
+        // (the known-answer test covers fit accuracy)
+        check_range("RJ (UI)", dpi_eye_rj(eye), WAVE_RJ, 0.5 * WAVE_RJ);
+        if (dpi_eye_write_histogram(eye, "sim/eye_histogram.csv") != 0) error_count++;
+        dpi_eye_destroy(eye);
+    endtask
+
+    //==========================================================================
+    // MAIN TEST SEQUENCE
+    //==========================================================================
+    initial begin
+        $display("========================================");
+        $display("  Bathtub / Dual-Dirac Analysis Test");
+        $display("========================================");
+
+        void'($urandom(81));
+        test_known_answer();
+        test_waveform();
+
+        $display("");
+        if (error_count == 0) begin
+            $display("========================================");
+            $display("*** PASSED: All tests passed ***");
+            $display("========================================");
+        end else begin
+            $display("========================================");
+            $display("*** FAILED: %0d errors detected ***", error_count);
+            $display("========================================");
+        end
+
+        $finish;
+    end
+
+    //==========================================================================
+    // TIMEOUT WATCHDOG
+    //==========================================================================
+    initial begin
+        #SIM_TIMEOUT;
+        $display("ERROR: Simulation timeout after %0d time units", SIM_TIMEOUT);
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,267 @@
+/**
+ * eye_mask_tb.sv - Self-Checking Testbench for Polygon Eye-Mask Compliance
+ *
+ * Test Strategy:
+ * - A 32x-oversampled NRZ waveform (±0.4 V, 0.3 UI edges, 0.01 UI RMS
+ *   jitter) with its crossings at 0.2 UI phase feeds two eye engines
+ * - Engine 1: hexagon mask (from the SV side) plus amplitude limits above
+ *   +0.5 V / below -0.5 V (from a mask file); after auto-alignment to the
+ *   eye center the mask must see zero hits; check the margin search
+ *   (geometry limit: +66.7%) and that a 1e-3 hit ratio allows more margin
+ * - Engine 1, shifted mask: a hexagon offset by +0.2 UI hits the
+ *   crossings; alignment search must find a shift with zero hits
+ * - Engine 2: an oversized mask installed before any data; hits counted
+ *   incrementally per sample must equal a full recount from the histogram
+ * - Rejected mask file: a valid polygon followed by a 2-vertex one must
+ *   fail to load and leave no polygon behind
+ *
+ * Author: Generated for SerDes eye / BER analysis
+ * Date: 2025
+ */
+
+`timescale 1ns / 1ps
+
+module eye_mask_tb #(
+    parameter SIM_TIMEOUT = 10000  // 10us timeout (50 blocks @ 100MHz = 0.5us + margin)
+);
+
+    //==========================================================================
+    // TEST PARAMETERS
+    //==========================================================================
+    localparam real UI = 100.0e-12;             // 10 Gb/s
+    localparam int  BLOCKS = 50;                // x 200 UIs
+    localparam int  UIS = 200;
+    localparam int  SPU = 32;                   // Samples per UI
+    localparam int  N = UIS * SPU;
+    localparam real RJ = 0.01;                  // UI RMS
+    localparam real RISE = 0.3;                 // Edge 0-100% time (UI)
+    localparam real LEVEL = 0.4;                // V
+    localparam real PHASE = 0.2;                // Crossing phase (UI)
+    localparam int  VERTS = 6;
+
+    //==========================================================================
+    // DPI-C IMPORTS
+    //==========================================================================
+    import "DPI-C" function chandle dpi_eye_create(input real ui_s, input int time_bins,
+        input real v_min, input real v_max, input int v_bins, input real vref);
+    import "DPI-C" function void dpi_eye_add_waveform(input chandle h,
+        input real v[N], input int n, input real t0, input real dt);
+    import "DPI-C" function real dpi_eye_center_phase(input chandle h);
+    import "DPI-C" function int  dpi_eye_mask_add_polygon(input chandle h,
+        input real x_ui[VERTS], input real v[VERTS], input int n);
+    import "DPI-C" function int  dpi_eye_mask_load(input chandle h, input string path);
+    import "DPI-C" function void dpi_eye_mask_clear(input chandle h);
+    import "DPI-C" function longint dpi_eye_mask_align(input chandle h, input real search_ui);
+    import "DPI-C" function longint dpi_eye_mask_recount(input chandle h);
+    import "DPI-C" function longint dpi_eye_mask_hits(input chandle h);
+    import "DPI-C" function longint dpi_eye_mask_polygon_hits(input chandle h, input int i);
+    import "DPI-C" function real dpi_eye_mask_offset(input chandle h);
+    import "DPI-C" function real dpi_eye_mask_margin(input chandle h, input real max_hit_ratio);
+    import "DPI-C" function void dpi_eye_destroy(input chandle h);
+
+    //==========================================================================
+    // TESTBENCH SIGNALS
+    //==========================================================================
+    logic clk;
+
+    //==========================================================================
+    // VERIFICATION VARIABLES
+    //==========================================================================
+    int     error_count = 0;
+    chandle eye;
+    chandle eye_big;
+    chandle eye_bad;
+    real    wave[N];
+    int     bits[UIS + 2];
+    real    jit[UIS + 2];
+    real    hex_x[VERTS] = '{-0.3, -0.15, 0.15, 0.3, 0.15, -0.15};
+    real    hex_v[VERTS] = '{0.0, 0.15, 0.15, 0.0, -0.15, -0.15};
+    real    big_x[VERTS] = '{-0.5, -0.25, 0.25, 0.5, 0.25, -0.25};
+    real    big_v[VERTS] = '{0.0, 0.3, 0.3, 0.0, -0.3, -0.3};
+    real    poly_x[VERTS];
+
+    //==========================================================================
+    // CLOCK GENERATION
+    //==========================================================================
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    //==========================================================================
+    // VCD WAVEFORM DUMP
+    //==========================================================================
+    initial begin
+        $dumpfile("sim/waves/eye_mask.vcd");
+        $dumpvars(0, eye_mask_tb);
+    end
+
+    //==========================================================================
+    // HELPERS
+    //==========================================================================
+    function automatic real urand();
+        return (real'($urandom % 1000000) + 1.0) / 1000001.0;
+    endfunction
+
+    function automatic real gauss();
+        return $sqrt(-2.0 * $ln(urand())) * $cos(2.0 * 3.14159265358979 * urand());
+    endfunction
+
+    task automatic check(input string name, input bit ok);
+        if (ok) begin
+            $display("  ✓ %s", name);
+        end else begin
+            $display("  ✗ ERROR: %s", name);
+            error_count++;
+        end
+    endtask
+
+    // Amplitude limits in the mask file format
+    task automatic write_outer_mask(input string path);
+        int fd;
+        fd = $fopen(path, "w");
+        $fdisplay(fd, "# Amplitude limits: |v| must stay below 0.5 V");
+        $fdisplay(fd, "polygon");
+        $fdisplay(fd, "-0.5 0.5\n0.5 0.5\n0.5 1.0\n-0.5 1.0");
+        $fdisplay(fd, "polygon");
+        $fdisplay(fd, "-0.5 -0.5\n0.5 -0.5\n0.5 -1.0\n-0.5 -1.0");
+        $fclose(fd);
+    endtask
+
+    // Valid first polygon, invalid (2-vertex) second one
+    task automatic write_bad_mask(input string path);
+        int fd;
+        fd = $fopen(path, "w");
+        $fdisplay(fd, "polygon");
+        $fdisplay(fd, "-0.5 0.5\n0.5 0.5\n0.5 1.0\n-0.5 1.0");
+        $fdisplay(fd, "polygon");
+        $fdisplay(fd, "-0.5 -0.5\n0.5 -0.5");
+        $fclose(fd);
+    endtask
+
+    //==========================================================================
+    // STIMULUS: JITTERED NRZ WAVEFORM
+    //==========================================================================
+    task automatic run_waveform();
+        int  k;
+        real f;
+        real b;
+        real u;
+
+        bits[UIS] = 0;
+        bits[UIS + 1] = int'($urandom % 2);
+        jit[UIS + 1] = RJ * gauss();
+        for (int blk = 0; blk < BLOCKS; blk++) begin
+            @(posedge clk);
+            // Boundary k (bits k-1 → k) at UI k-1+PHASE+jit[k]; each sample
+            // follows its nearest boundary
+            bits[0] = bits[UIS];
+            bits[1] = bits[UIS + 1];
+            jit[1] = jit[UIS + 1];
+            for (int i = 2; i <= UIS + 1; i++) begin
+                bits[i] = int'($urandom % 2);
+                jit[i] = RJ * gauss();
+            end
+            for (int n = 0; n < N; n++) begin
+                u = real'(n) / real'(SPU);
+                k = int'($floor(u - PHASE + 0.5)) + 1;
+                b = real'(k - 1) + PHASE + jit[k];
+                f = (u - b) / RISE + 0.5;
+                f = (f < 0.0) ? 0.0 : ((f > 1.0) ? 1.0 : f);
+                wave[n] = LEVEL * (2.0 * (real'(bits[k - 1]) + (real'(bits[k]) -
+                          real'(bits[k - 1])) * f) - 1.0);
+            end
+            dpi_eye_add_waveform(eye, wave, N, real'(blk * UIS) * UI, UI / SPU);
+            dpi_eye_add_waveform(eye_big, wave, N, real'(blk * UIS) * UI, UI / SPU);
+        end
+    endtask
+
+    //==========================================================================
+    // MAIN TEST SEQUENCE
+    //==========================================================================
+    initial begin
+        longint hits;
+        longint recount;
+        real    margin;
+
+        $display("========================================");
+        $display("  Eye Mask Compliance Test");
+        $display("========================================");
+
+        void'($urandom(83));
+        eye = dpi_eye_create(UI, 64, -1.0, 1.0, 512, 0.0);
+        eye_big = dpi_eye_create(UI, 64, -1.0, 1.0, 512, 0.0);
+        write_outer_mask("sim/eye_mask.txt");
+        check("hexagon mask added", dpi_eye_mask_add_polygon(eye, hex_x, hex_v, VERTS) == 0);
+        check("mask file loaded (2 polygons)", dpi_eye_mask_load(eye, "sim/eye_mask.txt") == 2);
+        check("oversized mask added", dpi_eye_mask_add_polygon(eye_big, big_x, big_v, VERTS) == 0);
+
+        run_waveform();
+
+        // Test 1: compliant mask after auto-alignment
+        $display("[%0t ns] Compliant mask (eye center at %0.3f UI)", $time,
+                 dpi_eye_center_phase(eye) + 0.5);
+        $display("  Hits: hexagon %0d, upper %0d, lower %0d", dpi_eye_mask_polygon_hits(eye, 0),
+                 dpi_eye_mask_polygon_hits(eye, 1), dpi_eye_mask_polygon_hits(eye, 2));
+        check("zero mask hits", dpi_eye_mask_hits(eye) == 0);
+        margin = dpi_eye_mask_margin(eye, 0.0);
+        $display("  Margin (zero hits)  = %0.2f%%", margin);
+        check("margin within geometry limit", margin > 40.0 && margin < 66.7);
+        $display("  Margin (ratio 1e-3) = %0.2f%%", dpi_eye_mask_margin(eye, 1.0e-3));
+        check("hit-ratio margin >= zero-hit margin", dpi_eye_mask_margin(eye, 1.0e-3) >= margin);
+
+        // Test 2: misplaced mask, alignment search
+        for (int i = 0; i < VERTS; i++) poly_x[i] = hex_x[i] + 0.2;
+        dpi_eye_mask_clear(eye);
+        void'(dpi_eye_mask_add_polygon(eye, poly_x, hex_v, VERTS));
+        hits = dpi_eye_mask_hits(eye);
+        $display("[%0t ns] Mask shifted by +0.2 UI: %0d hits", $time, hits);
+        check("shifted mask hits the crossing", hits > 0);
+        hits = dpi_eye_mask_align(eye, 0.25);
+        $display("  Aligned: %0d hits at offset %0.4f UI", hits, dpi_eye_mask_offset(eye));
+        check("alignment search clears the mask", hits == 0 && dpi_eye_mask_offset(eye) < 0.0 &&
+              dpi_eye_mask_offset(eye) > -0.2);
+
+        // Test 3: incremental counting vs recount
+        hits = dpi_eye_mask_hits(eye_big);
+        recount = dpi_eye_mask_recount(eye_big);
+        $display("[%0t ns] Oversized mask: %0d hits incremental, %0d recounted", $time,
+                 hits, recount);
+        check("incremental hits match recount", hits > 0 && hits == recount);
+        check("negative margin", dpi_eye_mask_margin(eye_big, 0.0) < 0.0);
+
+        // Test 4: a file that fails validation leaves the mask unchanged
+        write_bad_mask("sim/eye_mask_bad.txt");
+        eye_bad = dpi_eye_create(UI, 64, -1.0, 1.0, 512, 0.0);
+        $display("[%0t ns] Mask file with an invalid polygon", $time);
+        check("invalid mask file rejected",
+              dpi_eye_mask_load(eye_bad, "sim/eye_mask_bad.txt") == -1);
+        check("no polygon left behind",
+              dpi_eye_mask_add_polygon(eye_bad, hex_x, hex_v, VERTS) == 0);
+
+        dpi_eye_destroy(eye);
+        dpi_eye_destroy(eye_big);
+        dpi_eye_destroy(eye_bad);
+
+        $display("");
+        if (error_count == 0) begin
+            $display("========================================");
+            $display("*** PASSED: All tests passed ***");
+            $display("========================================");
+        end else begin
+            $display("========================================");
+            $display("*** FAILED: %0d errors detected ***", error_count);
+            $display("========================================");
+        end
+
+        $finish;
+    end
+
+    //==========================================================================
+    // TIMEOUT WATCHDOG
+    //==========================================================================
+    initial begin
+        #SIM_TIMEOUT;
+        $display("ERROR: Simulation timeout after %0d time units", SIM_TIMEOUT);
+        $finish;
+    end
+
+endmodule
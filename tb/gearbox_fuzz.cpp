@@ -0,0 +1,753 @@
+/**
+ * gearbox_fuzz.cpp - Coverage-Guided Fuzzer: gearbox_link RTL vs Golden Model
+ *
+ * Runs the Verilated gearbox_link (rtl/gearbox_link.sv + dpi/dpi_gearbox.cpp)
+ * and an independent bit-queue golden model side by side in one process.
+ * Each input is a sequence of clock-level operations (TX edges with words,
+ * RX edges with slip, reset changes, bursts); after every RX edge and reset
+ * change the RTL outputs must equal the golden model's.
+ *
+ * Fixed regressions stream rate-matched PRBS words, which never reach the
+ * corners: the FIFO saturating (pushes dropped at 64 Kbit), slips on an
+ * empty or partial-symbol queue, PAM4 pops stalled on half a symbol, a
+ * reset with data queued (which must be discarded). The fuzzer steers towards them:
+ *
+ * - Feedback: Verilator coverage counters (line / user points of the
+ *   model, read from the symbol table after each run, bucketed by hit
+ *   count) plus golden-model state features (FIFO fill per log2 bucket,
+ *   drops, slips on short queues, stalls, reset with data)
+ * - Mutation: word bit flips and special words, flag flips, op insert /
+ *   delete / duplicate, burst lengths (x2, /2, random), splicing with
+ *   another corpus entry
+ * - Parallel: N worker threads, each with its own VerilatedContext and
+ *   model per execution, sharing the corpus and the feature map
+ * - Corpus and mismatching inputs are saved as files; --replay re-runs one
+ *   with a per-operation trace
+ *
+ * Build (parameters must match the -D values; defaults 20:32 PAM4 Gray):
+ *   verilator --cc --exe --build -O3 -j 0 --coverage-line --coverage-user \
+ *     --top-module gearbox_link -GTX_WIDTH=20 -GRX_WIDTH=32 -GPAM_LEVELS=4 -GGRAY=1 \
+ *     -CFLAGS "-O2 -std=c++17 -DFUZZ_TX_WIDTH=20 -DFUZZ_RX_WIDTH=32 -DFUZZ_PAM=4" \
+ *     -LDFLAGS -pthread -Mdir sim/obj_dir_fuzz \
+ *     rtl/gearbox_link.sv tb/gearbox_fuzz.cpp dpi/dpi_gearbox.cpp
+ *
+ * Run (the engine reports every dropped push on stderr):
+ *   sim/obj_dir_fuzz/Vgearbox_link --threads 8 --time 600 --corpus sim/fuzz/gearbox 2>/dev/null
+ *   sim/obj_dir_fuzz/Vgearbox_link --replay sim/fuzz/gearbox/mismatch_0.bin
+ *
+ * Author: Generated for SerDes parallel/serial conversion
+ * Date: 2025
+ */
+
+#include <verilated.h>
+#include "Vgearbox_link.h"
+#if VM_COVERAGE
+#include "Vgearbox_link__Syms.h"
+#include "Vgearbox_link___024root.h"
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//==============================================================================
+// CONFIGURATION
+//==============================================================================
+#ifndef FUZZ_TX_WIDTH
+#define FUZZ_TX_WIDTH   20              // Must match -GTX_WIDTH
+#endif
+#ifndef FUZZ_RX_WIDTH
+#define FUZZ_RX_WIDTH   32              // Must match -GRX_WIDTH
+#endif
+#ifndef FUZZ_PAM
+#define FUZZ_PAM        4               // Must match -GPAM_LEVELS (SER stays 0)
+#endif
+#ifndef FUZZ_MSB_FIRST
+#define FUZZ_MSB_FIRST  0               // Must match -GMSB_FIRST
+#endif
+
+#define FIFO_BITS       65536ULL        // dpi_gearbox.cpp GB_FIFO_BITS
+#define MAX_OPS         4096            // Operations per input
+#define MAX_STEPS       (1 << 17)       // Operations per execution, bursts expanded
+#define MAX_BURST       4096
+#define HIT_BUCKETS     8               // Coverage count buckets per point
+#define FILE_MAGIC      0x5A464247u     // "GBFZ"
+
+static const int BPS = (FUZZ_PAM == 4) ? 2 : 1;
+
+//==============================================================================
+// INPUT FORMAT
+//==============================================================================
+enum OpKind : uint8_t {
+    OP_TX = 0,                          // tx_clk edge: tx_valid = flag, tx_word = data
+    OP_RX = 1,                          // rx_clk edge: slip = flag
+    OP_RST = 2,                         // rst_n = flag (asynchronous on the RX side)
+    OP_KINDS = 3
+};
+
+struct Op {
+    uint8_t kind;
+    uint8_t flag;
+    uint16_t repeat;                    // Burst: the op is applied repeat times (>= 1)
+    uint64_t data;
+};
+
+typedef std::vector<Op> Input;
+
+static inline uint64_t width_mask(int k) {
+    return (k >= 64) ? ~0ULL : ((1ULL << k) - 1);
+}
+
+//==============================================================================
+// GOLDEN MODEL
+//==============================================================================
+/**
+ * Bit-queue model of gearbox_link with SER = 0, written from the interface
+ * contract rather than the engine: one deque entry per serial bit.
+ */
+struct GoldenGearbox {
+    std::deque<uint8_t> bits;
+    uint64_t pushed = 0;                // Absolute tail (bits ever pushed)
+    bool rst_n = false;
+    bool rx_valid = false;
+    uint64_t rx_word = 0;
+
+    // State features seen during this execution
+    bool dropped = false;
+    bool slip_empty = false;
+    bool slip_partial = false;          // Slip with less than one symbol queued
+    bool stall_partial = false;         // Pop refused only because a symbol is incomplete
+    bool reset_with_data = false;
+    bool tx_in_reset = false;
+    bool rx_in_reset = false;
+    uint32_t fill_seen = 0;             // Bit b: queue size had log2 bucket b
+    uint32_t run_seen = 0;              // Bit b: valid-word run length had log2 bucket b
+    uint64_t run = 0;
+
+    void note_fill() {
+        const uint64_t n = bits.size();
+        int b = 0;
+        while (b < 31 && (1ULL << b) <= n) b++;
+        fill_seen |= 1u << b;
+    }
+
+    void tx_edge(bool valid, uint64_t word) {
+        if (!rst_n) {
+            tx_in_reset |= valid;
+            return;
+        }
+        if (!valid) return;
+        if (bits.size() + FUZZ_TX_WIDTH > FIFO_BITS) {
+            dropped = true;             // Engine rejects the push, RTL ignores it
+            return;
+        }
+        for (int i = 0; i < FUZZ_TX_WIDTH; i++) {
+            const int b = FUZZ_MSB_FIRST ? FUZZ_TX_WIDTH - 1 - i : i;
+            bits.push_back((uint8_t)((word >> b) & 1));
+        }
+        pushed += FUZZ_TX_WIDTH;
+        note_fill();
+    }
+
+    void rx_edge(bool slip) {
+        if (!rst_n) {
+            rx_in_reset = true;
+            rx_valid = false;
+            rx_word = 0;
+            return;
+        }
+        if (slip) {
+            slip_empty |= bits.empty();
+            slip_partial |= !bits.empty() && bits.size() < (size_t)BPS;
+            if (!bits.empty()) bits.pop_front();
+        }
+        // Only whole symbols can be popped: the partial symbol at the tail
+        // is not available yet
+        const uint64_t partial = pushed % BPS;
+        const uint64_t avail = (bits.size() > partial) ? bits.size() - partial : 0;
+        if (avail < (uint64_t)FUZZ_RX_WIDTH) {
+            stall_partial |= bits.size() >= (size_t)FUZZ_RX_WIDTH;
+            rx_valid = false;
+            rx_word = 0;
+            if (run) run_seen |= 1u << std::min(31, 63 - __builtin_clzll(run));
+            run = 0;
+        } else {
+            uint64_t w = 0;
+            for (int i = 0; i < FUZZ_RX_WIDTH; i++) {
+                const int b = FUZZ_MSB_FIRST ? FUZZ_RX_WIDTH - 1 - i : i;
+                w |= (uint64_t)bits.front() << b;
+                bits.pop_front();
+            }
+            rx_valid = true;
+            rx_word = w;
+            run++;
+        }
+        note_fill();
+    }
+
+    void set_reset(bool value) {
+        if (!value && rst_n) {
+            reset_with_data |= !bits.empty();
+            // Asserting rst_n empties the queue, partial symbol included
+            bits.clear();
+            pushed = 0;
+            // Asynchronous RX reset
+            rx_valid = false;
+            rx_word = 0;
+        }
+        rst_n = value;
+    }
+};
+
+//==============================================================================
+// FEATURE MAP
+//==============================================================================
+// Golden-model features follow the coverage points:
+//   [0, 32) fill buckets, [32, 64) run buckets, then 7 single flags
+#define MODEL_FEATURES  71
+
+struct FeatureMap {
+    std::mutex lock;
+    std::vector<uint8_t> seen;
+    size_t cover_points = 0;
+    size_t count = 0;
+
+    void init(size_t points) {
+        cover_points = points;
+        seen.assign(points * HIT_BUCKETS + MODEL_FEATURES, 0);
+    }
+
+    /** Marks the features; returns how many were new. */
+    size_t merge(const std::vector<uint32_t> &features) {
+        std::lock_guard<std::mutex> guard(lock);
+        size_t fresh = 0;
+        for (uint32_t f : features) {
+            if (!seen[f]) {
+                seen[f] = 1;
+                fresh++;
+            }
+        }
+        count += fresh;
+        return fresh;
+    }
+};
+
+/** AFL-style hit-count bucket: 1, 2, 3, 4-7, 8-15, 16-31, 32-127, 128+ */
+static inline int hit_bucket(uint32_t n) {
+    if (n <= 3) return (int)n - 1;
+    if (n < 8) return 3;
+    if (n < 16) return 4;
+    if (n < 32) return 5;
+    if (n < 128) return 6;
+    return 7;
+}
+
+static void model_features(const GoldenGearbox &g, size_t base, std::vector<uint32_t> &out) {
+    for (int b = 0; b < 32; b++) {
+        if (g.fill_seen & (1u << b)) out.push_back((uint32_t)(base + b));
+        if (g.run_seen & (1u << b)) out.push_back((uint32_t)(base + 32 + b));
+    }
+    const bool flags[7] = {g.dropped, g.slip_empty, g.slip_partial, g.stall_partial,
+                           g.reset_with_data, g.tx_in_reset, g.rx_in_reset};
+    for (int i = 0; i < 7; i++) {
+        if (flags[i]) out.push_back((uint32_t)(base + 64 + i));
+    }
+}
+
+//==============================================================================
+// EXECUTION
+//==============================================================================
+struct ExecResult {
+    bool mismatch = false;
+    size_t step = 0;                    // Expanded step of the first mismatch
+    uint64_t rtl_word = 0, gold_word = 0;
+    bool rtl_valid = false, gold_valid = false;
+    std::vector<uint32_t> features;
+};
+
+#if VM_COVERAGE
+static inline size_t cover_point_count(Vgearbox_link *top) {
+    return sizeof(top->rootp->vlSymsp->__Vcoverage) / sizeof(uint32_t);
+}
+#else
+static inline size_t cover_point_count(Vgearbox_link *) {
+    return 0;
+}
+#endif
+
+/** Number of coverage points of the model (one throwaway instance). */
+static size_t model_cover_points() {
+    VerilatedContext ctx;
+    ctx.quiet(true);
+    Vgearbox_link top(&ctx);
+    const size_t n = cover_point_count(&top);
+    top.final();
+    return n;
+}
+
+/**
+ * Runs one input on a fresh model and a fresh golden model.
+ *
+ * Args:
+ *   in:    Operation sequence
+ *   trace: Print every step (replay)
+ */
+static ExecResult execute(const Input &in, bool trace) {
+    ExecResult r;
+    VerilatedContext ctx;
+    ctx.quiet(true);
+    Vgearbox_link top(&ctx);
+    GoldenGearbox gold;
+
+    auto eval = [&]() {
+        top.eval();
+        ctx.timeInc(1);
+    };
+    auto compare = [&](size_t step) {
+        const uint64_t rtl = (uint64_t)top.rx_word & width_mask(FUZZ_RX_WIDTH);
+        if (trace) {
+            printf("  step %6zu: rtl %d %016llx  golden %d %016llx  queued %zu\n", step,
+                   (int)top.rx_valid, (unsigned long long)rtl, (int)gold.rx_valid,
+                   (unsigned long long)gold.rx_word, gold.bits.size());
+        }
+        if (!r.mismatch && ((bool)top.rx_valid != gold.rx_valid || rtl != gold.rx_word)) {
+            r.mismatch = true;
+            r.step = step;
+            r.rtl_valid = top.rx_valid;
+            r.rtl_word = rtl;
+            r.gold_valid = gold.rx_valid;
+            r.gold_word = gold.rx_word;
+        }
+    };
+
+    // Reset, then release: the engine is created by the first eval
+    top.tx_clk = 0;
+    top.rx_clk = 0;
+    top.rst_n = 0;
+    top.tx_valid = 0;
+    top.slip = 0;
+    eval();
+    top.rst_n = 1;
+    gold.set_reset(true);
+    eval();
+
+    size_t step = 0;
+    for (const Op &op : in) {
+        for (int k = 0; k < std::max<int>(1, op.repeat) && step < MAX_STEPS && !r.mismatch;
+             k++, step++) {
+            switch (op.kind) {
+            case OP_TX:
+                top.tx_valid = op.flag & 1;
+                top.tx_word = op.data & width_mask(FUZZ_TX_WIDTH);
+                top.tx_clk = 1;
+                eval();
+                top.tx_clk = 0;
+                eval();
+                gold.tx_edge(op.flag & 1, op.data & width_mask(FUZZ_TX_WIDTH));
+                break;
+            case OP_RX:
+                top.slip = op.flag & 1;
+                top.rx_clk = 1;
+                eval();
+                top.rx_clk = 0;
+                top.slip = 0;
+                eval();
+                gold.rx_edge(op.flag & 1);
+                compare(step);
+                break;
+            default:
+                top.rst_n = op.flag & 1;
+                eval();
+                gold.set_reset(op.flag & 1);
+                compare(step);
+                break;
+            }
+        }
+    }
+
+#if VM_COVERAGE
+    const uint32_t *counts = top.rootp->vlSymsp->__Vcoverage;
+    const size_t points = cover_point_count(&top);
+    for (size_t i = 0; i < points; i++) {
+        if (counts[i]) r.features.push_back((uint32_t)(i * HIT_BUCKETS + hit_bucket(counts[i])));
+    }
+#else
+    const size_t points = 0;
+#endif
+    model_features(gold, points * HIT_BUCKETS, r.features);
+    top.final();
+    return r;
+}
+
+//==============================================================================
+// MUTATION
+//==============================================================================
+struct Rng {
+    uint64_t s;
+    explicit Rng(uint64_t seed) : s(seed ? seed : 0x9E3779B97F4A7C15ULL) {}
+    uint64_t next() {
+        // xorshift64*
+        s ^= s >> 12;
+        s ^= s << 25;
+        s ^= s >> 27;
+        return s * 0x2545F4914F6CDD1DULL;
+    }
+    uint32_t below(uint32_t n) { return (uint32_t)(next() % n); }
+};
+
+static const uint64_t SPECIAL_WORDS[] = {
+    0x0ULL, ~0ULL, 0x5555555555555555ULL, 0xAAAAAAAAAAAAAAAAULL,
+    0x3333333333333333ULL, 0xCCCCCCCCCCCCCCCCULL, 0x1ULL, 0x8000000000000000ULL,
+};
+
+static Op random_op(Rng &rng) {
+    Op op;
+    op.kind = (rng.below(16) == 0) ? (uint8_t)OP_RST : (uint8_t)rng.below(2);
+    op.flag = (op.kind == OP_RST) ? (uint8_t)rng.below(2)
+              : (op.kind == OP_RX) ? (uint8_t)(rng.below(8) == 0) : (uint8_t)(rng.below(8) != 0);
+    op.repeat = 1;
+    op.data = rng.next();
+    return op;
+}
+
+/** Rate-matched streams (TX_WIDTH:RX_WIDTH edge pattern) and random seeds. */
+static std::vector<Input> initial_corpus(Rng &rng) {
+    std::vector<Input> seeds;
+    Input steady;
+    long long credit = 0;
+    for (int i = 0; i < 512; i++) {
+        // Bresenham interleave: RX_WIDTH TX edges per TX_WIDTH RX edges
+        credit += FUZZ_TX_WIDTH;
+        steady.push_back({OP_TX, 1, 1, rng.next()});
+        while (credit >= FUZZ_RX_WIDTH) {
+            credit -= FUZZ_RX_WIDTH;
+            steady.push_back({OP_RX, 0, 1, 0});
+        }
+    }
+    seeds.push_back(steady);
+
+    for (int s = 0; s < 4; s++) {
+        Input in;
+        for (int i = 0; i < 64; i++) in.push_back(random_op(rng));
+        seeds.push_back(in);
+    }
+    return seeds;
+}
+
+static void mutate(Input &in, const std::vector<Input> &corpus, Rng &rng) {
+    const int rounds = 1 + (int)rng.below(4);
+    for (int m = 0; m < rounds; m++) {
+        if (in.empty()) in.push_back(random_op(rng));
+        Op &op = in[rng.below((uint32_t)in.size())];
+        switch (rng.below(10)) {
+        case 0:                         // Flip one data bit
+            op.data ^= 1ULL << rng.below(64);
+            break;
+        case 1:                         // Special word
+            op.data = SPECIAL_WORDS[rng.below(sizeof(SPECIAL_WORDS) / sizeof(SPECIAL_WORDS[0]))];
+            break;
+        case 2:                         // Flip the flag (valid / slip / rst_n)
+            op.flag ^= 1;
+            break;
+        case 3:                         // Change the kind
+            op.kind = (uint8_t)rng.below(OP_KINDS);
+            break;
+        case 4:                         // Insert a random op
+            if (in.size() < MAX_OPS) in.insert(in.begin() + rng.below((uint32_t)in.size() + 1),
+                                               random_op(rng));
+            break;
+        case 5:                         // Delete an op
+            if (in.size() > 1) in.erase(in.begin() + rng.below((uint32_t)in.size()));
+            break;
+        case 6: {                       // Duplicate a short range
+            const uint32_t a = rng.below((uint32_t)in.size());
+            const uint32_t n = std::min<uint32_t>(1 + rng.below(16), (uint32_t)in.size() - a);
+            if (in.size() + n <= MAX_OPS) {
+                Input chunk(in.begin() + a, in.begin() + a + n);
+                in.insert(in.begin() + a, chunk.begin(), chunk.end());
+            }
+            break;
+        }
+        case 7:                         // Burst length: double, halve or random
+            switch (rng.below(3)) {
+            case 0: op.repeat = (uint16_t)std::min<uint32_t>(MAX_BURST, 2u * std::max<uint16_t>(1, op.repeat)); break;
+            case 1: op.repeat = (uint16_t)std::max(1, op.repeat / 2); break;
+            default: op.repeat = (uint16_t)(1 + rng.below(MAX_BURST)); break;
+            }
+            break;
+        case 8: {                       // Splice: tail from another corpus entry
+            const Input &other = corpus[rng.below((uint32_t)corpus.size())];
+            if (!other.empty()) {
+                const uint32_t cut = rng.below((uint32_t)in.size() + 1);
+                const uint32_t from = rng.below((uint32_t)other.size());
+                in.resize(cut);
+                for (uint32_t i = from; i < other.size() && in.size() < MAX_OPS; i++)
+                    in.push_back(other[i]);
+            }
+            break;
+        }
+        default:                        // Random data word
+            op.data = rng.next();
+            break;
+        }
+    }
+    if (in.empty()) in.push_back(random_op(rng));
+}
+
+//==============================================================================
+// CORPUS FILES
+//==============================================================================
+static bool save_input(const std::string &path, const Input &in) {
+    FILE *f = fopen(path.c_str(), "wb");
+    if (!f) {
+        fprintf(stderr, "[FUZZ ERROR] cannot write %s\n", path.c_str());
+        return false;
+    }
+    const uint32_t header[2] = {FILE_MAGIC, (uint32_t)in.size()};
+    fwrite(header, sizeof(header), 1, f);
+    fwrite(in.data(), sizeof(Op), in.size(), f);
+    fclose(f);
+    return true;
+}
+
+static bool load_input(const std::string &path, Input &in) {
+    FILE *f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    uint32_t header[2];
+    bool ok = fread(header, sizeof(header), 1, f) == 1 && header[0] == FILE_MAGIC &&
+              header[1] <= MAX_OPS;
+    if (ok) {
+        in.resize(header[1]);
+        ok = fread(in.data(), sizeof(Op), in.size(), f) == in.size();
+    }
+    fclose(f);
+    return ok;
+}
+
+//==============================================================================
+// FUZZING LOOP
+//==============================================================================
+struct Shared {
+    FeatureMap features;
+    std::mutex corpus_lock;
+    std::vector<Input> corpus;
+    std::atomic<uint64_t> execs{0};
+    std::atomic<uint64_t> mismatches{0};
+    std::atomic<bool> stop{false};
+    std::string corpus_dir;
+    bool stop_on_mismatch = true;
+};
+
+static void worker(Shared *sh, uint64_t seed, uint64_t max_execs) {
+    Rng rng(seed);
+    for (uint64_t n = 0; n < max_execs && !sh->stop.load(std::memory_order_relaxed); n++) {
+        Input in;
+        {
+            std::lock_guard<std::mutex> guard(sh->corpus_lock);
+            // Favor recent entries: they carry the newest features
+            const uint32_t size = (uint32_t)sh->corpus.size();
+            const uint32_t pick = (rng.below(2) == 0) ? size - 1 - rng.below(std::min(size, 8u))
+                                                      : rng.below(size);
+            in = sh->corpus[pick];
+            mutate(in, sh->corpus, rng);
+        }
+
+        const ExecResult r = execute(in, false);
+        sh->execs.fetch_add(1, std::memory_order_relaxed);
+
+        if (r.mismatch) {
+            const uint64_t id = sh->mismatches.fetch_add(1);
+            const std::string path = sh->corpus_dir + "/mismatch_" + std::to_string(id) + ".bin";
+            save_input(path, in);
+            printf("\n✗ MISMATCH at step %zu: RTL valid=%d word=%016llx, golden valid=%d "
+                   "word=%016llx\n  Input: %s\n", r.step, (int)r.rtl_valid,
+                   (unsigned long long)r.rtl_word, (int)r.gold_valid,
+                   (unsigned long long)r.gold_word, path.c_str());
+            fflush(stdout);
+            if (sh->stop_on_mismatch) sh->stop = true;
+            continue;
+        }
+
+        if (sh->features.merge(r.features) > 0) {
+            std::lock_guard<std::mutex> guard(sh->corpus_lock);
+            const std::string path = sh->corpus_dir + "/input_" +
+                                     std::to_string(sh->corpus.size()) + ".bin";
+            sh->corpus.push_back(in);
+            save_input(path, in);
+        }
+    }
+}
+
+static void usage(const char *prog) {
+    printf("Usage: %s [--threads N] [--execs N] [--time S] [--seed N] [--corpus DIR]\n"
+           "          [--keep-going] [--replay FILE]\n"
+           "  --threads N    Worker threads (default: hardware threads)\n"
+           "  --execs N      Executions per thread (default: unlimited)\n"
+           "  --time S       Wall-clock limit in seconds (default: 60)\n"
+           "  --seed N       Mutation seed (default: 95)\n"
+           "  --corpus DIR   Corpus / mismatch directory, loaded if present (default: .)\n"
+           "  --keep-going   Continue after a mismatch\n"
+           "  --replay FILE  Run one saved input with a per-step trace\n", prog);
+}
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+
+    int threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    uint64_t max_execs = UINT64_MAX;
+    double time_limit = 60.0;
+    uint64_t seed = 95;
+    std::string replay;
+    Shared sh;
+    sh.corpus_dir = ".";
+
+    for (int i = 1; i < argc; i++) {
+        const std::string a = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (a == "--threads" && has_value) threads = std::max(1, atoi(argv[++i]));
+        else if (a == "--execs" && has_value) max_execs = strtoull(argv[++i], nullptr, 10);
+        else if (a == "--time" && has_value) time_limit = atof(argv[++i]);
+        else if (a == "--seed" && has_value) seed = strtoull(argv[++i], nullptr, 10);
+        else if (a == "--corpus" && has_value) sh.corpus_dir = argv[++i];
+        else if (a == "--keep-going") sh.stop_on_mismatch = false;
+        else if (a == "--replay" && has_value) replay = argv[++i];
+        else if (a == "--help" || a == "-h") { usage(argv[0]); return 0; }
+        else if (a[0] == '+') continue;   // Verilator runtime arguments
+        else { usage(argv[0]); return 1; }
+    }
+
+    if (!replay.empty()) {
+        Input in;
+        if (!load_input(replay, in)) {
+            fprintf(stderr, "[FUZZ ERROR] cannot read %s\n", replay.c_str());
+            return 1;
+        }
+        printf("Replaying %s (%zu ops)\n", replay.c_str(), in.size());
+        const ExecResult r = execute(in, true);
+        if (r.mismatch) {
+            printf("*** FAILED: mismatch at step %zu ***\n", r.step);
+            return 1;
+        }
+        printf("*** PASSED: RTL matches the golden model ***\n");
+        return 0;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(sh.corpus_dir, ec);
+    sh.features.init(model_cover_points());
+    printf("gearbox_link fuzzer: %d:%d %s%s, %zu coverage points, %d threads\n",
+           FUZZ_TX_WIDTH, FUZZ_RX_WIDTH, FUZZ_PAM == 4 ? "PAM4" : "NRZ",
+           FUZZ_MSB_FIRST ? " MSB-first" : "", sh.features.cover_points, threads);
+
+    // Corpus: saved entries if present, else the built-in seeds
+    for (int i = 0;; i++) {
+        Input in;
+        if (!load_input(sh.corpus_dir + "/input_" + std::to_string(i) + ".bin", in)) break;
+        sh.corpus.push_back(in);
+    }
+    if (sh.corpus.empty()) {
+        Rng rng(seed);
+        for (const Input &in : initial_corpus(rng)) {
+            save_input(sh.corpus_dir + "/input_" + std::to_string(sh.corpus.size()) + ".bin", in);
+            sh.corpus.push_back(in);
+        }
+    }
+    for (const Input &in : sh.corpus) {
+        const ExecResult r = execute(in, false);
+        if (r.mismatch) {
+            printf("✗ Corpus entry mismatches at step %zu (replay it with --replay)\n", r.step);
+            return 1;
+        }
+        sh.features.merge(r.features);
+    }
+    printf("  Corpus: %zu inputs, %zu features\n", sh.corpus.size(), sh.features.count);
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++)
+        pool.emplace_back(worker, &sh, seed * 0x9E3779B97F4A7C15ULL + (uint64_t)t + 1, max_execs);
+
+    // Progress and time limit
+    std::thread monitor([&]() {
+        while (!sh.stop.load()) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            const double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (t >= time_limit) sh.stop = true;
+            static double last = 0.0;
+            if (t - last >= 5.0 || sh.stop.load()) {
+                last = t;
+                std::lock_guard<std::mutex> guard(sh.corpus_lock);
+                printf("  [%6.0fs] execs %llu (%.0f/s)  corpus %zu  features %zu  mismatches %llu\n",
+                       t, (unsigned long long)sh.execs.load(), sh.execs.load() / std::max(t, 1e-9),
+                       sh.corpus.size(), sh.features.count,
+                       (unsigned long long)sh.mismatches.load());
+                fflush(stdout);
+            }
+        }
+    });
+    for (std::thread &t : pool) t.join();
+    sh.stop = true;
+    monitor.join();
+
+    if (sh.mismatches.load()) {
+        printf("*** FAILED: %llu mismatching inputs saved in %s ***\n",
+               (unsigned long long)sh.mismatches.load(), sh.corpus_dir.c_str());
+        return 1;
+    }
+    printf("*** PASSED: no mismatches in %llu executions ***\n",
+           (unsigned long long)sh.execs.load());
+    return 0;
+}
+
+/**
+ * =============================================================================
+ * IMPLEMENTATION NOTES
+ * =============================================================================
+ *
+ * 1. Why In-Process:
+ *    - One execution is a few hundred to 10^5 clock edges; process start-up
+ *      and a file per run would cost more than the simulation. The model
+ *      and the golden model run in the same thread, and every execution
+ *      gets a fresh VerilatedContext (fresh coverage counters, fresh engine
+ *      via the initial block; final() frees it again)
+ *
+ * 2. Feedback:
+ *    - Built with --coverage-line / --coverage-user, the model counts
+ *      coverage in the __Vcoverage array of its symbol table; the counts
+ *      are read directly after each run (no coverage.dat is written)
+ *    - Counts are bucketed (1, 2, 3, 4-7, ...) so "this branch ran many
+ *      more times" is progress too, e.g. a longer burst towards overflow
+ *    - gearbox_link has few RTL points (the FIFO lives in C++), so the
+ *      golden model's state features carry most of the guidance
+ *
+ * 3. Golden Model:
+ *    - A deque of bits written from the interface contract (widths, bit
+ *      order, whole-symbol pops, 64 Kbit capacity with dropped pushes,
+ *      slips and pops gated by rst_n, queue emptied on reset), not from
+ *      the engine's word-level FIFO, so the two implementations are
+ *      independent. SER is 0: error placement is a statistical property
+ *      checked by gearbox_tb.sv
+ *
+ * 4. Parallel Workers:
+ *    - Threads share the corpus (mutex) and the feature map (mutex around
+ *      one merge per execution); everything else is per thread. Verilator
+ *      models in separate contexts may run on different threads
+ *
+ * 5. Verilator Compilation:
+ *    - See the build line in the header; the -D widths must match the -G
+ *      parameters, and the model must be built without --timing / --binary
+ *      (this file provides main())
+ *
+ * =============================================================================
+ */
@@ -0,0 +1,397 @@
+/**
+ * gearbox_tb.sv - Self-Checking Testbench for the Serializer/Deserializer Gearbox
+ *
+ * Test Strategy:
+ * - M:N ratios (32:40, 40:32, 64:10 MSB-first, 7:13) through the streaming
+ *   API against a bit-queue reference, with a 3-bit slip mid-stream
+ * - Full FIFO: with the head mid-word, fill to within one word of capacity
+ *   so the tail wraps into the head word, then drain against the reference
+ * - PAM4 bit planes: split / merge round trip against bit-by-bit extraction
+ * - PAM4 symbol packing: TX words -> Gray-coded level indices -> RX words
+ *   must round-trip; levels must follow the Gray map 00, 01, 11, 10
+ * - RTL (gearbox_link, 32:40, tx_clk 100 MHz / rx_clk 80 MHz, no serial
+ *   clock in the simulation):
+ *   - PAM4 Gray, SER 1e-2: every symbol error costs exactly one bit
+ *   - PAM4 natural coding, SER 1e-2: some symbol errors cost two bits
+ *   - NRZ MSB-first, error-free, one slip pulse: RX stream shifts by one bit
+ *
+ * Author: Generated for SerDes parallel/serial conversion
+ * Date: 2025
+ */
+
+`timescale 1ns / 1ps
+
+module gearbox_tb #(
+    parameter SIM_TIMEOUT = 30000  // 30us timeout (2000 TX words @ 100MHz = 20us + margin)
+);
+
+    //==========================================================================
+    // TEST PARAMETERS
+    //==========================================================================
+    localparam int  API_WORDS = 400;            // Words per ratio (streaming API)
+    localparam int  PAM4_WORDS = 64;
+    localparam int  SYMS = 16;                  // PAM4 symbols per 32-bit word
+    localparam int  LINK_WORDS = 2000;
+    localparam int  TX_W = 32;
+    localparam int  RX_W = 40;
+    localparam real SER = 1.0e-2;
+    localparam int  SLIP_CYCLE = 300;           // rx_clk cycle of the slip pulse
+    localparam int  GB_FIFO_BITS = 65536;       // dpi_gearbox.cpp FIFO capacity
+
+    //==========================================================================
+    // DPI-C IMPORTS
+    //==========================================================================
+    import "DPI-C" function chandle dpi_gearbox_create(input int in_width, input int out_width,
+        input int msb_first);
+    import "DPI-C" function int  dpi_gearbox_set_serial(input chandle h, input int pam,
+        input int gray, input real ser, input int seed);
+    import "DPI-C" function int  dpi_gearbox_push(input chandle h, input longint word);
+    import "DPI-C" function int  dpi_gearbox_pop(input chandle h, output longint word);
+    import "DPI-C" function int  dpi_gearbox_pop_symbols(input chandle h, output int symbols[SYMS],
+        input int n);
+    import "DPI-C" function int  dpi_gearbox_push_symbols(input chandle h, input int symbols[SYMS],
+        input int n);
+    import "DPI-C" function int  dpi_gearbox_slip(input chandle h, input int nbits);
+    import "DPI-C" function int  dpi_gearbox_level(input chandle h);
+    import "DPI-C" function longint dpi_gearbox_symbol_errors(input chandle h);
+    import "DPI-C" function longint dpi_gearbox_bit_errors(input chandle h);
+    import "DPI-C" function void dpi_gearbox_destroy(input chandle h);
+    import "DPI-C" function void dpi_pam4_split(input longint word, output int msb_plane,
+        output int lsb_plane);
+    import "DPI-C" function longint dpi_pam4_merge(input int msb_plane, input int lsb_plane);
+
+    //==========================================================================
+    // TESTBENCH SIGNALS
+    //==========================================================================
+    logic            clk;                       // TX parallel clock
+    logic            rx_clk;
+    logic            rst_n;
+    logic            tx_valid;
+    logic [TX_W-1:0] tx_word;
+    logic            slip;
+    logic            rx_valid[3];
+    logic [RX_W-1:0] rx_word[3];
+
+    //==========================================================================
+    // VERIFICATION VARIABLES
+    //==========================================================================
+    int     error_count = 0;
+    bit     ref_q[3][$];                        // Expected serial stream per link
+    int     rx_words[3] = '{0, 0, 0};
+    int     rx_mismatch[3] = '{0, 0, 0};
+    int     rx_cycles = 0;
+    int     sym_buf[SYMS];
+
+    //==========================================================================
+    // DUT INSTANTIATION
+    //==========================================================================
+    gearbox_link #(.TX_WIDTH(TX_W), .RX_WIDTH(RX_W), .PAM_LEVELS(4), .GRAY(1),
+                   .SER(SER), .SEED(1)) link_gray (
+        .tx_clk(clk), .rx_clk(rx_clk), .rst_n(rst_n), .tx_valid(tx_valid), .tx_word(tx_word),
+        .slip(1'b0), .rx_valid(rx_valid[0]), .rx_word(rx_word[0])
+    );
+
+    gearbox_link #(.TX_WIDTH(TX_W), .RX_WIDTH(RX_W), .PAM_LEVELS(4), .GRAY(0),
+                   .SER(SER), .SEED(2)) link_bin (
+        .tx_clk(clk), .rx_clk(rx_clk), .rst_n(rst_n), .tx_valid(tx_valid), .tx_word(tx_word),
+        .slip(1'b0), .rx_valid(rx_valid[1]), .rx_word(rx_word[1])
+    );
+
+    gearbox_link #(.TX_WIDTH(TX_W), .RX_WIDTH(RX_W), .MSB_FIRST(1)) link_nrz (
+        .tx_clk(clk), .rx_clk(rx_clk), .rst_n(rst_n), .tx_valid(tx_valid), .tx_word(tx_word),
+        .slip(slip), .rx_valid(rx_valid[2]), .rx_word(rx_word[2])
+    );
+
+    //==========================================================================
+    // CLOCK GENERATION
+    //==========================================================================
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    // 80 MHz: 40 bits / 12.5 ns = 32 bits / 10 ns
+    initial rx_clk = 0;
+    always #6.25 rx_clk = ~rx_clk;
+
+    //==========================================================================
+    // VCD WAVEFORM DUMP
+    //==========================================================================
+    initial begin
+        $dumpfile("sim/waves/gearbox.vcd");
+        $dumpvars(0, gearbox_tb);
+    end
+
+    //==========================================================================
+    // HELPERS
+    //==========================================================================
+    function automatic longint rand64();
+        return {32'($urandom), 32'($urandom)};
+    endfunction
+
+    task automatic check(input string name, input bit ok);
+        if (ok) begin
+            $display("  ✓ %s", name);
+        end else begin
+            $display("  ✗ ERROR: %s", name);
+            error_count++;
+        end
+    endtask
+
+    //==========================================================================
+    // LINK MONITORS
+    //==========================================================================
+    // Reference streams: links 0/1 send LSB first, link 2 MSB first
+    always @(posedge clk) begin
+        if (rst_n && tx_valid) begin
+            for (int b = 0; b < TX_W; b++) begin
+                ref_q[0].push_back(tx_word[b]);
+                ref_q[1].push_back(tx_word[b]);
+                ref_q[2].push_back(tx_word[TX_W - 1 - b]);
+            end
+        end
+    end
+
+    always @(posedge rx_clk) begin
+        if (rst_n) begin
+            if (slip) void'(ref_q[2].pop_front());
+            rx_cycles++;
+            #1;
+            for (int l = 0; l < 3; l++) begin
+                if (rx_valid[l]) begin
+                    for (int b = 0; b < RX_W; b++) begin
+                        if (rx_word[l][(l == 2) ? RX_W - 1 - b : b] != ref_q[l].pop_front())
+                            rx_mismatch[l]++;
+                    end
+                    rx_words[l]++;
+                end
+            end
+        end
+    end
+
+    //==========================================================================
+    // TEST: M:N RATIOS (STREAMING API)
+    //==========================================================================
+    task automatic test_ratio(input int m, input int n, input int msb_first);
+        chandle gb;
+        bit     q[$];
+        longint w;
+        longint o;
+        longint e;
+        int     words = 0;
+        int     bad = 0;
+
+        gb = dpi_gearbox_create(m, n, msb_first);
+        for (int i = 0; i < API_WORDS; i++) begin
+            w = rand64() & ((m == 64) ? -64'sd1 : ((64'sd1 <<< m) - 64'sd1));
+            void'(dpi_gearbox_push(gb, w));
+            for (int b = 0; b < m; b++) q.push_back(w[msb_first ? m - 1 - b : b]);
+            if (i == API_WORDS / 2) begin
+                void'(dpi_gearbox_slip(gb, 3));
+                repeat (3) void'(q.pop_front());
+            end
+            while (dpi_gearbox_pop(gb, o) == 1) begin
+                e = 0;
+                for (int b = 0; b < n; b++) e[msb_first ? n - 1 - b : b] = q.pop_front();
+                if (o != e) bad++;
+                words++;
+            end
+        end
+        check($sformatf("%0d:%0d %s: %0d words, %0d mismatches", m, n,
+              msb_first ? "MSB-first" : "LSB-first", words, bad),
+              bad == 0 && words == (API_WORDS * m - 3) / n);
+        dpi_gearbox_destroy(gb);
+    endtask
+
+    //==========================================================================
+    // TEST: FULL FIFO
+    //==========================================================================
+    // Near capacity the tail word and the spill word still hold unread head
+    // bits; a push must only touch its own field
+    task automatic test_fifo_full();
+        chandle gb;
+        bit     q[$];
+        longint w;
+        longint o;
+        longint e;
+        int     level;
+        int     words = 0;
+        int     bad = 0;
+
+        gb = dpi_gearbox_create(40, 32, 0);
+        for (int i = 0; i < 4; i++) begin
+            w = rand64() & 64'hFF_FFFF_FFFF;
+            void'(dpi_gearbox_push(gb, w));
+            for (int b = 0; b < 40; b++) q.push_back(w[b]);
+        end
+        // Head at bit 160, half way through FIFO word 2; the last push before
+        // full ends at bit 65680 and spills 16 bits into that same word
+        repeat (5) begin
+            void'(dpi_gearbox_pop(gb, o));
+            repeat (32) void'(q.pop_front());
+        end
+        while (dpi_gearbox_level(gb) + 40 <= GB_FIFO_BITS) begin
+            w = rand64() & 64'hFF_FFFF_FFFF;
+            void'(dpi_gearbox_push(gb, w));
+            for (int b = 0; b < 40; b++) q.push_back(w[b]);
+        end
+        level = dpi_gearbox_level(gb);
+        while (dpi_gearbox_pop(gb, o) == 1) begin
+            e = 0;
+            for (int b = 0; b < 32; b++) e[b] = q.pop_front();
+            if (o != e) bad++;
+            words++;
+        end
+        check($sformatf("full FIFO (%0d of %0d bits): %0d words drained, %0d mismatches",
+              level, GB_FIFO_BITS, words, bad),
+              level > GB_FIFO_BITS - 40 && bad == 0 && words == level / 32);
+        dpi_gearbox_destroy(gb);
+    endtask
+
+    //==========================================================================
+    // TEST: PAM4 BIT PLANES AND SYMBOL PACKING
+    //==========================================================================
+    task automatic test_pam4();
+        chandle tx;
+        chandle rx;
+        longint w;
+        longint o;
+        int     msb;
+        int     lsb;
+        int     plane_err = 0;
+        int     level_err = 0;
+        int     trip_err = 0;
+        int     gray_map[4] = '{0, 1, 3, 2};    // {first bit, second bit} -> level
+
+        for (int i = 0; i < 200; i++) begin
+            w = rand64();
+            dpi_pam4_split(w, msb, lsb);
+            for (int s = 0; s < 32; s++) begin
+                if (msb[s] != w[2 * s] || lsb[s] != w[2 * s + 1]) plane_err++;
+            end
+            if (dpi_pam4_merge(msb, lsb) != w) plane_err++;
+        end
+        check("PAM4 planes split / merge round trip", plane_err == 0);
+
+        tx = dpi_gearbox_create(TX_W, TX_W, 0);
+        rx = dpi_gearbox_create(TX_W, TX_W, 0);
+        void'(dpi_gearbox_set_serial(tx, 4, 1, 0.0, 1));
+        void'(dpi_gearbox_set_serial(rx, 4, 1, 0.0, 1));
+        for (int i = 0; i < PAM4_WORDS; i++) begin
+            w = longint'($urandom);
+            void'(dpi_gearbox_push(tx, w));
+            void'(dpi_gearbox_pop_symbols(tx, sym_buf, SYMS));
+            for (int s = 0; s < SYMS; s++) begin
+                if (sym_buf[s] != gray_map[{w[2 * s], w[2 * s + 1]}]) level_err++;
+            end
+            void'(dpi_gearbox_push_symbols(rx, sym_buf, SYMS));
+            if (dpi_gearbox_pop(rx, o) != 1 || o != w) trip_err++;
+        end
+        check($sformatf("Gray levels (%0d symbols)", PAM4_WORDS * SYMS), level_err == 0);
+        check("words -> symbols -> words round trip", trip_err == 0);
+        dpi_gearbox_destroy(tx);
+        dpi_gearbox_destroy(rx);
+    endtask
+
+    //==========================================================================
+    // TEST: PARALLEL-ONLY RTL LINKS
+    //==========================================================================
+    task automatic test_links();
+        longint sym_err[2];
+        longint bit_err[2];
+
+        for (int i = 0; i < LINK_WORDS; i++) begin
+            tx_word = $urandom;
+            tx_valid = 1;
+            @(posedge clk);
+            #1;
+        end
+        tx_valid = 0;
+        repeat (4) @(posedge rx_clk);
+        #2;
+
+        sym_err[0] = dpi_gearbox_symbol_errors(link_gray.gb);
+        bit_err[0] = dpi_gearbox_bit_errors(link_gray.gb);
+        sym_err[1] = dpi_gearbox_symbol_errors(link_bin.gb);
+        bit_err[1] = dpi_gearbox_bit_errors(link_bin.gb);
+        $display("[%0t ns] Links: %0d TX words; RX words %0d / %0d / %0d", $time, LINK_WORDS,
+                 rx_words[0], rx_words[1], rx_words[2]);
+        check("all RX words delivered", rx_words[0] == LINK_WORDS * TX_W / RX_W &&
+              rx_words[1] == LINK_WORDS * TX_W / RX_W &&
+              rx_words[2] == (LINK_WORDS * TX_W - 1) / RX_W);
+
+        $display("  PAM4 Gray:    %0d symbol errors, %0d bit errors, %0d RX mismatches",
+                 sym_err[0], bit_err[0], rx_mismatch[0]);
+        // 32000 symbols at 1e-2: 320 ± 18 (1σ)
+        check("symbol errors within ±5σ of SER", sym_err[0] > 230 && sym_err[0] < 410);
+        check("Gray: one bit per symbol error", bit_err[0] == sym_err[0] &&
+              rx_mismatch[0] == bit_err[0]);
+
+        $display("  PAM4 natural: %0d symbol errors, %0d bit errors, %0d RX mismatches",
+                 sym_err[1], bit_err[1], rx_mismatch[1]);
+        check("natural coding: 01 <-> 10 errors cost two bits", bit_err[1] > sym_err[1] &&
+              rx_mismatch[1] == bit_err[1]);
+
+        $display("  NRZ MSB-first: slip at rx cycle %0d, %0d RX mismatches", SLIP_CYCLE,
+                 rx_mismatch[2]);
+        check("slip realigns RX stream by one bit", rx_mismatch[2] == 0);
+    endtask
+
+    //==========================================================================
+    // MAIN TEST SEQUENCE
+    //==========================================================================
+    initial begin
+        $display("========================================");
+        $display("  SerDes Gearbox Test");
+        $display("========================================");
+
+        void'($urandom(85));
+        rst_n = 0;
+        tx_valid = 0;
+        tx_word = '0;
+        slip = 0;
+        repeat (2) @(posedge clk);
+        rst_n = 1;
+
+        $display("[%0t ns] M:N ratios", $time);
+        test_ratio(32, 40, 0);
+        test_ratio(40, 32, 0);
+        test_ratio(64, 10, 1);
+        test_ratio(7, 13, 0);
+        test_fifo_full();
+
+        $display("[%0t ns] PAM4 packing", $time);
+        test_pam4();
+
+        test_links();
+
+        $display("");
+        if (error_count == 0) begin
+            $display("========================================");
+            $display("*** PASSED: All tests passed ***");
+            $display("========================================");
+        end else begin
+            $display("========================================");
+            $display("*** FAILED: %0d errors detected ***", error_count);
+            $display("========================================");
+        end
+
+        $finish;
+    end
+
+    // One-cycle slip pulse on the NRZ link
+    initial begin
+        wait (rx_cycles == SLIP_CYCLE);
+        #2 slip = 1;
+        @(posedge rx_clk);
+        #2 slip = 0;
+    end
+
+    //==========================================================================
+    // TIMEOUT WATCHDOG
+    //==========================================================================
+    initial begin
+        #SIM_TIMEOUT;
+        $display("ERROR: Simulation timeout after %0d time units", SIM_TIMEOUT);
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,198 @@
+/**
+ * jtol_tb.sv - Jitter Tolerance Testbench (Bang-Bang CDR Model)
+ *
+ * Test Strategy (10 Gb/s NRZ, 0.02 UI RMS random jitter):
+ * - Behavioral first-order bang-bang CDR: on every data transition the
+ *   recovered phase moves 1/128 UI toward the received edge; a bit is in
+ *   error when the sampling point (phase + 0.5 UI) falls outside its eye
+ * - Sinusoidal jitter (SJ) on the data edges; the CDR can only slew
+ *   step·(transition density) UI per UI, so tolerance falls as 1/f below
+ *   the loop corner and flattens near 0.5 UI minus the RJ margin above it
+ * - Self-check (no plusargs): 1 MHz SJ passes at 0.3 UI and fails at 12 UI;
+ *   100 MHz SJ passes at 0.2 UI and fails at 0.7 UI
+ * - Single-point mode (scripts/threshold_search.py, run_test.py --sweep):
+ *   +SJ_FREQ_HZ=<f> +SJ_AMP_UI=<a> [+BITS=<n>] [+SEED=<s>] runs one point
+ *   and reports errors / bits / BER as [METRIC] lines
+ *
+ * Author: Generated for SerDes jitter tolerance characterization
+ * Date: 2025
+ */
+
+`timescale 1ns / 1ps
+
+module jtol_tb #(
+    parameter SIM_TIMEOUT = 100000  // 100us timeout (10M bits / 1000 per block @ 100MHz + margin)
+);
+
+    //==========================================================================
+    // TEST PARAMETERS
+    //==========================================================================
+    localparam real UI = 100.0e-12;             // 10 Gb/s
+    localparam real RJ_UI = 0.02;               // RMS random jitter (UI)
+    localparam real CDR_STEP_UI = 1.0 / 128.0;  // Bang-bang phase step
+    localparam int  WARMUP_BITS = 1000;         // CDR acquisition, not counted
+    localparam int  BLOCK_BITS = 1000;          // Bits per clock
+    localparam int  DEFAULT_BITS = 200000;
+    localparam real PI = 3.14159265358979;
+
+    //==========================================================================
+    // TESTBENCH SIGNALS
+    //==========================================================================
+    logic clk;
+
+    //==========================================================================
+    // VERIFICATION VARIABLES
+    //==========================================================================
+    int      error_count = 0;
+    longint  point_errors;
+    longint  point_bits;
+
+    //==========================================================================
+    // CLOCK GENERATION
+    //==========================================================================
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    //==========================================================================
+    // VCD WAVEFORM DUMP
+    //==========================================================================
+    initial begin
+        if (!$test$plusargs("NO_VCD")) begin
+            $dumpfile("sim/waves/jtol.vcd");
+            $dumpvars(0, jtol_tb);
+        end
+    end
+
+    //==========================================================================
+    // HELPERS
+    //==========================================================================
+    task automatic check(input string name, input bit ok);
+        if (ok) begin
+            $display("  ✓ %s", name);
+        end else begin
+            $display("  ✗ ERROR: %s", name);
+            error_count++;
+        end
+    endtask
+
+    function automatic real urand();
+        return (real'($urandom % 1000000) + 1.0) / 1000001.0;
+    endfunction
+
+    function automatic real gauss();
+        return $sqrt(-2.0 * $ln(urand())) * $cos(2.0 * PI * urand());
+    endfunction
+
+    //==========================================================================
+    // CDR + SJ CHANNEL
+    //==========================================================================
+    // Edge k of the data stream arrives at k + e_k UI with
+    // e_k = A·sin(2π·f·k·UI) + RJ; the recovered clock edge sits at k + φ.
+    // A transition at k is missed (early sample) when φ + 0.5 < e_k, and the
+    // previous bit is over-run (late sample) when φ + 0.5 > 1 + e_k.
+    task automatic run_point(input real sj_freq_hz, input real sj_amp_ui, input int bits,
+                             input int seed);
+        real    phi = 0.0;
+        real    e;
+        bit     prev = 0;
+        bit     b;
+        int     k = 0;
+
+        void'($urandom(seed));
+        point_errors = 0;
+        point_bits = 0;
+        while (k < bits + WARMUP_BITS) begin
+            @(posedge clk);
+            for (int i = 0; i < BLOCK_BITS && k < bits + WARMUP_BITS; i++) begin
+                b = 1'($urandom % 2);
+                if (b != prev) begin
+                    e = sj_amp_ui * $sin(2.0 * PI * sj_freq_hz * UI * real'(k)) + RJ_UI * gauss();
+                    if (k >= WARMUP_BITS && (phi + 0.5 < e || phi - 0.5 > e)) point_errors++;
+                    phi += (e > phi) ? CDR_STEP_UI : -CDR_STEP_UI;
+                end
+                prev = b;
+                if (k >= WARMUP_BITS) point_bits++;
+                k++;
+            end
+        end
+    endtask
+
+    task automatic report_point(input real sj_freq_hz, input real sj_amp_ui);
+        $display("[%0t ns] SJ %0.3g Hz, %0.4f UI: %0d errors / %0d bits (BER %0.3e)", $time,
+                 sj_freq_hz, sj_amp_ui, point_errors, point_bits,
+                 real'(point_errors) / real'(point_bits));
+    endtask
+
+    //==========================================================================
+    // TEST: TOLERANCE CORNERS
+    //==========================================================================
+    task automatic test_corners();
+        $display("[%0t ns] Bang-bang CDR jitter tolerance corners", $time);
+
+        run_point(1.0e6, 0.3, DEFAULT_BITS, 89);
+        report_point(1.0e6, 0.3);
+        check("1 MHz SJ 0.3 UI tracked (no errors)", point_errors == 0);
+
+        run_point(1.0e6, 12.0, DEFAULT_BITS, 89);
+        report_point(1.0e6, 12.0);
+        check("1 MHz SJ 12 UI exceeds CDR slew (errors)", point_errors > 100);
+
+        run_point(100.0e6, 0.2, DEFAULT_BITS, 89);
+        report_point(100.0e6, 0.2);
+        check("100 MHz SJ 0.2 UI inside the eye (no errors)", point_errors == 0);
+
+        run_point(100.0e6, 0.7, DEFAULT_BITS, 89);
+        report_point(100.0e6, 0.7);
+        check("100 MHz SJ 0.7 UI closes the eye (errors)", point_errors > 100);
+    endtask
+
+    //==========================================================================
+    // MAIN TEST SEQUENCE
+    //==========================================================================
+    initial begin
+        real sj_freq_hz;
+        real sj_amp_ui;
+        int  bits = DEFAULT_BITS;
+        int  seed = 89;
+
+        $display("========================================");
+        $display("  Jitter Tolerance (Bang-Bang CDR) Test");
+        $display("========================================");
+
+        void'($value$plusargs("BITS=%d", bits));
+        void'($value$plusargs("SEED=%d", seed));
+        if ($value$plusargs("SJ_FREQ_HZ=%f", sj_freq_hz) &&
+            $value$plusargs("SJ_AMP_UI=%f", sj_amp_ui)) begin
+            run_point(sj_freq_hz, sj_amp_ui, bits, seed);
+            report_point(sj_freq_hz, sj_amp_ui);
+            $display("[METRIC] errors = %0d", point_errors);
+            $display("[METRIC] bits = %0d", point_bits);
+            $display("[METRIC] ber = %0.6e", real'(point_errors) / real'(point_bits));
+        end else begin
+            test_corners();
+        end
+
+        $display("");
+        if (error_count == 0) begin
+            $display("========================================");
+            $display("*** PASSED: All tests passed ***");
+            $display("========================================");
+        end else begin
+            $display("========================================");
+            $display("*** FAILED: %0d errors detected ***", error_count);
+            $display("========================================");
+        end
+
+        $finish;
+    end
+
+    //==========================================================================
+    // TIMEOUT WATCHDOG
+    //==========================================================================
+    initial begin
+        #SIM_TIMEOUT;
+        $display("ERROR: Simulation timeout after %0d time units", SIM_TIMEOUT);
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,302 @@
+/**
+ * pcie_codec_tb.sv - Self-Checking Testbench for the PCIe Line Coding Layer
+ *
+ * Test Strategy:
+ * 1. Scrambler
+ *    - Gen1/2 keystream matches the known sequence FF 17 C0 14 B2 E7 02 82
+ *    - Gen3 64-bit jump-table steps match the bit-serial LFSR word for word
+ *    - Block API scramble → descramble restores the data
+ * 2. 8b/10b
+ *    - K28.5 encodes to 0x17C (RD-) / 0x283 (RD+)
+ *    - All 256 data symbols + 12 K symbols round-trip via the block API
+ *    - An invalid code word is flagged as a code error
+ * 3. 128b/130b
+ *    - 32 blocks (data + ordered set) are framed, the word stream is
+ *      misaligned by 37 bits, and the deframer must lock and recover them
+ *
+ * Author: Generated for SerDes PCIe encoding layer
+ * Date: 2025
+ */
+
+`timescale 1ns / 1ps
+
+module pcie_codec_tb #(
+    parameter SIM_TIMEOUT = 10000  // 10us timeout (all checks run in zero time)
+);
+
+    //==========================================================================
+    // TEST PARAMETERS
+    //==========================================================================
+    localparam int BLOCK_WORDS = 64;
+    localparam int CODE_SYMS = 268;           // 256 data + 12 K symbols
+    localparam int NUM_BLOCKS = 32;
+    localparam int MAX_WORDS = 80;            // ceil(32 × 130 / 64) + slack
+    localparam int BIT_SLIP = 37;             // RX misalignment in bits
+
+    //==========================================================================
+    // DPI-C IMPORTS
+    //==========================================================================
+    import "DPI-C" function chandle  dpi_scrambler_create(input int gen, input int lane);
+    import "DPI-C" function longint  dpi_scrambler_word(input chandle h, input longint data);
+    import "DPI-C" function longint  dpi_scrambler_serial_word(input chandle h, input longint data);
+    import "DPI-C" function void     dpi_scrambler_block(input chandle h,
+        input longint in_words[BLOCK_WORDS], output longint out_words[BLOCK_WORDS], input int n);
+    import "DPI-C" function int      dpi_scrambler_symbol(input chandle h, input int sym);
+    import "DPI-C" function void     dpi_scrambler_destroy(input chandle h);
+
+    import "DPI-C" function chandle  dpi_8b10b_create();
+    import "DPI-C" function int      dpi_8b10b_encode(input chandle h, input int sym);
+    import "DPI-C" function int      dpi_8b10b_decode(input chandle h, input int code);
+    import "DPI-C" function int      dpi_8b10b_encode_block(input chandle h,
+        input int syms[CODE_SYMS], output int codes[CODE_SYMS], input int n);
+    import "DPI-C" function int      dpi_8b10b_decode_block(input chandle h,
+        input int codes[CODE_SYMS], output int syms[CODE_SYMS], input int n);
+    import "DPI-C" function longint  dpi_8b10b_code_errors(input chandle h);
+    import "DPI-C" function longint  dpi_8b10b_disparity_errors(input chandle h);
+    import "DPI-C" function void     dpi_8b10b_destroy(input chandle h);
+
+    import "DPI-C" function chandle  dpi_128b130b_create(input int lane, input int scramble);
+    import "DPI-C" function int      dpi_128b130b_tx_block(input chandle h, input int sync_hdr,
+        input longint payload_lo, input longint payload_hi);
+    import "DPI-C" function int      dpi_128b130b_tx_pop_word(input chandle h, output longint word);
+    import "DPI-C" function int      dpi_128b130b_rx_push_word(input chandle h, input longint word);
+    import "DPI-C" function int      dpi_128b130b_rx_pop_block(input chandle h, output int sync_hdr,
+        output longint payload_lo, output longint payload_hi);
+    import "DPI-C" function int      dpi_128b130b_rx_slip(input chandle h);
+    import "DPI-C" function void     dpi_128b130b_destroy(input chandle h);
+
+    //==========================================================================
+    // VERIFICATION VARIABLES
+    //==========================================================================
+    int error_count = 0;
+    chandle scr_a;
+    chandle scr_b;
+    chandle codec;
+    chandle framer_tx;
+    chandle framer_rx;
+
+    longint data_words[BLOCK_WORDS];
+    longint scr_words[BLOCK_WORDS];
+    longint desc_words[BLOCK_WORDS];
+    int     syms[CODE_SYMS];
+    int     codes[CODE_SYMS];
+    int     decoded[CODE_SYMS];
+
+    int     tx_hdr[NUM_BLOCKS];
+    longint tx_lo[NUM_BLOCKS];
+    longint tx_hi[NUM_BLOCKS];
+    longint tx_stream[MAX_WORDS];
+    int     tx_word_count = 0;
+
+    //==========================================================================
+    // VCD WAVEFORM DUMP
+    //==========================================================================
+    initial begin
+        $dumpfile("sim/waves/pcie_codec.vcd");
+        $dumpvars(0, pcie_codec_tb);
+    end
+
+    //==========================================================================
+    // TEST 1: SCRAMBLER
+    //==========================================================================
+    task automatic test_scrambler();
+        int expected_gen1[8] = '{'hFF, 'h17, 'hC0, 'h14, 'hB2, 'hE7, 'h02, 'h82};
+        int key;
+        longint fast;
+        longint slow;
+        int mismatches = 0;
+
+        $display("[TEST 1] Scrambler");
+
+        scr_a = dpi_scrambler_create(1, 0);
+        for (int i = 0; i < 8; i++) begin
+            key = dpi_scrambler_symbol(scr_a, 0);
+            if (key != expected_gen1[i]) begin
+                $display("  ✗ ERROR: Gen1 keystream byte %0d = %02h (expected %02h)",
+                         i, key, expected_gen1[i]);
+                error_count++;
+            end
+        end
+        dpi_scrambler_destroy(scr_a);
+
+        scr_a = dpi_scrambler_create(3, 0);
+        scr_b = dpi_scrambler_create(3, 0);
+        for (int i = 0; i < 256; i++) begin
+            fast = dpi_scrambler_word(scr_a, longint'(i));
+            slow = dpi_scrambler_serial_word(scr_b, longint'(i));
+            if (fast != slow) mismatches++;
+        end
+        if (mismatches != 0) begin
+            $display("  ✗ ERROR: %0d jump-table words differ from bit-serial LFSR", mismatches);
+            error_count++;
+        end
+        dpi_scrambler_destroy(scr_a);
+        dpi_scrambler_destroy(scr_b);
+
+        scr_a = dpi_scrambler_create(3, 2);
+        scr_b = dpi_scrambler_create(3, 2);
+        for (int i = 0; i < BLOCK_WORDS; i++) data_words[i] = {$urandom, $urandom};
+        dpi_scrambler_block(scr_a, data_words, scr_words, BLOCK_WORDS);
+        dpi_scrambler_block(scr_b, scr_words, desc_words, BLOCK_WORDS);
+        mismatches = 0;
+        for (int i = 0; i < BLOCK_WORDS; i++) begin
+            if (desc_words[i] != data_words[i]) mismatches++;
+        end
+        if (mismatches != 0) begin
+            $display("  ✗ ERROR: %0d words not restored by descrambler", mismatches);
+            error_count++;
+        end
+        dpi_scrambler_destroy(scr_a);
+        dpi_scrambler_destroy(scr_b);
+        $display("  Done (Gen1 keystream, Gen3 jump vs serial, block round trip)");
+    endtask
+
+    //==========================================================================
+    // TEST 2: 8b/10b
+    //==========================================================================
+    task automatic test_8b10b();
+        int k_syms[12] = '{'h11C, 'h13C, 'h15C, 'h17C, 'h19C, 'h1BC,
+                           'h1DC, 'h1FC, 'h1F7, 'h1FB, 'h1FD, 'h1FE};
+        int code;
+        int errors;
+
+        $display("[TEST 2] 8b/10b");
+
+        codec = dpi_8b10b_create();
+        code = dpi_8b10b_encode(codec, 'h1BC);
+        if (code != 'h17C) begin
+            $display("  ✗ ERROR: K28.5 RD- = %03h (expected 17C)", code);
+            error_count++;
+        end
+        code = dpi_8b10b_encode(codec, 'h1BC);
+        if (code != 'h283) begin
+            $display("  ✗ ERROR: K28.5 RD+ = %03h (expected 283)", code);
+            error_count++;
+        end
+        dpi_8b10b_destroy(codec);
+
+        for (int i = 0; i < 256; i++) syms[i] = i;
+        for (int i = 0; i < 12; i++) syms[256 + i] = k_syms[i];
+
+        codec = dpi_8b10b_create();
+        errors = dpi_8b10b_encode_block(codec, syms, codes, CODE_SYMS);
+        if (errors != 0) begin
+            $display("  ✗ ERROR: %0d symbols rejected by encoder", errors);
+            error_count++;
+        end
+        errors = dpi_8b10b_decode_block(codec, codes, decoded, CODE_SYMS);
+        for (int i = 0; i < CODE_SYMS; i++) begin
+            if (decoded[i] != syms[i]) errors++;
+        end
+        if (errors != 0) begin
+            $display("  ✗ ERROR: %0d symbols failed the round trip", errors);
+            error_count++;
+        end
+
+        // An all-zeros word (run length 10) is never a valid code
+        void'(dpi_8b10b_decode(codec, 'h000));
+        if (dpi_8b10b_code_errors(codec) != 1 || dpi_8b10b_disparity_errors(codec) != 0) begin
+            $display("  ✗ ERROR: invalid code not detected");
+            error_count++;
+        end
+        dpi_8b10b_destroy(codec);
+        $display("  Done (K28.5, %0d-symbol round trip, error detection)", CODE_SYMS);
+    endtask
+
+    //==========================================================================
+    // TEST 3: 128b/130b
+    //==========================================================================
+    task automatic test_128b130b();
+        longint word;
+        longint prev;
+        longint shifted;
+        int     hdr;
+        longint lo;
+        longint hi;
+        int     rx_blocks = 0;
+        int     mismatches = 0;
+
+        $display("[TEST 3] 128b/130b");
+
+        framer_tx = dpi_128b130b_create(0, 1);
+        framer_rx = dpi_128b130b_create(0, 1);
+
+        for (int b = 0; b < NUM_BLOCKS; b++) begin
+            tx_hdr[b] = (b % 8 == 3) ? 1 : 2;    // Ordered set every 8th block
+            tx_lo[b] = {$urandom, $urandom};
+            tx_hi[b] = {$urandom, $urandom};
+            void'(dpi_128b130b_tx_block(framer_tx, tx_hdr[b], tx_lo[b], tx_hi[b]));
+            while (dpi_128b130b_tx_pop_word(framer_tx, word) != 0) begin
+                tx_stream[tx_word_count++] = word;
+            end
+        end
+
+        // Misalign by BIT_SLIP bits (zeros in front = invalid 00b headers)
+        prev = 0;
+        for (int i = 0; i <= tx_word_count; i++) begin
+            word = (i < tx_word_count) ? tx_stream[i] : 64'd0;
+            shifted = (word << BIT_SLIP) | (prev >> (64 - BIT_SLIP));
+            prev = word;
+            void'(dpi_128b130b_rx_push_word(framer_rx, shifted));
+            while (dpi_128b130b_rx_pop_block(framer_rx, hdr, lo, hi) != 0) begin
+                if (rx_blocks < NUM_BLOCKS &&
+                    (hdr != tx_hdr[rx_blocks] || lo != tx_lo[rx_blocks] ||
+                     hi != tx_hi[rx_blocks])) begin
+                    mismatches++;
+                end
+                rx_blocks++;
+            end
+        end
+
+        if (dpi_128b130b_rx_slip(framer_rx) != BIT_SLIP) begin
+            $display("  ✗ ERROR: locked after %0d slips (expected %0d)",
+                     dpi_128b130b_rx_slip(framer_rx), BIT_SLIP);
+            error_count++;
+        end
+        if (rx_blocks != NUM_BLOCKS || mismatches != 0) begin
+            $display("  ✗ ERROR: %0d/%0d blocks received, %0d mismatches",
+                     rx_blocks, NUM_BLOCKS, mismatches);
+            error_count++;
+        end
+        dpi_128b130b_destroy(framer_tx);
+        dpi_128b130b_destroy(framer_rx);
+        $display("  Done (%0d blocks, %0d words, lock after %0d-bit slip)",
+                 NUM_BLOCKS, tx_word_count, BIT_SLIP);
+    endtask
+
+    //==========================================================================
+    // MAIN TEST SEQUENCE
+    //==========================================================================
+    initial begin
+        $display("========================================");
+        $display("  PCIe Line Coding Layer Test");
+        $display("========================================");
+
+        test_scrambler();
+        test_8b10b();
+        test_128b130b();
+
+        $display("");
+        if (error_count == 0) begin
+            $display("========================================");
+            $display("*** PASSED: All tests passed ***");
+            $display("========================================");
+        end else begin
+            $display("========================================");
+            $display("*** FAILED: %0d errors detected ***", error_count);
+            $display("========================================");
+        end
+
+        $finish;
+    end
+
+    //==========================================================================
+    // TIMEOUT WATCHDOG
+    //==========================================================================
+    initial begin
+        #SIM_TIMEOUT;
+        $display("ERROR: Simulation timeout after %0d time units", SIM_TIMEOUT);
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,250 @@
+/**
+ * rs_fec_tb.sv - Self-Checking Testbench for RS(544,514) KP4 FEC
+ *
+ * Test Strategy:
+ * - Codec: encode random messages, inject 0..15 random symbol errors and
+ *   check the decoder restores the codeword exactly; inject 16 errors and
+ *   check the codeword is flagged uncorrectable
+ * - Estimator: feed a pre-FEC error stream (random events, 30% of them short
+ *   bursts of 2..6 bits) into the post-FEC estimator and check the
+ *   compound-Poisson burst model reproduces the measured FER, once without
+ *   interleaving and once with 2-way symbol interleaving
+ * - Write the estimator report (last pass) to sim/rs_fec_report.txt
+ *
+ * Author: Generated for SerDes PAM4 FEC evaluation
+ * Date: 2025
+ */
+
+`timescale 1ns / 1ps
+
+module rs_fec_tb #(
+    parameter SIM_TIMEOUT = 10000  // 10us timeout (codec trials @ 100MHz + margin)
+);
+
+    //==========================================================================
+    // TEST PARAMETERS
+    //==========================================================================
+    localparam int  RS_N = 544;
+    localparam int  RS_K = 514;
+    localparam int  RS_T = 15;
+    localparam int  NUM_TRIALS = 64;            // Codec trials, errors = trial % 17
+    localparam int  EST_CODEWORDS = 4000;       // Estimator stream length
+    localparam real EVENTS_PER_CW = 9.0;        // Error events per codeword
+    localparam real BURST_FRACTION = 0.3;       // Events that are 2..6-bit bursts
+    localparam real FER_RATIO_TOL = 1.5;        // Model vs measured FER
+
+    //==========================================================================
+    // DPI-C IMPORTS
+    //==========================================================================
+    import "DPI-C" function chandle dpi_rsfec_create(input int n, input int k);
+    import "DPI-C" function void dpi_rsfec_encode(input chandle h,
+        input int msg[RS_K], output int cw[RS_N]);
+    import "DPI-C" function int  dpi_rsfec_decode(input chandle h, inout int cw[RS_N]);
+    import "DPI-C" function void dpi_rsfec_est_config(input chandle h,
+        input int interleave, input int burst_gap);
+    import "DPI-C" function void dpi_rsfec_est_error_bit(input chandle h,
+        input longint bit_index);
+    import "DPI-C" function void dpi_rsfec_est_finish(input chandle h,
+        input longint total_bits);
+    import "DPI-C" function real dpi_rsfec_est_pre_fec_ber(input chandle h);
+    import "DPI-C" function real dpi_rsfec_est_measured_fer(input chandle h);
+    import "DPI-C" function real dpi_rsfec_est_model_fer(input chandle h,
+        input real ber_scale);
+    import "DPI-C" function int  dpi_rsfec_est_write_report(input chandle h,
+        input string path);
+    import "DPI-C" function void dpi_rsfec_destroy(input chandle h);
+
+    //==========================================================================
+    // TESTBENCH SIGNALS
+    //==========================================================================
+    logic   clk;
+    chandle fec;
+
+    //==========================================================================
+    // VERIFICATION VARIABLES
+    //==========================================================================
+    int     error_count = 0;
+    int     msg[RS_K];
+    int     cw[RS_N];
+    int     ref_cw[RS_N];
+    bit     hit[RS_N];
+
+    //==========================================================================
+    // CLOCK GENERATION
+    //==========================================================================
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    //==========================================================================
+    // VCD WAVEFORM DUMP
+    //==========================================================================
+    initial begin
+        $dumpfile("sim/waves/rs_fec.vcd");
+        $dumpvars(0, rs_fec_tb);
+    end
+
+    //==========================================================================
+    // HELPERS
+    //==========================================================================
+    // Uniform (0, 1)
+    function automatic real urand();
+        return (real'($urandom % 1000000) + 1.0) / 1000001.0;
+    endfunction
+
+    //==========================================================================
+    // TEST: ENCODE / INJECT / DECODE
+    //==========================================================================
+    task automatic test_codec();
+        int nerr;
+        int placed;
+        int pos;
+        int result;
+        int mismatch;
+        int detected = 0;
+        int overload = 0;
+
+        $display("[%0t ns] Codec: %0d trials, 0..16 symbol errors", $time, NUM_TRIALS);
+        for (int trial = 0; trial < NUM_TRIALS; trial++) begin
+            @(posedge clk);
+            for (int i = 0; i < RS_K; i++) msg[i] = int'($urandom % 1024);
+            dpi_rsfec_encode(fec, msg, cw);
+            ref_cw = cw;
+
+            nerr = trial % 17;
+            placed = 0;
+            for (int i = 0; i < RS_N; i++) hit[i] = 1'b0;
+            while (placed < nerr) begin
+                pos = int'($urandom % RS_N);
+                if (!hit[pos]) begin
+                    hit[pos] = 1'b1;
+                    cw[pos] = cw[pos] ^ int'(1 + $urandom % 1023);
+                    placed++;
+                end
+            end
+
+            result = dpi_rsfec_decode(fec, cw);
+            if (nerr <= RS_T) begin
+                mismatch = 0;
+                for (int i = 0; i < RS_N; i++) if (cw[i] != ref_cw[i]) mismatch++;
+                if (result != nerr || mismatch != 0) begin
+                    $display("  ✗ ERROR: trial %0d, %0d errors: decode=%0d, %0d symbols wrong",
+                             trial, nerr, result, mismatch);
+                    error_count++;
+                end
+            end else begin
+                overload++;
+                if (result < 0) detected++;
+            end
+        end
+        $display("  %0d/%0d overloaded codewords flagged uncorrectable", detected, overload);
+        if (detected != overload) begin
+            $display("  ✗ ERROR: uncorrectable codeword not detected");
+            error_count++;
+        end
+    endtask
+
+    //==========================================================================
+    // TEST: POST-FEC ESTIMATOR
+    //==========================================================================
+    task automatic test_estimator(input int interleave);
+        longint total_bits;
+        longint bit_pos;
+        longint injected = 0;
+        real    p_event;
+        real    gap;
+        real    fer_meas;
+        real    fer_model;
+        real    fer_low;
+        int     len;
+
+        total_bits = longint'(EST_CODEWORDS) * RS_N * 10;
+        p_event = EVENTS_PER_CW / (RS_N * 10.0);
+        dpi_rsfec_est_config(fec, interleave, 10);
+
+        bit_pos = -1;
+        forever begin
+            gap = -$ln(urand()) / p_event;
+            bit_pos = bit_pos + longint'(gap) + 1;
+            if (bit_pos >= total_bits) break;
+            len = (urand() < BURST_FRACTION) ? 2 + int'($urandom % 5) : 1;
+            for (int b = 0; b < len && bit_pos < total_bits; b++) begin
+                dpi_rsfec_est_error_bit(fec, bit_pos);
+                injected++;
+                if (b < len - 1) bit_pos++;
+            end
+        end
+        dpi_rsfec_est_finish(fec, total_bits);
+
+        fer_meas = dpi_rsfec_est_measured_fer(fec);
+        fer_model = dpi_rsfec_est_model_fer(fec, 1.0);
+        fer_low = dpi_rsfec_est_model_fer(fec, 0.1);
+        $display("[%0t ns] Estimator: %0d codewords, interleave %0d, %0d error bits",
+                 $time, EST_CODEWORDS, interleave, injected);
+        $display("  Pre-FEC BER         = %e", dpi_rsfec_est_pre_fec_ber(fec));
+        $display("  FER measured        = %e", fer_meas);
+        $display("  FER model           = %e", fer_model);
+        $display("  FER model @ 0.1xBER = %e", fer_low);
+
+        if (dpi_rsfec_est_pre_fec_ber(fec) != real'(injected) / real'(total_bits)) begin
+            $display("  ✗ ERROR: pre-FEC BER does not match injected errors");
+            error_count++;
+        end
+        if (fer_meas <= 0.0 || fer_model > fer_meas * FER_RATIO_TOL ||
+            fer_model < fer_meas / FER_RATIO_TOL) begin
+            $display("  ✗ ERROR: model FER outside %0.1fx of measured", FER_RATIO_TOL);
+            error_count++;
+        end
+        if (fer_low >= fer_model * 1.0e-3) begin
+            $display("  ✗ ERROR: FER did not fall steeply with pre-FEC BER");
+            error_count++;
+        end
+        if (dpi_rsfec_est_write_report(fec, "sim/rs_fec_report.txt") != 0) begin
+            $display("  ✗ ERROR: report not written");
+            error_count++;
+        end
+    endtask
+
+    //==========================================================================
+    // MAIN TEST SEQUENCE
+    //==========================================================================
+    initial begin
+        $display("========================================");
+        $display("  RS(544,514) KP4 FEC Test");
+        $display("========================================");
+
+        void'($urandom(78));
+        fec = dpi_rsfec_create(RS_N, RS_K);
+        if (fec == null) begin
+            $display("✗ FAIL: dpi_rsfec_create returned null");
+            $finish;
+        end
+
+        test_codec();
+        test_estimator(1);
+        test_estimator(2);
+        dpi_rsfec_destroy(fec);
+
+        $display("");
+        if (error_count == 0) begin
+            $display("========================================");
+            $display("*** PASSED: All tests passed ***");
+            $display("========================================");
+        end else begin
+            $display("========================================");
+            $display("*** FAILED: %0d errors detected ***", error_count);
+            $display("========================================");
+        end
+
+        $finish;
+    end
+
+    //==========================================================================
+    // TIMEOUT WATCHDOG
+    //==========================================================================
+    initial begin
+        #SIM_TIMEOUT;
+        $display("ERROR: Simulation timeout after %0d time units", SIM_TIMEOUT);
+        $finish;
+    end
+
+endmodule
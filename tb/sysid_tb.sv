@@ -0,0 +1,191 @@
+/**
+ * sysid_tb.sv - Self-Checking Testbench for MLS System Identification
+ *
+ * Test Strategy:
+ * - Drive a known 3-tap FIR "channel" with the MLS stimulus from
+ *   dpi_sysid_next_stimulus() and capture its output with dpi_sysid_capture()
+ * - Solve with the Hadamard cross-correlation after 1 warmup + 4 averaged
+ *   periods of PRBS7 (635 samples total)
+ * - Self-check: identified taps, DC gain and Nyquist gain match the
+ *   FIR coefficients (noise-free, so agreement is to numerical precision)
+ * - Write the full Bode plot to sim/sysid_bode.csv
+ *
+ * The same flow applies unchanged to an RTL DUT such as ctle_rnm.sv: replace
+ * the FIR expression with the DUT input/output ports.
+ *
+ * Author: Generated for SerDes CTLE characterization
+ * Date: 2025
+ */
+
+`timescale 1ns / 1ps
+
+module sysid_tb #(
+    parameter SIM_TIMEOUT = 20000  // 20us timeout (635 samples @ 100MHz = 6.35us + margin)
+);
+
+    //==========================================================================
+    // DPI-C IMPORTS
+    //==========================================================================
+    import "DPI-C" function chandle dpi_sysid_create(
+        input int order, input real amplitude, input real sample_rate_hz,
+        input int warmup_periods, input int avg_periods);
+    import "DPI-C" function real dpi_sysid_next_stimulus(input chandle h);
+    import "DPI-C" function int  dpi_sysid_capture(input chandle h, input real y);
+    import "DPI-C" function int  dpi_sysid_solve(input chandle h);
+    import "DPI-C" function real dpi_sysid_impulse(input chandle h, input int k);
+    import "DPI-C" function real dpi_sysid_gain_db(input chandle h, input real freq_hz);
+    import "DPI-C" function int  dpi_sysid_write_bode(input chandle h, input string path);
+    import "DPI-C" function void dpi_sysid_destroy(input chandle h);
+
+    //==========================================================================
+    // TEST PARAMETERS
+    //==========================================================================
+    localparam int  MLS_ORDER = 7;              // PRBS7, period 127
+    localparam real AMPLITUDE = 0.1;            // Stimulus ±0.1 V
+    localparam real SAMPLE_RATE = 100.0e6;      // 100 MHz (10ns clock)
+    localparam int  WARMUP_PERIODS = 1;
+    localparam int  AVG_PERIODS = 4;
+
+    // Known channel: y[n] = H0·x[n] + H1·x[n-1] + H2·x[n-2]
+    localparam real H0 = 0.6;
+    localparam real H1 = 0.3;
+    localparam real H2 = -0.1;
+    localparam real TOLERANCE = 1.0e-9;         // Tap error (noise-free)
+    localparam real GAIN_TOL_DB = 0.01;
+
+    //==========================================================================
+    // TESTBENCH SIGNALS
+    //==========================================================================
+    logic   clk;
+    real    stimulus;
+    real    x_d1;
+    real    x_d2;
+    real    channel_out;
+    chandle sysid;
+
+    //==========================================================================
+    // VERIFICATION VARIABLES
+    //==========================================================================
+    int  error_count = 0;
+    int  sample_count = 0;
+    int  done = 0;
+    real tap;
+    real expected_tap;
+    real gain_db;
+    real expected_db;
+
+    //==========================================================================
+    // CLOCK GENERATION
+    //==========================================================================
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    //==========================================================================
+    // VCD WAVEFORM DUMP
+    //==========================================================================
+    initial begin
+        $dumpfile("sim/waves/sysid.vcd");
+        $dumpvars(0, sysid_tb);
+    end
+
+    //==========================================================================
+    // MAIN TEST SEQUENCE
+    //==========================================================================
+    initial begin
+        $display("========================================");
+        $display("  MLS System Identification Test");
+        $display("========================================");
+        $display("  MLS order     : %0d (period %0d)", MLS_ORDER, (1 << MLS_ORDER) - 1);
+        $display("  Amplitude     : %0.3f V", AMPLITUDE);
+        $display("  Periods       : %0d warmup + %0d averaged", WARMUP_PERIODS, AVG_PERIODS);
+        $display("  Channel taps  : %0.2f, %0.2f, %0.2f", H0, H1, H2);
+        $display("========================================");
+
+        stimulus = 0.0;
+        x_d1 = 0.0;
+        x_d2 = 0.0;
+        channel_out = 0.0;
+
+        sysid = dpi_sysid_create(MLS_ORDER, AMPLITUDE, SAMPLE_RATE,
+                                 WARMUP_PERIODS, AVG_PERIODS);
+        if (sysid == null) begin
+            $display("✗ FAIL: dpi_sysid_create returned null");
+            $finish;
+        end
+
+        // Stimulus and capture in the same sample slot
+        while (done == 0) begin
+            @(posedge clk);
+            stimulus = dpi_sysid_next_stimulus(sysid);
+            channel_out = H0 * stimulus + H1 * x_d1 + H2 * x_d2;
+            x_d2 = x_d1;
+            x_d1 = stimulus;
+            done = dpi_sysid_capture(sysid, channel_out);
+            sample_count++;
+        end
+        $display("[%0t ns] Captured %0d samples, solving...", $time, sample_count);
+
+        if (dpi_sysid_solve(sysid) != 0) begin
+            $display("✗ FAIL: dpi_sysid_solve failed");
+            error_count++;
+        end
+
+        // Check impulse taps 0..7 (taps 3.. must be zero)
+        for (int k = 0; k < 8; k++) begin
+            tap = dpi_sysid_impulse(sysid, k);
+            expected_tap = (k == 0) ? H0 : (k == 1) ? H1 : (k == 2) ? H2 : 0.0;
+            $display("  h[%0d] = %9.6f (expected %9.6f)", k, tap, expected_tap);
+            if (tap - expected_tap > TOLERANCE || expected_tap - tap > TOLERANCE) begin
+                $display("  ✗ ERROR: tap %0d mismatch", k);
+                error_count++;
+            end
+        end
+
+        // DC gain: 20·log10(H0 + H1 + H2)
+        gain_db = dpi_sysid_gain_db(sysid, 0.0);
+        expected_db = 20.0 * $log10(H0 + H1 + H2);
+        $display("  Gain @ DC      = %7.3f dB (expected %7.3f dB)", gain_db, expected_db);
+        if (gain_db - expected_db > GAIN_TOL_DB || expected_db - gain_db > GAIN_TOL_DB) begin
+            $display("  ✗ ERROR: DC gain mismatch");
+            error_count++;
+        end
+
+        // Nyquist gain: 20·log10(|H0 - H1 + H2|)
+        gain_db = dpi_sysid_gain_db(sysid, SAMPLE_RATE / 2.0);
+        expected_db = 20.0 * $log10(H0 - H1 + H2);
+        $display("  Gain @ Nyquist = %7.3f dB (expected %7.3f dB)", gain_db, expected_db);
+        if (gain_db - expected_db > GAIN_TOL_DB || expected_db - gain_db > GAIN_TOL_DB) begin
+            $display("  ✗ ERROR: Nyquist gain mismatch");
+            error_count++;
+        end
+
+        if (dpi_sysid_write_bode(sysid, "sim/sysid_bode.csv") <= 0) begin
+            $display("  ✗ ERROR: Bode CSV not written");
+            error_count++;
+        end
+        dpi_sysid_destroy(sysid);
+
+        $display("");
+        if (error_count == 0) begin
+            $display("========================================");
+            $display("*** PASSED: All tests passed ***");
+            $display("========================================");
+        end else begin
+            $display("========================================");
+            $display("*** FAILED: %0d errors detected ***", error_count);
+            $display("========================================");
+        end
+
+        $finish;
+    end
+
+    //==========================================================================
+    // TIMEOUT WATCHDOG
+    //==========================================================================
+    initial begin
+        #SIM_TIMEOUT;
+        $display("ERROR: Simulation timeout after %0d time units", SIM_TIMEOUT);
+        $finish;
+    end
+
+endmodule
@@ -0,0 +1,246 @@
+/**
+ * tie_tb.sv - Self-Checking Testbench for TIE Capture / Jitter Decomposition
+ *
+ * Test Strategy:
+ * - Known-answer test (ideal clock): 100k UIs of random data edges with
+ *   RJ = 0.01 UI RMS, PJ = 0.05 UI at UI rate / 200, DCD = 0.04 UI and
+ *   ISI (+0.03 UI after a single-UI bit) fed through dpi_tie_add_edge();
+ *   check RJ, DCD, DDJ, PJ amplitude and frequency
+ * - Waveform path (recovered clock): a 16x-oversampled clock waveform with
+ *   a +100 ppm frequency offset and 0.005 UI RMS edge jitter goes through
+ *   dpi_tie_add_waveform(); check edge count, tracked UI, RJ and DCD
+ * - Write the histogram, residual spectrum and report to sim/
+ *
+ * Author: Generated for SerDes jitter analysis
+ * Date: 2025
+ */
+
+`timescale 1ns / 1ps
+
+module tie_tb #(
+    parameter SIM_TIMEOUT = 20000  // 20us timeout (100 + 80 blocks @ 100MHz = 1.8us + margin)
+);
+
+    //==========================================================================
+    // TEST PARAMETERS
+    //==========================================================================
+    localparam real UI = 100.0e-12;             // 10 Gb/s
+    localparam int  KAT_BLOCKS = 100;           // x 1000 UIs
+    localparam real RJ = 0.01;                  // UI RMS
+    localparam real PJ_AMP = 0.05;              // UI 0-peak
+    localparam real PJ_PERIOD = 200.0;          // UIs
+    localparam real DCD = 0.04;                 // Rising - falling (UI)
+    localparam real ISI = 0.03;                 // Late edge after a 1-UI bit
+    localparam int  CLK_BLOCKS = 80;
+    localparam int  CLK_UIS = 250;              // UIs (edges) per block
+    localparam int  SPU = 16;                   // Samples per UI
+    localparam int  CLK_N = CLK_UIS * SPU;
+    localparam real PPM = 100.0e-6;             // Clock frequency offset
+    localparam real CLK_RJ = 0.005;             // UI RMS
+    localparam real CDR_BW = 0.002;             // Cycles per edge
+    localparam real RISE = 0.3;                 // Edge 0-100% time (UI)
+
+    //==========================================================================
+    // DPI-C IMPORTS
+    //==========================================================================
+    import "DPI-C" function chandle dpi_tie_create(input real ui_s, input real vref,
+        input real cdr_bw, input int fft_len);
+    import "DPI-C" function int  dpi_tie_add_waveform(input chandle h,
+        input real v[CLK_N], input int n, input real t0, input real dt);
+    import "DPI-C" function void dpi_tie_add_edge(input chandle h, input real t, input int rising);
+    import "DPI-C" function real dpi_tie_period(input chandle h);
+    import "DPI-C" function longint dpi_tie_edges(input chandle h);
+    import "DPI-C" function real dpi_tie_rms(input chandle h);
+    import "DPI-C" function real dpi_tie_dcd(input chandle h);
+    import "DPI-C" function real dpi_tie_ddj(input chandle h);
+    import "DPI-C" function real dpi_tie_pj(input chandle h);
+    import "DPI-C" function int  dpi_tie_pj_count(input chandle h);
+    import "DPI-C" function real dpi_tie_pj_freq(input chandle h, input int i);
+    import "DPI-C" function real dpi_tie_pj_amp(input chandle h, input int i);
+    import "DPI-C" function real dpi_tie_rj(input chandle h);
+    import "DPI-C" function real dpi_tie_tj(input chandle h, input real ber);
+    import "DPI-C" function int  dpi_tie_write_histogram(input chandle h, input string path);
+    import "DPI-C" function int  dpi_tie_write_spectrum(input chandle h, input string path);
+    import "DPI-C" function int  dpi_tie_write_report(input chandle h, input string path);
+    import "DPI-C" function void dpi_tie_destroy(input chandle h);
+
+    //==========================================================================
+    // TESTBENCH SIGNALS
+    //==========================================================================
+    logic clk;
+
+    //==========================================================================
+    // VERIFICATION VARIABLES
+    //==========================================================================
+    int  error_count = 0;
+    real wave[CLK_N];
+    real jit[1024];                             // Clock edge jitter ring (by edge index)
+
+    //==========================================================================
+    // CLOCK GENERATION
+    //==========================================================================
+    initial clk = 0;
+    always #5 clk = ~clk;
+
+    //==========================================================================
+    // VCD WAVEFORM DUMP
+    //==========================================================================
+    initial begin
+        $dumpfile("sim/waves/tie.vcd");
+        $dumpvars(0, tie_tb);
+    end
+
+    //==========================================================================
+    // HELPERS
+    //==========================================================================
+    function automatic real urand();
+        return (real'($urandom % 1000000) + 1.0) / 1000001.0;
+    endfunction
+
+    function automatic real gauss();
+        return $sqrt(-2.0 * $ln(urand())) * $cos(2.0 * 3.14159265358979 * urand());
+    endfunction
+
+    task automatic check_range(input string name, input real value, input real expected,
+                               input real tol);
+        $display("  %-16s = %9.5f (expected %9.5f ± %0.4f)", name, value, expected, tol);
+        if (value > expected + tol || value < expected - tol) begin
+            $display("  ✗ ERROR: %s out of range", name);
+            error_count++;
+        end
+    endtask
+
+    //==========================================================================
+    // TEST: DECOMPOSITION KNOWN ANSWER
+    //==========================================================================
+    task automatic test_known_answer();
+        chandle tie;
+        int     bit_now;
+        int     bit_prev = 0;
+        int     bit_prev2 = 0;
+        real    j;
+        real    t;
+
+        tie = dpi_tie_create(UI, 0.0, 0.0, 4096);
+        for (int blk = 0; blk < KAT_BLOCKS; blk++) begin
+            @(posedge clk);
+            for (int i = 0; i < 1000; i++) begin
+                t = real'(blk * 1000 + i);
+                bit_now = int'($urandom % 2);
+                if (bit_now != bit_prev) begin
+                    j = RJ * gauss() + PJ_AMP * $sin(2.0 * 3.14159265358979 * t / PJ_PERIOD) +
+                        ((bit_now == 1) ? DCD / 2.0 : -DCD / 2.0) +
+                        ((bit_prev != bit_prev2) ? ISI : 0.0);
+                    dpi_tie_add_edge(tie, (t + j) * UI, bit_now);
+                end
+                bit_prev2 = bit_prev;
+                bit_prev = bit_now;
+            end
+        end
+
+        $display("[%0t ns] Known answer (%0d UIs, %0d edges)", $time, KAT_BLOCKS * 1000,
+                 dpi_tie_edges(tie));
+        check_range("RJ (UI)", dpi_tie_rj(tie), RJ, 0.001);
+        check_range("DCD (UI)", dpi_tie_dcd(tie), DCD, 0.003);
+        // Pattern means: rise/fall × (after 1-UI bit or not) → DCD + ISI p-p
+        check_range("DDJ (UI)", dpi_tie_ddj(tie), DCD + ISI, 0.007);
+        check_range("PJ p-p (UI)", dpi_tie_pj(tie), 2.0 * PJ_AMP, 0.005);
+        if (dpi_tie_pj_count(tie) != 1) begin
+            $display("  ✗ ERROR: expected 1 PJ tone, found %0d", dpi_tie_pj_count(tie));
+            error_count++;
+        end else begin
+            // Resolution: one bin = UI rate / 4096
+            check_range("PJ freq (MHz)", dpi_tie_pj_freq(tie, 0) / 1.0e6,
+                        1.0 / (PJ_PERIOD * UI) / 1.0e6, 1.0 / (4096.0 * UI) / 1.0e6);
+        end
+        $display("  TJ@1e-12 (UI)     = %9.5f", dpi_tie_tj(tie, 1.0e-12));
+        if (dpi_tie_write_histogram(tie, "sim/tie_histogram.csv") != 0) error_count++;
+        if (dpi_tie_write_spectrum(tie, "sim/tie_spectrum.csv") != 0) error_count++;
+        if (dpi_tie_write_report(tie, "sim/tie_report.txt") != 0) error_count++;
+        dpi_tie_destroy(tie);
+    endtask
+
+    //==========================================================================
+    // TEST: CLOCK WAVEFORM, RECOVERED CLOCK
+    //==========================================================================
+    task automatic test_clock_waveform();
+        chandle tie;
+        int     edges = 0;
+        longint gen = 0;
+        longint k;
+        longint k_max;
+        real    u;
+        real    b;
+        real    f;
+        real    after;
+
+        tie = dpi_tie_create(UI, 0.0, CDR_BW, 1024);
+        for (int blk = 0; blk < CLK_BLOCKS; blk++) begin
+            @(posedge clk);
+            // Edge k at k·(1 + PPM) + jit[k] UI; rising on even k
+            k_max = longint'($floor(real'((blk + 1) * CLK_UIS) / (1.0 + PPM) + 0.5)) + 1;
+            while (gen <= k_max) begin
+                jit[int'(gen % 1024)] = CLK_RJ * gauss();
+                gen++;
+            end
+            for (int n = 0; n < CLK_N; n++) begin
+                u = real'(blk * CLK_N + n) / real'(SPU);
+                k = longint'($floor(u / (1.0 + PPM) + 0.5));
+                b = real'(k) * (1.0 + PPM) + jit[int'(k % 1024)];
+                after = (k % 2 == 0) ? 1.0 : 0.0;
+                f = (u - b) / RISE + 0.5;
+                f = (f < 0.0) ? 0.0 : ((f > 1.0) ? 1.0 : f);
+                wave[n] = 0.4 * (2.0 * ((1.0 - after) + (2.0 * after - 1.0) * f) - 1.0);
+            end
+            edges += dpi_tie_add_waveform(tie, wave, CLK_N, real'(blk * CLK_UIS) * UI, UI / SPU);
+        end
+
+        $display("[%0t ns] Clock waveform, +%0.0f ppm, recovered clock (%0d edges)", $time,
+                 PPM * 1.0e6, edges);
+        // All edges but the one at t = 0 (no sample before it)
+        if (edges < CLK_BLOCKS * CLK_UIS - 5 || edges > CLK_BLOCKS * CLK_UIS) begin
+            $display("  ✗ ERROR: edge count %0d", edges);
+            error_count++;
+        end
+        check_range("UI offset (ppm)", (dpi_tie_period(tie) / UI - 1.0) * 1.0e6, PPM * 1.0e6, 5.0);
+        check_range("RJ (UI)", dpi_tie_rj(tie), CLK_RJ, 0.0005);
+        check_range("DCD (UI)", dpi_tie_dcd(tie), 0.0, 0.001);
+        dpi_tie_destroy(tie);
+    endtask
+
+    //==========================================================================
+    // MAIN TEST SEQUENCE
+    //==========================================================================
+    initial begin
+        $display("========================================");
+        $display("  TIE Jitter Decomposition Test");
+        $display("========================================");
+
+        void'($urandom(82));
+        test_known_answer();
+        test_clock_waveform();
+
+        $display("");
+        if (error_count == 0) begin
+            $display("========================================");
+            $display("*** PASSED: All tests passed ***");
+            $display("========================================");
+        end else begin
+            $display("========================================");
+            $display("*** FAILED: %0d errors detected ***", error_count);
+            $display("========================================");
+        end
+
+        $finish;
+    end
+
+    //==========================================================================
+    // TIMEOUT WATCHDOG
+    //==========================================================================
+    initial begin
+        #SIM_TIMEOUT;
+        $display("ERROR: Simulation timeout after %0d time units", SIM_TIMEOUT);
+        $finish;
+    end
+
+endmodule